@@ -23,6 +23,7 @@
 #include "alljoyn/gateway/GatewayEnums.h"
 
 #include <list>
+#include <pthread.h>
 
 #include "GatewayMergedAcl.h"
 
@@ -75,6 +76,24 @@ class GatewayConnector : public MessageReceiver {
      */
     QStatus getMergedAclAsync(GatewayMergedAcl* response);
 
+    /**
+     * Get the merged Acl from the GatewayMgmtApp only if it changed since the
+     * version held in response. The response is left untouched if it did not change
+     * @param response - MergedAcl response, holding the version of the last fetch
+     * @param changed - set to whether the merged Acl changed
+     * @return status - success/failure
+     */
+    QStatus getMergedAclIfChanged(GatewayMergedAcl* response, bool* changed);
+
+    /**
+     * Get a copy of the merged Acl kept by the GatewayConnector. The copy is kept
+     * current by applying the deltas of the MergedAclUpdated signal, and is
+     * fetched from the GatewayMgmtApp if it is not known yet
+     * @param response - MergedAcl response
+     * @return status - success/failure
+     */
+    QStatus getCachedMergedAcl(GatewayMergedAcl* response);
+
   protected:
 
     /**
@@ -85,7 +104,8 @@ class GatewayConnector : public MessageReceiver {
     virtual void receiveGetMergedAclAsync(QStatus unmarshalStatus, GatewayMergedAcl* response) { }
 
     /**
-     * Handler for the mergedAcl signal
+     * Handler for the mergedAcl signal. Called once the cached merged Acl
+     * was updated, or if updating it failed
      */
     virtual void mergedAclUpdated() = 0;
 
@@ -145,6 +165,16 @@ class GatewayConnector : public MessageReceiver {
      * The proxyBusObject used for Remote methods
      */
     ProxyBusObject* m_RemoteAppAccess;
+
+    /**
+     * The merged Acl kept current from the MergedAclUpdated signal
+     */
+    GatewayMergedAcl m_MergedAcl;
+
+    /**
+     * Lock protecting m_MergedAcl
+     */
+    pthread_mutex_t m_MergedAclLock;
 };
 
 } //namespace gw
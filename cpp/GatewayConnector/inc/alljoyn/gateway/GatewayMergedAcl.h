@@ -32,6 +32,11 @@ static const uint16_t UUID_LENGTH = 16;
 class GatewayMergedAcl {
   public:
 
+    /**
+     * Constructor for GatewayMergedAcl
+     */
+    GatewayMergedAcl() : m_Version(0) { }
+
     /**
      * Function to unmarshal a message and retrieve MergedAcl data
      * @param msg - msg to unmarshal
@@ -39,6 +44,35 @@ class GatewayMergedAcl {
      */
     QStatus unmarshal(Message& msg);
 
+    /**
+     * Function to retrieve MergedAcl data from the args of a message
+     * @param args - the args of the message
+     * @param numArgs - the number of args
+     * @return status - success/failure
+     */
+    QStatus unmarshal(const MsgArg* args, size_t numArgs);
+
+    /**
+     * Function to unmarshal the reply of GetMergedAclIfChanged. If the MergedAcl
+     * changed it replaces the current data and updates m_Version, otherwise
+     * the current data is kept
+     * @param msg - msg to unmarshal
+     * @param changed - set to whether the MergedAcl changed
+     * @return status - success/failure
+     */
+    QStatus unmarshalIfChanged(Message& msg, bool* changed);
+
+    /**
+     * Function to apply the delta carried by the MergedAclUpdated signal. The
+     * delta is only applied if it follows on m_Version. Otherwise gap is set
+     * and the MergedAcl has to be fetched again with GetMergedAclIfChanged
+     * @param msg - msg of the signal
+     * @param changed - set to whether the delta was applied
+     * @param gap - set to whether the delta does not follow on m_Version
+     * @return status - success/failure
+     */
+    QStatus unmarshalUpdate(Message& msg, bool* changed, bool* gap);
+
     /**
      * ObjectDescription structure
      */
@@ -91,8 +125,53 @@ class GatewayMergedAcl {
      */
     std::list<RemotedApp> m_RemotedApps;
 
+    /**
+     * The version of the MergedAcl, as received from GetMergedAclIfChanged
+     * or the MergedAclUpdated signal. 0 if the version is unknown
+     */
+    uint32_t m_Version;
+
   private:
 
+    /**
+     * private function used to unmarshal the exposedServices and remotedApps args
+     * @param exposedServicesArg - msgArg of the exposed services
+     * @param remotedAppsArg - msgArg of the remoted apps
+     * @return status - success/failure
+     */
+    QStatus unmarshalMergedAcl(const MsgArg* exposedServicesArg, const MsgArg* remotedAppsArg);
+
+    /**
+     * private function used to unmarshal RemotedApps
+     * @param remotedAppsArg - msgArg of the remoted apps
+     * @param dest - destination to unmarshal them into
+     * @return status - success/failure
+     */
+    QStatus unmarshalRemotedApps(const MsgArg* remotedAppsArg, std::list<RemotedApp>& dest);
+
+    /**
+     * private function used to add ObjectDescriptions or interfaces to a list.
+     * Adding an ObjectDescription without interfaces widens it to all interfaces
+     * @param objects - the list to add to
+     * @param added - the ObjectDescriptions to add
+     */
+    static void addObjectDescriptions(std::list<ObjectDescription>& objects, const std::list<ObjectDescription>& added);
+
+    /**
+     * private function used to remove ObjectDescriptions or interfaces from a list.
+     * Removing an ObjectDescription without interfaces, or its last interface, removes it
+     * @param objects - the list to remove from
+     * @param removed - the ObjectDescriptions to remove
+     */
+    static void removeObjectDescriptions(std::list<ObjectDescription>& objects, const std::list<ObjectDescription>& removed);
+
+    /**
+     * private function used to find a RemotedApp
+     * @param remotedApp - the RemotedApp to look for
+     * @return iterator - m_RemotedApps.end() if the RemotedApp is not there
+     */
+    std::list<RemotedApp>::iterator findRemotedApp(const RemotedApp& remotedApp);
+
     /**
      * private function used to unmarshal ObjectDescriptions
      * @param objDescArgs - msgArg to unmarshal
@@ -100,7 +179,7 @@ class GatewayMergedAcl {
      * @param dest - destination to unmarshal them into
      * @return status - sucess/failure
      */
-    QStatus unmarshalObjectDescriptions(MsgArg* objDescArgs, size_t numObjDescs, std::list<ObjectDescription>& dest);
+    static QStatus unmarshalObjectDescriptions(MsgArg* objDescArgs, size_t numObjDescs, std::list<ObjectDescription>& dest);
 };
 
 } //namespace gw
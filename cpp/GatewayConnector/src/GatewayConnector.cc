@@ -29,11 +29,12 @@ GatewayConnector::GatewayConnector(BusAttachment* bus, qcc::String const& appNam
 {
     m_ObjectPath.append(appName);
     m_WellKnownName.append(appName);
+    pthread_mutex_init(&m_MergedAclLock, NULL);
 }
 
 GatewayConnector::~GatewayConnector()
 {
-
+    pthread_mutex_destroy(&m_MergedAclLock);
 }
 
 QStatus GatewayConnector::init()
@@ -93,12 +94,18 @@ const InterfaceDescription* GatewayConnector::initInterface(QStatus& status)
         return NULL;
     }
 
+    status = ifc->AddMethod("GetMergedAclIfChanged", "u",  "uba(obas)a(saya(obas))", "version,currentVersion,changed,exposedServices,remotedApps");
+    if (ER_OK != status) {
+        return NULL;
+    }
+
     status = ifc->AddMethod("UpdateConnectionStatus", "q", NULL, "connectionStatus", MEMBER_ANNOTATE_NO_REPLY);
     if (ER_OK != status) {
         return NULL;
     }
 
-    status = ifc->AddSignal("MergedAclUpdated", NULL, NULL);
+    status = ifc->AddSignal("MergedAclUpdated", "ua(obas)a(obas)a(saya(obas))a(saya(obas))",
+                            "mergeSequence,addedExposedServices,removedExposedServices,addedRemotedApps,removedRemotedApps");
     if (ER_OK != status) {
         return NULL;
     }
@@ -128,6 +135,41 @@ QStatus GatewayConnector::getMergedAcl(GatewayMergedAcl* response)
     return status;
 }
 
+QStatus GatewayConnector::getMergedAclIfChanged(GatewayMergedAcl* response, bool* changed)
+{
+    QStatus status = ER_OK;
+
+    MsgArg input[1];
+    input[0].Set("u", response->m_Version);
+
+    Message reply(*m_Bus);
+    status = m_RemoteAppAccess->MethodCall(GW_CONNECTOR_IFC_NAME, "GetMergedAclIfChanged", input, 1, reply);
+    if (ER_OK != status) {
+        return status;
+    }
+
+    status = response->unmarshalIfChanged(reply, changed);
+
+    return status;
+}
+
+QStatus GatewayConnector::getCachedMergedAcl(GatewayMergedAcl* response)
+{
+    QStatus status = ER_OK;
+
+    pthread_mutex_lock(&m_MergedAclLock);
+    if (m_MergedAcl.m_Version == 0) {
+        bool changed;
+        status = getMergedAclIfChanged(&m_MergedAcl, &changed);
+    }
+    if (ER_OK == status) {
+        *response = m_MergedAcl;
+    }
+    pthread_mutex_unlock(&m_MergedAclLock);
+
+    return status;
+}
+
 QStatus GatewayConnector::updateConnectionStatus(ConnectionStatus connStatus)
 {
     MsgArg input[1];
@@ -137,7 +179,25 @@ QStatus GatewayConnector::updateConnectionStatus(ConnectionStatus connStatus)
 
 void GatewayConnector::mergedAclUpdatedSignalHandler(const InterfaceDescription::Member* member, const char* sourcePath, Message& msg)
 {
-    mergedAclUpdated();
+    bool changed = false;
+    bool gap = false;
+
+    pthread_mutex_lock(&m_MergedAclLock);
+    QStatus status = m_MergedAcl.unmarshalUpdate(msg, &changed, &gap);
+    if (ER_OK == status && gap) {
+        // signals were missed - fetch the whole merged Acl. The call blocks, which needs concurrent callbacks
+        m_Bus->EnableConcurrentCallbacks();
+        status = getMergedAclIfChanged(&m_MergedAcl, &changed);
+    }
+    if (ER_OK != status) {
+        // the cached merged Acl is incomplete, make sure the next update fetches it again
+        m_MergedAcl.m_Version = 0;
+    }
+    pthread_mutex_unlock(&m_MergedAclLock);
+
+    if (changed || ER_OK != status) {
+        mergedAclUpdated();
+    }
 }
 
 void GatewayConnector::shutdownSignalHandler(const InterfaceDescription::Member* member, const char* sourcePath, Message& msg)
@@ -16,27 +16,190 @@
 
 #include "alljoyn/gateway/GatewayMergedAcl.h"
 
+#include <algorithm>
+
 using namespace ajn;
 using namespace gw;
 using namespace std;
 
+static list<GatewayMergedAcl::ObjectDescription>::iterator findObjectDescription(list<GatewayMergedAcl::ObjectDescription>& objects,
+                                                                                  const GatewayMergedAcl::ObjectDescription& objDesc)
+{
+    list<GatewayMergedAcl::ObjectDescription>::iterator iter;
+    for (iter = objects.begin(); iter != objects.end(); iter++) {
+        if (iter->objectPath == objDesc.objectPath && iter->isPrefix == objDesc.isPrefix) {
+            break;
+        }
+    }
+    return iter;
+}
+
 QStatus GatewayMergedAcl::unmarshal(Message& msg)
+{
+    const ajn::MsgArg* returnArgs = NULL;
+    size_t numArgs = 0;
+
+    msg->GetArgs(numArgs, returnArgs);
+
+    return unmarshal(returnArgs, numArgs);
+}
+
+QStatus GatewayMergedAcl::unmarshal(const MsgArg* args, size_t numArgs)
+{
+    if (numArgs < 2) {
+        return ER_BUS_UNEXPECTED_SIGNATURE;
+    }
+
+    return unmarshalMergedAcl(&args[0], &args[1]);
+}
+
+QStatus GatewayMergedAcl::unmarshalIfChanged(Message& msg, bool* changed)
 {
     QStatus status = ER_OK;
 
-    //exposed services
-    MsgArg* exposedServiceArgs;
-    size_t numExposedServiceArgs;
     const ajn::MsgArg* returnArgs = NULL;
     size_t numArgs = 0;
 
     msg->GetArgs(numArgs, returnArgs);
 
-    if (numArgs == 0) {
+    if (numArgs < 4) {
+        return ER_BUS_UNEXPECTED_SIGNATURE;
+    }
+
+    uint32_t version;
+    status = returnArgs[0].Get("u", &version);
+    if (ER_OK != status) {
+        return status;
+    }
+    status = returnArgs[1].Get("b", changed);
+    if (ER_OK != status) {
+        return status;
+    }
+
+    if (!*changed) {
+        return status;
+    }
+
+    m_ExposedServices.clear();
+    m_RemotedApps.clear();
+    status = unmarshalMergedAcl(&returnArgs[2], &returnArgs[3]);
+    if (ER_OK != status) {
+        // the data is incomplete, make sure the next call fetches it again
+        m_Version = 0;
+        return status;
+    }
+    m_Version = version;
+
+    return status;
+}
+
+QStatus GatewayMergedAcl::unmarshalUpdate(Message& msg, bool* changed, bool* gap)
+{
+    QStatus status = ER_OK;
+    *changed = false;
+    *gap = false;
+
+    const ajn::MsgArg* returnArgs = NULL;
+    size_t numArgs = 0;
+
+    msg->GetArgs(numArgs, returnArgs);
+
+    if (numArgs < 5) {
         return ER_BUS_UNEXPECTED_SIGNATURE;
     }
 
-    status = msg->GetArg(0)->Get("a(obas)", &numExposedServiceArgs, &exposedServiceArgs);
+    uint32_t version;
+    status = returnArgs[0].Get("u", &version);
+    if (ER_OK != status) {
+        return status;
+    }
+
+    // the same version is a repeated signal, anything but the next one means signals were missed
+    if (m_Version != 0 && version == m_Version) {
+        return status;
+    }
+    if (m_Version == 0 || version != m_Version + 1) {
+        *gap = true;
+        return status;
+    }
+
+    list<ObjectDescription> addedExposedServices;
+    list<ObjectDescription> removedExposedServices;
+    list<RemotedApp> addedRemotedApps;
+    list<RemotedApp> removedRemotedApps;
+
+    MsgArg* objDescArgs;
+    size_t numObjDescArgs;
+    status = returnArgs[1].Get("a(obas)", &numObjDescArgs, &objDescArgs);
+    if (ER_OK != status) {
+        return status;
+    }
+    status = unmarshalObjectDescriptions(objDescArgs, numObjDescArgs, addedExposedServices);
+    if (ER_OK != status) {
+        return status;
+    }
+
+    status = returnArgs[2].Get("a(obas)", &numObjDescArgs, &objDescArgs);
+    if (ER_OK != status) {
+        return status;
+    }
+    status = unmarshalObjectDescriptions(objDescArgs, numObjDescArgs, removedExposedServices);
+    if (ER_OK != status) {
+        return status;
+    }
+
+    status = unmarshalRemotedApps(&returnArgs[3], addedRemotedApps);
+    if (ER_OK != status) {
+        return status;
+    }
+
+    status = unmarshalRemotedApps(&returnArgs[4], removedRemotedApps);
+    if (ER_OK != status) {
+        return status;
+    }
+
+    // removals are applied before additions
+    removeObjectDescriptions(m_ExposedServices, removedExposedServices);
+    addObjectDescriptions(m_ExposedServices, addedExposedServices);
+
+    list<RemotedApp>::const_iterator appIter;
+    for (appIter = removedRemotedApps.begin(); appIter != removedRemotedApps.end(); appIter++) {
+        list<RemotedApp>::iterator remotedApp = findRemotedApp(*appIter);
+        if (remotedApp == m_RemotedApps.end()) {
+            continue;
+        }
+
+        if (!appIter->objectDescs.empty()) {
+            removeObjectDescriptions(remotedApp->objectDescs, appIter->objectDescs);
+        }
+        if (appIter->objectDescs.empty() || remotedApp->objectDescs.empty()) {
+            m_RemotedApps.erase(remotedApp);
+        }
+    }
+
+    for (appIter = addedRemotedApps.begin(); appIter != addedRemotedApps.end(); appIter++) {
+        list<RemotedApp>::iterator remotedApp = findRemotedApp(*appIter);
+        if (remotedApp == m_RemotedApps.end()) {
+            m_RemotedApps.push_back(*appIter);
+        } else {
+            addObjectDescriptions(remotedApp->objectDescs, appIter->objectDescs);
+        }
+    }
+
+    m_Version = version;
+    *changed = true;
+
+    return status;
+}
+
+QStatus GatewayMergedAcl::unmarshalMergedAcl(const MsgArg* exposedServicesArg, const MsgArg* remotedAppsArg)
+{
+    QStatus status = ER_OK;
+
+    //exposed services
+    MsgArg* exposedServiceArgs;
+    size_t numExposedServiceArgs;
+    status = exposedServicesArg->Get("a(obas)", &numExposedServiceArgs, &exposedServiceArgs);
     if (ER_OK != status) {
         return status;
     }
@@ -46,9 +209,16 @@ QStatus GatewayMergedAcl::unmarshal(Message& msg)
     }
 
     //remoted apps
+    return unmarshalRemotedApps(remotedAppsArg, m_RemotedApps);
+}
+
+QStatus GatewayMergedAcl::unmarshalRemotedApps(const MsgArg* remotedAppsArg, std::list<RemotedApp>& dest)
+{
+    QStatus status = ER_OK;
+
     MsgArg* remotedAppArgs;
     size_t numRemotedAppArgs;
-    status = msg->GetArg(1)->Get("a(saya(obas))", &numRemotedAppArgs, &remotedAppArgs);
+    status = remotedAppsArg->Get("a(saya(obas))", &numRemotedAppArgs, &remotedAppArgs);
     if (ER_OK != status) {
         return status;
     }
@@ -72,17 +242,86 @@ QStatus GatewayMergedAcl::unmarshal(Message& msg)
 
         RemotedApp remotedApp;
         remotedApp.deviceId.assign(deviceIdArg);
+        memset(remotedApp.appId, 0, UUID_LENGTH);
         memcpy(remotedApp.appId, appIdArg, appIdLen);
         status = unmarshalObjectDescriptions(objDescArgs, numObjDescArgs, remotedApp.objectDescs);
         if (status != ER_OK) {
             return status;
         }
-        m_RemotedApps.push_back(remotedApp);
+        dest.push_back(remotedApp);
     }
 
     return status;
 }
 
+void GatewayMergedAcl::addObjectDescriptions(std::list<ObjectDescription>& objects, const std::list<ObjectDescription>& added)
+{
+    list<ObjectDescription>::const_iterator addedIter;
+    for (addedIter = added.begin(); addedIter != added.end(); addedIter++) {
+        list<ObjectDescription>::iterator iter = findObjectDescription(objects, *addedIter);
+        if (iter == objects.end()) {
+            objects.push_back(*addedIter);
+            continue;
+        }
+
+        // no interfaces means all interfaces
+        if (iter->interfaces.empty()) {
+            continue;
+        }
+        if (addedIter->interfaces.empty()) {
+            iter->interfaces.clear();
+            continue;
+        }
+
+        list<qcc::String>::const_iterator ifcIter;
+        for (ifcIter = addedIter->interfaces.begin(); ifcIter != addedIter->interfaces.end(); ifcIter++) {
+            if (find(iter->interfaces.begin(), iter->interfaces.end(), *ifcIter) == iter->interfaces.end()) {
+                iter->interfaces.push_back(*ifcIter);
+            }
+        }
+    }
+}
+
+void GatewayMergedAcl::removeObjectDescriptions(std::list<ObjectDescription>& objects, const std::list<ObjectDescription>& removed)
+{
+    list<ObjectDescription>::const_iterator removedIter;
+    for (removedIter = removed.begin(); removedIter != removed.end(); removedIter++) {
+        list<ObjectDescription>::iterator iter = findObjectDescription(objects, *removedIter);
+        if (iter == objects.end()) {
+            continue;
+        }
+
+        if (removedIter->interfaces.empty()) {
+            objects.erase(iter);
+            continue;
+        }
+
+        // single interfaces can not be removed from an object that allows all of them
+        if (iter->interfaces.empty()) {
+            continue;
+        }
+
+        list<qcc::String>::const_iterator ifcIter;
+        for (ifcIter = removedIter->interfaces.begin(); ifcIter != removedIter->interfaces.end(); ifcIter++) {
+            iter->interfaces.remove(*ifcIter);
+        }
+        if (iter->interfaces.empty()) {
+            objects.erase(iter);
+        }
+    }
+}
+
+std::list<GatewayMergedAcl::RemotedApp>::iterator GatewayMergedAcl::findRemotedApp(const RemotedApp& remotedApp)
+{
+    list<RemotedApp>::iterator iter;
+    for (iter = m_RemotedApps.begin(); iter != m_RemotedApps.end(); iter++) {
+        if (iter->deviceId == remotedApp.deviceId && memcmp(iter->appId, remotedApp.appId, UUID_LENGTH) == 0) {
+            break;
+        }
+    }
+    return iter;
+}
+
 QStatus GatewayMergedAcl::unmarshalObjectDescriptions(MsgArg* objDescArgs, size_t numObjDescs, std::list<ObjectDescription>& dest)
 {
     QStatus status = ER_OK;
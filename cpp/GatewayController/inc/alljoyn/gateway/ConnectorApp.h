@@ -210,6 +210,14 @@ class ConnectorApp : public MessageReceiver {
      */
     QStatus retrieveAcls(SessionId sessionId, std::vector <Acl*>& acls);
 
+    /**
+     * Retrieves only the ids and statuses of the Access Control Lists installed on the application
+     * @param sessionId The id of the session established with the gateway
+     * @param aclStatuses map of ACL id to {@link AclStatus}
+     * @return {@QStatus}
+     */
+    QStatus retrieveAclStatuses(SessionId sessionId, std::map<qcc::String, AclStatus>& aclStatuses);
+
     /**
      * Delete the Access Control List of this application
      * @param sessionId The id of the session established with the gateway
@@ -315,6 +323,15 @@ class ConnectorApp : public MessageReceiver {
 
     void emptyVector();
 
+    /**
+     * Creates an {@link Acl} for every entry of a list of ACLs received from the gateway
+     * @param aclInfoArray The received entries
+     * @param numAcls The number of entries
+     * @param acls vector of the {@link Acl} to add to
+     * @return {@QStatus}
+     */
+    QStatus addAcls(const MsgArg* aclInfoArray, size_t numAcls, std::vector <Acl*>& acls);
+
 };
 }
 }
@@ -78,6 +78,14 @@ typedef enum AclStatus {
     GW_AS_INACTIVE = 0,                     //!< Inactive
     GW_AS_ACTIVE = 1                        //!< Active
 } AclStatus;
+
+/**
+ * The fields the gateway returns for every entry of a paged list
+ */
+typedef enum {
+    GW_LP_FULL = 0,                         //!< All the fields
+    GW_LP_ID_STATUS = 1                     //!< Only the id and the status
+} ListProjection;
 }
 }
 
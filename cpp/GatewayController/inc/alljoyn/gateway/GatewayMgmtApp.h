@@ -73,6 +73,25 @@ class GatewayMgmtApp : public AnnouncedApp {
      */
     QStatus retrieveConnectorApps(SessionId sessionId, std::vector<ConnectorApp*>& connectorApps);
 
+    /**
+     * Retrieve only the ids and operational statuses of the applications installed on the gateway.
+     * The applications must have been retrieved with retrieveConnectorApps before
+     * @param sessionId The id of the session established with the gateway
+     * @param appStatuses map of application id to {@link OperationalStatus}
+     * @return {@link QStatus}
+     */
+    QStatus retrieveConnectorAppStatuses(SessionId sessionId, std::map<qcc::String, OperationalStatus>& appStatuses);
+
+    /**
+     * Limit the application status changed signals sent to the given session to the given
+     * applications. An empty vector restores receiving the status changes of all applications.
+     * The applications must have been retrieved with retrieveConnectorApps before
+     * @param sessionId The id of the session established with the gateway
+     * @param connectorIds The ids of the applications whose status changes should be received
+     * @return {@link QStatus}
+     */
+    QStatus setAppStatusSubscriptions(SessionId sessionId, std::vector<qcc::String> const& connectorIds);
+
 
     /**
      * Join session synchronously with the given gateway identified by the gwBusName.
@@ -125,6 +144,14 @@ class GatewayMgmtApp : public AnnouncedApp {
 
     void emptyVector();
 
+    /**
+     * Creates a {@link ConnectorApp} for every entry of a list of applications received from the gateway
+     * @param appInfoArray The received entries
+     * @param numApplications The number of entries
+     * @return {@link QStatus}
+     */
+    QStatus addInstalledApps(const MsgArg* appInfoArray, size_t numApplications);
+
     std::vector<ConnectorApp*> m_InstalledApps;
 
     SessionHandler m_SessionHandler;
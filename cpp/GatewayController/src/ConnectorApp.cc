@@ -174,6 +174,12 @@ QStatus ConnectorApp::init(const qcc::String& gwBusName, ajn::MsgArg*appInfo)
                 return status;
             }
 
+            status = interfaceDescription->AddMethod(AJ_METHOD_LISTACLSPAGED.c_str(), "suq", "vs", "cursor,pageSize,projection,aclsList,nextCursor");
+            if (status != ER_OK) {
+                QCC_LogError(status, ("Could not AddMethod"));
+                return status;
+            }
+
             status = interfaceDescription->AddProperty(AJ_PROPERTY_VERSION.c_str(), AJPARAM_UINT16.c_str(), PROP_ACCESS_READ);
             if (status != ER_OK) {
                 QCC_LogError(status, ("Could not AddProperty"));
@@ -842,54 +848,156 @@ QStatus ConnectorApp::retrieveAcls(SessionId sessionId, std::vector <Acl*>& acls
             goto end;
         }
 
+        qcc::String cursor;
+        do {
+            MsgArg inputArgs[3];
+            status = PayloadAdapter::marshalPageRequest(cursor, 0, GW_LP_FULL, inputArgs);
+            if (status != ER_OK) {
+                goto end;
+            }
 
-        Message replyMsg(*busAttachment);
-        status = proxy.MethodCall(AJ_GATEWAYCONTROLLER_ACLMGMT_INTERFACE.c_str(), AJ_METHOD_LISTACLS.c_str(), NULL, 0, replyMsg);
-        if (status != ER_OK) {
-            QCC_LogError(status, ("Call to GetACLs failed"));
-            goto end;
-        }
+            Message replyMsg(*busAttachment);
+            status = proxy.MethodCall(AJ_GATEWAYCONTROLLER_ACLMGMT_INTERFACE.c_str(), AJ_METHOD_LISTACLSPAGED.c_str(), inputArgs, 3, replyMsg);
+            if (status == ER_BUS_REPLY_IS_ERROR_MESSAGE && cursor.empty()) {
+                // gateways that do not support paging return all the ACLs at once
+                QCC_DbgPrintf(("ListAclsPaged failed - falling back to ListAcls"));
+                status = proxy.MethodCall(AJ_GATEWAYCONTROLLER_ACLMGMT_INTERFACE.c_str(), AJ_METHOD_LISTACLS.c_str(), NULL, 0, replyMsg);
+                if (status != ER_OK) {
+                    QCC_LogError(status, ("Call to GetACLs failed"));
+                    goto end;
+                }
 
-        const ajn::MsgArg* returnArgs;
-        size_t numArgs = 0;
-        replyMsg->GetArgs(numArgs, returnArgs);
-        if (numArgs != 1) {
-            QCC_DbgHLPrintf(("Received unexpected amount of returnArgs"));
-            status = ER_BUS_UNEXPECTED_SIGNATURE;
+                const ajn::MsgArg* returnArgs;
+                size_t numArgs = 0;
+                replyMsg->GetArgs(numArgs, returnArgs);
+                if (numArgs != 1) {
+                    QCC_DbgHLPrintf(("Received unexpected amount of returnArgs"));
+                    status = ER_BUS_UNEXPECTED_SIGNATURE;
+                    goto end;
+                }
+
+                size_t numACLs;
+                MsgArg* tempEntries;
+                status = returnArgs[0].Get("a(ssqo)", &numACLs, &tempEntries);
+                if (status != ER_OK) {
+                    QCC_LogError(status, ("Call to Get failed"));
+                    goto end;
+                }
+
+                status = addAcls(tempEntries, numACLs, acls);
+                goto end;
+            }
+            if (status != ER_OK) {
+                QCC_LogError(status, ("Call to ListAclsPaged failed"));
+                goto end;
+            }
+
+            size_t numACLs;
+            MsgArg* tempEntries;
+            status = PayloadAdapter::unmarshalPage(replyMsg, "a(ssqo)", &numACLs, &tempEntries, &cursor);
+            if (status != ER_OK) {
+                goto end;
+            }
+
+            status = addAcls(tempEntries, numACLs, acls);
+            if (status != ER_OK) {
+                goto end;
+            }
+        } while (!cursor.empty());
+    }
+end:
+
+    return status;
+}
+
+QStatus ConnectorApp::retrieveAclStatuses(SessionId sessionId, std::map<qcc::String, AclStatus>& aclStatuses)
+{
+
+    QStatus status = ER_OK;
+
+    {
+        BusAttachment* busAttachment = GatewayController::getInstance()->getBusAttachment();
+
+        // create proxy bus object
+        ProxyBusObject proxy(*busAttachment, m_GwBusName.c_str(), m_ObjectPath.c_str(), sessionId, true);
+
+        qcc::String interfaceName = AJ_GATEWAYCONTROLLER_ACLMGMT_INTERFACE;
+        InterfaceDescription* interfaceDescription = (InterfaceDescription*) busAttachment->GetInterface(interfaceName.c_str());
+        if (!interfaceDescription) {
+            status = ER_FAIL;
             goto end;
         }
 
-        int numACLs;
-        MsgArg* tempEntries;
-        status = returnArgs[0].Get("a(ssqo)", &numACLs, &tempEntries);
+        status = proxy.AddInterface(*interfaceDescription);
         if (status != ER_OK) {
-            QCC_LogError(status, ("Call to Get failed"));
+            QCC_LogError(status, ("AddInterface failed"));
             goto end;
         }
 
-        for (int i = 0; i < numACLs; i++) {
-
-            Acl*accessControlList = new Acl();
-
-            status = accessControlList->init(m_GwBusName, &tempEntries[i]);
+        qcc::String cursor;
+        do {
+            MsgArg inputArgs[3];
+            status = PayloadAdapter::marshalPageRequest(cursor, 0, GW_LP_ID_STATUS, inputArgs);
             if (status != ER_OK) {
-                QCC_LogError(status, ("Acl init failed"));
+                goto end;
+            }
 
-                delete accessControlList;
-                accessControlList = NULL;
+            Message replyMsg(*busAttachment);
+            status = proxy.MethodCall(AJ_GATEWAYCONTROLLER_ACLMGMT_INTERFACE.c_str(), AJ_METHOD_LISTACLSPAGED.c_str(), inputArgs, 3, replyMsg);
+            if (status != ER_OK) {
+                QCC_LogError(status, ("Call to ListAclsPaged failed"));
+                goto end;
+            }
 
+            size_t numACLs;
+            MsgArg* tempEntries;
+            status = PayloadAdapter::unmarshalPage(replyMsg, "a(sq)", &numACLs, &tempEntries, &cursor);
+            if (status != ER_OK) {
                 goto end;
             }
 
-            m_Acls.push_back(accessControlList);
-            acls.push_back(accessControlList);
-        }
+            for (size_t i = 0; i < numACLs; i++) {
+                char* aclId;
+                uint16_t aclStatus;
+                status = tempEntries[i].Get("(sq)", &aclId, &aclStatus);
+                if (status != ER_OK) {
+                    QCC_LogError(status, ("Call to Get failed"));
+                    goto end;
+                }
+                aclStatuses[aclId] = (AclStatus) aclStatus;
+            }
+        } while (!cursor.empty());
     }
 end:
 
     return status;
 }
 
+QStatus ConnectorApp::addAcls(const MsgArg* aclInfoArray, size_t numAcls, std::vector <Acl*>& acls)
+{
+    QStatus status = ER_OK;
+
+    for (size_t i = 0; i < numAcls; i++) {
+
+        Acl*accessControlList = new Acl();
+
+        status = accessControlList->init(m_GwBusName, &aclInfoArray[i]);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Acl init failed"));
+
+            delete accessControlList;
+            accessControlList = NULL;
+
+            return status;
+        }
+
+        m_Acls.push_back(accessControlList);
+        acls.push_back(accessControlList);
+    }
+
+    return status;
+}
+
 QStatus ConnectorApp::deleteAcl(SessionId sessionId, const qcc::String& aclId, AclResponseCode& responseCode) {
 
     QStatus status = ER_OK;
@@ -42,6 +42,8 @@ static const qcc::String AJ_PROPERTY_VERSION = "Version";
 static const qcc::String AJ_SIGNAL_APPSTATUSCHANGED = "AppStatusChanged";
 
 static const qcc::String AJ_METHOD_GETINSTALLEDAPPS = "GetInstalledApps";
+static const qcc::String AJ_METHOD_GETINSTALLEDAPPSPAGED = "GetInstalledAppsPaged";
+static const qcc::String AJ_METHOD_SETAPPSTATUSSUBSCRIPTIONS = "SetAppStatusSubscriptions";
 static const qcc::String AJ_METHOD_GETMANIFESTFILE = "GetManifestFile";
 static const qcc::String AJ_METHOD_GETMANIFESTINTERFACES = "GetManifestInterfaces";
 static const qcc::String AJ_METHOD_GETAPPSTATUS = "GetAppStatus";
@@ -51,6 +53,7 @@ static const qcc::String AJ_GATEWAYCONTROLLER_ACLMGMT_INTERFACE = "org.alljoyn.g
 static const qcc::String AJ_METHOD_CREATEACL = "CreateAcl";
 static const qcc::String AJ_METHOD_DELETEACL = "DeleteAcl";
 static const qcc::String AJ_METHOD_LISTACLS = "ListAcls";
+static const qcc::String AJ_METHOD_LISTACLSPAGED = "ListAclsPaged";
 
 static const qcc::String AJ_GATEWAYCONTROLLERACL_INTERFACE = "org.alljoyn.gwagent.ctrl.Acl";
 static const qcc::String AJ_METHOD_ACTIVATEACL = "ActivateAcl";
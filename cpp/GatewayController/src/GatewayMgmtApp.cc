@@ -19,6 +19,7 @@
 #include <alljoyn/gateway/LogModule.h>
 #include <alljoyn/Status.h>
 #include "Constants.h"
+#include "PayloadAdapter.h"
 #include <qcc/Log.h>
 
 using namespace ajn::gwc::gwcConsts;
@@ -83,6 +84,19 @@ QStatus GatewayMgmtApp::retrieveConnectorApps(SessionId sessionId, std::vector<C
                 goto end;
             }
 
+            status = interfaceDescription->AddMethod(AJ_METHOD_GETINSTALLEDAPPSPAGED.c_str(), "suq", "vs",
+                                                     "cursor,pageSize,projection,connectorAppsInfoArray,nextCursor");
+            if (status != ER_OK) {
+                QCC_LogError(status, ("Could not AddMethod"));
+                goto end;
+            }
+
+            status = interfaceDescription->AddMethod(AJ_METHOD_SETAPPSTATUSSUBSCRIPTIONS.c_str(), "as", NULL, "connectorIds");
+            if (status != ER_OK) {
+                QCC_LogError(status, ("Could not AddMethod"));
+                goto end;
+            }
+
             status = interfaceDescription->AddProperty(AJ_PROPERTY_VERSION.c_str(), AJPARAM_UINT16.c_str(), PROP_ACCESS_READ);
             if (status != ER_OK) {
                 QCC_LogError(status, ("Could not AddProperty"));
@@ -104,51 +118,200 @@ QStatus GatewayMgmtApp::retrieveConnectorApps(SessionId sessionId, std::vector<C
             goto end;
         }
 
-        Message replyMsg(*busAttachment);
-        status = proxy.MethodCall(interfaceName.c_str(), AJ_METHOD_GETINSTALLEDAPPS.c_str(), NULL, 0, replyMsg);
-        if (status != ER_OK) {
-            QCC_LogError(status, ("Call to getInstalledApps failed"));
-            goto end;
-        }
+        qcc::String cursor;
+        do {
+            MsgArg inputArgs[3];
+            status = PayloadAdapter::marshalPageRequest(cursor, 0, GW_LP_FULL, inputArgs);
+            if (status != ER_OK) {
+                goto end;
+            }
+
+            Message replyMsg(*busAttachment);
+            status = proxy.MethodCall(interfaceName.c_str(), AJ_METHOD_GETINSTALLEDAPPSPAGED.c_str(), inputArgs, 3, replyMsg);
+            if (status == ER_BUS_REPLY_IS_ERROR_MESSAGE && cursor.empty()) {
+                // gateways that do not support paging return all the applications at once
+                QCC_DbgPrintf(("GetInstalledAppsPaged failed - falling back to GetInstalledApps"));
+                status = proxy.MethodCall(interfaceName.c_str(), AJ_METHOD_GETINSTALLEDAPPS.c_str(), NULL, 0, replyMsg);
+                if (status != ER_OK) {
+                    QCC_LogError(status, ("Call to getInstalledApps failed"));
+                    goto end;
+                }
+
+                const ajn::MsgArg* returnArgs = NULL;
+                size_t numArgs = 0;
+                replyMsg->GetArgs(numArgs, returnArgs);
+                if (numArgs != 1) {
+                    QCC_DbgHLPrintf(("Received unexpected amount of returnArgs"));
+                    status = ER_BUS_UNEXPECTED_SIGNATURE;
+                    goto end;
+                }
+
+                size_t numApplications;
+                MsgArg* tempEntries;
+                status = returnArgs[0].Get("a(ssos)", &numApplications, &tempEntries);
+                if (status != ER_OK) {
+                    QCC_LogError(status, ("Call to Get failed"));
+                    goto end;
+                }
+
+                status = addInstalledApps(tempEntries, numApplications);
+                goto end;
+            }
+            if (status != ER_OK) {
+                QCC_LogError(status, ("Call to getInstalledAppsPaged failed"));
+                goto end;
+            }
+
+            size_t numApplications;
+            MsgArg* tempEntries;
+            status = PayloadAdapter::unmarshalPage(replyMsg, "a(ssos)", &numApplications, &tempEntries, &cursor);
+            if (status != ER_OK) {
+                goto end;
+            }
+
+            status = addInstalledApps(tempEntries, numApplications);
+            if (status != ER_OK) {
+                goto end;
+            }
+        } while (!cursor.empty());
+    }
+end:
+
+    connectorApps = m_InstalledApps;
+    return status;
+}
+
+QStatus GatewayMgmtApp::retrieveConnectorAppStatuses(SessionId sessionId, std::map<qcc::String, OperationalStatus>& appStatuses)
+{
+    QStatus status;
+    {
+        BusAttachment* busAttachment = GatewayController::getInstance()->getBusAttachment();
 
-        const ajn::MsgArg* returnArgs = NULL;
-        size_t numArgs = 0;
-        replyMsg->GetArgs(numArgs, returnArgs);
-        if (numArgs != 1) {
-            QCC_DbgHLPrintf(("Received unexpected amount of returnArgs"));
-            status = ER_BUS_UNEXPECTED_SIGNATURE;
+        // create proxy bus object
+        ProxyBusObject proxy(*busAttachment, getBusName().c_str(), AJ_OBJECTPATH_PREFIX.c_str(), sessionId, true);
+
+        qcc::String interfaceName = AJ_GATEWAYCONTROLLER_APPMGMT_INTERFACE;
+        InterfaceDescription* interfaceDescription = (InterfaceDescription*) busAttachment->GetInterface(interfaceName.c_str());
+        if (!interfaceDescription) {
+            QCC_DbgHLPrintf(("Interface description missing - retrieveConnectorApps has to be called first"));
+            status = ER_FAIL;
             goto end;
         }
 
-        int numApplications;
-        MsgArg* tempEntries;
-        status = returnArgs[0].Get("a(ssos)", &numApplications, &tempEntries);
+        status = proxy.AddInterface(*interfaceDescription);
         if (status != ER_OK) {
-            QCC_LogError(status, ("Call to Get failed"));
+            QCC_LogError(status, ("AddInterface failed"));
             goto end;
         }
 
-        for (int i = 0; i < numApplications; i++) {
-
-            ConnectorApp*connectorApp = new ConnectorApp();
-            status = connectorApp->init(getBusName(), &tempEntries[i]);
-
+        qcc::String cursor;
+        do {
+            MsgArg inputArgs[3];
+            status = PayloadAdapter::marshalPageRequest(cursor, 0, GW_LP_ID_STATUS, inputArgs);
             if (status != ER_OK) {
-                QCC_LogError(status, ("Call to connectorApp->init failed"));
+                goto end;
+            }
 
-                delete connectorApp;
-                connectorApp = NULL;
+            Message replyMsg(*busAttachment);
+            status = proxy.MethodCall(interfaceName.c_str(), AJ_METHOD_GETINSTALLEDAPPSPAGED.c_str(), inputArgs, 3, replyMsg);
+            if (status != ER_OK) {
+                QCC_LogError(status, ("Call to getInstalledAppsPaged failed"));
+                goto end;
+            }
 
+            size_t numApplications;
+            MsgArg* tempEntries;
+            status = PayloadAdapter::unmarshalPage(replyMsg, "a(sq)", &numApplications, &tempEntries, &cursor);
+            if (status != ER_OK) {
                 goto end;
             }
 
-            m_InstalledApps.push_back(connectorApp);
+            for (size_t i = 0; i < numApplications; i++) {
+                char* connectorId;
+                uint16_t operationalStatus;
+                status = tempEntries[i].Get("(sq)", &connectorId, &operationalStatus);
+                if (status != ER_OK) {
+                    QCC_LogError(status, ("Call to Get failed"));
+                    goto end;
+                }
+                appStatuses[connectorId] = (OperationalStatus) operationalStatus;
+            }
+        } while (!cursor.empty());
+    }
+end:
+
+    return status;
+}
+
+QStatus GatewayMgmtApp::addInstalledApps(const MsgArg* appInfoArray, size_t numApplications)
+{
+    QStatus status = ER_OK;
+
+    for (size_t i = 0; i < numApplications; i++) {
+
+        ConnectorApp*connectorApp = new ConnectorApp();
+        status = connectorApp->init(getBusName(), (MsgArg*) &appInfoArray[i]);
+
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Call to connectorApp->init failed"));
+
+            delete connectorApp;
+            connectorApp = NULL;
 
+            return status;
+        }
+
+        m_InstalledApps.push_back(connectorApp);
+
+    }
+
+    return status;
+}
+
+QStatus GatewayMgmtApp::setAppStatusSubscriptions(SessionId sessionId, std::vector<qcc::String> const& connectorIds)
+{
+    QStatus status;
+    {
+        BusAttachment* busAttachment = GatewayController::getInstance()->getBusAttachment();
+
+        // create proxy bus object
+        ProxyBusObject proxy(*busAttachment, getBusName().c_str(), AJ_OBJECTPATH_PREFIX.c_str(), sessionId, true);
+
+        qcc::String interfaceName = AJ_GATEWAYCONTROLLER_APPMGMT_INTERFACE;
+        InterfaceDescription* interfaceDescription = (InterfaceDescription*) busAttachment->GetInterface(interfaceName.c_str());
+        if (!interfaceDescription) {
+            QCC_DbgHLPrintf(("Interface description missing - retrieveConnectorApps has to be called first"));
+            status = ER_FAIL;
+            goto end;
+        }
+
+        status = proxy.AddInterface(*interfaceDescription);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("AddInterface failed"));
+            goto end;
+        }
+
+        std::vector<const char*> connectorIdStrings(connectorIds.size());
+        for (size_t i = 0; i < connectorIds.size(); i++) {
+            connectorIdStrings[i] = connectorIds[i].c_str();
+        }
+
+        MsgArg inputArg;
+        status = inputArg.Set("as", connectorIdStrings.size(), connectorIdStrings.empty() ? NULL : &connectorIdStrings[0]);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Could not marshal connectorIds"));
+            goto end;
+        }
+
+        Message replyMsg(*busAttachment);
+        status = proxy.MethodCall(interfaceName.c_str(), AJ_METHOD_SETAPPSTATUSSUBSCRIPTIONS.c_str(), &inputArg, 1, replyMsg);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Call to SetAppStatusSubscriptions failed"));
+            goto end;
         }
     }
 end:
 
-    connectorApps = m_InstalledApps;
     return status;
 }
 
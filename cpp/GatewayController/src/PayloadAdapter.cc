@@ -132,6 +132,61 @@ RuleObjectDescription*PayloadAdapter::unmarshalObjectDescriptionsWithFriendlyNam
     return manifestObjectDescriptionOut;
 }
 
+QStatus PayloadAdapter::marshalPageRequest(const qcc::String& cursor, uint32_t pageSize, ListProjection projection, MsgArg* inputArgs)
+{
+    QStatus status = inputArgs[0].Set("s", cursor.c_str());
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Set failed"));
+        return status;
+    }
+
+    status = inputArgs[1].Set("u", pageSize);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Set failed"));
+        return status;
+    }
+
+    status = inputArgs[2].Set("q", (uint16_t) projection);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Set failed"));
+    }
+    return status;
+}
+
+QStatus PayloadAdapter::unmarshalPage(Message& replyMsg, const char* entrySignature, size_t* numEntries, MsgArg** entries, qcc::String* nextCursor)
+{
+    const ajn::MsgArg* returnArgs = NULL;
+    size_t numArgs = 0;
+    replyMsg->GetArgs(numArgs, returnArgs);
+    if (numArgs != 2) {
+        QCC_DbgHLPrintf(("Received unexpected amount of returnArgs"));
+        return ER_BUS_UNEXPECTED_SIGNATURE;
+    }
+
+    MsgArg* pageArg;
+    QStatus status = returnArgs[0].Get("v", &pageArg);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Failed Get"));
+        return status;
+    }
+
+    status = pageArg->Get(entrySignature, numEntries, entries);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Failed Get"));
+        return status;
+    }
+
+    char* cursor;
+    status = returnArgs[1].Get("s", &cursor);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Failed Get"));
+        return status;
+    }
+    nextCursor->assign(cursor);
+
+    return ER_OK;
+}
+
 QStatus PayloadAdapter::unmarshalMetadata(const MsgArg* metadataArg, std::map<qcc::String, qcc::String>* metadata)
 {
 
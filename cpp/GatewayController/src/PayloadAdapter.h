@@ -104,6 +104,27 @@ class PayloadAdapter {
      */
     static QStatus MarshalAclRules(const AclRules& aclRules, std::vector<MsgArg*>& aclRulesVector);
 
+    /**
+     * Marshal the arguments of a paged list method
+     * @param cursor - the cursor returned with the previous page, empty for the first page
+     * @param pageSize - the maximum number of entries, 0 for the gateway default
+     * @param projection - the fields to return for every entry
+     * @param inputArgs - array of 3 args to marshal into
+     * @return status - success/failure
+     */
+    static QStatus marshalPageRequest(const qcc::String& cursor, uint32_t pageSize, ListProjection projection, MsgArg* inputArgs);
+
+    /**
+     * Unmarshal the reply of a paged list method
+     * @param replyMsg - the reply to unmarshal. Must outlive the entries
+     * @param entrySignature - the signature of the array of entries
+     * @param numEntries - the number of entries in the page
+     * @param entries - the entries of the page
+     * @param nextCursor - the cursor of the next page, empty if this was the last page
+     * @return status - success/failure
+     */
+    static QStatus unmarshalPage(Message& replyMsg, const char* entrySignature, size_t* numEntries, MsgArg** entries, qcc::String* nextCursor);
+
 
 
 
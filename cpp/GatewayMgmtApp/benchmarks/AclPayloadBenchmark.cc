@@ -0,0 +1,415 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/Init.h>
+#include <alljoyn/gateway/GatewayAcl.h>
+#include <alljoyn/gateway/GatewayAclSnapshot.h>
+#include <alljoyn/gateway/GatewayConnectorApp.h>
+#include <alljoyn/gateway/GatewayMetadataManager.h>
+#include <alljoyn/gateway/GatewayMsgArgArena.h>
+// the connector header comes before the controller ones, which define UUID_LENGTH as a macro
+#include <alljoyn/gateway/GatewayMergedAcl.h>
+#include <alljoyn/gateway/AclRules.h>
+#include <alljoyn/gateway/ConnectorCapabilities.h>
+#include <qcc/StringUtil.h>
+#include "busObjects/AclAdapter.h"
+#include "PayloadAdapter.h"
+#include "GatewayConstants.h"
+#include "BenchmarkUtil.h"
+#include <iostream>
+#include <iomanip>
+#include <time.h>
+
+using namespace ajn;
+using namespace gw;
+using namespace benchUtil;
+using namespace gwConsts;
+
+/**
+ * Get the monotonic time in nanoseconds
+ * @return time
+ */
+static uint64_t GetMonotonicNs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+/**
+ * Get the D-Bus alignment of a type
+ * @param typeCode - first character of the signature of the type
+ * @return alignment in bytes
+ */
+static size_t getAlignment(char typeCode)
+{
+    switch (typeCode) {
+    case 'y':
+    case 'g':
+    case 'v':
+        return 1;
+
+    case 'n':
+    case 'q':
+        return 2;
+
+    case 'x':
+    case 't':
+    case 'd':
+    case '(':
+    case '{':
+        return 8;
+
+    default:
+        return 4;
+    }
+}
+
+/**
+ * Pad an offset to an alignment
+ * @param offset - the offset
+ * @param alignment - the alignment
+ * @return padded offset
+ */
+static size_t alignTo(size_t offset, size_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * Add the D-Bus wire size of an arg to an offset into the message body
+ * @param arg - the arg
+ * @param offset - offset of the arg in the body
+ * @return offset after the arg
+ */
+static size_t addWireSize(const MsgArg& arg, size_t offset)
+{
+    switch (arg.typeId) {
+    case ALLJOYN_BYTE:
+        return offset + 1;
+
+    case ALLJOYN_INT16:
+    case ALLJOYN_UINT16:
+        return alignTo(offset, 2) + 2;
+
+    case ALLJOYN_BOOLEAN:
+    case ALLJOYN_INT32:
+    case ALLJOYN_UINT32:
+    case ALLJOYN_HANDLE:
+        return alignTo(offset, 4) + 4;
+
+    case ALLJOYN_INT64:
+    case ALLJOYN_UINT64:
+    case ALLJOYN_DOUBLE:
+        return alignTo(offset, 8) + 8;
+
+    case ALLJOYN_STRING:
+        return alignTo(offset, 4) + 4 + arg.v_string.len + 1;
+
+    case ALLJOYN_OBJECT_PATH:
+        return alignTo(offset, 4) + 4 + arg.v_objPath.len + 1;
+
+    case ALLJOYN_SIGNATURE:
+        return offset + 1 + arg.v_signature.len + 1;
+
+    case ALLJOYN_VARIANT: {
+            qcc::String signature = arg.v_variant.val->Signature();
+            return addWireSize(*arg.v_variant.val, offset + 1 + signature.size() + 1);
+        }
+
+    case ALLJOYN_STRUCT:
+        offset = alignTo(offset, 8);
+        for (size_t i = 0; i < arg.v_struct.numMembers; i++) {
+            offset = addWireSize(arg.v_struct.members[i], offset);
+        }
+        return offset;
+
+    case ALLJOYN_DICT_ENTRY:
+        offset = alignTo(offset, 8);
+        offset = addWireSize(*arg.v_dictEntry.key, offset);
+        return addWireSize(*arg.v_dictEntry.val, offset);
+
+    case ALLJOYN_ARRAY: {
+            offset = alignTo(offset, 4) + 4;
+            offset = alignTo(offset, getAlignment(arg.v_array.GetElemSig()[0]));
+            const MsgArg* elements = arg.v_array.GetElements();
+            for (size_t i = 0; i < arg.v_array.GetNumElements(); i++) {
+                offset = addWireSize(elements[i], offset);
+            }
+            return offset;
+        }
+
+    case ALLJOYN_BYTE_ARRAY:
+        return alignTo(offset, 4) + 4 + arg.v_scalarArray.numElements;
+
+    case ALLJOYN_INT16_ARRAY:
+    case ALLJOYN_UINT16_ARRAY:
+        return alignTo(offset, 4) + 4 + arg.v_scalarArray.numElements * 2;
+
+    case ALLJOYN_BOOLEAN_ARRAY:
+    case ALLJOYN_INT32_ARRAY:
+    case ALLJOYN_UINT32_ARRAY:
+        return alignTo(offset, 4) + 4 + arg.v_scalarArray.numElements * 4;
+
+    case ALLJOYN_INT64_ARRAY:
+    case ALLJOYN_UINT64_ARRAY:
+    case ALLJOYN_DOUBLE_ARRAY:
+        return alignTo(alignTo(offset, 4) + 4, 8) + arg.v_scalarArray.numElements * 8;
+
+    default:
+        return offset;
+    }
+}
+
+/**
+ * Get the D-Bus wire size of the body of a message with the given args
+ * @param args - the args
+ * @param numArgs - the number of args
+ * @return size in bytes
+ */
+static size_t getPayloadBytes(const MsgArg* args, size_t numArgs)
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < numArgs; i++) {
+        offset = addWireSize(args[i], offset);
+    }
+    return offset;
+}
+
+/**
+ * Result of a benchmark case
+ */
+struct CaseResult {
+    const char* m_Name;
+    uint64_t m_Nanoseconds;
+    size_t m_Allocations;
+    size_t m_PayloadBytes;
+};
+
+/**
+ * Print a row of the result table
+ * @param result - result of the case
+ * @param iterations - number of iterations of the case
+ */
+static void printResult(CaseResult const& result, uint32_t iterations)
+{
+    std::cout << std::left << std::setw(40) << result.m_Name << std::right
+              << std::setw(12) << result.m_Nanoseconds / iterations
+              << std::setw(14) << result.m_Allocations / iterations
+              << std::setw(16) << result.m_PayloadBytes << std::endl;
+}
+
+static void usage(const char* name)
+{
+    std::cout << "Usage: " << name << " [--acls=N] [--objects=N] [--interfaces=N] [--remote-apps=N] [--metadata=N] [--iterations=N]"
+              << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t numAcls = 10;
+    uint32_t numObjects = 20;
+    uint32_t numInterfaces = 5;
+    uint32_t numRemoteApps = 10;
+    uint32_t numMetadata = 4;
+    uint32_t iterations = 1000;
+
+    for (int i = 1; i < argc; i++) {
+        qcc::String arg(argv[i]);
+        size_t eq = arg.find('=');
+        qcc::String value = eq == qcc::String::npos ? "" : arg.substr(eq + 1);
+        if (arg.compare(0, 7, "--acls=") == 0) {
+            numAcls = qcc::StringToU32(value, 10, numAcls);
+        } else if (arg.compare(0, 10, "--objects=") == 0) {
+            numObjects = qcc::StringToU32(value, 10, numObjects);
+        } else if (arg.compare(0, 13, "--interfaces=") == 0) {
+            numInterfaces = qcc::StringToU32(value, 10, numInterfaces);
+        } else if (arg.compare(0, 14, "--remote-apps=") == 0) {
+            numRemoteApps = qcc::StringToU32(value, 10, numRemoteApps);
+        } else if (arg.compare(0, 11, "--metadata=") == 0) {
+            numMetadata = qcc::StringToU32(value, 10, numMetadata);
+        } else if (arg.compare(0, 13, "--iterations=") == 0) {
+            iterations = qcc::StringToU32(value, 10, iterations);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!numAcls || !iterations) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (AllJoynInit() != ER_OK) {
+        return 1;
+    }
+
+    // the Acls are marshaled with an empty metadata manager, the remote apps are not known to the agent
+    GatewayMetadataManager metadataManager;
+    GatewayConnectorApp connectorApp("bench", GatewayConnectorAppManifest());
+    std::map<qcc::String, GatewayAcl*> acls;
+    for (uint32_t i = 0; i < numAcls; i++) {
+        qcc::String aclId = "acl" + qcc::U32ToString(i);
+
+        GatewayAclRules aclRules;
+        aclRules.setExposedServicesRules(buildObjects("/exposed/" + aclId, numObjects, numInterfaces));
+        GatewayRemoteAppRules remoteAppRules;
+        for (uint32_t j = 0; j < numRemoteApps; j++) {
+            uint8_t appId[16] = { 0 };
+            appId[0] = (uint8_t)i;
+            appId[1] = (uint8_t)j;
+            GatewayAppIdentifier appKey(appId, sizeof(appId), "device" + qcc::U32ToString(j));
+            remoteAppRules.insert(std::pair<GatewayAppIdentifier, GatewayRuleObjectDescriptions>(appKey,
+                                                                                                  buildObjects("/remoted/" + aclId, numObjects, numInterfaces)));
+        }
+        aclRules.setRemoteAppRules(remoteAppRules);
+
+        std::map<qcc::String, qcc::String> customMetadata;
+        for (uint32_t j = 0; j < numMetadata; j++) {
+            customMetadata["key" + qcc::U32ToString(j)] = "value" + qcc::U32ToString(j);
+        }
+
+        acls[aclId] = new GatewayAcl(aclId, aclId, &connectorApp, aclRules, customMetadata, GW_AS_ACTIVE);
+    }
+    GatewayRef<GatewayAclSet> aclSet(new GatewayAclSet(1, acls, NULL));
+    GatewayAclSnapshot aclSnapshot(*acls.begin()->second);
+
+    // the inputs of the unmarshal cases are the outputs of the marshal cases
+    GatewayMsgArgArena aclArena;
+    MsgArg aclArgs[5];
+    GatewayMsgArgArena mergedArena;
+    MsgArg mergedArgs[2];
+    if (AclAdapter::marshalAcl(aclSnapshot, &metadataManager, aclArgs, &aclArena) != ER_OK ||
+        AclAdapter::marshalMergedAcl(*aclSet, mergedArgs, &mergedArena) != ER_OK) {
+        std::cout << "could not marshal the inputs" << std::endl;
+        return 1;
+    }
+
+    gwc::ConnectorCapabilities capabilities;
+    std::map<qcc::String, qcc::String> internalMetadata;
+    gwc::AclRules controllerRules;
+    if (controllerRules.init(&mergedArgs[0], &mergedArgs[1], capabilities, internalMetadata) != ER_OK) {
+        std::cout << "could not unmarshal the controller input" << std::endl;
+        return 1;
+    }
+
+    std::cout << "acls=" << numAcls << " objects=" << numObjects << " interfaces=" << numInterfaces
+              << " remoteApps=" << numRemoteApps << " metadata=" << numMetadata << " iterations=" << iterations << std::endl;
+    std::cout << std::left << std::setw(40) << "case" << std::right << std::setw(12) << "ns/op" << std::setw(14) << "allocs/op"
+              << std::setw(16) << "payload bytes" << std::endl;
+
+    CaseResult result;
+    QStatus status = ER_OK;
+
+    result.m_Name = "agent AclAdapter::marshalAcl";
+    result.m_PayloadBytes = getPayloadBytes(aclArgs, 5);
+    result.m_Allocations = getNumAllocations();
+    result.m_Nanoseconds = GetMonotonicNs();
+    for (uint32_t i = 0; i < iterations && status == ER_OK; i++) {
+        GatewayMsgArgArena arena;
+        MsgArg replyArg[5];
+        status = AclAdapter::marshalAcl(aclSnapshot, &metadataManager, replyArg, &arena);
+    }
+    result.m_Nanoseconds = GetMonotonicNs() - result.m_Nanoseconds;
+    result.m_Allocations = getNumAllocations() - result.m_Allocations;
+    printResult(result, iterations);
+
+    result.m_Name = "agent AclAdapter::marshalMergedAcl";
+    result.m_PayloadBytes = getPayloadBytes(mergedArgs, 2);
+    result.m_Allocations = getNumAllocations();
+    result.m_Nanoseconds = GetMonotonicNs();
+    for (uint32_t i = 0; i < iterations && status == ER_OK; i++) {
+        GatewayMsgArgArena arena;
+        MsgArg replyArg[2];
+        status = AclAdapter::marshalMergedAcl(*aclSet, replyArg, &arena);
+    }
+    result.m_Nanoseconds = GetMonotonicNs() - result.m_Nanoseconds;
+    result.m_Allocations = getNumAllocations() - result.m_Allocations;
+    printResult(result, iterations);
+
+    result.m_Name = "agent AclAdapter::unmarshalAcl";
+    result.m_PayloadBytes = getPayloadBytes(aclArgs, 5);
+    result.m_Allocations = getNumAllocations();
+    result.m_Nanoseconds = GetMonotonicNs();
+    for (uint32_t i = 0; i < iterations && status == ER_OK; i++) {
+        qcc::String aclName;
+        GatewayAclRules aclRules;
+        std::map<qcc::String, qcc::String> metadata;
+        std::map<qcc::String, qcc::String> customMetadata;
+        status = AclAdapter::unmarshalAcl(aclArgs, 5, &aclName, &aclRules, &metadata, &customMetadata);
+    }
+    result.m_Nanoseconds = GetMonotonicNs() - result.m_Nanoseconds;
+    result.m_Allocations = getNumAllocations() - result.m_Allocations;
+    printResult(result, iterations);
+
+    result.m_Name = "connector GatewayMergedAcl::unmarshal";
+    result.m_PayloadBytes = getPayloadBytes(mergedArgs, 2);
+    result.m_Allocations = getNumAllocations();
+    result.m_Nanoseconds = GetMonotonicNs();
+    for (uint32_t i = 0; i < iterations && status == ER_OK; i++) {
+        GatewayMergedAcl mergedAcl;
+        status = mergedAcl.unmarshal(mergedArgs, 2);
+    }
+    result.m_Nanoseconds = GetMonotonicNs() - result.m_Nanoseconds;
+    result.m_Allocations = getNumAllocations() - result.m_Allocations;
+    printResult(result, iterations);
+
+    result.m_Name = "controller AclRules::init";
+    result.m_PayloadBytes = getPayloadBytes(mergedArgs, 2);
+    result.m_Allocations = getNumAllocations();
+    result.m_Nanoseconds = GetMonotonicNs();
+    for (uint32_t i = 0; i < iterations && status == ER_OK; i++) {
+        gwc::AclRules aclRules;
+        status = aclRules.init(&mergedArgs[0], &mergedArgs[1], capabilities, internalMetadata);
+        aclRules.release();
+    }
+    result.m_Nanoseconds = GetMonotonicNs() - result.m_Nanoseconds;
+    result.m_Allocations = getNumAllocations() - result.m_Allocations;
+    printResult(result, iterations);
+
+    result.m_Name = "controller PayloadAdapter::MarshalAclRules";
+    result.m_PayloadBytes = 0;
+    result.m_Allocations = getNumAllocations();
+    result.m_Nanoseconds = GetMonotonicNs();
+    for (uint32_t i = 0; i < iterations && status == ER_OK; i++) {
+        std::vector<MsgArg*> aclRulesArgs;
+        status = gwc::PayloadAdapter::MarshalAclRules(controllerRules, aclRulesArgs);
+        for (size_t j = 0; j < aclRulesArgs.size(); j++) {
+            if (i == 0) {
+                result.m_PayloadBytes += getPayloadBytes(aclRulesArgs[j], 1);
+            }
+            aclRulesArgs[j]->SetOwnershipFlags(MsgArg::OwnsArgs, true);
+            delete aclRulesArgs[j];
+        }
+    }
+    result.m_Nanoseconds = GetMonotonicNs() - result.m_Nanoseconds;
+    result.m_Allocations = getNumAllocations() - result.m_Allocations;
+    printResult(result, iterations);
+
+    if (status != ER_OK) {
+        std::cout << "a case failed: " << QCC_StatusText(status) << std::endl;
+    }
+
+    controllerRules.release();
+    std::map<qcc::String, GatewayAcl*>::iterator it;
+    for (it = acls.begin(); it != acls.end(); it++) {
+        delete it->second;
+    }
+
+    AllJoynShutdown();
+    return status == ER_OK ? 0 : 1;
+}
@@ -0,0 +1,474 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/AboutData.h>
+#include <alljoyn/Init.h>
+#include <alljoyn/gateway/GatewayAclRules.h>
+#include <alljoyn/gateway/GatewayRouterPolicyManager.h>
+#include <alljoyn/gateway/GatewayStats.h>
+#include <alljoyn/gateway/AnnouncedApp.h>
+#include <alljoyn/gateway/AnnouncementData.h>
+#include <qcc/StringUtil.h>
+#include "GatewayConstants.h"
+#include "BenchmarkUtil.h"
+#include <algorithm>
+#include <iostream>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace ajn;
+using namespace gw;
+using namespace benchUtil;
+using namespace gwConsts;
+
+/**
+ * Object path prefix of the objects every fake device announces
+ */
+static const qcc::String LOAD_OBJECT_PREFIX = "/load/obj";
+
+/**
+ * Signature of an object of the About object description
+ */
+static const char* LOAD_OBJECT_DESCRIPTION = "(oas)";
+
+/**
+ * Signature of the About object description
+ */
+static const char* LOAD_OBJECT_DESCRIPTION_ARRAY = "a(oas)";
+
+/**
+ * Port every fake device announces
+ */
+static const SessionPort LOAD_SESSION_PORT = 900;
+
+/**
+ * Time the stub reload finished on the calling thread, 0 if it did not run
+ */
+static __thread uint64_t s_ThreadReloadUs = 0;
+
+/**
+ * Policy manager whose reload only counts and optionally sleeps instead of
+ * calling the daemon. The policy files are already on disk when it runs
+ */
+class LoadPolicyManager : public GatewayRouterPolicyManager {
+  public:
+
+    /**
+     * Constructor for LoadPolicyManager
+     * @param reloadUs - time a reload takes in microseconds
+     */
+    LoadPolicyManager(uint32_t reloadUs) : m_ReloadUs(reloadUs), m_NumReloads(0) { }
+
+    /**
+     * Get the number of reloads so far
+     * @return numReloads
+     */
+    uint32_t getNumReloads() const
+    {
+        return m_NumReloads;
+    }
+
+  protected:
+
+    /**
+     * Stub of the daemon ReloadConfig call
+     * @return status - success
+     */
+    QStatus reloadConfig()
+    {
+        if (m_ReloadUs) {
+            usleep(m_ReloadUs);
+        }
+        __sync_fetch_and_add(&m_NumReloads, 1);
+        s_ThreadReloadUs = GatewayStats::getMonotonicUs();
+        return ER_OK;
+    }
+
+  private:
+
+    /**
+     * Time a reload takes in microseconds
+     */
+    uint32_t m_ReloadUs;
+
+    /**
+     * Number of reloads so far
+     */
+    volatile uint32_t m_NumReloads;
+};
+
+/**
+ * State of a fake device
+ */
+struct FakeDevice {
+    uint8_t m_AppId[16];
+    qcc::String m_DeviceId;
+    qcc::String m_BusName;
+    uint32_t m_Generation;
+};
+
+/**
+ * A pre-built announcement
+ */
+struct Announcement {
+    qcc::String m_BusName;
+    MsgArg m_AboutData;
+};
+
+/**
+ * Announcements and results of a load thread
+ */
+struct LoadThread {
+    pthread_t m_Thread;
+    LoadPolicyManager* m_PolicyManager;
+    const MsgArg* m_ObjectDescriptions;
+    std::vector<Announcement> m_Announcements;
+    uint32_t m_RatePerSec;
+    uint64_t m_StartUs;
+    std::vector<uint64_t> m_LatenciesUs;
+};
+
+/**
+ * Give a device a new bus name
+ * @param index - index of the device
+ * @param device - the device
+ */
+static void changeBusName(uint32_t index, FakeDevice* device)
+{
+    device->m_Generation++;
+    device->m_BusName = ":load" + qcc::U32ToString(index) + "." + qcc::U32ToString(device->m_Generation);
+}
+
+/**
+ * Replace a device by a new one, the way a device leaves the network and another joins
+ * @param index - index of the device
+ * @param device - the device
+ */
+static void replaceDevice(uint32_t index, FakeDevice* device)
+{
+    changeBusName(index, device);
+    memset(device->m_AppId, 0, sizeof(device->m_AppId));
+    memcpy(device->m_AppId, &index, sizeof(index));
+    memcpy(device->m_AppId + sizeof(index), &device->m_Generation, sizeof(device->m_Generation));
+    device->m_DeviceId = "device" + qcc::U32ToString(index) + "-" + qcc::U32ToString(device->m_Generation);
+}
+
+/**
+ * Build the announcement of a device
+ * @param device - the device
+ * @param announcement - the announcement to fill
+ * @return status - success/failure
+ */
+static QStatus buildAnnouncement(FakeDevice const& device, Announcement* announcement)
+{
+    AboutData aboutData("en");
+    aboutData.SetAppId(device.m_AppId, sizeof(device.m_AppId));
+    aboutData.SetDeviceId(device.m_DeviceId.c_str());
+    aboutData.SetDeviceName(device.m_DeviceId.c_str());
+    aboutData.SetAppName("LoadApp");
+    aboutData.SetManufacturer("AllSeen");
+    aboutData.SetModelNumber("1");
+    aboutData.SetDescription("Synthetic device");
+    aboutData.SetSoftwareVersion("1.0");
+
+    announcement->m_BusName = device.m_BusName;
+    QStatus status = aboutData.GetAboutData(&announcement->m_AboutData);
+    announcement->m_AboutData.Stabilize();
+    return status;
+}
+
+/**
+ * Convert the AboutData of an announcement to the map the controller consumes
+ * @param aboutDataArg - the AboutData
+ * @param aboutData - the map to fill
+ */
+static void toAboutDataMap(const MsgArg& aboutDataArg, services::AboutClient::AboutData* aboutData)
+{
+    const MsgArg* entries = aboutDataArg.v_array.GetElements();
+    for (size_t i = 0; i < aboutDataArg.v_array.GetNumElements(); i++) {
+        (*aboutData)[entries[i].v_dictEntry.key->v_string.str] = *entries[i].v_dictEntry.val->v_variant.val;
+    }
+}
+
+/**
+ * Feed the announcements of a thread to the policy manager
+ * @param arg - the LoadThread
+ * @return NULL
+ */
+static void* runLoadThread(void* arg)
+{
+    LoadThread* thread = (LoadThread*)arg;
+    for (size_t i = 0; i < thread->m_Announcements.size(); i++) {
+        if (thread->m_RatePerSec) {
+            uint64_t dueUs = thread->m_StartUs + (uint64_t)i * 1000000 / thread->m_RatePerSec;
+            uint64_t nowUs = GatewayStats::getMonotonicUs();
+            if (dueUs > nowUs) {
+                usleep(dueUs - nowUs);
+            }
+        }
+
+        s_ThreadReloadUs = 0;
+        uint64_t announcedUs = GatewayStats::getMonotonicUs();
+        thread->m_PolicyManager->Announced(thread->m_Announcements[i].m_BusName.c_str(), 1, LOAD_SESSION_PORT,
+                                           *thread->m_ObjectDescriptions, thread->m_Announcements[i].m_AboutData);
+        if (s_ThreadReloadUs) {
+            thread->m_LatenciesUs.push_back(s_ThreadReloadUs - announcedUs);
+        }
+    }
+    return NULL;
+}
+
+static void usage(const char* name)
+{
+    std::cout << "Usage: " << name << " [--devices=N] [--announcements=N] [--churn=PCT] [--bus-name-changes=PCT]"
+              << " [--rate=N] [--threads=N] [--objects=N] [--interfaces=N] [--connectors=N] [--remoted-devices=N]"
+              << " [--reload-us=N] [--seed=N] [--policy-dir=DIR]" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t numDevices = 1000;
+    uint32_t numAnnouncements = 10000;
+    uint32_t churnPct = 5;
+    uint32_t busNameChangePct = 10;
+    uint32_t rate = 0;
+    uint32_t numThreads = 1;
+    uint32_t numObjects = 5;
+    uint32_t numInterfaces = 3;
+    uint32_t numConnectors = 5;
+    uint32_t numRemotedDevices = 100;
+    uint32_t reloadUs = 0;
+    uint32_t seed = 1;
+    qcc::String policyDir;
+
+    for (int i = 1; i < argc; i++) {
+        qcc::String arg(argv[i]);
+        size_t eq = arg.find('=');
+        qcc::String value = eq == qcc::String::npos ? "" : arg.substr(eq + 1);
+        if (arg.compare(0, 10, "--devices=") == 0) {
+            numDevices = qcc::StringToU32(value, 10, numDevices);
+        } else if (arg.compare(0, 16, "--announcements=") == 0) {
+            numAnnouncements = qcc::StringToU32(value, 10, numAnnouncements);
+        } else if (arg.compare(0, 8, "--churn=") == 0) {
+            churnPct = qcc::StringToU32(value, 10, churnPct);
+        } else if (arg.compare(0, 19, "--bus-name-changes=") == 0) {
+            busNameChangePct = qcc::StringToU32(value, 10, busNameChangePct);
+        } else if (arg.compare(0, 7, "--rate=") == 0) {
+            rate = qcc::StringToU32(value, 10, rate);
+        } else if (arg.compare(0, 10, "--threads=") == 0) {
+            numThreads = qcc::StringToU32(value, 10, numThreads);
+        } else if (arg.compare(0, 10, "--objects=") == 0) {
+            numObjects = qcc::StringToU32(value, 10, numObjects);
+        } else if (arg.compare(0, 13, "--interfaces=") == 0) {
+            numInterfaces = qcc::StringToU32(value, 10, numInterfaces);
+        } else if (arg.compare(0, 13, "--connectors=") == 0) {
+            numConnectors = qcc::StringToU32(value, 10, numConnectors);
+        } else if (arg.compare(0, 18, "--remoted-devices=") == 0) {
+            numRemotedDevices = qcc::StringToU32(value, 10, numRemotedDevices);
+        } else if (arg.compare(0, 12, "--reload-us=") == 0) {
+            reloadUs = qcc::StringToU32(value, 10, reloadUs);
+        } else if (arg.compare(0, 7, "--seed=") == 0) {
+            seed = qcc::StringToU32(value, 10, seed);
+        } else if (arg.compare(0, 13, "--policy-dir=") == 0) {
+            policyDir = value;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!numDevices || !numThreads || numThreads > numDevices || churnPct + busNameChangePct > 100) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (AllJoynInit() != ER_OK) {
+        return 1;
+    }
+
+    bool removePolicyDir = policyDir.empty();
+    if (removePolicyDir) {
+        char dirTemplate[] = "/tmp/gwagent-announce-load-XXXXXX";
+        if (!mkdtemp(dirTemplate)) {
+            std::cout << "could not create the policy directory" << std::endl;
+            return 1;
+        }
+        policyDir = dirTemplate;
+    }
+    qcc::String appPolicyDir = policyDir + "/apps";
+    mkdir(appPolicyDir.c_str(), 0755);
+
+    LoadPolicyManager policyManager(reloadUs);
+    policyManager.setGatewayPolicyFile((policyDir + "/gwagent-config.xml").c_str());
+    policyManager.setAppPolicyDirectory(appPolicyDir.c_str());
+
+    // every device announces the same objects
+    std::vector<qcc::String> objectPaths;
+    std::vector<qcc::String> interfaceNames;
+    std::vector<const char*> interfaces;
+    for (uint32_t j = 0; j < numInterfaces; j++) {
+        interfaceNames.push_back("org.alljoyn.load.Interface" + qcc::U32ToString(j));
+    }
+    for (uint32_t j = 0; j < numInterfaces; j++) {
+        interfaces.push_back(interfaceNames[j].c_str());
+    }
+    std::vector<MsgArg> objectArgs(numObjects);
+    services::AboutClient::ObjectDescriptions objectDescriptions;
+    for (uint32_t i = 0; i < numObjects; i++) {
+        objectPaths.push_back(LOAD_OBJECT_PREFIX + qcc::U32ToString(i));
+        objectDescriptions[objectPaths[i]] = interfaceNames;
+    }
+    for (uint32_t i = 0; i < numObjects; i++) {
+        objectArgs[i].Set(LOAD_OBJECT_DESCRIPTION, objectPaths[i].c_str(), interfaces.size(), interfaces.data());
+    }
+    MsgArg objectDescriptionArg;
+    objectDescriptionArg.Set(LOAD_OBJECT_DESCRIPTION_ARRAY, objectArgs.size(), objectArgs.data());
+
+    std::vector<FakeDevice> devices(numDevices);
+    for (uint32_t i = 0; i < numDevices; i++) {
+        devices[i].m_Generation = 0;
+        replaceDevice(i, &devices[i]);
+    }
+
+    // the connector apps remote the first devices, so applied announcements change their policy files
+    GatewayRuleObjectDescriptions remotedObjects;
+    for (uint32_t i = 0; i < numObjects; i++) {
+        remotedObjects.push_back(GatewayRuleObjectDescription(objectPaths[i], false, interfaceNames));
+    }
+    GatewayRemoteAppRules remoteAppRules;
+    for (uint32_t i = 0; i < numRemotedDevices && i < numDevices; i++) {
+        GatewayAppIdentifier appKey(devices[i].m_AppId, sizeof(devices[i].m_AppId), devices[i].m_DeviceId);
+        remoteAppRules.insert(std::pair<GatewayAppIdentifier, GatewayRuleObjectDescriptions>(appKey, remotedObjects));
+    }
+    GatewayAclRules aclRules;
+    aclRules.setRemoteAppRules(remoteAppRules);
+    std::map<qcc::String, std::vector<GatewayAclRules> > connectorRules;
+    for (uint32_t i = 0; i < numConnectors; i++) {
+        connectorRules["connector" + qcc::U32ToString(i)] = std::vector<GatewayAclRules>(1, aclRules);
+    }
+    policyManager.addConnectorAppRules(connectorRules);
+
+    // every device announces once, then the announcements follow the configured mix.
+    // Device i belongs to thread i % numThreads so each thread owns the state of its devices
+    std::vector<LoadThread> threads(numThreads);
+    uint32_t numTotal = numDevices + numAnnouncements;
+    unsigned int randState = seed;
+    for (uint32_t t = 0; t < numThreads; t++) {
+        threads[t].m_Announcements.reserve(numTotal / numThreads + numDevices);
+    }
+    for (uint32_t i = 0; i < numTotal; i++) {
+        uint32_t index = i;
+        if (i >= numDevices) {
+            index = rand_r(&randState) % numDevices;
+            uint32_t roll = rand_r(&randState) % 100;
+            if (roll < churnPct) {
+                replaceDevice(index, &devices[index]);
+            } else if (roll < churnPct + busNameChangePct) {
+                changeBusName(index, &devices[index]);
+            }
+        }
+        LoadThread& thread = threads[index % numThreads];
+        thread.m_Announcements.resize(thread.m_Announcements.size() + 1);
+        if (buildAnnouncement(devices[index], &thread.m_Announcements.back()) != ER_OK) {
+            std::cout << "could not build the AboutData of " << devices[index].m_DeviceId.c_str() << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "devices=" << numDevices << " announcements=" << numTotal << " churn=" << churnPct << "%"
+              << " busNameChanges=" << busNameChangePct << "% rate=" << rate << "/s threads=" << numThreads
+              << " connectors=" << numConnectors << " reloadUs=" << reloadUs << " policyDir=" << policyDir.c_str() << std::endl;
+
+    GatewayStats::reset();
+    policyManager.setAutoCommit(true);
+    uint32_t reloadsBefore = policyManager.getNumReloads();
+    uint64_t startUs = GatewayStats::getMonotonicUs();
+    for (uint32_t t = 0; t < numThreads; t++) {
+        threads[t].m_PolicyManager = &policyManager;
+        threads[t].m_ObjectDescriptions = &objectDescriptionArg;
+        threads[t].m_RatePerSec = rate ? std::max(rate / numThreads, (uint32_t)1) : 0;
+        threads[t].m_StartUs = startUs;
+        pthread_create(&threads[t].m_Thread, NULL, runLoadThread, &threads[t]);
+    }
+    std::vector<uint64_t> latenciesUs;
+    for (uint32_t t = 0; t < numThreads; t++) {
+        pthread_join(threads[t].m_Thread, NULL);
+        latenciesUs.insert(latenciesUs.end(), threads[t].m_LatenciesUs.begin(), threads[t].m_LatenciesUs.end());
+    }
+    uint64_t elapsedUs = GatewayStats::getMonotonicUs() - startUs;
+    policyManager.setAutoCommit(false);
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+
+    std::vector<GatewayStats::CounterValue> counters;
+    std::vector<GatewayStats::HistogramValue> histograms;
+    GatewayStats::getSnapshot(&counters, &histograms);
+
+    std::cout << "agent: " << (elapsedUs ? (uint64_t)numTotal * 1000000 / elapsedUs : 0) << " announcements/s sustained, "
+              << policyManager.getNumReloads() - reloadsBefore << " commits, "
+              << policyManager.getAnnouncedDevices().size() << " devices known" << std::endl;
+    for (size_t i = 0; i < counters.size(); i++) {
+        if (counters[i].m_Name.compare(0, 14, "announcements.") == 0) {
+            std::cout << "  " << counters[i].m_Name.c_str() << "=" << counters[i].m_Value << std::endl;
+        }
+    }
+    std::cout << "  announcement to policy on disk: p50=" << getPercentile(latenciesUs, 50) << "us p90="
+              << getPercentile(latenciesUs, 90) << "us p99=" << getPercentile(latenciesUs, 99) << "us max="
+              << (latenciesUs.empty() ? 0 : latenciesUs.back()) << "us" << std::endl;
+
+    // the controller keeps the latest AnnouncementData of every bus name and an AnnouncedApp per device
+    std::map<qcc::String, gwc::AnnouncementData*> announcements;
+    startUs = GatewayStats::getMonotonicUs();
+    for (uint32_t t = 0; t < numThreads; t++) {
+        for (size_t i = 0; i < threads[t].m_Announcements.size(); i++) {
+            const Announcement& announcement = threads[t].m_Announcements[i];
+            services::AboutClient::AboutData aboutData;
+            toAboutDataMap(announcement.m_AboutData, &aboutData);
+
+            std::map<qcc::String, gwc::AnnouncementData*>::iterator it = announcements.find(announcement.m_BusName);
+            if (it != announcements.end()) {
+                delete it->second;
+                announcements.erase(it);
+            }
+            announcements[announcement.m_BusName] = new gwc::AnnouncementData(LOAD_SESSION_PORT, aboutData, objectDescriptions);
+
+            gwc::AnnouncedApp announcedApp;
+            announcedApp.init(announcement.m_BusName, aboutData);
+        }
+    }
+    elapsedUs = GatewayStats::getMonotonicUs() - startUs;
+    std::cout << "controller: " << (elapsedUs ? (uint64_t)numTotal * 1000000 / elapsedUs : 0) << " announcements/s, "
+              << announcements.size() << " bus names known" << std::endl;
+
+    std::map<qcc::String, gwc::AnnouncementData*>::iterator it;
+    for (it = announcements.begin(); it != announcements.end(); it++) {
+        delete it->second;
+    }
+
+    if (removePolicyDir) {
+        for (uint32_t i = 0; i < numConnectors; i++) {
+            remove((appPolicyDir + "/connector" + qcc::U32ToString(i) + ".xml").c_str());
+        }
+        remove((policyDir + "/gwagent-config.xml").c_str());
+        rmdir(appPolicyDir.c_str());
+        rmdir(policyDir.c_str());
+    }
+
+    AllJoynShutdown();
+    return 0;
+}
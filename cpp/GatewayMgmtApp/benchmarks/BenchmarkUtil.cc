@@ -0,0 +1,48 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include "BenchmarkUtil.h"
+#include <qcc/StringUtil.h>
+#include <algorithm>
+
+namespace ajn {
+namespace gw {
+namespace benchUtil {
+
+GatewayRuleObjectDescriptions buildObjects(qcc::String const& prefix, uint32_t numObjects, uint32_t numInterfaces)
+{
+    GatewayRuleObjectDescriptions objects;
+    for (uint32_t i = 0; i < numObjects; i++) {
+        std::vector<qcc::String> interfaces;
+        for (uint32_t j = 0; j < numInterfaces; j++) {
+            interfaces.push_back("org.alljoyn.bench.Interface" + qcc::U32ToString(j));
+        }
+        objects.push_back(GatewayRuleObjectDescription(prefix + "/obj" + qcc::U32ToString(i), false, interfaces));
+    }
+    return objects;
+}
+
+uint64_t getPercentile(std::vector<uint64_t> const& samples, uint32_t percentile)
+{
+    if (samples.empty()) {
+        return 0;
+    }
+    return samples[std::min(samples.size() - 1, samples.size() * percentile / 100)];
+}
+
+} /* namespace benchUtil */
+} /* namespace gw */
+} /* namespace ajn */
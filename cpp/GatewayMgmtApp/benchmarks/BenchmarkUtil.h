@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef BENCHMARKUTIL_H_
+#define BENCHMARKUTIL_H_
+
+#include <alljoyn/gateway/GatewayAclRules.h>
+#include <vector>
+
+namespace ajn {
+namespace gw {
+namespace benchUtil {
+
+/**
+ * Build a set of object descriptions. Every path and interface name is built
+ * into a fresh string, the way they arrive from D-Bus messages or Acl files
+ * @param prefix - prefix of the object paths
+ * @param numObjects - number of objects
+ * @param numInterfaces - number of interfaces per object
+ * @return objectDescriptions
+ */
+GatewayRuleObjectDescriptions buildObjects(qcc::String const& prefix, uint32_t numObjects, uint32_t numInterfaces);
+
+/**
+ * Get a percentile of sorted samples
+ * @param samples - the sorted samples
+ * @param percentile - the percentile
+ * @return value
+ */
+uint64_t getPercentile(std::vector<uint64_t> const& samples, uint32_t percentile);
+
+/**
+ * Get the number of heap allocations made since the start of the program.
+ * Only available in benchmarks linked with BenchmarkAllocCounter, which
+ * replaces the global operator new and delete
+ * @return numAllocations
+ */
+size_t getNumAllocations();
+
+} /* namespace benchUtil */
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* BENCHMARKUTIL_H_ */
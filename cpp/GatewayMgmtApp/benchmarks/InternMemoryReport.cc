@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/gateway/GatewayAclRules.h>
+#include <alljoyn/gateway/GatewayInternedString.h>
+#include <qcc/StringUtil.h>
+#include "BenchmarkUtil.h"
+#include <iostream>
+
+using namespace ajn;
+using namespace gw;
+using namespace benchUtil;
+
+static void usage(const char* name)
+{
+    std::cout << "Usage: " << name << " [--acls=N] [--objects=N] [--interfaces=N] [--remote-apps=N]" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t numAcls = 100;
+    uint32_t numObjects = 20;
+    uint32_t numInterfaces = 5;
+    uint32_t numRemoteApps = 20;
+
+    for (int i = 1; i < argc; i++) {
+        qcc::String arg(argv[i]);
+        size_t eq = arg.find('=');
+        qcc::String value = eq == qcc::String::npos ? "" : arg.substr(eq + 1);
+        if (arg.compare(0, 7, "--acls=") == 0) {
+            numAcls = qcc::StringToU32(value, 10, numAcls);
+        } else if (arg.compare(0, 10, "--objects=") == 0) {
+            numObjects = qcc::StringToU32(value, 10, numObjects);
+        } else if (arg.compare(0, 13, "--interfaces=") == 0) {
+            numInterfaces = qcc::StringToU32(value, 10, numInterfaces);
+        } else if (arg.compare(0, 14, "--remote-apps=") == 0) {
+            numRemoteApps = qcc::StringToU32(value, 10, numRemoteApps);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    GatewayInternedString::TableStats baseline;
+    GatewayInternedString::getTableStats(&baseline);
+
+    // every Acl exposes and remotes the same object paths, the way Acls of one Connector App overlap
+    std::vector<GatewayAclRules> acls(numAcls);
+    GatewayAclRules mergedRules;
+    for (uint32_t i = 0; i < numAcls; i++) {
+        acls[i].setExposedServicesRules(buildObjects("/exposed", numObjects, numInterfaces));
+        GatewayRemoteAppRules remoteAppRules;
+        for (uint32_t j = 0; j < numRemoteApps; j++) {
+            uint8_t appId[16] = { 0 };
+            appId[0] = (uint8_t)j;
+            GatewayAppIdentifier appKey(appId, sizeof(appId), "device" + qcc::U32ToString(j));
+            remoteAppRules.insert(std::pair<GatewayAppIdentifier, GatewayRuleObjectDescriptions>(appKey,
+                                                                                                  buildObjects("/remoted", numObjects, numInterfaces)));
+        }
+        acls[i].setRemoteAppRules(remoteAppRules);
+        mergedRules.mergeRules(acls[i]);
+    }
+
+    GatewayInternedString::TableStats stats;
+    GatewayInternedString::getTableStats(&stats);
+    size_t numStrings = stats.m_NumStrings - baseline.m_NumStrings;
+    size_t numHandles = stats.m_NumHandles - baseline.m_NumHandles;
+    size_t internedBytes = stats.m_InternedBytes - baseline.m_InternedBytes;
+    size_t copiedBytes = stats.m_CopiedBytes - baseline.m_CopiedBytes;
+
+    std::cout << "acls=" << numAcls << " objects=" << numObjects << " interfaces=" << numInterfaces
+              << " remoteApps=" << numRemoteApps << std::endl;
+    std::cout << "strings: " << numStrings << " distinct, " << numHandles << " references" << std::endl;
+    std::cout << "copied:   " << copiedBytes << " bytes of string data" << std::endl;
+    std::cout << "interned: " << internedBytes << " bytes of string data and table entries" << std::endl;
+    if (copiedBytes) {
+        std::cout << "saved:    " << (copiedBytes > internedBytes ? copiedBytes - internedBytes : 0) << " bytes ("
+                  << (copiedBytes > internedBytes ? (copiedBytes - internedBytes) * 100 / copiedBytes : 0) << "%)" << std::endl;
+    }
+
+    acls.clear();
+    mergedRules = GatewayAclRules();
+    GatewayInternedString::getTableStats(&stats);
+    std::cout << "after release: " << stats.m_NumStrings - baseline.m_NumStrings << " strings left in the table" << std::endl;
+    return 0;
+}
@@ -0,0 +1,403 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/AboutData.h>
+#include <alljoyn/Init.h>
+#include <alljoyn/gateway/GatewayAcl.h>
+#include <alljoyn/gateway/GatewayConnectorApp.h>
+#include <alljoyn/gateway/GatewayConnectorAppManager.h>
+#include <alljoyn/gateway/GatewayLoopbackBus.h>
+#include <alljoyn/gateway/GatewayMgmt.h>
+#include <alljoyn/gateway/GatewayRouterPolicyManager.h>
+#include <alljoyn/gateway/GatewayStats.h>
+#include <alljoyn/gateway/GatewayTaskQueue.h>
+#include <qcc/StringUtil.h>
+#include "GatewayConstants.h"
+#include "BenchmarkUtil.h"
+#include <algorithm>
+#include <dirent.h>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace ajn;
+using namespace gw;
+using namespace benchUtil;
+using namespace gwConsts;
+
+/**
+ * Object path every fake device announces
+ */
+static const char* LOOPBACK_OBJECT_PATH = "/loopback/obj";
+
+/**
+ * Interface every fake device announces
+ */
+static const char* LOOPBACK_INTERFACE = "org.alljoyn.loopback.Interface";
+
+/**
+ * Port every fake device announces
+ */
+static const SessionPort LOOPBACK_SESSION_PORT = 900;
+
+/**
+ * Counts the signals the agent sends on the loopback
+ */
+class SignalCounter : public GatewayLoopbackSignalHandler {
+  public:
+
+    /**
+     * Constructor for SignalCounter
+     */
+    SignalCounter() : m_NumAclUpdated(0) { }
+
+    /**
+     * Count a signal
+     */
+    void signalReceived(const char* objectPath, const char* destination, SessionId sessionId,
+                        const InterfaceDescription::Member& signal, const MsgArg* args, size_t numArgs)
+    {
+        if (signal.name == AJ_SIGNAL_ACL_UPDATED) {
+            __sync_fetch_and_add(&m_NumAclUpdated, 1);
+        }
+    }
+
+    /**
+     * Number of AclUpdated signals so far
+     */
+    volatile uint32_t m_NumAclUpdated;
+};
+
+/**
+ * Runs an Acl operation on the task queue of a Connector App, which owns the
+ * state of the App and its Acls
+ */
+class AclOperationTask : public GatewayTask {
+  public:
+
+    /**
+     * The operations
+     */
+    enum Operation {
+        CREATE_ACL,
+        UPDATE_ACL,
+        DELETE_ACL
+    };
+
+    /**
+     * Constructor for AclOperationTask
+     * @param operation - the operation
+     * @param connectorApp - the Connector App
+     * @param aclId - the Acl to update or delete, set to the created Acl
+     * @param aclName - the name of the created or updated Acl
+     * @param responseCode - set to the response code of the operation
+     */
+    AclOperationTask(Operation operation, GatewayConnectorApp* connectorApp, qcc::String* aclId, qcc::String const& aclName,
+                     AclResponseCode* responseCode) :
+        m_Operation(operation), m_ConnectorApp(connectorApp), m_AclId(aclId), m_AclName(aclName), m_ResponseCode(responseCode) { }
+
+    void run()
+    {
+        GatewayAclRules aclRules;
+        std::map<qcc::String, qcc::String> metadata;
+        std::map<qcc::String, qcc::String> customMetadata;
+        if (m_Operation == CREATE_ACL) {
+            *m_ResponseCode = m_ConnectorApp->createAcl(m_AclId, m_AclName, aclRules, metadata, customMetadata);
+        } else if (m_Operation == UPDATE_ACL) {
+            std::map<qcc::String, GatewayAcl*>::const_iterator acl = m_ConnectorApp->getAcls().find(*m_AclId);
+            *m_ResponseCode = acl == m_ConnectorApp->getAcls().end() ? GW_ACL_RC_INVALID :
+                              acl->second->updateAcl(m_AclName, aclRules, metadata, customMetadata);
+        } else {
+            *m_ResponseCode = m_ConnectorApp->deleteAcl(*m_AclId);
+        }
+    }
+
+    void cancel()
+    {
+        *m_ResponseCode = GW_ACL_RC_INVALID;
+    }
+
+  private:
+
+    Operation m_Operation;
+
+    GatewayConnectorApp* m_ConnectorApp;
+
+    qcc::String* m_AclId;
+
+    qcc::String m_AclName;
+
+    AclResponseCode* m_ResponseCode;
+};
+
+/**
+ * Run an Acl operation on the task queue of a Connector App and wait for it
+ * @param operation - the operation
+ * @param connectorApp - the Connector App
+ * @param aclId - the Acl to update or delete, set to the created Acl
+ * @param aclName - the name of the created or updated Acl
+ * @return responseCode
+ */
+static AclResponseCode runAclOperation(AclOperationTask::Operation operation, GatewayConnectorApp* connectorApp, qcc::String* aclId,
+                                       qcc::String const& aclName)
+{
+    AclResponseCode responseCode = GW_ACL_RC_INVALID;
+    connectorApp->getTaskQueue()->postAndWait(new AclOperationTask(operation, connectorApp, aclId, aclName, &responseCode));
+    return responseCode;
+}
+
+/**
+ * Sort latencies and print their percentiles
+ * @param name - name of the operation
+ * @param latenciesUs - the latencies
+ */
+static void printLatencies(const char* name, std::vector<uint64_t>& latenciesUs)
+{
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    std::cout << "  " << name << ": count=" << latenciesUs.size() << " p50=" << getPercentile(latenciesUs, 50) << "us p90="
+              << getPercentile(latenciesUs, 90) << "us p99=" << getPercentile(latenciesUs, 99) << "us max="
+              << (latenciesUs.empty() ? 0 : latenciesUs.back()) << "us" << std::endl;
+}
+
+/**
+ * Build the AboutData of a fake device
+ * @param index - index of the device
+ * @param aboutDataArg - the AboutData to fill
+ * @return status - success/failure
+ */
+static QStatus buildAboutData(uint32_t index, MsgArg* aboutDataArg)
+{
+    uint8_t appId[16];
+    memset(appId, 0, sizeof(appId));
+    memcpy(appId, &index, sizeof(index));
+    qcc::String deviceId = "loopback" + qcc::U32ToString(index);
+
+    AboutData aboutData("en");
+    aboutData.SetAppId(appId, sizeof(appId));
+    aboutData.SetDeviceId(deviceId.c_str());
+    aboutData.SetDeviceName(deviceId.c_str());
+    aboutData.SetAppName("LoopbackApp");
+    aboutData.SetManufacturer("AllSeen");
+    aboutData.SetModelNumber("1");
+    aboutData.SetDescription("Synthetic device");
+    aboutData.SetSoftwareVersion("1.0");
+
+    QStatus status = aboutData.GetAboutData(aboutDataArg);
+    aboutDataArg->Stabilize();
+    return status;
+}
+
+static void usage(const char* name)
+{
+    std::cout << "Usage: " << name << " [--devices=N] [--announcements=N] [--acl-cycles=N] [--calls=N] [--reload-us=N] [--policy-dir=DIR]"
+              << std::endl << "  --acl-cycles creates, updates and deletes Acls of the installed Connector Apps in "
+              << GATEWAY_APPS_DIRECTORY.c_str() << std::endl
+              << "  --calls calls GetAppStatus of every installed Connector App through the loopback" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t numDevices = 100;
+    uint32_t numAnnouncements = 10000;
+    uint32_t numAclCycles = 0;
+    uint32_t numCalls = 0;
+    uint32_t reloadUs = 0;
+    qcc::String policyDir;
+
+    for (int i = 1; i < argc; i++) {
+        qcc::String arg(argv[i]);
+        size_t eq = arg.find('=');
+        qcc::String value = eq == qcc::String::npos ? "" : arg.substr(eq + 1);
+        if (arg.compare(0, 10, "--devices=") == 0) {
+            numDevices = qcc::StringToU32(value, 10, numDevices);
+        } else if (arg.compare(0, 16, "--announcements=") == 0) {
+            numAnnouncements = qcc::StringToU32(value, 10, numAnnouncements);
+        } else if (arg.compare(0, 13, "--acl-cycles=") == 0) {
+            numAclCycles = qcc::StringToU32(value, 10, numAclCycles);
+        } else if (arg.compare(0, 8, "--calls=") == 0) {
+            numCalls = qcc::StringToU32(value, 10, numCalls);
+        } else if (arg.compare(0, 12, "--reload-us=") == 0) {
+            reloadUs = qcc::StringToU32(value, 10, reloadUs);
+        } else if (arg.compare(0, 13, "--policy-dir=") == 0) {
+            policyDir = value;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!numDevices) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (AllJoynInit() != ER_OK) {
+        return 1;
+    }
+
+    bool removePolicyDir = policyDir.empty();
+    if (removePolicyDir) {
+        char dirTemplate[] = "/tmp/gwagent-loopback-XXXXXX";
+        if (!mkdtemp(dirTemplate)) {
+            std::cout << "could not create the policy directory" << std::endl;
+            return 1;
+        }
+        policyDir = dirTemplate;
+    }
+    qcc::String appPolicyDir = policyDir + "/apps";
+    mkdir(appPolicyDir.c_str(), 0755);
+
+    GatewayLoopbackBus bus(reloadUs);
+    SignalCounter signalCounter;
+    bus.registerSignalHandler(&signalCounter);
+
+    GatewayMgmt* gatewayMgmt = GatewayMgmt::getInstance();
+    gatewayMgmt->setGatewayPolicyFile((policyDir + "/gwagent-config.xml").c_str());
+    gatewayMgmt->setAppPolicyDir(appPolicyDir.c_str());
+
+    std::cout << "devices=" << numDevices << " announcements=" << numAnnouncements << " aclCycles=" << numAclCycles
+              << " calls=" << numCalls << " reloadUs=" << reloadUs << " policyDir=" << policyDir.c_str() << std::endl;
+
+    uint64_t startUs = GatewayStats::getMonotonicUs();
+    QStatus status = gatewayMgmt->initGatewayMgmt(&bus);
+    uint64_t elapsedUs = GatewayStats::getMonotonicUs() - startUs;
+    if (status != ER_OK) {
+        std::cout << "could not initialize the agent on the loopback: " << QCC_StatusText(status) << std::endl;
+        return 1;
+    }
+
+    const std::map<qcc::String, GatewayConnectorApp*>& connectorApps = gatewayMgmt->getConnectorAppManager()->getConnectorApps();
+    std::cout << "init: " << elapsedUs << "us, " << connectorApps.size() << " connector apps, " << bus.getNumBusObjects()
+              << " objects registered, " << bus.getNumReloads() << " reloads" << std::endl;
+
+    // every device announces the same object
+    const char* interfaces[] = { LOOPBACK_INTERFACE };
+    MsgArg objectArg;
+    objectArg.Set("(oas)", LOOPBACK_OBJECT_PATH, 1, interfaces);
+    MsgArg objectDescriptionArg;
+    objectDescriptionArg.Set("a(oas)", 1, &objectArg);
+
+    std::vector<MsgArg> aboutDataArgs(numDevices);
+    for (uint32_t i = 0; i < numDevices; i++) {
+        if (buildAboutData(i, &aboutDataArgs[i]) != ER_OK) {
+            std::cout << "could not build the AboutData of device " << i << std::endl;
+            return 1;
+        }
+    }
+
+    GatewayStats::reset();
+    uint64_t reloadsBefore = bus.getNumReloads();
+    std::vector<uint64_t> latenciesUs;
+    latenciesUs.reserve(numAnnouncements);
+    startUs = GatewayStats::getMonotonicUs();
+    for (uint32_t i = 0; i < numAnnouncements; i++) {
+        uint32_t index = i % numDevices;
+        qcc::String busName = ":loopback" + qcc::U32ToString(index) + ".1";
+        uint64_t announcedUs = GatewayStats::getMonotonicUs();
+        bus.announce(busName.c_str(), 1, LOOPBACK_SESSION_PORT, objectDescriptionArg, aboutDataArgs[index]);
+        latenciesUs.push_back(GatewayStats::getMonotonicUs() - announcedUs);
+    }
+    elapsedUs = GatewayStats::getMonotonicUs() - startUs;
+    std::cout << "announcements: " << (elapsedUs ? (uint64_t)numAnnouncements * 1000000 / elapsedUs : 0) << "/s, "
+              << bus.getNumReloads() - reloadsBefore << " reloads, "
+              << gatewayMgmt->getRouterPolicyManager()->getAnnouncedDevices().size() << " devices known" << std::endl;
+    printLatencies("Announced", latenciesUs);
+
+    if (numAclCycles) {
+        // the operations run on the task queues of the apps, the latencies include the hop to the queue
+        std::vector<uint64_t> createUs, updateUs, deleteUs;
+        uint32_t numErrors = 0;
+        std::map<qcc::String, GatewayConnectorApp*>::const_iterator it;
+        for (it = connectorApps.begin(); it != connectorApps.end(); it++) {
+            GatewayConnectorApp* connectorApp = it->second;
+            for (uint32_t i = 0; i < numAclCycles; i++) {
+                qcc::String aclId;
+                uint64_t callUs = GatewayStats::getMonotonicUs();
+                if (runAclOperation(AclOperationTask::CREATE_ACL, connectorApp, &aclId, "loopback" + qcc::U32ToString(i)) != GW_ACL_RC_SUCCESS) {
+                    numErrors++;
+                    continue;
+                }
+                createUs.push_back(GatewayStats::getMonotonicUs() - callUs);
+
+                callUs = GatewayStats::getMonotonicUs();
+                if (runAclOperation(AclOperationTask::UPDATE_ACL, connectorApp, &aclId, "loopback-updated" + qcc::U32ToString(i)) == GW_ACL_RC_SUCCESS) {
+                    updateUs.push_back(GatewayStats::getMonotonicUs() - callUs);
+                } else {
+                    numErrors++;
+                }
+
+                callUs = GatewayStats::getMonotonicUs();
+                if (runAclOperation(AclOperationTask::DELETE_ACL, connectorApp, &aclId, "") == GW_ACL_RC_SUCCESS) {
+                    deleteUs.push_back(GatewayStats::getMonotonicUs() - callUs);
+                } else {
+                    numErrors++;
+                }
+            }
+        }
+        std::cout << "acls: " << numErrors << " errors, " << signalCounter.m_NumAclUpdated << " AclUpdated signals, "
+                  << bus.getNumSignals() << " signals" << std::endl;
+        printLatencies("CreateAcl", createUs);
+        printLatencies("UpdateAcl", updateUs);
+        printLatencies("DeleteAcl", deleteUs);
+    }
+
+    if (numCalls) {
+        // the calls go through the method handlers of the App objects on their task queues
+        std::vector<uint64_t> callLatenciesUs;
+        uint32_t numErrors = 0;
+        std::map<qcc::String, GatewayConnectorApp*>::const_iterator it;
+        for (it = connectorApps.begin(); it != connectorApps.end(); it++) {
+            for (uint32_t i = 0; i < numCalls; i++) {
+                GatewayLoopbackReply reply;
+                uint64_t callUs = GatewayStats::getMonotonicUs();
+                if (bus.callMethod(it->second->getObjectPath(), AJ_GW_APP_INTERFACE, AJ_METHOD_GET_APP_STATUS, NULL, 0, &reply) != ER_OK) {
+                    numErrors++;
+                    continue;
+                }
+                callLatenciesUs.push_back(GatewayStats::getMonotonicUs() - callUs);
+            }
+        }
+        std::cout << "method calls: " << numErrors << " errors" << std::endl;
+        printLatencies("GetAppStatus", callLatenciesUs);
+    }
+
+    startUs = GatewayStats::getMonotonicUs();
+    status = gatewayMgmt->shutdownGatewayMgmt();
+    elapsedUs = GatewayStats::getMonotonicUs() - startUs;
+    std::cout << "shutdown: " << elapsedUs << "us, " << bus.getNumBusObjects() << " objects left registered" << std::endl;
+    bus.unregisterSignalHandler(&signalCounter);
+
+    if (removePolicyDir) {
+        DIR* dir = opendir(appPolicyDir.c_str());
+        if (dir) {
+            struct dirent* entry;
+            while ((entry = readdir(dir)) != NULL) {
+                if (entry->d_type == DT_REG) {
+                    remove((appPolicyDir + "/" + entry->d_name).c_str());
+                }
+            }
+            closedir(dir);
+        }
+        remove((policyDir + "/gwagent-config.xml").c_str());
+        rmdir(appPolicyDir.c_str());
+        rmdir(policyDir.c_str());
+    }
+
+    AllJoynShutdown();
+    return status == ER_OK ? 0 : 1;
+}
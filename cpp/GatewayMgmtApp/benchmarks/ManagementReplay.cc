@@ -0,0 +1,350 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/BusAttachment.h>
+#include <alljoyn/Init.h>
+#include <alljoyn/ProxyBusObject.h>
+#include <alljoyn/gateway/GatewayLoopbackBus.h>
+#include <alljoyn/gateway/GatewayMgmt.h>
+#include <alljoyn/gateway/GatewayRecorder.h>
+#include <alljoyn/gateway/GatewayRouterPolicyManager.h>
+#include <alljoyn/gateway/GatewayStats.h>
+#include <qcc/StringUtil.h>
+#include "GatewayConstants.h"
+#include "app/SrpKeyXListener.h"
+#include "BenchmarkUtil.h"
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <unistd.h>
+
+using namespace ajn;
+using namespace gw;
+using namespace benchUtil;
+using namespace gwConsts;
+
+/**
+ * Name of the announcements in the report
+ */
+static const qcc::String ANNOUNCEMENT_NAME = "Announced";
+
+/**
+ * Timeout of a replayed method call
+ */
+static const uint32_t REPLAY_CALL_TIMEOUT_MS = 25000;
+
+/**
+ * Latencies and errors of a method
+ */
+struct MethodResults {
+    std::vector<uint64_t> m_LatenciesUs;
+    uint32_t m_NumErrors;
+
+    MethodResults() : m_NumErrors(0) { }
+};
+
+/**
+ * Start and connect a BusAttachment and enable the security the agent interfaces require
+ * @param bus - the BusAttachment
+ * @param connectSpec - the router to connect to, empty for the default one
+ * @param keyListener - the listener providing the passcode
+ * @return status - success/failure
+ */
+static QStatus prepareBus(BusAttachment* bus, qcc::String const& connectSpec, SrpKeyXListener* keyListener)
+{
+    QStatus status = bus->Start();
+    if (status != ER_OK) {
+        return status;
+    }
+    status = connectSpec.empty() ? bus->Connect() : bus->Connect(connectSpec.c_str());
+    if (status != ER_OK) {
+        return status;
+    }
+    return bus->EnablePeerSecurity("ALLJOYN_SRP_KEYX ALLJOYN_SRP_LOGON ALLJOYN_ECDHE_PSK", keyListener);
+}
+
+/**
+ * Get the proxy of an object of the agent, introspected on first use
+ * @param bus - the BusAttachment of the driver
+ * @param agentName - the bus name of the agent
+ * @param objectPath - the object path
+ * @param proxies - the proxies so far
+ * @return proxy or NULL if the object could not be introspected
+ */
+static ProxyBusObject* getProxy(BusAttachment* bus, qcc::String const& agentName, qcc::String const& objectPath,
+                                std::map<qcc::String, ProxyBusObject*>* proxies)
+{
+    std::map<qcc::String, ProxyBusObject*>::iterator it = proxies->find(objectPath);
+    if (it != proxies->end()) {
+        return it->second;
+    }
+
+    ProxyBusObject* proxy = new ProxyBusObject(*bus, agentName.c_str(), objectPath.c_str(), 0);
+    QStatus status = proxy->IntrospectRemoteObject();
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not introspect %s", objectPath.c_str()));
+        delete proxy;
+        proxy = NULL;
+    }
+    // a failed introspection is not retried, the calls to the object count as errors
+    (*proxies)[objectPath] = proxy;
+    return proxy;
+}
+
+static void usage(const char* name)
+{
+    std::cout << "Usage: " << name << " --trace=FILE [--max-speed] [--connect=SPEC] [--agent=NAME] [--passcode=CODE]"
+              << " [--in-process|--loopback [--gwagent-policy-file=FILE] [--apps-policy-dir=DIR]]" << std::endl
+              << "  --loopback runs the agent on a GatewayLoopbackBus without a router. Only the calls to the"
+              << " Connector Apps and their Acls are replayed" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    qcc::String traceFile;
+    qcc::String connectSpec;
+    qcc::String agentName = GW_WELLKNOWN_NAME;
+    qcc::String passcode = "000000";
+    qcc::String policyFile;
+    qcc::String appsPolicyDir;
+    bool maxSpeed = false;
+    bool inProcess = false;
+    bool loopback = false;
+
+    for (int i = 1; i < argc; i++) {
+        qcc::String arg(argv[i]);
+        size_t eq = arg.find('=');
+        qcc::String value = eq == qcc::String::npos ? "" : arg.substr(eq + 1);
+        if (arg.compare(0, 8, "--trace=") == 0) {
+            traceFile = value;
+        } else if (arg == "--max-speed") {
+            maxSpeed = true;
+        } else if (arg.compare(0, 10, "--connect=") == 0) {
+            connectSpec = value;
+        } else if (arg.compare(0, 8, "--agent=") == 0) {
+            agentName = value;
+        } else if (arg.compare(0, 11, "--passcode=") == 0) {
+            passcode = value;
+        } else if (arg == "--in-process") {
+            inProcess = true;
+        } else if (arg == "--loopback") {
+            loopback = true;
+        } else if (arg.compare(0, 22, "--gwagent-policy-file=") == 0) {
+            policyFile = value;
+        } else if (arg.compare(0, 18, "--apps-policy-dir=") == 0) {
+            appsPolicyDir = value;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (traceFile.empty() || (inProcess && loopback)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    GatewayRecordReader reader;
+    QStatus status = reader.open(traceFile);
+    if (status != ER_OK) {
+        std::cout << "could not read the recording " << traceFile.c_str() << ": " << QCC_StatusText(status) << std::endl;
+        return 1;
+    }
+
+    if (AllJoynInit() != ER_OK) {
+        return 1;
+    }
+#ifdef ROUTER
+    if (AllJoynRouterInit() != ER_OK) {
+        AllJoynShutdown();
+        return 1;
+    }
+#endif
+
+    SrpKeyXListener keyListener;
+    keyListener.setPassCode(passcode);
+
+    // in-process the agent runs on its own BusAttachment, so the calls still go through the router
+    BusAttachment* agentBus = NULL;
+    GatewayLoopbackBus* loopbackBus = NULL;
+    GatewayMgmt* gatewayMgmt = NULL;
+    if (inProcess || loopback) {
+        if (inProcess) {
+            agentBus = new BusAttachment("GatewayReplayAgent", true);
+            status = prepareBus(agentBus, connectSpec, &keyListener);
+            if (status == ER_OK) {
+                status = agentBus->RequestName(agentName.c_str(), DBUS_NAME_FLAG_REPLACE_EXISTING | DBUS_NAME_FLAG_DO_NOT_QUEUE);
+            }
+        } else {
+            loopbackBus = new GatewayLoopbackBus();
+        }
+        if (status == ER_OK) {
+            gatewayMgmt = GatewayMgmt::getInstance();
+            if (!policyFile.empty()) {
+                gatewayMgmt->setGatewayPolicyFile(policyFile.c_str());
+            }
+            if (!appsPolicyDir.empty()) {
+                gatewayMgmt->setAppPolicyDir(appsPolicyDir.c_str());
+            }
+            status = agentBus ? gatewayMgmt->initGatewayMgmt(agentBus) : gatewayMgmt->initGatewayMgmt(loopbackBus);
+        }
+        if (status != ER_OK) {
+            std::cout << "could not start the agent: " << QCC_StatusText(status) << std::endl;
+            delete agentBus;
+            delete loopbackBus;
+            AllJoynShutdown();
+            return 1;
+        }
+    }
+
+    // on the loopback the method calls are dispatched in-process instead of through a router
+    BusAttachment* bus = NULL;
+    if (!loopback) {
+        bus = new BusAttachment("GatewayReplay", true);
+        status = prepareBus(bus, connectSpec, &keyListener);
+        if (status != ER_OK) {
+            std::cout << "could not connect to the router: " << QCC_StatusText(status) << std::endl;
+            delete bus;
+            if (gatewayMgmt) {
+                gatewayMgmt->shutdownGatewayMgmt();
+            }
+            delete agentBus;
+            AllJoynShutdown();
+            return 1;
+        }
+    }
+
+    std::cout << "trace=" << traceFile.c_str() << " speed=" << (maxSpeed ? "max" : "1x") << " agent=" << agentName.c_str()
+              << " connect=" << (connectSpec.empty() ? "default" : connectSpec.c_str()) << (inProcess ? " in-process" : "") << (loopback ? " loopback" : "")
+              << std::endl;
+
+    std::map<qcc::String, ProxyBusObject*> proxies;
+    std::map<qcc::String, MethodResults> results;
+    uint32_t numEvents = 0;
+    uint32_t numSkipped = 0;
+    uint32_t numSkippedCalls = 0;
+    uint64_t maxLagUs = 0;
+    uint64_t startUs = GatewayStats::getMonotonicUs();
+
+    GatewayRecordedEvent event;
+    while ((status = reader.next(&event)) == ER_OK) {
+        numEvents++;
+        if (!maxSpeed) {
+            uint64_t dueUs = startUs + event.m_TimestampUs;
+            uint64_t nowUs = GatewayStats::getMonotonicUs();
+            if (dueUs > nowUs) {
+                usleep(dueUs - nowUs);
+            } else {
+                maxLagUs = std::max(maxLagUs, nowUs - dueUs);
+            }
+        }
+
+        if (event.m_Type == GW_RECORD_ANNOUNCEMENT) {
+            // announcements reach the agent from the About listener, which only the in-process agent can be fed
+            if (!gatewayMgmt || event.m_Args.size() != 2) {
+                numSkipped++;
+                continue;
+            }
+            uint64_t callUs = GatewayStats::getMonotonicUs();
+            if (loopbackBus) {
+                loopbackBus->announce(event.m_BusName.c_str(), event.m_Version, event.m_Port, event.m_Args[0], event.m_Args[1]);
+            } else {
+                gatewayMgmt->getRouterPolicyManager()->Announced(event.m_BusName.c_str(), event.m_Version, event.m_Port,
+                                                                 event.m_Args[0], event.m_Args[1]);
+            }
+            results[ANNOUNCEMENT_NAME].m_LatenciesUs.push_back(GatewayStats::getMonotonicUs() - callUs);
+            continue;
+        }
+
+        // the loopback only dispatches the calls to the Connector Apps and their Acls
+        if (loopbackBus && event.m_ObjectPath.compare(0, AJ_GW_OBJECTPATH.size() + 1, AJ_GW_OBJECTPATH + "/") != 0) {
+            numSkippedCalls++;
+            continue;
+        }
+
+        MethodResults& methodResults = results[event.m_Interface + "." + event.m_Member];
+        if (loopbackBus) {
+            GatewayLoopbackReply reply;
+            uint64_t callUs = GatewayStats::getMonotonicUs();
+            status = loopbackBus->callMethod(event.m_ObjectPath, event.m_Interface, event.m_Member, event.m_Args.empty() ? NULL : &event.m_Args[0],
+                                             event.m_Args.size(), &reply);
+            uint64_t latencyUs = GatewayStats::getMonotonicUs() - callUs;
+            if (status != ER_OK) {
+                QCC_DbgHLPrintf(("%s.%s on %s failed: %s", event.m_Interface.c_str(), event.m_Member.c_str(),
+                                 event.m_ObjectPath.c_str(), QCC_StatusText(status)));
+                methodResults.m_NumErrors++;
+                continue;
+            }
+            methodResults.m_LatenciesUs.push_back(latencyUs);
+            continue;
+        }
+
+        ProxyBusObject* proxy = getProxy(bus, agentName, event.m_ObjectPath, &proxies);
+        if (!proxy) {
+            methodResults.m_NumErrors++;
+            continue;
+        }
+
+        Message reply(*bus);
+        uint64_t callUs = GatewayStats::getMonotonicUs();
+        status = proxy->MethodCall(event.m_Interface.c_str(), event.m_Member.c_str(), event.m_Args.empty() ? NULL : &event.m_Args[0],
+                                   event.m_Args.size(), reply, REPLAY_CALL_TIMEOUT_MS);
+        uint64_t latencyUs = GatewayStats::getMonotonicUs() - callUs;
+        if (status != ER_OK) {
+            QCC_DbgHLPrintf(("%s.%s on %s failed: %s", event.m_Interface.c_str(), event.m_Member.c_str(),
+                             event.m_ObjectPath.c_str(), QCC_StatusText(status)));
+            methodResults.m_NumErrors++;
+            continue;
+        }
+        methodResults.m_LatenciesUs.push_back(latencyUs);
+    }
+    uint64_t elapsedUs = GatewayStats::getMonotonicUs() - startUs;
+
+    if (status != ER_EOF) {
+        std::cout << "the recording is corrupt after " << numEvents << " events" << std::endl;
+    }
+
+    std::cout << numEvents << " events in " << elapsedUs / 1000 << "ms, " << numSkipped << " announcements and "
+              << numSkippedCalls << " method calls skipped";
+    if (!maxSpeed) {
+        std::cout << ", max lag " << maxLagUs << "us";
+    }
+    std::cout << std::endl;
+
+    std::map<qcc::String, MethodResults>::iterator it;
+    for (it = results.begin(); it != results.end(); it++) {
+        std::vector<uint64_t>& latenciesUs = it->second.m_LatenciesUs;
+        std::sort(latenciesUs.begin(), latenciesUs.end());
+        std::cout << "  " << it->first.c_str() << ": count=" << latenciesUs.size() << " errors=" << it->second.m_NumErrors
+                  << " p50=" << getPercentile(latenciesUs, 50) << "us p90=" << getPercentile(latenciesUs, 90) << "us p99="
+                  << getPercentile(latenciesUs, 99) << "us max=" << (latenciesUs.empty() ? 0 : latenciesUs.back()) << "us"
+                  << std::endl;
+    }
+
+    std::map<qcc::String, ProxyBusObject*>::iterator pit;
+    for (pit = proxies.begin(); pit != proxies.end(); pit++) {
+        delete pit->second;
+    }
+    delete bus;
+    if (gatewayMgmt) {
+        gatewayMgmt->shutdownGatewayMgmt();
+    }
+    delete agentBus;
+    delete loopbackBus;
+
+    AllJoynShutdown();
+    return status == ER_EOF ? 0 : 1;
+}
@@ -0,0 +1,246 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/Init.h>
+#include <alljoyn/gateway/GatewayAcl.h>
+#include <alljoyn/gateway/GatewayAclSnapshot.h>
+#include <alljoyn/gateway/GatewayConnectorApp.h>
+#include <alljoyn/gateway/GatewayMsgArgArena.h>
+#include <qcc/StringUtil.h>
+#include "busObjects/AclAdapter.h"
+#include "GatewayConstants.h"
+#include "BenchmarkUtil.h"
+#include <iostream>
+#include <time.h>
+
+using namespace ajn;
+using namespace gw;
+using namespace benchUtil;
+using namespace gwConsts;
+
+/**
+ * Marshal objectDescriptions the way AclAdapter did before the arena:
+ * a temporary vector for the interfaces of every object
+ */
+static QStatus marshalObjectDesciptionsLegacy(const GatewayRuleObjectDescriptions& objects, MsgArg* objectsArray, size_t* objectsIndx)
+{
+    QStatus status = ER_OK;
+
+    for (size_t i = 0; i < objects.size(); i++) {
+
+        const GatewayInternedStrings& interfaces = objects[i].getInterfaces();
+        std::vector<const char*> interfacesVector(interfaces.size());
+        GatewayInternedStrings::const_iterator interfaceIt;
+        int interfaceIndex = 0;
+
+        for (interfaceIt = interfaces.begin(); interfaceIt != interfaces.end(); ++interfaceIt) {
+            interfacesVector[interfaceIndex++] = interfaceIt->str().c_str();
+        }
+
+        status = objectsArray[(*objectsIndx)++].Set(AJPARAM_INTERFACE_INFO.c_str(), objects[i].getObjectPath().c_str(),
+                                                    objects[i].getIsPrefix(), interfaceIndex, interfacesVector.data());
+        if (status != ER_OK) {
+            return status;
+        }
+    }
+    return status;
+}
+
+/**
+ * Marshal the merged Acl the way AclAdapter did before the arena:
+ * a separate MsgArg array for every list, owned by its parent MsgArg
+ */
+static QStatus marshalMergedAclLegacy(GatewayAclSet const& aclSet, MsgArg* msgArg)
+{
+    const std::map<qcc::String, GatewayAclSnapshot>& acls = aclSet.getAcls();
+    QStatus status = ER_OK;
+    size_t exposedServicesSize = 0;
+    size_t remotedAppsSize = 0;
+    std::map<qcc::String, GatewayAclSnapshot>::const_iterator it;
+    for (it = acls.begin(); it != acls.end(); it++) {
+        if (it->second.getAclStatus() != GW_AS_ACTIVE) {
+            continue;
+        }
+        exposedServicesSize += it->second.getAclRules().getExposedServicesRules().size();
+        remotedAppsSize += it->second.getAclRules().getRemoteAppRules().size();
+    }
+
+    MsgArg* exposedServicesArray = new MsgArg[exposedServicesSize];
+    size_t exposedServicesIndx = 0;
+    MsgArg* remoteAppPermsArray = new MsgArg[remotedAppsSize];
+    size_t remoteAppPermsIndx = 0;
+
+    for (it = acls.begin(); it != acls.end(); it++) {
+        if (it->second.getAclStatus() != GW_AS_ACTIVE) {
+            continue;
+        }
+
+        status = marshalObjectDesciptionsLegacy(it->second.getAclRules().getExposedServicesRules(), exposedServicesArray, &exposedServicesIndx);
+        if (status != ER_OK) {
+            delete[] exposedServicesArray;
+            delete[] remoteAppPermsArray;
+            return status;
+        }
+
+        const GatewayRemoteAppRules& remoteAppRules = it->second.getAclRules().getRemoteAppRules();
+        GatewayRemoteAppRules::const_iterator iter;
+        for (iter = remoteAppRules.begin(); iter != remoteAppRules.end(); iter++) {
+            MsgArg* remotedObjectsArray = new MsgArg[iter->second.size()];
+            size_t remotedObjectsIndx = 0;
+            status = marshalObjectDesciptionsLegacy(iter->second, remotedObjectsArray, &remotedObjectsIndx);
+            if (status != ER_OK) {
+                delete[] exposedServicesArray;
+                delete[] remoteAppPermsArray;
+                delete[] remotedObjectsArray;
+                return status;
+            }
+
+            status = remoteAppPermsArray[remoteAppPermsIndx].Set(AJPARAM_REMOTED_APPS.c_str(), iter->first.getDeviceId().c_str(),
+                                                                 iter->first.getAppIdHexLength(), iter->first.getAppIdHex(),
+                                                                 remotedObjectsIndx, remotedObjectsArray);
+            if (status != ER_OK) {
+                delete[] exposedServicesArray;
+                delete[] remoteAppPermsArray;
+                delete[] remotedObjectsArray;
+                return status;
+            }
+            remoteAppPermsArray[remoteAppPermsIndx++].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+        }
+    }
+
+    msgArg[0].Set(AJPARAM_INTERFACE_INFO_ARRAY.c_str(), exposedServicesIndx, exposedServicesArray);
+    msgArg[1].Set(AJPARAM_REMOTED_APPS_ARRAY.c_str(), remoteAppPermsIndx, remoteAppPermsArray);
+    msgArg[0].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+    msgArg[1].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+
+    return status;
+}
+
+/**
+ * Get the monotonic time in microseconds
+ * @return time
+ */
+static uint64_t GetMonotonicUs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static void usage(const char* name)
+{
+    std::cout << "Usage: " << name << " [--acls=N] [--objects=N] [--interfaces=N] [--remote-apps=N] [--iterations=N]" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t numAcls = 10;
+    uint32_t numObjects = 20;
+    uint32_t numInterfaces = 5;
+    uint32_t numRemoteApps = 10;
+    uint32_t iterations = 1000;
+
+    for (int i = 1; i < argc; i++) {
+        qcc::String arg(argv[i]);
+        size_t eq = arg.find('=');
+        qcc::String value = eq == qcc::String::npos ? "" : arg.substr(eq + 1);
+        if (arg.compare(0, 7, "--acls=") == 0) {
+            numAcls = qcc::StringToU32(value, 10, numAcls);
+        } else if (arg.compare(0, 10, "--objects=") == 0) {
+            numObjects = qcc::StringToU32(value, 10, numObjects);
+        } else if (arg.compare(0, 13, "--interfaces=") == 0) {
+            numInterfaces = qcc::StringToU32(value, 10, numInterfaces);
+        } else if (arg.compare(0, 14, "--remote-apps=") == 0) {
+            numRemoteApps = qcc::StringToU32(value, 10, numRemoteApps);
+        } else if (arg.compare(0, 13, "--iterations=") == 0) {
+            iterations = qcc::StringToU32(value, 10, iterations);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (AllJoynInit() != ER_OK) {
+        return 1;
+    }
+
+    GatewayConnectorApp connectorApp("bench", GatewayConnectorAppManifest());
+    std::map<qcc::String, GatewayAcl*> acls;
+    for (uint32_t i = 0; i < numAcls; i++) {
+        qcc::String aclId = "acl" + qcc::U32ToString(i);
+
+        GatewayAclRules aclRules;
+        aclRules.setExposedServicesRules(buildObjects("/exposed/" + aclId, numObjects, numInterfaces));
+        GatewayRemoteAppRules remoteAppRules;
+        for (uint32_t j = 0; j < numRemoteApps; j++) {
+            uint8_t appId[16] = { 0 };
+            appId[0] = (uint8_t)i;
+            appId[1] = (uint8_t)j;
+            GatewayAppIdentifier appKey(appId, sizeof(appId), "device" + qcc::U32ToString(j));
+            remoteAppRules.insert(std::pair<GatewayAppIdentifier, GatewayRuleObjectDescriptions>(appKey,
+                                                                                                  buildObjects("/remoted/" + aclId, numObjects, numInterfaces)));
+        }
+        aclRules.setRemoteAppRules(remoteAppRules);
+
+        acls[aclId] = new GatewayAcl(aclId, aclId, &connectorApp, aclRules, std::map<qcc::String, qcc::String>(), GW_AS_ACTIVE);
+    }
+    GatewayRef<GatewayAclSet> aclSet(new GatewayAclSet(1, acls, NULL));
+
+    std::cout << "acls=" << numAcls << " objects=" << numObjects << " interfaces=" << numInterfaces
+              << " remoteApps=" << numRemoteApps << " iterations=" << iterations << std::endl;
+
+    size_t legacyAllocations = getNumAllocations();
+    uint64_t legacyTime = GetMonotonicUs();
+    for (uint32_t i = 0; i < iterations; i++) {
+        MsgArg replyArg[2];
+        if (marshalMergedAclLegacy(*aclSet, replyArg) != ER_OK) {
+            std::cout << "legacy marshaling failed" << std::endl;
+            return 1;
+        }
+    }
+    legacyTime = GetMonotonicUs() - legacyTime;
+    legacyAllocations = getNumAllocations() - legacyAllocations;
+
+    size_t arenaAllocations = getNumAllocations();
+    size_t arenaBlocks = 0;
+    uint64_t arenaTime = GetMonotonicUs();
+    for (uint32_t i = 0; i < iterations; i++) {
+        GatewayMsgArgArena arena;
+        MsgArg replyArg[2];
+        if (AclAdapter::marshalMergedAcl(*aclSet, replyArg, &arena) != ER_OK) {
+            std::cout << "arena marshaling failed" << std::endl;
+            return 1;
+        }
+        arenaBlocks += arena.getNumAllocations();
+    }
+    arenaTime = GetMonotonicUs() - arenaTime;
+    arenaAllocations = getNumAllocations() - arenaAllocations;
+
+    if (iterations) {
+        std::cout << "legacy: " << legacyAllocations / iterations << " allocations/reply, "
+                  << legacyTime / iterations << " us/reply" << std::endl;
+        std::cout << "arena:  " << arenaAllocations / iterations << " allocations/reply ("
+                  << arenaBlocks / iterations << " arena blocks), " << arenaTime / iterations << " us/reply" << std::endl;
+    }
+
+    std::map<qcc::String, GatewayAcl*>::iterator it;
+    for (it = acls.begin(); it != acls.end(); it++) {
+        delete it->second;
+    }
+
+    AllJoynShutdown();
+    return 0;
+}
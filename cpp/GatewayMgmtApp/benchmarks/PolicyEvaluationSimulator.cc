@@ -0,0 +1,664 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/String.h>
+#include <qcc/StringUtil.h>
+#include <libxml/parser.h>
+#include <libxml/tree.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+#include <dirent.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * Message types of the decision model
+ */
+typedef enum {
+    SIM_METHOD_CALL = 1,
+    SIM_METHOD_RETURN = 2,
+    SIM_SIGNAL = 4,
+    SIM_ERROR = 8,
+    SIM_ANY_TYPE = 15
+} SimMessageType;
+
+/**
+ * An allow or deny rule of a busconfig policy. Empty attributes match anything
+ */
+struct PolicyRule {
+    bool m_Allow;
+    int m_Types;
+    qcc::String m_Path;
+    bool m_IsPrefix;
+    qcc::String m_Interface;
+    qcc::String m_Member;
+    qcc::String m_Peer;
+};
+
+/**
+ * The rules that apply to the connections of a user, in evaluation order
+ */
+struct UserRules {
+    std::vector<const PolicyRule*> m_Send;
+    std::vector<const PolicyRule*> m_Receive;
+};
+
+/**
+ * A message of the trace. The users are the users the sending and the receiving
+ * connections run as, empty when only the default policies apply
+ */
+struct SimMessage {
+    SimMessageType m_Type;
+    qcc::String m_Path;
+    qcc::String m_Interface;
+    qcc::String m_Member;
+    qcc::String m_Sender;
+    qcc::String m_Destination;
+    qcc::String m_SenderUser;
+    qcc::String m_DestinationUser;
+};
+
+/**
+ * Outcome of the evaluation of a message
+ */
+struct SimDecision {
+    bool m_Allowed;
+    size_t m_SendScanned;
+    size_t m_ReceiveScanned;
+};
+
+/**
+ * Policies loaded from the busconfig files. Policies apply in the order of
+ * the router: default context, then per user, then mandatory context. Within
+ * them the last matching rule wins
+ */
+struct PolicyModel {
+    std::vector<PolicyRule*> m_Rules;
+    std::vector<const PolicyRule*> m_DefaultSend;
+    std::vector<const PolicyRule*> m_DefaultReceive;
+    std::vector<const PolicyRule*> m_MandatorySend;
+    std::vector<const PolicyRule*> m_MandatoryReceive;
+    std::map<qcc::String, UserRules> m_UserPolicies;
+    std::map<qcc::String, UserRules> m_UserRules;
+    std::vector<std::pair<qcc::String, const PolicyRule*> > m_SendAllows;
+};
+
+/**
+ * Get the monotonic time in nanoseconds
+ * @return time
+ */
+static uint64_t GetMonotonicNs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+/**
+ * Parse a message type
+ * @param type - the type as written in busconfig files and traces
+ * @return types - the types, 0 if the type is unknown
+ */
+static int parseTypes(qcc::String const& type)
+{
+    if (type.empty() || type.compare("*") == 0) {
+        return SIM_ANY_TYPE;
+    } else if (type.compare("method_call") == 0) {
+        return SIM_METHOD_CALL;
+    } else if (type.compare("method_return") == 0) {
+        return SIM_METHOD_RETURN;
+    } else if (type.compare("signal") == 0) {
+        return SIM_SIGNAL;
+    } else if (type.compare("error") == 0) {
+        return SIM_ERROR;
+    }
+    return 0;
+}
+
+/**
+ * Get the name of a message type
+ * @param type - the type
+ * @return name
+ */
+static const char* getTypeName(SimMessageType type)
+{
+    switch (type) {
+    case SIM_METHOD_CALL:
+        return "method_call";
+
+    case SIM_METHOD_RETURN:
+        return "method_return";
+
+    case SIM_SIGNAL:
+        return "signal";
+
+    case SIM_ERROR:
+        return "error";
+
+    default:
+        return "*";
+    }
+}
+
+/**
+ * Parse an allow or deny element. Rules without send or receive attributes,
+ * like the connect rules of the default policy, do not apply to messages
+ * @param node - the element
+ * @param allow - whether this is an allow element
+ * @param isSend - set to whether this is a send rule
+ * @return rule - the rule, NULL if it does not apply to messages
+ */
+static PolicyRule* parseRule(xmlNode* node, bool allow, bool* isSend)
+{
+    PolicyRule* rule = new PolicyRule();
+    rule->m_Allow = allow;
+    rule->m_Types = SIM_ANY_TYPE;
+    rule->m_IsPrefix = false;
+
+    bool isReceive = false;
+    *isSend = false;
+    for (xmlAttr* attr = node->properties; attr != NULL; attr = attr->next) {
+        qcc::String name((const char*)attr->name);
+        qcc::String value(attr->children ? (const char*)attr->children->content : "");
+
+        size_t separator = name.find('_');
+        if (separator == qcc::String::npos) {
+            continue;
+        }
+        qcc::String direction = name.substr(0, separator);
+        qcc::String key = name.substr(separator + 1);
+        if (direction.compare("send") == 0) {
+            *isSend = true;
+        } else if (direction.compare("receive") == 0) {
+            isReceive = true;
+        } else {
+            continue;
+        }
+
+        if (key.compare("type") == 0) {
+            rule->m_Types = parseTypes(value);
+        } else if (key.compare("path") == 0) {
+            rule->m_Path = value;
+        } else if (key.compare("path_prefix") == 0) {
+            rule->m_Path = value;
+            rule->m_IsPrefix = true;
+        } else if (key.compare("interface") == 0) {
+            rule->m_Interface = value.compare("*") == 0 ? "" : value;
+        } else if (key.compare("member") == 0) {
+            rule->m_Member = value.compare("*") == 0 ? "" : value;
+        } else if (key.compare("destination") == 0 || key.compare("sender") == 0) {
+            rule->m_Peer = value.compare("*") == 0 ? "" : value;
+        }
+    }
+
+    if (*isSend == isReceive) {
+        delete rule;
+        return NULL;
+    }
+    return rule;
+}
+
+/**
+ * Load the policies of a busconfig file into the model
+ * @param fileName - the file
+ * @param model - the model
+ * @param includeDirs - the includedir elements of the file, appended to
+ * @return true if the file was loaded
+ */
+static bool loadPolicyFile(qcc::String const& fileName, PolicyModel* model, std::vector<qcc::String>* includeDirs)
+{
+    xmlDocPtr doc = xmlReadFile(fileName.c_str(), NULL, XML_PARSE_NOERROR | XML_PARSE_NOBLANKS);
+    if (doc == NULL) {
+        std::cout << "could not parse " << fileName.c_str() << std::endl;
+        return false;
+    }
+
+    xmlNode* root = xmlDocGetRootElement(doc);
+    for (xmlNode* node = root ? root->children : NULL; node != NULL; node = node->next) {
+        if (node->type != XML_ELEMENT_NODE) {
+            continue;
+        }
+
+        if (xmlStrEqual(node->name, (const xmlChar*)"includedir")) {
+            if (node->children && node->children->content) {
+                includeDirs->push_back((const char*)node->children->content);
+            }
+            continue;
+        }
+
+        if (!xmlStrEqual(node->name, (const xmlChar*)"policy")) {
+            continue;
+        }
+
+        std::vector<const PolicyRule*>* send = NULL;
+        std::vector<const PolicyRule*>* receive = NULL;
+        qcc::String user;
+        xmlChar* context = xmlGetProp(node, (const xmlChar*)"context");
+        xmlChar* userProp = xmlGetProp(node, (const xmlChar*)"user");
+        if (context && xmlStrEqual(context, (const xmlChar*)"default")) {
+            send = &model->m_DefaultSend;
+            receive = &model->m_DefaultReceive;
+        } else if (context && xmlStrEqual(context, (const xmlChar*)"mandatory")) {
+            send = &model->m_MandatorySend;
+            receive = &model->m_MandatoryReceive;
+        } else if (userProp) {
+            user = (const char*)userProp;
+            send = &model->m_UserPolicies[user].m_Send;
+            receive = &model->m_UserPolicies[user].m_Receive;
+        }
+        xmlFree(context);
+        xmlFree(userProp);
+        if (!send) {
+            continue;
+        }
+
+        for (xmlNode* ruleNode = node->children; ruleNode != NULL; ruleNode = ruleNode->next) {
+            if (ruleNode->type != XML_ELEMENT_NODE) {
+                continue;
+            }
+            bool allow = xmlStrEqual(ruleNode->name, (const xmlChar*)"allow");
+            if (!allow && !xmlStrEqual(ruleNode->name, (const xmlChar*)"deny")) {
+                continue;
+            }
+
+            bool isSend;
+            PolicyRule* rule = parseRule(ruleNode, allow, &isSend);
+            if (!rule) {
+                continue;
+            }
+            model->m_Rules.push_back(rule);
+            (isSend ? send : receive)->push_back(rule);
+            if (isSend && allow && !user.empty()) {
+                model->m_SendAllows.push_back(std::pair<qcc::String, const PolicyRule*>(user, rule));
+            }
+        }
+    }
+
+    xmlFreeDoc(doc);
+    return true;
+}
+
+/**
+ * Load the gateway policy file and the app policy files it includes
+ * @param fileName - the gateway policy file
+ * @param includeDir - the app policy directory, overrides the includedir of the file if not empty
+ * @param model - the model to fill
+ * @return true if the files were loaded
+ */
+static bool loadPolicies(qcc::String const& fileName, qcc::String const& includeDir, PolicyModel* model)
+{
+    std::vector<qcc::String> includeDirs;
+    if (!loadPolicyFile(fileName, model, &includeDirs)) {
+        return false;
+    }
+    if (!includeDir.empty()) {
+        includeDirs.assign(1, includeDir);
+    }
+
+    for (size_t i = 0; i < includeDirs.size(); i++) {
+        DIR* dir;
+        struct dirent* entry;
+        if ((dir = opendir(includeDirs[i].c_str())) == NULL) {
+            std::cout << "could not open " << includeDirs[i].c_str() << std::endl;
+            continue;
+        }
+
+        // the router reads an include directory in name order
+        std::vector<qcc::String> fileNames;
+        while ((entry = readdir(dir)) != NULL) {
+            qcc::String name(entry->d_name);
+            if (name.size() > 4 && name.compare(name.size() - 4, 4, ".xml") == 0) {
+                fileNames.push_back(name);
+            }
+        }
+        closedir(dir);
+        std::sort(fileNames.begin(), fileNames.end());
+
+        // the app policy files do not include further directories
+        std::vector<qcc::String> nestedDirs;
+        for (size_t j = 0; j < fileNames.size(); j++) {
+            loadPolicyFile(includeDirs[i] + "/" + fileNames[j], model, &nestedDirs);
+        }
+    }
+
+    // flatten the rules every user is checked against, in the order they apply
+    std::map<qcc::String, UserRules>::iterator it;
+    for (it = model->m_UserPolicies.begin(); it != model->m_UserPolicies.end(); it++) {
+        UserRules& rules = model->m_UserRules[it->first];
+        rules.m_Send = model->m_DefaultSend;
+        rules.m_Send.insert(rules.m_Send.end(), it->second.m_Send.begin(), it->second.m_Send.end());
+        rules.m_Send.insert(rules.m_Send.end(), model->m_MandatorySend.begin(), model->m_MandatorySend.end());
+        rules.m_Receive = model->m_DefaultReceive;
+        rules.m_Receive.insert(rules.m_Receive.end(), it->second.m_Receive.begin(), it->second.m_Receive.end());
+        rules.m_Receive.insert(rules.m_Receive.end(), model->m_MandatoryReceive.begin(), model->m_MandatoryReceive.end());
+    }
+    UserRules& defaultRules = model->m_UserRules[""];
+    defaultRules.m_Send = model->m_DefaultSend;
+    defaultRules.m_Send.insert(defaultRules.m_Send.end(), model->m_MandatorySend.begin(), model->m_MandatorySend.end());
+    defaultRules.m_Receive = model->m_DefaultReceive;
+    defaultRules.m_Receive.insert(defaultRules.m_Receive.end(), model->m_MandatoryReceive.begin(), model->m_MandatoryReceive.end());
+    return true;
+}
+
+/**
+ * Check whether a rule matches a message
+ * @param rule - the rule
+ * @param message - the message
+ * @param peer - the destination of a send rule or the sender of a receive rule
+ * @return true/false
+ */
+static bool matches(const PolicyRule* rule, SimMessage const& message, qcc::String const& peer)
+{
+    if (!(rule->m_Types & message.m_Type)) {
+        return false;
+    }
+    if (!rule->m_Path.empty()) {
+        if (rule->m_IsPrefix) {
+            if (message.m_Path.compare(0, rule->m_Path.size(), rule->m_Path) != 0) {
+                return false;
+            }
+        } else if (message.m_Path != rule->m_Path) {
+            return false;
+        }
+    }
+    if (!rule->m_Interface.empty() && message.m_Interface != rule->m_Interface) {
+        return false;
+    }
+    if (!rule->m_Member.empty() && message.m_Member != rule->m_Member) {
+        return false;
+    }
+    if (!rule->m_Peer.empty() && peer != rule->m_Peer) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Evaluate rules against a message. The last matching rule wins, so the
+ * rules are scanned from the end and the scan stops at the first match
+ * @param rules - the rules in the order they apply
+ * @param message - the message
+ * @param peer - the destination of send rules or the sender of receive rules
+ * @param scanned - the number of rules scanned
+ * @return true if the message is allowed. Messages no rule matches are allowed
+ */
+static bool evaluateRules(std::vector<const PolicyRule*> const& rules, SimMessage const& message, qcc::String const& peer, size_t* scanned)
+{
+    for (size_t i = rules.size(); i > 0; i--) {
+        if (matches(rules[i - 1], message, peer)) {
+            *scanned = rules.size() - i + 1;
+            return rules[i - 1]->m_Allow;
+        }
+    }
+    *scanned = rules.size();
+    return true;
+}
+
+/**
+ * Get the rules of a user
+ * @param model - the model
+ * @param user - the user
+ * @return rules - the rules, the default ones if the user has no policy
+ */
+static const UserRules& getUserRules(PolicyModel const& model, qcc::String const& user)
+{
+    std::map<qcc::String, UserRules>::const_iterator it = model.m_UserRules.find(user);
+    if (it == model.m_UserRules.end()) {
+        it = model.m_UserRules.find("");
+    }
+    return it->second;
+}
+
+/**
+ * Evaluate a message against the policies of its sender and its receiver
+ * @param model - the model
+ * @param message - the message
+ * @param decision - the decision
+ */
+static void evaluate(PolicyModel const& model, SimMessage const& message, SimDecision* decision)
+{
+    decision->m_ReceiveScanned = 0;
+    decision->m_Allowed = evaluateRules(getUserRules(model, message.m_SenderUser).m_Send, message, message.m_Destination,
+                                        &decision->m_SendScanned);
+    if (decision->m_Allowed) {
+        decision->m_Allowed = evaluateRules(getUserRules(model, message.m_DestinationUser).m_Receive, message, message.m_Sender,
+                                            &decision->m_ReceiveScanned);
+    }
+}
+
+/**
+ * Load a recorded trace. Every line holds the fields of a message as
+ * key=value pairs: type, path, interface, member, sender, destination,
+ * sender_user and destination_user. Lines starting with # are skipped
+ * @param fileName - the trace file
+ * @param messages - the messages, appended to
+ * @return true if the trace was loaded
+ */
+static bool loadTrace(qcc::String const& fileName, std::vector<SimMessage>* messages)
+{
+    std::ifstream ifs(fileName.c_str());
+    if (!ifs.is_open()) {
+        std::cout << "could not open " << fileName.c_str() << std::endl;
+        return false;
+    }
+
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(ifs, line)) {
+        lineNumber++;
+        qcc::String fields(line.c_str());
+        if (fields.empty() || fields[0] == '#') {
+            continue;
+        }
+
+        SimMessage message;
+        message.m_Type = SIM_METHOD_CALL;
+        size_t pos = 0;
+        while (pos < fields.size()) {
+            size_t end = fields.find_first_of(" \t", pos);
+            if (end == qcc::String::npos) {
+                end = fields.size();
+            }
+            qcc::String field = fields.substr(pos, end - pos);
+            pos = end + 1;
+
+            size_t eq = field.find('=');
+            if (eq == qcc::String::npos) {
+                continue;
+            }
+            qcc::String key = field.substr(0, eq);
+            qcc::String value = field.substr(eq + 1);
+            if (key.compare("type") == 0) {
+                int type = parseTypes(value);
+                if (!type || type == SIM_ANY_TYPE) {
+                    std::cout << "unknown type " << value.c_str() << " in line " << lineNumber << std::endl;
+                    return false;
+                }
+                message.m_Type = (SimMessageType)type;
+            } else if (key.compare("path") == 0) {
+                message.m_Path = value;
+            } else if (key.compare("interface") == 0) {
+                message.m_Interface = value;
+            } else if (key.compare("member") == 0) {
+                message.m_Member = value;
+            } else if (key.compare("sender") == 0) {
+                message.m_Sender = value;
+            } else if (key.compare("destination") == 0) {
+                message.m_Destination = value;
+            } else if (key.compare("sender_user") == 0) {
+                message.m_SenderUser = value;
+            } else if (key.compare("destination_user") == 0) {
+                message.m_DestinationUser = value;
+            }
+        }
+        messages->push_back(message);
+    }
+    return true;
+}
+
+/**
+ * Build a synthetic trace from the send rules the users are allowed. Every
+ * message is sent by the user of a random allow rule and matches it, unless
+ * it is made to miss
+ * @param model - the model
+ * @param numMessages - number of messages
+ * @param missPct - percentage of messages changed to miss their rule
+ * @param seed - seed of the random generator
+ * @param messages - the messages, appended to
+ */
+static void buildSyntheticTrace(PolicyModel const& model, uint32_t numMessages, uint32_t missPct, uint32_t seed,
+                                std::vector<SimMessage>* messages)
+{
+    if (model.m_SendAllows.empty()) {
+        return;
+    }
+
+    unsigned int randState = seed;
+    for (uint32_t i = 0; i < numMessages; i++) {
+        const std::pair<qcc::String, const PolicyRule*>& allow = model.m_SendAllows[rand_r(&randState) % model.m_SendAllows.size()];
+        const PolicyRule* rule = allow.second;
+
+        SimMessage message;
+        message.m_Type = SIM_METHOD_CALL;
+        for (int type = SIM_METHOD_CALL; type <= SIM_ERROR; type <<= 1) {
+            if (rule->m_Types & type) {
+                message.m_Type = (SimMessageType)type;
+                break;
+            }
+        }
+        message.m_Path = rule->m_Path.empty() ? "/sim" : rule->m_Path;
+        if (rule->m_IsPrefix) {
+            message.m_Path += "/child";
+        }
+        message.m_Interface = rule->m_Interface.empty() ? "org.alljoyn.sim.Any" : rule->m_Interface;
+        message.m_Member = rule->m_Member.empty() ? "Call" : rule->m_Member;
+        message.m_Sender = ":sim.1";
+        message.m_Destination = rule->m_Peer.empty() ? ":sim.2" : rule->m_Peer;
+        message.m_SenderUser = allow.first;
+
+        if ((uint32_t)(rand_r(&randState) % 100) < missPct) {
+            message.m_Interface = "org.alljoyn.sim.Unknown";
+        }
+        messages->push_back(message);
+    }
+}
+
+static void usage(const char* name)
+{
+    std::cout << "Usage: " << name << " [--policy-file=FILE] [--include-dir=DIR] [--trace=FILE | --synthetic=N]"
+              << " [--miss=PCT] [--seed=N] [--repeat=N] [--quiet]" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    qcc::String policyFile = "/opt/alljoyn/alljoyn-daemon.d/gwagent-config.xml";
+    qcc::String includeDir;
+    qcc::String traceFile;
+    uint32_t numSynthetic = 10000;
+    uint32_t missPct = 20;
+    uint32_t seed = 1;
+    uint32_t repeat = 100;
+    bool quiet = false;
+
+    for (int i = 1; i < argc; i++) {
+        qcc::String arg(argv[i]);
+        size_t eq = arg.find('=');
+        qcc::String value = eq == qcc::String::npos ? "" : arg.substr(eq + 1);
+        if (arg.compare(0, 14, "--policy-file=") == 0) {
+            policyFile = value;
+        } else if (arg.compare(0, 14, "--include-dir=") == 0) {
+            includeDir = value;
+        } else if (arg.compare(0, 8, "--trace=") == 0) {
+            traceFile = value;
+        } else if (arg.compare(0, 12, "--synthetic=") == 0) {
+            numSynthetic = qcc::StringToU32(value, 10, numSynthetic);
+        } else if (arg.compare(0, 7, "--miss=") == 0) {
+            missPct = qcc::StringToU32(value, 10, missPct);
+        } else if (arg.compare(0, 7, "--seed=") == 0) {
+            seed = qcc::StringToU32(value, 10, seed);
+        } else if (arg.compare(0, 9, "--repeat=") == 0) {
+            repeat = qcc::StringToU32(value, 10, repeat);
+        } else if (arg.compare("--quiet") == 0) {
+            quiet = true;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!repeat) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    PolicyModel model;
+    if (!loadPolicies(policyFile, includeDir, &model)) {
+        return 1;
+    }
+
+    std::vector<SimMessage> messages;
+    if (!traceFile.empty()) {
+        if (!loadTrace(traceFile, &messages)) {
+            return 1;
+        }
+    } else {
+        buildSyntheticTrace(model, numSynthetic, missPct, seed, &messages);
+    }
+
+    std::cout << "rules=" << model.m_Rules.size() << " users=" << model.m_UserPolicies.size() << " messages=" << messages.size()
+              << " repeat=" << repeat << std::endl;
+
+    // every message is evaluated repeat times, the clock is too coarse for a single evaluation
+    size_t numAllowed = 0;
+    uint64_t totalScanned = 0;
+    uint64_t totalNs = 0;
+    std::vector<uint64_t> evaluationNs;
+    for (size_t i = 0; i < messages.size(); i++) {
+        SimDecision decision;
+        uint64_t startNs = GetMonotonicNs();
+        for (uint32_t j = 0; j < repeat; j++) {
+            evaluate(model, messages[i], &decision);
+        }
+        uint64_t ns = (GetMonotonicNs() - startNs) / repeat;
+
+        numAllowed += decision.m_Allowed ? 1 : 0;
+        totalScanned += decision.m_SendScanned + decision.m_ReceiveScanned;
+        totalNs += ns;
+        evaluationNs.push_back(ns);
+
+        if (!quiet) {
+            std::cout << i << " " << (decision.m_Allowed ? "allow" : "deny") << " " << getTypeName(messages[i].m_Type)
+                      << " " << (messages[i].m_SenderUser.empty() ? "-" : messages[i].m_SenderUser.c_str()) << " " << messages[i].m_Path.c_str()
+                      << " " << messages[i].m_Interface.c_str() << " scanned=" << decision.m_SendScanned << "+"
+                      << decision.m_ReceiveScanned << " ns=" << ns << std::endl;
+        }
+    }
+
+    if (!messages.empty()) {
+        std::sort(evaluationNs.begin(), evaluationNs.end());
+        std::cout << "allowed=" << numAllowed << " denied=" << messages.size() - numAllowed
+                  << " rulesScanned/msg=" << totalScanned / messages.size() << " ns/msg=" << totalNs / messages.size()
+                  << " p99=" << evaluationNs[messages.size() * 99 / 100] << "ns max=" << evaluationNs.back() << "ns" << std::endl;
+    }
+
+    for (size_t i = 0; i < model.m_Rules.size(); i++) {
+        delete model.m_Rules[i];
+    }
+    return 0;
+}
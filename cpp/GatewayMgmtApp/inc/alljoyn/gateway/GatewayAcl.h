@@ -18,6 +18,7 @@
 #define GATEWAYACL_H_
 
 #include <alljoyn/gateway/GatewayAclRules.h>
+#include <alljoyn/gateway/GatewayBus.h>
 #include <alljoyn/gateway/GatewayEnums.h>
 #include <libxml/tree.h>
 #include <libxml/xmlwriter.h>
@@ -61,7 +62,7 @@ class GatewayAcl {
     virtual ~GatewayAcl();
 
     /**
-     * Load the values of this Acl from a file
+     * Load the values of this Acl from a file, followed by its patch file
      * @param fileName - file used to parse
      * @return status - success/failure
      */
@@ -78,14 +79,14 @@ class GatewayAcl {
      * @param bus - bus used to register
      * @return status - success/failure
      */
-    QStatus init(BusAttachment* bus);
+    QStatus init(GatewayBus* bus);
 
     /**
      * Shutdown this Acl
      * @param bus - bus used to register
      * @return status - success/failure
      */
-    QStatus shutdown(BusAttachment* bus);
+    QStatus shutdown(GatewayBus* bus);
 
     /**
      * Get the rules of the Acl
@@ -123,6 +124,18 @@ class GatewayAcl {
      */
     const std::map<qcc::String, qcc::String>& getCustomMetadata() const;
 
+    /**
+     * Get the Connector App of the Acl
+     * @return connectorApp
+     */
+    GatewayConnectorApp* getConnectorApp() const;
+
+    /**
+     * Get the BusObject of the Acl
+     * @return busObject
+     */
+    AclBusObject* getAclBusObject() const;
+
     /**
      * Update the Acl
      * @param aclName - name of Acl
@@ -134,6 +147,15 @@ class GatewayAcl {
     AclResponseCode updateAcl(qcc::String const& aclName, GatewayAclRules const& aclRules, std::map<qcc::String, qcc::String> const& metadata,
                               std::map<qcc::String, qcc::String> const& customMetadata);
 
+    /**
+     * Patch the rules of the Acl. Only the patch is appended to the patch file
+     * of the Acl; the Acl file is rewritten once enough patches accumulated
+     * @param patch - the patch to apply
+     * @param metadata - metadata to update to
+     * @return status - success/failure
+     */
+    AclResponseCode patchAcl(GatewayAclRulesPatch const& patch, std::map<qcc::String, qcc::String> const& metadata);
+
     /**
      * Update the metadata of the Acl
      * @param metadata - metadata to update to
@@ -155,6 +177,27 @@ class GatewayAcl {
      */
     AclResponseCode updateAclStatus(AclStatus aclStatus);
 
+    /**
+     * Set and persist the name, rules and customMetadata of the Acl without
+     * publishing a snapshot, updating the policies or notifying the app.
+     * The changes are rolled back if they can not be persisted
+     * @param aclName - name of Acl
+     * @param aclRules - rules to update to
+     * @param customMetadata - customMetadata to update to
+     * @return status - success/failure
+     */
+    AclResponseCode persistAcl(qcc::String const& aclName, GatewayAclRules const& aclRules,
+                               std::map<qcc::String, qcc::String> const& customMetadata);
+
+    /**
+     * Set and persist the AclStatus of the Acl without publishing a snapshot,
+     * updating the policies or notifying the app.
+     * The change is rolled back if it can not be persisted
+     * @param aclStatus - status to update to
+     * @return status - success/failure
+     */
+    AclResponseCode persistAclStatus(AclStatus aclStatus);
+
   private:
 
     /**
@@ -192,6 +235,17 @@ class GatewayAcl {
      */
     AclBusObject* m_AclBusObject;
 
+    /**
+     * Sequence number of the last patch applied to the Acl. The Acl file records
+     * the sequence number it includes, so older patches in the patch file are skipped
+     */
+    uint32_t m_PatchSequence;
+
+    /**
+     * Number of patches in the patch file that are not included in the Acl file
+     */
+    uint32_t m_NumPendingPatches;
+
     /**
      * The Connector App that contains this Acl
      */
@@ -218,6 +272,27 @@ class GatewayAcl {
      */
     void parseRemotedApp(xmlNode* currentKey, GatewayRemoteAppRules& remoteAppRules);
 
+    /**
+     * Get the name of the file the patches of this Acl are appended to
+     * @return fileName
+     */
+    qcc::String getPatchFileName() const;
+
+    /**
+     * Append a patch to the patch file and sync it to disk
+     * @param patch - the patch to append
+     * @param sequence - the sequence number of the patch
+     * @return status - success/failure
+     */
+    QStatus appendPatchToFile(GatewayAclRulesPatch const& patch, uint32_t sequence);
+
+    /**
+     * Apply the patches of the patch file that are newer than the Acl file.
+     * A partial patch at the end of the file is cut off the file
+     * @return status - success/failure
+     */
+    QStatus loadPatchesFromFile();
+
     /**
      * Helper function to write Objects to a file
      * @param writer - the writer to use
@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef GATEWAYACLBATCHOPERATION_H_
+#define GATEWAYACLBATCHOPERATION_H_
+
+#include <map>
+#include <vector>
+#include <qcc/String.h>
+#include <alljoyn/gateway/GatewayAclRules.h>
+#include <alljoyn/gateway/GatewayEnums.h>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * One operation of a BatchUpdate call, together with its result
+ */
+struct GatewayAclBatchOperation {
+
+    /**
+     * Constructor for GatewayAclBatchOperation
+     */
+    GatewayAclBatchOperation() : m_Type(GW_BO_CREATE_ACL), m_ResponseCode(GW_ACL_RC_INVALID) { }
+
+    /**
+     * The type of the operation
+     */
+    AclBatchOperationType m_Type;
+
+    /**
+     * The connectorId of the App owning the Acl
+     */
+    qcc::String m_ConnectorId;
+
+    /**
+     * The aclId the operation applies to. Set by the operation for created Acls
+     */
+    qcc::String m_AclId;
+
+    /**
+     * The aclName - used by create and update operations only
+     */
+    qcc::String m_AclName;
+
+    /**
+     * The aclRules - used by create and update operations only
+     */
+    GatewayAclRules m_AclRules;
+
+    /**
+     * The metadata - used by create and update operations only
+     */
+    std::map<qcc::String, qcc::String> m_Metadata;
+
+    /**
+     * The customMetadata - used by create and update operations only
+     */
+    std::map<qcc::String, qcc::String> m_CustomMetadata;
+
+    /**
+     * The result of the operation
+     */
+    AclResponseCode m_ResponseCode;
+};
+
+/**
+ * The Acls an Acl batch changed in one App, as they were before the batch,
+ * so the App can be restored when a later part of the batch fails
+ */
+struct GatewayAclBatchUndo {
+
+    /**
+     * One Acl as it was before the batch changed it
+     */
+    struct AclState {
+
+        /**
+         * Constructor for AclState
+         */
+        AclState() : m_Created(false), m_AclStatus(GW_AS_INACTIVE) { }
+
+        /**
+         * The aclId of the Acl
+         */
+        qcc::String m_AclId;
+
+        /**
+         * The Acl was created by the batch - it is removed on rollback
+         */
+        bool m_Created;
+
+        /**
+         * The aclName before the batch
+         */
+        qcc::String m_AclName;
+
+        /**
+         * The aclRules before the batch
+         */
+        GatewayAclRules m_AclRules;
+
+        /**
+         * The customMetadata before the batch
+         */
+        std::map<qcc::String, qcc::String> m_CustomMetadata;
+
+        /**
+         * The aclStatus before the batch
+         */
+        AclStatus m_AclStatus;
+    };
+
+    /**
+     * Constructor for GatewayAclBatchUndo
+     */
+    GatewayAclBatchUndo() : m_ActiveRulesChanged(false) { }
+
+    /**
+     * The changed Acls in the order they were changed
+     */
+    std::vector<AclState> m_AclStates;
+
+    /**
+     * The batch changed the rules of the active Acls of the App
+     */
+    bool m_ActiveRulesChanged;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYACLBATCHOPERATION_H_ */
@@ -17,18 +17,61 @@
 #ifndef GatewayAclRules_H_
 #define GatewayAclRules_H_
 
+#include <qcc/STLContainer.h>
 #include <alljoyn/gateway/GatewayMgmt.h>
 #include <alljoyn/gateway/GatewayAppIdentifier.h>
+#include <alljoyn/gateway/GatewayRef.h>
 #include <alljoyn/gateway/GatewayRuleObjectDescription.h>
 
 namespace ajn {
 namespace gw {
 
 typedef std::vector<GatewayRuleObjectDescription> GatewayRuleObjectDescriptions;
-typedef std::map<GatewayAppIdentifier, std::vector<GatewayRuleObjectDescription> > GatewayRemoteAppRules;
+typedef std::unordered_map<GatewayAppIdentifier, std::vector<GatewayRuleObjectDescription>, GatewayAppIdentifierHash> GatewayRemoteAppRules;
 
 /**
- * Class used to define AclRules
+ * Change to the rules of an Acl. Removals are applied before additions, so
+ * an object can be narrowed by removing it and adding it back.
+ * An object description without interfaces covers all interfaces of its path,
+ * a remote app without object descriptions covers all of its objects
+ */
+struct GatewayAclRulesPatch {
+
+    /**
+     * Object descriptions or interfaces added to the exposed services
+     */
+    GatewayRuleObjectDescriptions m_AddedExposedServices;
+
+    /**
+     * Object descriptions or interfaces removed from the exposed services
+     */
+    GatewayRuleObjectDescriptions m_RemovedExposedServices;
+
+    /**
+     * Remote apps, object descriptions or interfaces added to the remoted apps
+     */
+    GatewayRemoteAppRules m_AddedRemoteApps;
+
+    /**
+     * Remote apps, object descriptions or interfaces removed from the remoted apps
+     */
+    GatewayRemoteAppRules m_RemovedRemoteApps;
+
+    /**
+     * Check whether the patch changes anything
+     * @return true if the patch has no additions and no removals
+     */
+    bool empty() const
+    {
+        return m_AddedExposedServices.empty() && m_RemovedExposedServices.empty() &&
+               m_AddedRemoteApps.empty() && m_RemovedRemoteApps.empty();
+    }
+};
+
+/**
+ * Class used to define AclRules. The exposed services and the remote app
+ * rules are immutable and reference counted, so copies of the rules share
+ * them. Changing the rules replaces only the part that changed
  */
 class GatewayAclRules {
 
@@ -68,17 +111,106 @@ class GatewayAclRules {
      */
     void setRemoteAppRules(const GatewayRemoteAppRules& remoteAppRules);
 
+    /**
+     * Apply a patch to the rules in place
+     * @param patch - the patch to apply
+     */
+    void applyPatch(const GatewayAclRulesPatch& patch);
+
+    /**
+     * Merge the rules of another Acl into these rules. Objects and remote apps
+     * that are in both are merged into one entry
+     * @param rules - the rules to merge in
+     */
+    void mergeRules(const GatewayAclRules& rules);
+
+    /**
+     * Get the patch that turns these rules into the target rules
+     * @param target - the rules the patch should lead to
+     * @param patch - the patch, filled in
+     */
+    void getPatchTo(const GatewayAclRules& target, GatewayAclRulesPatch* patch) const;
+
   private:
 
     /**
-     * Exposed Services Rules
+     * Add remote apps, object descriptions or interfaces to remote app rules
+     * @param remoteApps - the rules to add to
+     * @param added - the remote apps to add
+     */
+    static void addRemoteApps(GatewayRemoteAppRules& remoteApps, const GatewayRemoteAppRules& added);
+
+    /**
+     * Add object descriptions or interfaces to a list of object descriptions.
+     * Adding an object description without interfaces widens it to all interfaces
+     * @param objects - the list to add to
+     * @param added - the object descriptions to add
+     */
+    static void addObjects(GatewayRuleObjectDescriptions& objects, const GatewayRuleObjectDescriptions& added);
+
+    /**
+     * Remove object descriptions or interfaces from a list of object descriptions.
+     * Removing an object description without interfaces, or its last interface, removes it
+     * @param objects - the list to remove from
+     * @param removed - the object descriptions to remove
+     */
+    static void removeObjects(GatewayRuleObjectDescriptions& objects, const GatewayRuleObjectDescriptions& removed);
+
+    /**
+     * Get the removals and additions that turn one list of object descriptions into another
+     * @param from - the list to start with
+     * @param to - the list to end with
+     * @param removed - the object descriptions or interfaces to remove, appended to
+     * @param added - the object descriptions or interfaces to add, appended to
+     */
+    static void diffObjects(const GatewayRuleObjectDescriptions& from, const GatewayRuleObjectDescriptions& to,
+                            GatewayRuleObjectDescriptions* removed, GatewayRuleObjectDescriptions* added);
+
+    /**
+     * Immutable, shared list of object descriptions
+     */
+    class SharedObjects : public GatewayRefCounted {
+      public:
+
+        /**
+         * Constructor for SharedObjects
+         * @param objects - the object descriptions to hold
+         */
+        SharedObjects(const GatewayRuleObjectDescriptions& objects) : m_Objects(objects) { }
+
+        /**
+         * The object descriptions
+         */
+        GatewayRuleObjectDescriptions m_Objects;
+    };
+
+    /**
+     * Immutable, shared remote app rules
+     */
+    class SharedRemoteApps : public GatewayRefCounted {
+      public:
+
+        /**
+         * Constructor for SharedRemoteApps
+         * @param remoteApps - the remote app rules to hold
+         */
+        SharedRemoteApps(const GatewayRemoteAppRules& remoteApps) : m_RemoteApps(remoteApps) { }
+
+        /**
+         * The remote app rules
+         */
+        GatewayRemoteAppRules m_RemoteApps;
+    };
+
+    /**
+     * Exposed Services Rules. NULL when there are none
      */
-    GatewayRuleObjectDescriptions m_ExposedServicesRules;
+    GatewayRef<SharedObjects> m_ExposedServicesRules;
 
     /**
-     * RemoteAppRules
+     * RemoteAppRules. NULL when there are none
      */
-    GatewayRemoteAppRules m_RemoteAppRules;
+    GatewayRef<SharedRemoteApps> m_RemoteAppRules;
 
 };
 
@@ -0,0 +1,250 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef GATEWAYACLSNAPSHOT_H_
+#define GATEWAYACLSNAPSHOT_H_
+
+#include <map>
+#include <qcc/String.h>
+#include <alljoyn/MsgArg.h>
+#include <alljoyn/gateway/GatewayAclRules.h>
+#include <alljoyn/gateway/GatewayEnums.h>
+#include <alljoyn/gateway/GatewayMsgArgArena.h>
+#include <alljoyn/gateway/GatewayRef.h>
+
+namespace ajn {
+namespace gw {
+
+//forward declaration
+class GatewayAcl;
+
+/**
+ * Immutable copy of the state of an Acl at the time a GatewayAclSet was published
+ */
+class GatewayAclSnapshot {
+  public:
+
+    /**
+     * Constructor for GatewayAclSnapshot
+     * @param acl - the acl to copy
+     */
+    GatewayAclSnapshot(GatewayAcl const& acl);
+
+    /**
+     * Get the AclId
+     * @return aclId
+     */
+    const qcc::String& getAclId() const;
+
+    /**
+     * Get the AclName
+     * @return aclName
+     */
+    const qcc::String& getAclName() const;
+
+    /**
+     * Get the AclStatus
+     * @return aclStatus
+     */
+    AclStatus getAclStatus() const;
+
+    /**
+     * Get the ObjectPath of the Acl
+     * @return objectPath
+     */
+    const qcc::String& getObjectPath() const;
+
+    /**
+     * Get the AclRules
+     * @return aclRules
+     */
+    const GatewayAclRules& getAclRules() const;
+
+    /**
+     * Get the Custom Metadata
+     * @return customMetadata
+     */
+    const std::map<qcc::String, qcc::String>& getCustomMetadata() const;
+
+  private:
+
+    /**
+     * The AclId
+     */
+    qcc::String m_AclId;
+
+    /**
+     * The AclName
+     */
+    qcc::String m_AclName;
+
+    /**
+     * The ObjectPath of the Acl
+     */
+    qcc::String m_ObjectPath;
+
+    /**
+     * The AclRules
+     */
+    GatewayAclRules m_AclRules;
+
+    /**
+     * The AclStatus
+     */
+    AclStatus m_AclStatus;
+
+    /**
+     * The Custom Metadata
+     */
+    std::map<qcc::String, qcc::String> m_CustomMetadata;
+};
+
+/**
+ * Immutable, versioned set of the Acls of a Connector App. A new set is
+ * published by the App every time one of its Acls changes, so readers can
+ * hold on to a set without locking while the App keeps changing.
+ * The set also holds the merged rules of its active Acls and their marshaled
+ * form, so GetMergedAcl replies are built once per version. The merge sequence
+ * only moves when the merged rules change, and the set keeps the delta from
+ * the merged rules of the set it replaced for the MergedAclUpdated signal
+ */
+class GatewayAclSet : public GatewayRefCounted {
+  public:
+
+    /**
+     * Constructor for GatewayAclSet
+     * @param version - version of the set
+     * @param acls - the acls to copy
+     * @param previous - the set this one replaces, NULL for the first set
+     */
+    GatewayAclSet(uint32_t version, std::map<qcc::String, GatewayAcl*> const& acls, const GatewayAclSet* previous);
+
+    /**
+     * Get the version of the set. Versions increase with every published set
+     * @return version
+     */
+    uint32_t getVersion() const;
+
+    /**
+     * Get the merge sequence of the set. It increases by one with every set
+     * whose merged rules differ from the set it replaced
+     * @return mergeSequence
+     */
+    uint32_t getMergeSequence() const;
+
+    /**
+     * Get the merged rules of the active Acls in the set
+     * @return mergedRules
+     */
+    const GatewayAclRules& getMergedRules() const;
+
+    /**
+     * Get the Acls in the set
+     * @return acls - map of aclId to Acl
+     */
+    const std::map<qcc::String, GatewayAclSnapshot>& getAcls() const;
+
+    /**
+     * Find an Acl in the set
+     * @param aclId - the aclId to look for
+     * @return acl - NULL if no such Acl is in the set
+     */
+    const GatewayAclSnapshot* findAcl(qcc::String const& aclId) const;
+
+    /**
+     * Get the marshaled merged Acl of the active Acls in the set
+     * @return mergedAcl - exposedServices and remotedApps args, NULL if marshaling failed
+     */
+    const MsgArg* getMergedAcl() const;
+
+    /**
+     * Get the reply args of GetMergedAclIfChanged for a caller that is not current:
+     * version, changed, exposedServices and remotedApps
+     * @return reply - 4 args, NULL if marshaling failed
+     */
+    const MsgArg* getMergedAclChangedReply() const;
+
+    /**
+     * Get the args of the MergedAclUpdated signal: mergeSequence and the delta from
+     * the previous merge sequence as added and removed exposedServices and remotedApps
+     * @return args - 5 args, NULL if marshaling failed
+     */
+    const MsgArg* getMergedAclUpdatedArgs() const;
+
+  private:
+
+    /**
+     * The version of the set
+     */
+    uint32_t m_Version;
+
+    /**
+     * The Acls in the set
+     */
+    std::map<qcc::String, GatewayAclSnapshot> m_Acls;
+
+    /**
+     * The merge sequence of the set
+     */
+    uint32_t m_MergeSequence;
+
+    /**
+     * The merged rules of the active Acls
+     */
+    GatewayAclRules m_MergedRules;
+
+    /**
+     * The delta from the merged rules of the previous set
+     */
+    GatewayAclRulesPatch m_MergeDelta;
+
+    /**
+     * Arena holding the arrays of the marshaled merged Acl. Declared before
+     * m_MergedAcl so it is released after it
+     */
+    GatewayMsgArgArena m_MergedAclArena;
+
+    /**
+     * The marshaled merged Acl, laid out as the changed reply of GetMergedAclIfChanged:
+     * version, changed, exposedServices and remotedApps
+     */
+    MsgArg m_MergedAcl[4];
+
+    /**
+     * Status of marshaling the merged Acl
+     */
+    QStatus m_MergedAclStatus;
+
+    /**
+     * Arena holding the arrays of the marshaled MergedAclUpdated args
+     */
+    GatewayMsgArgArena m_MergedAclUpdatedArena;
+
+    /**
+     * The marshaled MergedAclUpdated args
+     */
+    MsgArg m_MergedAclUpdated[5];
+
+    /**
+     * Status of marshaling the MergedAclUpdated args
+     */
+    QStatus m_MergedAclUpdatedStatus;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYACLSNAPSHOT_H_ */
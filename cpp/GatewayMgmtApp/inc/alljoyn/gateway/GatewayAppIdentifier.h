@@ -18,6 +18,7 @@
 #define GATEWAYAPPIDDEVICEIDKEY_H_
 
 #include <qcc/String.h>
+#include <alljoyn/gateway/GatewayInternedString.h>
 
 namespace ajn {
 namespace gw {
@@ -25,14 +26,17 @@ namespace gw {
 #define APPID_LENGTH 16
 
 /**
- * Class used to define a key combining appId and DeviceId
+ * Class used to define a key combining appId and DeviceId. The appId is kept
+ * in binary form and the DeviceId is interned, so keys are cheap to build from
+ * announcements and compare and hash without string compares. The hex form of
+ * the appId is only produced on request, for XML and logging
  */
 class GatewayAppIdentifier {
   public:
 
     /**
      * Constructor for GatewayAppIdentifier
-     * @param appId as a qcc::String
+     * @param appId as a hex qcc::String
      * @param deviceId
      */
     GatewayAppIdentifier(qcc::String const& appId, qcc::String const& deviceId);
@@ -43,7 +47,7 @@ class GatewayAppIdentifier {
      * @param appIdLen len of array
      * @param deviceId
      */
-    GatewayAppIdentifier(uint8_t* appId, size_t appIdLen, qcc::String const& deviceId);
+    GatewayAppIdentifier(const uint8_t* appId, size_t appIdLen, qcc::String const& deviceId);
 
     /**
      * Destructor for GatewayAppIdentifier
@@ -65,10 +69,10 @@ class GatewayAppIdentifier {
     bool operator==(const GatewayAppIdentifier& other) const;
 
     /**
-     * get the AppId as string
+     * get the AppId as hex string. Built on every call
      * @return appID
      */
-    const qcc::String& getAppId() const;
+    qcc::String getAppId() const;
 
     /**
      * get the AppIdHex
@@ -88,23 +92,50 @@ class GatewayAppIdentifier {
      */
     const qcc::String& getDeviceId() const;
 
+    /**
+     * Get the hash of the key, computed when the key was built
+     * @return hash
+     */
+    size_t getHash() const;
+
   private:
 
     /**
-     * the AppId of the Key
+     * Compute m_Hash from the appId and the DeviceId
      */
-    qcc::String m_AppId;
+    void computeHash();
 
     /**
-     * The AppId in Hex form of the Key
+     * The AppId in binary form of the Key
      */
     uint8_t m_AppIdHex[APPID_LENGTH];
 
     /**
-     * The DeviceId of the Key
+     * The interned DeviceId of the Key
      */
-    qcc::String m_DeviceId;
+    GatewayInternedString m_DeviceId;
 
+    /**
+     * The hash of the Key
+     */
+    size_t m_Hash;
+
+};
+
+/**
+ * Hash functor for hash tables keyed by GatewayAppIdentifier
+ */
+struct GatewayAppIdentifierHash {
+
+    /**
+     * Get the hash of a key
+     * @param key
+     * @return hash
+     */
+    size_t operator()(const GatewayAppIdentifier& key) const
+    {
+        return key.getHash();
+    }
 };
 
 } /* namespace gw */
@@ -0,0 +1,242 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef GATEWAYBUS_H_
+#define GATEWAYBUS_H_
+
+#include <alljoyn/AboutListener.h>
+#include <alljoyn/BusAttachment.h>
+#include <alljoyn/BusListener.h>
+#include <alljoyn/BusObject.h>
+#include <alljoyn/InterfaceDescription.h>
+#include <alljoyn/Message.h>
+#include <alljoyn/MsgArg.h>
+#include <alljoyn/Session.h>
+#include <alljoyn/SessionPortListener.h>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * The bus the GatewayMgmt and its managers reach the router through.
+ * GatewayRouterBus passes the calls on to a started and connected
+ * BusAttachment, GatewayLoopbackBus serves them in-process
+ */
+class GatewayBus {
+  public:
+
+    /**
+     * Constructor for GatewayBus
+     */
+    GatewayBus();
+
+    /**
+     * Destructor for GatewayBus
+     */
+    virtual ~GatewayBus();
+
+    /**
+     * Get the BusAttachment the interfaces of the BusObjects are created on
+     * @return the BusAttachment
+     */
+    virtual BusAttachment* getBusAttachment() const = 0;
+
+    /**
+     * Check whether the bus can be used
+     * @return true/false
+     */
+    virtual bool isConnected() const = 0;
+
+    /**
+     * Register a BusObject
+     * @param busObject - the BusObject
+     * @return status - success/failure
+     */
+    virtual QStatus registerBusObject(BusObject& busObject) = 0;
+
+    /**
+     * Unregister a BusObject
+     * @param busObject - the BusObject
+     */
+    virtual void unregisterBusObject(BusObject& busObject) = 0;
+
+    /**
+     * Register a BusListener
+     * @param busListener - the BusListener
+     */
+    virtual void registerBusListener(BusListener& busListener) = 0;
+
+    /**
+     * Unregister a BusListener
+     * @param busListener - the BusListener
+     */
+    virtual void unregisterBusListener(BusListener& busListener) = 0;
+
+    /**
+     * Bind a session port
+     * @param sessionPort - the session port
+     * @param sessionOpts - the session options
+     * @param listener - the listener accepting the sessions
+     * @return status - success/failure
+     */
+    virtual QStatus bindSessionPort(SessionPort& sessionPort, SessionOpts const& sessionOpts, SessionPortListener& listener) = 0;
+
+    /**
+     * Unbind a session port
+     * @param sessionPort - the session port
+     * @return status - success/failure
+     */
+    virtual QStatus unbindSessionPort(SessionPort sessionPort) = 0;
+
+    /**
+     * Register an AboutListener and ask for the announcements of all the apps
+     * @param aboutListener - the AboutListener
+     * @return status - success/failure
+     */
+    virtual QStatus registerAboutListener(AboutListener& aboutListener) = 0;
+
+    /**
+     * Unregister an AboutListener
+     * @param aboutListener - the AboutListener
+     */
+    virtual void unregisterAboutListener(AboutListener& aboutListener) = 0;
+
+    /**
+     * Make the router reload the policy files
+     * @return status - success/failure
+     */
+    virtual QStatus reloadConfig() = 0;
+
+    /**
+     * Offer a signal to the bus before it is sent through the router
+     * @param objectPath - object path of the sender
+     * @param destination - destination of the signal, NULL for a session
+     * @param sessionId - the session of the signal
+     * @param signal - the signal
+     * @param args - args of the signal
+     * @param numArgs - number of args
+     * @return true if the bus delivered the signal, false if the sender sends it
+     */
+    virtual bool deliverSignal(const char* objectPath, const char* destination, SessionId sessionId,
+                               const InterfaceDescription::Member& signal, const MsgArg* args, size_t numArgs) = 0;
+
+    /**
+     * Get the args of a method call the bus dispatched itself
+     * @param msg - the message of the method
+     * @param numArgs - set to the number of args
+     * @param args - set to the args
+     * @return true if the bus dispatched the call, false if the args are in the message
+     */
+    virtual bool getMethodArgs(const Message& msg, size_t* numArgs, const MsgArg** args) = 0;
+
+    /**
+     * Offer the reply to a method call to the bus before it is sent through the
+     * router. Only the first reply to a call counts, later ones are dropped
+     * @param msg - the message of the method
+     * @param status - ER_OK or the error the method replies with
+     * @param args - args of the reply
+     * @param numArgs - number of args
+     * @return true if the bus delivered the reply, false if the receiver sends it
+     */
+    virtual bool deliverMethodReply(const Message& msg, QStatus status, const MsgArg* args, size_t numArgs) = 0;
+
+  private:
+
+    /**
+     * Private copy constructor - GatewayBus is not copied
+     */
+    GatewayBus(const GatewayBus&);
+
+    /**
+     * Private assignment operator - GatewayBus is not copied
+     */
+    GatewayBus& operator=(const GatewayBus&);
+};
+
+/**
+ * GatewayBus of a started and connected BusAttachment
+ */
+class GatewayRouterBus : public GatewayBus {
+  public:
+
+    /**
+     * Constructor for GatewayRouterBus
+     * @param bus - the BusAttachment, owned by the caller
+     */
+    GatewayRouterBus(BusAttachment* bus);
+
+    /**
+     * Destructor for GatewayRouterBus
+     */
+    virtual ~GatewayRouterBus();
+
+    BusAttachment* getBusAttachment() const;
+
+    bool isConnected() const;
+
+    QStatus registerBusObject(BusObject& busObject);
+
+    void unregisterBusObject(BusObject& busObject);
+
+    void registerBusListener(BusListener& busListener);
+
+    void unregisterBusListener(BusListener& busListener);
+
+    QStatus bindSessionPort(SessionPort& sessionPort, SessionOpts const& sessionOpts, SessionPortListener& listener);
+
+    QStatus unbindSessionPort(SessionPort sessionPort);
+
+    QStatus registerAboutListener(AboutListener& aboutListener);
+
+    void unregisterAboutListener(AboutListener& aboutListener);
+
+    /**
+     * Call ReloadConfig of the router
+     * @return status - success/failure
+     */
+    QStatus reloadConfig();
+
+    /**
+     * Signals go through the router
+     * @return false
+     */
+    bool deliverSignal(const char* objectPath, const char* destination, SessionId sessionId,
+                       const InterfaceDescription::Member& signal, const MsgArg* args, size_t numArgs);
+
+    /**
+     * Method calls come through the router, their args are in the message
+     * @return false
+     */
+    bool getMethodArgs(const Message& msg, size_t* numArgs, const MsgArg** args);
+
+    /**
+     * Replies go through the router
+     * @return false
+     */
+    bool deliverMethodReply(const Message& msg, QStatus status, const MsgArg* args, size_t numArgs);
+
+  private:
+
+    /**
+     * The BusAttachment
+     */
+    BusAttachment* m_Bus;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYBUS_H_ */
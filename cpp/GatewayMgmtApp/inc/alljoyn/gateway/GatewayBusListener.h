@@ -21,6 +21,10 @@
 #include <alljoyn/BusListener.h>
 #include <alljoyn/SessionPortListener.h>
 #include <vector>
+#include <map>
+#include <set>
+#include <qcc/String.h>
+#include <alljoyn/gateway/GatewayMutex.h>
 
 namespace ajn {
 namespace gw {
@@ -96,10 +100,27 @@ class GatewayBusListener : public BusListener, public SessionPortListener,
     void SessionLost(SessionId sessionId, SessionLostReason reason);
 
     /**
-     * Get the SessionIds associated with this Listener
+     * Get a copy of the SessionIds associated with this Listener
      * @return vector of sessionIds
      */
-    const std::vector<SessionId>& getSessionIds() const;
+    std::vector<SessionId> getSessionIds() const;
+
+    /**
+     * Get a copy of the SessionIds that are interested in the status of a Connector App
+     * @param connectorId - the connectorId of the App
+     * @param allSessions - set to true if every session is interested
+     * @return vector of sessionIds
+     */
+    std::vector<SessionId> getSessionIds(qcc::String const& connectorId, bool* allSessions) const;
+
+    /**
+     * Set the Connector Apps a session wants to receive status changes for.
+     * Sessions without subscriptions receive the status changes of all Apps
+     * @param sessionId - the session
+     * @param connectorIds - the connectorIds of the Apps. Empty to receive all
+     * @return status - success/failure
+     */
+    QStatus setAppSubscriptions(SessionId sessionId, std::vector<qcc::String> const& connectorIds);
 
     /**
      * Function for when Bus has been disconnected
@@ -123,6 +144,16 @@ class GatewayBusListener : public BusListener, public SessionPortListener,
      */
     std::vector<SessionId> m_SessionIds;
 
+    /**
+     * Lock guarding the sessionIds
+     */
+    mutable GatewayMutex m_SessionIdsLock;
+
+    /**
+     * The Connector Apps each session subscribed to. Guarded by m_SessionIdsLock
+     */
+    std::map<SessionId, std::set<qcc::String> > m_AppSubscriptions;
+
     /**
      * Callback when daemon is disconnected
      */
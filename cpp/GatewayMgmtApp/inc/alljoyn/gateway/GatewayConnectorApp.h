@@ -19,19 +19,26 @@
 
 #include <map>
 #include <qcc/String.h>
-#include <alljoyn/BusAttachment.h>
+#include <alljoyn/gateway/GatewayBus.h>
 #include <alljoyn/gateway/GatewayEnums.h>
 #include <alljoyn/gateway/GatewayAcl.h>
+#include <alljoyn/gateway/GatewayAclBatchOperation.h>
+#include <alljoyn/gateway/GatewayAclSnapshot.h>
 #include <alljoyn/gateway/GatewayConnectorAppManifest.h>
+#include <alljoyn/gateway/GatewayManifestReplies.h>
+#include <alljoyn/gateway/GatewayTaskQueue.h>
+#include <alljoyn/gateway/GatewayMutex.h>
 
 namespace ajn {
 namespace gw {
 
 //forward declaration
 class AppBusObject;
+class ShardedBusObject;
 
 /**
- * Class that represents an App on the Gateway
+ * Class that represents an App on the Gateway. The App and its Acls are
+ * only modified on the App's task queue - see GatewayMgmt for the threading model
  */
 class GatewayConnectorApp {
   public:
@@ -49,18 +56,19 @@ class GatewayConnectorApp {
     virtual ~GatewayConnectorApp();
 
     /**
-     * Initialize this Connector App
+     * Initialize this Connector App. The Connector App process is not started
+     * here - see GatewayConnectorAppManager::startConnectorApps
      * @param bus - bus used to register
      * @return status - success/failure
      */
-    QStatus init(BusAttachment* bus);
+    QStatus init(GatewayBus* bus);
 
     /**
      * Shutdown this Connector App
      * @param bus - bus used to register
      * @return status - success/failure
      */
-    QStatus shutdown(BusAttachment* bus);
+    QStatus shutdown(GatewayBus* bus);
 
     /**
      * Restart the Connector App
@@ -93,6 +101,57 @@ class GatewayConnectorApp {
      */
     AclResponseCode deleteAcl(qcc::String const& aclId);
 
+    /**
+     * Apply the operations of an Acl batch on the task queue and wait for them
+     * @param operations - the operations of this App
+     * @param activeRules - filled with the rules of the active Acls once the operations are applied
+     * @param undo - filled with what is needed to roll the operations back
+     * @param responseCode - the response code of applyAclBatch
+     * @return applied - false if the queue was stopped before the operations were applied
+     */
+    bool postApplyAclBatch(std::vector<GatewayAclBatchOperation*> const& operations, std::vector<GatewayAclRules>* activeRules,
+                           GatewayAclBatchUndo* undo, AclResponseCode* responseCode);
+
+    /**
+     * Roll back an applied Acl batch on the task queue and wait for it
+     * @param undo - the undo of applyAclBatch
+     * @param activeRules - filled with the rules of the active Acls once the batch is rolled back
+     */
+    void postRollbackAclBatch(GatewayAclBatchUndo* undo, std::vector<GatewayAclRules>* activeRules);
+
+    /**
+     * Complete an Acl batch on the task queue
+     */
+    void postCompleteAclBatch();
+
+    /**
+     * Apply the operations of an Acl batch that belong to this App, in order.
+     * The Acls are persisted and one new Acl snapshot is published, but the
+     * policies are not updated and the app is not notified - see completeAclBatch.
+     * Stops at the first operation that fails and rolls back the operations
+     * before it, so either all operations are applied or none is
+     * @param operations - the operations to apply. Their response code and, for created Acls, aclId are set
+     * @param activeRules - filled with the rules of the active Acls once the operations are applied
+     * @param undo - filled with what is needed to roll the operations back - see rollbackAclBatch
+     * @return response code - success/failure of the first failing operation
+     */
+    AclResponseCode applyAclBatch(std::vector<GatewayAclBatchOperation*> const& operations, std::vector<GatewayAclRules>* activeRules,
+                                  GatewayAclBatchUndo* undo);
+
+    /**
+     * Restore the Acls an applied batch changed, newest change first, and
+     * publish one new Acl snapshot. The app is not notified
+     * @param undo - the undo of applyAclBatch. Emptied once rolled back
+     * @param activeRules - filled with the rules of the active Acls once the batch is rolled back
+     */
+    void rollbackAclBatch(GatewayAclBatchUndo* undo, std::vector<GatewayAclRules>* activeRules);
+
+    /**
+     * Complete an Acl batch once its policies are committed: send one AclUpdated
+     * signal and start or stop the app according to its active Acls
+     */
+    void completeAclBatch();
+
     /**
      * Get the connectorId of the Connector App
      * @return connectorId
@@ -130,17 +189,36 @@ class GatewayConnectorApp {
     OperationalStatus getOperationalStatus() const;
 
     /**
-     * Get the Acl of this Connector App
+     * Get the Acl of this Connector App. Only valid on the task queue
      * @return map of acls
      */
     const std::map<qcc::String, GatewayAcl*>& getAcls() const;
 
+    /**
+     * Get the last published snapshot of the Acls of this Connector App.
+     * Can be called from any thread and does not wait for the task queue
+     * @return aclSet
+     */
+    GatewayRef<GatewayAclSet> getAclSnapshot() const;
+
+    /**
+     * Publish a new snapshot of the Acls of this Connector App.
+     * Called on the task queue after the Acls changed
+     */
+    void publishAclSnapshot();
+
     /**
      * Get the Manifest of the Connector App
      * @return manifest
      */
     const GatewayConnectorAppManifest& getManifest() const;
 
+    /**
+     * Get the marshaled replies of the manifest queries, built when the Manifest was loaded
+     * @return manifestReplies
+     */
+    const GatewayManifestReplies& getManifestReplies() const;
+
     /**
      * Get the BusObject of this Connector App
      * @return busObject
@@ -153,6 +231,46 @@ class GatewayConnectorApp {
      */
     pid_t getProcessId() const;
 
+    /**
+     * Get the resource usage of the running Connector App. Read from the
+     * App's cgroup when resource limits are applied, from /proc otherwise
+     * @param cpuUsage - cpu time consumed in microseconds
+     * @param memoryUsage - memory in use in bytes
+     * @return status - success/failure
+     */
+    QStatus getResourceUsage(uint64_t* cpuUsage, uint64_t* memoryUsage) const;
+
+    /**
+     * Get the task queue that executes all operations on this Connector App
+     * @return taskQueue
+     */
+    GatewayTaskQueue* getTaskQueue();
+
+    /**
+     * Get the BusObject of this Connector App or one of its Acls. In on demand
+     * mode the BusObject of the Acl is registered by its first lookup.
+     * Called on the task queue
+     * @param objectPath - objectPath of the BusObject
+     * @return busObject or NULL if not found
+     */
+    ShardedBusObject* getShardedBusObject(qcc::String const& objectPath);
+
+    /**
+     * Register the BusObject of an Acl if it is not registered yet. Used in
+     * on demand mode before the object path of the Acl is handed out or
+     * the Acl is looked up by its object path. Called on the task queue
+     * @param aclId - id of the Acl
+     * @return status - success/failure
+     */
+    QStatus materializeAclObject(qcc::String const& aclId);
+
+    /**
+     * Start the Connector App on its task queue if it has an active Acl
+     * and is not running yet. Waits until the start was attempted
+     * @return true if a start was attempted
+     */
+    bool postStartConnectorApp();
+
     /**
      * Set the ConnectionStatus of the Connector App
      * @param connectionStatus
@@ -160,7 +278,7 @@ class GatewayConnectorApp {
     void setConnectionStatus(ConnectionStatus connectionStatus);
 
     /**
-     * This Connector app has shutdown
+     * This Connector app has shutdown. Handled on the task queue
      */
     void sigChildReceived();
 
@@ -204,6 +322,39 @@ class GatewayConnectorApp {
      */
     qcc::String generateAclId(qcc::String const& aclName);
 
+    /**
+     * Create, register and persist an Acl without publishing a snapshot,
+     * updating the policies or starting the app
+     * @param aclId - filled with the generated id of the Acl
+     * @param aclName - name of the Acl
+     * @param aclRules - rules of the Acl
+     * @param customMetadata - customMetadata of the Acl
+     * @return response code - success/failure
+     */
+    AclResponseCode addAcl(qcc::String* aclId, qcc::String const& aclName, GatewayAclRules const& aclRules,
+                           std::map<qcc::String, qcc::String> const& customMetadata);
+
+    /**
+     * Register, persist and insert a new Acl. The Acl is deleted if that fails
+     * @param acl - the Acl
+     * @return response code - success/failure
+     */
+    AclResponseCode insertAcl(GatewayAcl* acl);
+
+    /**
+     * Remove the file of an Acl, unregister and delete it without publishing
+     * a snapshot, updating the policies or stopping the app
+     * @param it - the Acl to remove
+     * @return response code - success/failure
+     */
+    AclResponseCode removeAcl(std::map<qcc::String, GatewayAcl*>::iterator it);
+
+    /**
+     * Get the rules of the active Acls
+     * @param aclRules - vector to fill
+     */
+    void getActiveAclRules(std::vector<GatewayAclRules>* aclRules) const;
+
     /**
      * load the Acls of this App
      * @return status - success/failure
@@ -216,6 +367,24 @@ class GatewayConnectorApp {
      */
     bool shutdownConnectorApp();
 
+    /**
+     * Update the state after the Connector App process exited
+     */
+    void processSigChild();
+
+    /**
+     * Apply the resource limits of the manifest to the current process.
+     * Called in the forked child before dropping privileges. Uses a cgroup v2
+     * group per Connector App and falls back to rlimits
+     * @return true if the cgroup was used, false if rlimits were used
+     */
+    bool applyResourceLimits();
+
+    /**
+     * Remove the cgroup of the Connector App after it exited
+     */
+    void removeResourceLimits();
+
     /**
      * The connectorId of the App
      */
@@ -232,9 +401,10 @@ class GatewayConnectorApp {
     ConnectionStatus m_ConnectionStatus;
 
     /**
-     * The OperationalStatus of the App
+     * The OperationalStatus of the App. Written on the task queue,
+     * polled by the threads stopping the App
      */
-    OperationalStatus m_OperationalStatus;
+    volatile OperationalStatus m_OperationalStatus;
 
     /**
      * The InstallStatus of the App
@@ -251,20 +421,47 @@ class GatewayConnectorApp {
      */
     GatewayConnectorAppManifest m_Manifest;
 
+    /**
+     * The marshaled replies of the manifest queries. Declared after
+     * m_Manifest, which they point into
+     */
+    GatewayManifestReplies m_ManifestReplies;
+
     /**
      * The BusObject of the App
      */
     AppBusObject* m_AppBusObject;
 
     /**
-     * The PID of the App
+     * The PID of the App. Written on the task queue, polled by the
+     * threads stopping the App and read when SIGCHLD is received
      */
-    pid_t m_ProcessId;
+    volatile pid_t m_ProcessId;
 
     /**
      * The Acls of this App
      */
     std::map<qcc::String, GatewayAcl*> m_Acls;
+
+    /**
+     * The last published snapshot of the Acls
+     */
+    GatewayRef<GatewayAclSet> m_AclSnapshot;
+
+    /**
+     * Lock guarding m_AclSnapshot. Only held to copy or swap the reference
+     */
+    mutable GatewayMutex m_AclSnapshotLock;
+
+    /**
+     * The version of the last published snapshot
+     */
+    uint32_t m_AclSnapshotVersion;
+
+    /**
+     * The task queue of the App
+     */
+    GatewayTaskQueue m_TaskQueue;
 };
 
 } /* namespace gw */
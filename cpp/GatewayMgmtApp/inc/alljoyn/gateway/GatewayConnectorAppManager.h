@@ -17,9 +17,12 @@
 #ifndef GATEWAYAPPMANAGER_H_
 #define GATEWAYAPPMANAGER_H_
 
-#include <alljoyn/BusAttachment.h>
+#include <alljoyn/gateway/GatewayBus.h>
 #include <alljoyn/gateway/GatewayMgmt.h>
+#include <alljoyn/gateway/GatewayAclBatchOperation.h>
+#include <alljoyn/gateway/GatewayMutex.h>
 #include <map>
+#include <vector>
 
 namespace ajn {
 namespace gw {
@@ -49,14 +52,31 @@ class GatewayConnectorAppManager {
      * @param bus - bus used to register
      * @return status - success/failure
      */
-    QStatus init(BusAttachment* bus);
+    QStatus init(GatewayBus* bus);
 
     /**
      * Shutdown the GatewayConnectorAppManager
      * @param bus - bus used to unregister
      * @return status - success/failure
      */
-    QStatus shutdown(BusAttachment* bus);
+    QStatus shutdown(GatewayBus* bus);
+
+    /**
+     * Start the Connector Apps that have an active Acl on timers of the event
+     * loop. Apps are started in order of their manifest priority, at most
+     * concurrency apps at a time with staggerMs milliseconds between them.
+     * Without an event loop all apps are started right away on the calling thread
+     * @param concurrency - number of apps started in one batch
+     * @param staggerMs - delay between two batches in milliseconds
+     * @return status - success/failure
+     */
+    QStatus startConnectorApps(uint32_t concurrency, uint32_t staggerMs);
+
+    /**
+     * Start the next batch of apps and schedule the batch after it.
+     * Called on the thread of the event loop
+     */
+    void startNextApps();
 
     /**
      * receive Sig Child Signal
@@ -65,19 +85,47 @@ class GatewayConnectorAppManager {
     void sigChildReceived(pid_t pid);
 
     /**
-     * Get the Apps stored by the App Manager
+     * Get the Apps stored by the App Manager. The map does not change
+     * between init and shutdown
      * @return apps
      */
-    std::map<qcc::String, GatewayConnectorApp*> getConnectorApps() const;
+    const std::map<qcc::String, GatewayConnectorApp*>& getConnectorApps() const;
+
+    /**
+     * Apply a batch of Acl operations across Connector Apps. All operations are
+     * validated before any of them is applied; each App then applies its own
+     * operations on its task queue, the metadata is persisted, the policies of
+     * all Apps whose active rules changed are committed with a single reload and
+     * each of those Apps gets one AclUpdated signal. The batch is atomic: if any
+     * part fails, the Apps that applied their operations are rolled back.
+     * Operations that were not applied or were rolled back report GW_ACL_RC_INVALID
+     * @param operations - the operations, in order. Their response code and, for created Acls, aclId are set
+     * @return response code - success or the response code of the first failing operation
+     */
+    AclResponseCode batchUpdate(std::vector<GatewayAclBatchOperation>& operations);
 
   private:
 
+    /**
+     * Roll back the Apps that applied their operations of a failed batch
+     * @param operations - the operations of the batch
+     * @param undos - the undo of every App that applied its operations
+     * @param policiesChanged - the policies were updated with the rules of the batch
+     */
+    void rollbackBatch(std::vector<GatewayAclBatchOperation>& operations, std::map<qcc::String, GatewayAclBatchUndo>& undos,
+                       bool policiesChanged);
+
     /**
      * Load the installed Apps by parsing the apps directory
      * @return
      */
     QStatus loadConnectorApps();
 
+    /**
+     * Stop starting the apps. Waits for a batch that is being started
+     */
+    void stopStartingApps();
+
     /**
      * BusObject used for AppMgmt
      */
@@ -87,6 +135,46 @@ class GatewayConnectorAppManager {
      * The map storing the Apps
      */
     std::map<qcc::String, GatewayConnectorApp*> m_ConnectorApps;
+
+    /**
+     * Guards the timer starting the apps and the flags
+     */
+    GatewayMutex m_StartAppsLock;
+
+    /**
+     * The apps to start in order of their priority
+     */
+    std::vector<GatewayConnectorApp*> m_StartApps;
+
+    /**
+     * Index of the next app to start
+     */
+    size_t m_NextStartApp;
+
+    /**
+     * The timer of the next batch, 0 if none is scheduled
+     */
+    uint32_t m_StartAppsTimerId;
+
+    /**
+     * Whether the apps were started or are being started
+     */
+    bool m_StartingApps;
+
+    /**
+     * Set to stop starting the apps
+     */
+    volatile bool m_StopStartingApps;
+
+    /**
+     * Number of apps started in one batch
+     */
+    uint32_t m_StartConcurrency;
+
+    /**
+     * Delay between two batches in milliseconds
+     */
+    uint32_t m_StartStaggerMs;
 };
 
 } /* namespace gw */
@@ -116,6 +116,37 @@ class GatewayConnectorAppManifest {
      */
     const std::vector<qcc::String>& getAppArguments() const;
 
+    /**
+     * Get the start priority of the App. Apps with a higher priority
+     * are started first
+     * @return priority - 0 if no priority was defined
+     */
+    uint32_t getPriority() const;
+
+    /**
+     * Get the cgroup cpu weight of the App
+     * @return cpuWeight - 0 if no limit was defined
+     */
+    uint32_t getCpuWeight() const;
+
+    /**
+     * Get the maximum memory in bytes the App may use
+     * @return memoryMax - 0 if no limit was defined
+     */
+    uint64_t getMemoryMax() const;
+
+    /**
+     * Get the maximum number of open files of the App
+     * @return openFiles - 0 if no limit was defined
+     */
+    uint32_t getOpenFiles() const;
+
+    /**
+     * Check whether the manifest defines any resource limit
+     * @return true/false
+     */
+    bool hasResourceLimits() const;
+
   private:
 
     /**
@@ -168,6 +199,26 @@ class GatewayConnectorAppManifest {
      */
     Capabilities m_RemotedServices;
 
+    /**
+     * Start priority of the App
+     */
+    uint32_t m_Priority;
+
+    /**
+     * CPU weight of the App
+     */
+    uint32_t m_CpuWeight;
+
+    /**
+     * Maximum memory of the App
+     */
+    uint64_t m_MemoryMax;
+
+    /**
+     * Maximum number of open files of the App
+     */
+    uint32_t m_OpenFiles;
+
     /**
      * parseObjects - internal function to help parse the objects
      * @param currentKey - current key in parser
@@ -181,6 +232,12 @@ class GatewayConnectorAppManifest {
      */
     void parseExecutionInfo(xmlNode* currentKey);
 
+    /**
+     * parseResourceLimits - internal function to help parse the resourceLimits
+     * @param currentKey - current key in parser
+     */
+    void parseResourceLimits(xmlNode* currentKey);
+
 };
 
 } /* namespace gw */
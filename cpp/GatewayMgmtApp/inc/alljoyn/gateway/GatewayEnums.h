@@ -61,6 +61,27 @@ typedef enum {
     GW_AS_MAX_ACL_STATUS = 1       //!< MAX_ACL_STATUS
 } AclStatus;
 
+/**
+ * Enum to describe the fields returned for every entry of a paged list
+ */
+typedef enum {
+    GW_LP_FULL =  0,               //!< FULL
+    GW_LP_ID_STATUS = 1,           //!< ID_STATUS
+    GW_LP_MAX_LIST_PROJECTION = 1  //!< MAX_LIST_PROJECTION
+} ListProjection;
+
+/**
+ * Enum to describe the type of an operation of an Acl batch
+ */
+typedef enum {
+    GW_BO_CREATE_ACL =  0,         //!< CREATE_ACL
+    GW_BO_UPDATE_ACL = 1,          //!< UPDATE_ACL
+    GW_BO_ACTIVATE_ACL = 2,        //!< ACTIVATE_ACL
+    GW_BO_DEACTIVATE_ACL = 3,      //!< DEACTIVATE_ACL
+    GW_BO_DELETE_ACL = 4,          //!< DELETE_ACL
+    GW_BO_MAX_BATCH_OPERATION = 4  //!< MAX_BATCH_OPERATION
+} AclBatchOperationType;
+
 /**
  * Enum to describe the response code for trying to restart an App
  */
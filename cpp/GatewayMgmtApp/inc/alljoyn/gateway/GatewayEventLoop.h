@@ -0,0 +1,267 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef GATEWAYEVENTLOOP_H_
+#define GATEWAYEVENTLOOP_H_
+
+#include <pthread.h>
+#include <signal.h>
+#include <map>
+#include <vector>
+#include <qcc/platform.h>
+#include <alljoyn/Status.h>
+#include <alljoyn/gateway/GatewayTaskQueue.h>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * Handler for a signal received by the GatewayEventLoop. Called on the
+ * thread of the loop, so it is not restricted to async-signal-safe calls
+ * @param signum - the signal that was received
+ */
+typedef void (*GatewaySignalHandler)(int32_t signum);
+
+/**
+ * Process-wide event loop of the agent. A single thread waits in epoll on a
+ * signalfd for signals and an eventfd for timer changes, and runs timers from
+ * a hashed timer wheel. The thread only wakes up when a signal arrived, a
+ * timer is due or a timer was added
+ */
+class GatewayEventLoop {
+  public:
+
+    /**
+     * Constructor for GatewayEventLoop
+     */
+    GatewayEventLoop();
+
+    /**
+     * Destructor for GatewayEventLoop. Stops the loop and cancels the timers
+     * that did not fire
+     */
+    virtual ~GatewayEventLoop();
+
+    /**
+     * Create the epoll and eventfd descriptors of the loop
+     * @return status - success/failure
+     */
+    QStatus init();
+
+    /**
+     * Handle a signal on the loop instead of in a signal handler. The signal
+     * is blocked for the calling thread, so this must be called before any
+     * other thread is started - threads inherit the blocked signals
+     * @param signum - the signal to handle
+     * @param handler - the handler to call on the thread of the loop
+     * @return status - success/failure
+     */
+    QStatus addSignalHandler(int32_t signum, GatewaySignalHandler handler);
+
+    /**
+     * Unblock the signals handled by the loop for the calling thread. Used by
+     * forked children before they exec, since the blocked signals survive exec
+     */
+    void unblockSignals() const;
+
+    /**
+     * Start the thread of the loop
+     * @return status - success/failure
+     */
+    QStatus start();
+
+    /**
+     * Stop the thread of the loop and wait for it to exit. Timers that did
+     * not fire are cancelled
+     */
+    void stop();
+
+    /**
+     * Schedule a task to run on the loop once the delay expired. The delay is
+     * rounded up to the tick of the timer wheel. The loop takes ownership of the task
+     * @param task - the task to execute
+     * @param delayMs - the delay in milliseconds
+     * @return timerId - id to cancel the timer with, 0 if it could not be scheduled
+     */
+    uint32_t addTimer(GatewayTask* task, uint32_t delayMs);
+
+    /**
+     * Cancel a timer that did not fire yet. Calls cancel on its task. If the
+     * timer is firing on the thread of the loop, waits until its task returned,
+     * so the objects the task uses can be deleted afterwards
+     * @param timerId - the id returned by addTimer
+     * @return true if the timer was cancelled, false if it already fired
+     */
+    bool cancelTimer(uint32_t timerId);
+
+    /**
+     * Check whether the caller runs on the thread of the loop
+     * @return true/false
+     */
+    bool isCurrentThread() const;
+
+  private:
+
+    /**
+     * Private copy constructor - a loop can not be copied
+     */
+    GatewayEventLoop(const GatewayEventLoop&);
+
+    /**
+     * Private assignment operator - a loop can not be copied
+     */
+    GatewayEventLoop& operator=(const GatewayEventLoop&);
+
+    /**
+     * A timer in a slot of the wheel
+     */
+    struct Timer {
+
+        /**
+         * The task to run when the timer fires
+         */
+        GatewayTask* m_Task;
+
+        /**
+         * Number of full turns of the wheel left before the timer fires
+         */
+        uint32_t m_Rounds;
+    };
+
+    /**
+     * static function for the thread of the loop
+     * @param loop - the GatewayEventLoop
+     */
+    static void* Run(void* loop);
+
+    /**
+     * Wake the thread of the loop up
+     */
+    void wakeUp();
+
+    /**
+     * Read the pending signals from the signalfd and call their handlers
+     */
+    void dispatchSignals();
+
+    /**
+     * Advance the wheel to the current time and move the timers that are due
+     * to the due timers. Called with the lock held
+     */
+    void advanceWheel();
+
+    /**
+     * Run the due timers one by one. Called without the lock held
+     * @return true if a timer ran
+     */
+    bool runDueTimers();
+
+    /**
+     * Get the time until the next timer is due. Called with the lock held
+     * @return timeout in milliseconds for epoll_wait, -1 if there are no timers
+     */
+    int getWheelTimeout() const;
+
+    /**
+     * The epoll descriptor
+     */
+    int m_EpollFd;
+
+    /**
+     * The eventfd used to wake the loop up
+     */
+    int m_WakeFd;
+
+    /**
+     * The signalfd, -1 while no signal is handled
+     */
+    int m_SignalFd;
+
+    /**
+     * The signals handled by the loop
+     */
+    sigset_t m_SignalMask;
+
+    /**
+     * The handlers of the signals
+     */
+    std::map<int32_t, GatewaySignalHandler> m_SignalHandlers;
+
+    /**
+     * The thread of the loop
+     */
+    pthread_t m_Thread;
+
+    /**
+     * Lock guarding the timers and the flags
+     */
+    pthread_mutex_t m_Lock;
+
+    /**
+     * Signalled when a timer finished firing
+     */
+    pthread_cond_t m_TimerFired;
+
+    /**
+     * The slots of the timer wheel, each keyed by timerId
+     */
+    std::vector<std::map<uint32_t, Timer> > m_Wheel;
+
+    /**
+     * The slot of every scheduled timer, keyed by timerId
+     */
+    std::map<uint32_t, size_t> m_TimerSlots;
+
+    /**
+     * The tasks of the timers that are due but did not fire yet, keyed by timerId
+     */
+    std::map<uint32_t, GatewayTask*> m_DueTimers;
+
+    /**
+     * The timer whose task is running, 0 if none
+     */
+    uint32_t m_FiringTimerId;
+
+    /**
+     * The slot the wheel is at
+     */
+    size_t m_CurrentSlot;
+
+    /**
+     * Monotonic time in milliseconds of the tick the wheel is at
+     */
+    uint64_t m_WheelTime;
+
+    /**
+     * The id of the last scheduled timer
+     */
+    uint32_t m_LastTimerId;
+
+    /**
+     * Whether the thread of the loop was started
+     */
+    bool m_IsRunning;
+
+    /**
+     * Whether the loop was stopped
+     */
+    bool m_IsStopping;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYEVENTLOOP_H_ */
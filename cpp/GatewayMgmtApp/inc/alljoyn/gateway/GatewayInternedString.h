@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef GATEWAYINTERNEDSTRING_H_
+#define GATEWAYINTERNEDSTRING_H_
+
+#include <qcc/platform.h>
+#include <qcc/atomic.h>
+#include <qcc/String.h>
+#include <vector>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * Handle to a string in the process-wide intern table. Equal strings share
+ * one entry, so handles compare by address and carry a precomputed hash.
+ * Entries are reference counted by their handles and leave the table with
+ * the last handle, so strings that come from remote callers do not pile up
+ */
+class GatewayInternedString {
+  public:
+
+    /**
+     * Constructor for GatewayInternedString. Refers to the empty string
+     */
+    GatewayInternedString();
+
+    /**
+     * Constructor for GatewayInternedString. Looks the string up in the intern
+     * table and adds it if it is not there yet
+     * @param value - the string to intern
+     */
+    explicit GatewayInternedString(qcc::String const& value);
+
+    /**
+     * Copy constructor for GatewayInternedString. Shares the entry of the other handle
+     * @param other - the handle to copy
+     */
+    GatewayInternedString(const GatewayInternedString& other) : m_Entry(other.m_Entry)
+    {
+        qcc::IncrementAndFetch(&m_Entry->m_RefCount);
+    }
+
+    /**
+     * Destructor for GatewayInternedString
+     */
+    ~GatewayInternedString()
+    {
+        release(m_Entry);
+    }
+
+    /**
+     * Assignment operator for GatewayInternedString
+     * @param other - the handle to copy
+     * @return this handle
+     */
+    GatewayInternedString& operator=(const GatewayInternedString& other)
+    {
+        if (m_Entry != other.m_Entry) {
+            qcc::IncrementAndFetch(&other.m_Entry->m_RefCount);
+            release(m_Entry);
+            m_Entry = other.m_Entry;
+        }
+        return *this;
+    }
+
+    /**
+     * Get the interned string
+     * @return value
+     */
+    const qcc::String& str() const
+    {
+        return m_Entry->m_Value;
+    }
+
+    /**
+     * Get the hash of the interned string
+     * @return hash
+     */
+    size_t getHash() const
+    {
+        return m_Entry->m_Hash;
+    }
+
+    /**
+     * operator == comparing the entries of both handles
+     * @param other
+     * @return boolean equal or not
+     */
+    bool operator==(const GatewayInternedString& other) const
+    {
+        return m_Entry == other.m_Entry;
+    }
+
+    /**
+     * operator != comparing the entries of both handles
+     * @param other
+     * @return boolean different or not
+     */
+    bool operator!=(const GatewayInternedString& other) const
+    {
+        return m_Entry != other.m_Entry;
+    }
+
+    /**
+     * Hash a string the way the intern table does
+     * @param value - the string to hash
+     * @return hash
+     */
+    static size_t hashString(qcc::String const& value);
+
+    /**
+     * Usage of the intern table
+     */
+    struct TableStats {
+
+        /**
+         * Number of strings in the table
+         */
+        size_t m_NumStrings;
+
+        /**
+         * Number of handles referring to the strings
+         */
+        size_t m_NumHandles;
+
+        /**
+         * Bytes held by the table: the entries and one copy of every string
+         */
+        size_t m_InternedBytes;
+
+        /**
+         * Bytes the strings would take if every handle held its own copy
+         */
+        size_t m_CopiedBytes;
+    };
+
+    /**
+     * Get the usage of the intern table
+     * @param stats - filled with the usage
+     */
+    static void getTableStats(TableStats* stats);
+
+    /**
+     * Entry of the intern table
+     */
+    struct Entry {
+
+        /**
+         * The interned string
+         */
+        qcc::String m_Value;
+
+        /**
+         * The hash of the string
+         */
+        size_t m_Hash;
+
+        /**
+         * The number of handles referring to the entry
+         */
+        mutable volatile int32_t m_RefCount;
+    };
+
+  private:
+
+    /**
+     * Release a reference to an entry. Removes the entry from the intern
+     * table when the last reference is released
+     * @param entry - the entry to release
+     */
+    static void release(const Entry* entry);
+
+    /**
+     * The entry in the intern table
+     */
+    const Entry* m_Entry;
+};
+
+/**
+ * Vector of interned strings
+ */
+typedef std::vector<GatewayInternedString> GatewayInternedStrings;
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYINTERNEDSTRING_H_ */
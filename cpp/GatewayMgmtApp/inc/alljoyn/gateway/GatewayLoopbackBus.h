@@ -0,0 +1,282 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef GATEWAYLOOPBACKBUS_H_
+#define GATEWAYLOOPBACKBUS_H_
+
+#include <alljoyn/gateway/GatewayBus.h>
+#include <alljoyn/gateway/GatewayMutex.h>
+#include <qcc/String.h>
+#include <pthread.h>
+#include <map>
+#include <vector>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * Receives the signals sent on a GatewayLoopbackBus
+ */
+class GatewayLoopbackSignalHandler {
+  public:
+
+    /**
+     * Destructor for GatewayLoopbackSignalHandler
+     */
+    virtual ~GatewayLoopbackSignalHandler() { }
+
+    /**
+     * A signal was sent
+     * @param objectPath - object path of the sender
+     * @param destination - destination of the signal, NULL for a session
+     * @param sessionId - the session of the signal
+     * @param signal - the signal
+     * @param args - args of the signal
+     * @param numArgs - number of args
+     */
+    virtual void signalReceived(const char* objectPath, const char* destination, SessionId sessionId,
+                                const InterfaceDescription::Member& signal, const MsgArg* args, size_t numArgs) = 0;
+};
+
+/**
+ * Reply to a method call made on a GatewayLoopbackBus
+ */
+struct GatewayLoopbackReply {
+
+    /**
+     * ER_OK or the error the method replied with
+     */
+    QStatus m_Status;
+
+    /**
+     * Args of the reply
+     */
+    std::vector<MsgArg> m_Args;
+};
+
+/**
+ * In-process GatewayBus that needs no router. The BusObjects are kept by
+ * object path, announcements are fed to the registered AboutListeners by
+ * the caller, method calls are dispatched to the task queues of the
+ * Connector Apps, signals go to the registered signal handlers and
+ * ReloadConfig only counts. The interfaces are created on a BusAttachment
+ * that is never started, so the GatewayMgmt and its managers run in a plain binary
+ */
+class GatewayLoopbackBus : public GatewayBus {
+  public:
+
+    /**
+     * Constructor for GatewayLoopbackBus
+     * @param reloadUs - time the stub ReloadConfig takes in microseconds
+     */
+    GatewayLoopbackBus(uint32_t reloadUs = 0);
+
+    /**
+     * Destructor for GatewayLoopbackBus
+     */
+    virtual ~GatewayLoopbackBus();
+
+    BusAttachment* getBusAttachment() const;
+
+    /**
+     * The loopback is always connected
+     * @return true
+     */
+    bool isConnected() const;
+
+    QStatus registerBusObject(BusObject& busObject);
+
+    void unregisterBusObject(BusObject& busObject);
+
+    void registerBusListener(BusListener& busListener);
+
+    void unregisterBusListener(BusListener& busListener);
+
+    QStatus bindSessionPort(SessionPort& sessionPort, SessionOpts const& sessionOpts, SessionPortListener& listener);
+
+    QStatus unbindSessionPort(SessionPort sessionPort);
+
+    QStatus registerAboutListener(AboutListener& aboutListener);
+
+    void unregisterAboutListener(AboutListener& aboutListener);
+
+    /**
+     * Stub of the ReloadConfig of the router
+     * @return status - success
+     */
+    QStatus reloadConfig();
+
+    /**
+     * Pass a signal to the registered signal handlers
+     * @return true
+     */
+    bool deliverSignal(const char* objectPath, const char* destination, SessionId sessionId,
+                       const InterfaceDescription::Member& signal, const MsgArg* args, size_t numArgs);
+
+    /**
+     * Get the args of a method call made with callMethod
+     * @return true if the call was made with callMethod
+     */
+    bool getMethodArgs(const Message& msg, size_t* numArgs, const MsgArg** args);
+
+    /**
+     * Hand the reply of a method call made with callMethod to the caller
+     * @return true if the call was made with callMethod
+     */
+    bool deliverMethodReply(const Message& msg, QStatus status, const MsgArg* args, size_t numArgs);
+
+    /**
+     * Call a method of a Connector App or one of its Acls and wait for the
+     * reply. The call goes through ShardedBusObject::DispatchToShard, so it
+     * runs on the task queue of the App like a call from the router. Must not
+     * be called on that task queue. A method annotated NO_REPLY returns ER_OK
+     * once its handler ran, a handler that returns without a reply fails the
+     * call with ER_TIMEOUT, as does a call the task queue does not run in time
+     * @param objectPath - object path of the App or the Acl
+     * @param interfaceName - the interface of the method
+     * @param methodName - the method
+     * @param args - args of the call
+     * @param numArgs - number of args
+     * @param reply - set to the reply
+     * @return status - ER_OK or the error the call failed or the method replied with
+     */
+    QStatus callMethod(qcc::String const& objectPath, qcc::String const& interfaceName, qcc::String const& methodName,
+                       const MsgArg* args, size_t numArgs, GatewayLoopbackReply* reply);
+
+    /**
+     * Feed an announcement to the registered AboutListeners
+     * @param busName - the bus name of the announcer
+     * @param version - the version of the announcement
+     * @param port - the session port of the announcer
+     * @param objectDescriptionArg - the object description
+     * @param aboutDataArg - the AboutData
+     */
+    void announce(const char* busName, uint16_t version, SessionPort port, const MsgArg& objectDescriptionArg, const MsgArg& aboutDataArg);
+
+    /**
+     * Register a signal handler
+     * @param signalHandler - the signal handler
+     */
+    void registerSignalHandler(GatewayLoopbackSignalHandler* signalHandler);
+
+    /**
+     * Unregister a signal handler
+     * @param signalHandler - the signal handler
+     */
+    void unregisterSignalHandler(GatewayLoopbackSignalHandler* signalHandler);
+
+    /**
+     * Get a registered BusObject
+     * @param objectPath - the object path
+     * @return busObject or NULL if no BusObject is registered at the object path
+     */
+    BusObject* getBusObject(qcc::String const& objectPath);
+
+    /**
+     * Get the number of registered BusObjects
+     * @return numBusObjects
+     */
+    size_t getNumBusObjects();
+
+    /**
+     * Get the number of ReloadConfig calls so far
+     * @return numReloads
+     */
+    uint64_t getNumReloads();
+
+    /**
+     * Get the number of signals sent so far
+     * @return numSignals
+     */
+    uint64_t getNumSignals();
+
+  private:
+
+    /**
+     * The BusAttachment the interfaces are created on
+     */
+    BusAttachment* m_Bus;
+
+    /**
+     * Time the stub ReloadConfig takes in microseconds
+     */
+    uint32_t m_ReloadUs;
+
+    /**
+     * A method call made with callMethod
+     */
+    struct PendingCall;
+
+    /**
+     * Number of ReloadConfig calls so far
+     */
+    uint64_t m_NumReloads;
+
+    /**
+     * Number of signals sent so far
+     */
+    uint64_t m_NumSignals;
+
+    /**
+     * Guards the registered objects, listeners and counters
+     */
+    GatewayMutex m_Lock;
+
+    /**
+     * Guards the pending calls
+     */
+    pthread_mutex_t m_CallLock;
+
+    /**
+     * Signaled when a pending call got its reply
+     */
+    pthread_cond_t m_CallReplied;
+
+    /**
+     * The pending calls by their message
+     */
+    std::map<const _Message*, PendingCall*> m_Calls;
+
+    /**
+     * The registered BusObjects by object path
+     */
+    std::map<qcc::String, BusObject*> m_BusObjects;
+
+    /**
+     * The bound session ports
+     */
+    std::map<SessionPort, SessionPortListener*> m_SessionPorts;
+
+    /**
+     * The registered BusListeners
+     */
+    std::vector<BusListener*> m_BusListeners;
+
+    /**
+     * The registered AboutListeners
+     */
+    std::vector<AboutListener*> m_AboutListeners;
+
+    /**
+     * The registered signal handlers
+     */
+    std::vector<GatewayLoopbackSignalHandler*> m_SignalHandlers;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYLOOPBACKBUS_H_ */
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef GATEWAYMANIFESTREPLIES_H_
+#define GATEWAYMANIFESTREPLIES_H_
+
+#include <alljoyn/MsgArg.h>
+#include <alljoyn/gateway/GatewayConnectorAppManifest.h>
+#include <alljoyn/gateway/GatewayMsgArgArena.h>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * Marshaled replies of GetManifestFile and GetManifestInterfaces for a Manifest.
+ * They are built once when the Manifest is loaded and do not change afterwards,
+ * so the replies can be sent from any thread without copying or marshaling
+ */
+class GatewayManifestReplies {
+  public:
+
+    /**
+     * Constructor for GatewayManifestReplies
+     * @param manifest - the manifest to marshal. Must outlive the replies
+     */
+    GatewayManifestReplies(GatewayConnectorAppManifest const& manifest);
+
+    /**
+     * Get the reply args of GetManifestFile
+     * @return reply - 1 arg, NULL if marshaling failed
+     */
+    const MsgArg* getManifestFileReply() const;
+
+    /**
+     * Get the reply args of GetManifestInterfaces: exposedServices and remotedServices
+     * @return reply - 2 args, NULL if marshaling failed
+     */
+    const MsgArg* getManifestInterfacesReply() const;
+
+  private:
+
+    /**
+     * Private copy constructor - the args point into the arena
+     */
+    GatewayManifestReplies(const GatewayManifestReplies&);
+
+    /**
+     * Private assignment operator - the args point into the arena
+     */
+    GatewayManifestReplies& operator=(const GatewayManifestReplies&);
+
+    /**
+     * Marshal Capabilities into an array arg
+     * @param capabilities - the capabilities to marshal
+     * @param msgArg - the arg to fill
+     * @param arena - arena for the arrays of the msgArg
+     * @return status - success/failure
+     */
+    static QStatus marshalCapabilities(const GatewayConnectorAppManifest::Capabilities& capabilities, MsgArg* msgArg,
+                                       GatewayMsgArgArena* arena);
+
+    /**
+     * Count the MsgArgs needed to marshal Capabilities, used to size the arena
+     * @param capabilities - the capabilities to count
+     * @return numArgs
+     */
+    static size_t countCapabilityArgs(const GatewayConnectorAppManifest::Capabilities& capabilities);
+
+    /**
+     * Arena holding the arrays of the marshaled replies. Declared before
+     * the replies so it is released after them
+     */
+    GatewayMsgArgArena m_Arena;
+
+    /**
+     * The marshaled reply of GetManifestFile
+     */
+    MsgArg m_ManifestFile[1];
+
+    /**
+     * Status of marshaling the reply of GetManifestFile
+     */
+    QStatus m_ManifestFileStatus;
+
+    /**
+     * The marshaled reply of GetManifestInterfaces
+     */
+    MsgArg m_ManifestInterfaces[2];
+
+    /**
+     * Status of marshaling the reply of GetManifestInterfaces
+     */
+    QStatus m_ManifestInterfacesStatus;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYMANIFESTREPLIES_H_ */
@@ -15,8 +15,10 @@
  ******************************************************************************/
 
 #include <alljoyn/gateway/GatewayAppIdentifier.h>
+#include <alljoyn/gateway/GatewayMutex.h>
 #include <alljoyn/Status.h>
 #include <map>
+#include <qcc/STLContainer.h>
 
 #ifndef GATEWAYMETADATAMANAGER_H_
 #define GATEWAYMETADATAMANAGER_H_
@@ -25,7 +27,8 @@ namespace ajn {
 namespace gw {
 
 /**
- * Class that manages the Metadata
+ * Class that manages the Metadata. Shared by all Connector Apps, so every
+ * public function holds the metadata lock
  */
 class GatewayMetadataManager {
 
@@ -94,10 +97,20 @@ class GatewayMetadataManager {
             appNameKey(appKey), deviceNameKey(deviceKey), appName(app), deviceName(device), refCount(0) { }
     };
 
+    /**
+     * Hash table of the MetadataValues of the remote apps
+     */
+    typedef std::unordered_map<GatewayAppIdentifier, MetadataValues, GatewayAppIdentifierHash> MetadataMap;
+
+    /**
+     * Lock guarding the Metadata
+     */
+    GatewayMutex m_MetadataLock;
+
     /**
      * Metadata being managed
      */
-    std::map<GatewayAppIdentifier, MetadataValues> m_Metadata;
+    MetadataMap m_Metadata;
 
     /**
      * Write Metadata to file
@@ -18,6 +18,7 @@
 #define GATEWAYMANAGEMENT_H_
 
 #include <alljoyn/BusAttachment.h>
+#include <alljoyn/gateway/GatewayBus.h>
 #include <alljoyn/gateway/GatewayBusListener.h>
 #include <map>
 
@@ -29,9 +30,33 @@ namespace gw {
 class GatewayRouterPolicyManager;
 class GatewayConnectorAppManager;
 class GatewayMetadataManager;
+class GatewayEventLoop;
 
 /**
  * GatewayMgmt class. Used to initialize and shutdown the GatewayMgmt instance
+ *
+ * Threading model:
+ * - Every GatewayConnectorApp is a shard with its own GatewayTaskQueue. The
+ *   method handlers of its AppBusObject and AclBusObjects, SIGCHLD handling
+ *   and connector starts are posted to that queue, so the App and its Acls
+ *   are only modified on one thread. Different Apps run concurrently.
+ * - After every Acl change the App publishes an immutable GatewayAclSet.
+ *   Read-only Acl queries are served from the last published set on the
+ *   calling thread and never wait for the task queue.
+ * - Threads stopping or restarting a connector process only send signals and
+ *   poll the process id; the restart itself is posted to the queue.
+ * - GatewayRouterPolicyManager is the single owner of the policy files. Rule
+ *   changes, Announced callbacks and commits are serialized by its lock.
+ * - GatewayMetadataManager and GatewayBusListener guard their state with their
+ *   own locks. These locks are leaves and are never held while calling out.
+ * - The Apps of the GatewayConnectorAppManager are created in init and
+ *   destroyed in shutdown only, so the map itself needs no lock and is
+ *   handed out by reference.
+ * - Signals are handled on the thread of the GatewayEventLoop of the process,
+ *   which also runs the timers of the scheduled work: the end of the
+ *   AppStatusChanged coalescing window and the staggered connector starts.
+ *   Timers hand App state changes to the task queue of the App and must not
+ *   block for long.
  */
 class GatewayMgmt {
 
@@ -44,7 +69,8 @@ class GatewayMgmt {
     static GatewayMgmt* getInstance();
 
     /**
-     * Callback when child dies
+     * Callback when child dies. Reaps every child that exited, since
+     * several SIGCHLDs may be delivered as one
      * @param signum
      */
     static void sigChildCallback(int32_t signum);
@@ -61,6 +87,13 @@ class GatewayMgmt {
      */
     QStatus initGatewayMgmt(BusAttachment* bus);
 
+    /**
+     * Initialize the GatewayMgmt instance on a GatewayBus, e.g. a GatewayLoopbackBus
+     * @param bus - bus used for GatewayMgmt, owned by the caller
+     * @return status
+     */
+    QStatus initGatewayMgmt(GatewayBus* bus);
+
     /**
      * Shutdown the GatewayMgmt instance. Allows a new call to initGatewayMgmt to be made
      * @return status
@@ -79,6 +112,12 @@ class GatewayMgmt {
      */
     BusAttachment* getBusAttachment() const;
 
+    /**
+     * Get the GatewayBus of the GatewayMgmt
+     * @return the bus
+     */
+    GatewayBus* getBus() const;
+
     /**
      * Get the RouterPolicyManager of the GatewayMgmt
      * @return the routerPolicyManager
@@ -115,6 +154,63 @@ class GatewayMgmt {
      */
     void setAppPolicyDir(const char* appPolicyDirectory);
 
+    /**
+     * Start the Connector Apps. Should be called once initGatewayMgmt
+     * succeeded and the gateway was announced
+     * @return status
+     */
+    QStatus startConnectorApps();
+
+    /**
+     * Set the number of Connector Apps started in one batch
+     * @param concurrency
+     */
+    void setConnectorStartConcurrency(uint32_t concurrency);
+
+    /**
+     * Set the delay between two batches of Connector App starts
+     * @param staggerMs - delay in milliseconds
+     */
+    void setConnectorStartStagger(uint32_t staggerMs);
+
+    /**
+     * Set whether signals meant for every session are sent once to all
+     * hosted sessions. Requires a router that supports SESSION_ID_ALL_HOSTED
+     * @param sessioncast
+     */
+    void setSessioncastSignals(bool sessioncast);
+
+    /**
+     * Get whether signals meant for every session are sent once to all hosted sessions
+     * @return sessioncast
+     */
+    bool getSessioncastSignals() const;
+
+    /**
+     * Set whether the BusObjects of Acls are only registered once their
+     * ObjectPath is handed out, instead of when the Acls are loaded
+     * @param onDemand
+     */
+    void setAclObjectsOnDemand(bool onDemand);
+
+    /**
+     * Get whether the BusObjects of Acls are only registered once their ObjectPath is handed out
+     * @return onDemand
+     */
+    bool getAclObjectsOnDemand() const;
+
+    /**
+     * Set the event loop of the process. The loop is owned by the caller
+     * @param eventLoop
+     */
+    void setEventLoop(GatewayEventLoop* eventLoop);
+
+    /**
+     * Get the event loop of the process
+     * @return eventLoop - NULL if none was set
+     */
+    GatewayEventLoop* getEventLoop() const;
+
   private:
 
     /**
@@ -129,9 +225,14 @@ class GatewayMgmt {
     static GatewayMgmt* s_Instance;
 
     /**
-     * BusAttachement used in GatewayMgmt instance
+     * Bus used in GatewayMgmt instance
      */
-    BusAttachment* m_Bus;
+    GatewayBus* m_Bus;
+
+    /**
+     * GatewayBus of the BusAttachment passed to initGatewayMgmt
+     */
+    GatewayRouterBus* m_RouterBus;
 
     /**
      * The Buslistener of the GatewayMgmt instance
@@ -163,6 +264,31 @@ class GatewayMgmt {
      */
     qcc::String m_appPolicyDirectory;
 
+    /**
+     * Number of Connector Apps started in one batch
+     */
+    uint32_t m_connectorStartConcurrency;
+
+    /**
+     * Delay between two batches of Connector App starts in milliseconds
+     */
+    uint32_t m_connectorStartStagger;
+
+    /**
+     * Whether signals meant for every session are sent once to all hosted sessions
+     */
+    bool m_sessioncastSignals;
+
+    /**
+     * Whether the BusObjects of Acls are only registered once their ObjectPath is handed out
+     */
+    bool m_aclObjectsOnDemand;
+
+    /**
+     * The event loop of the process
+     */
+    GatewayEventLoop* m_eventLoop;
+
 };
 
 } //namespace gw
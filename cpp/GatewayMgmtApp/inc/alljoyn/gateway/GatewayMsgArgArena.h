@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef GATEWAYMSGARGARENA_H_
+#define GATEWAYMSGARGARENA_H_
+
+#include <vector>
+#include <alljoyn/MsgArg.h>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * Arena for the MsgArg arrays and string pointer arrays of a marshaled reply.
+ * The marshaling code counts what it needs and reserves it in one pass, so a
+ * reply costs one block of MsgArgs and one block of string pointers no matter
+ * how many lists it contains. Everything is released in one shot when the
+ * arena is released or destroyed, so the arena must outlive the MsgArgs that
+ * point into it and those MsgArgs must not own their arrays
+ */
+class GatewayMsgArgArena {
+  public:
+
+    /**
+     * Constructor for GatewayMsgArgArena
+     */
+    GatewayMsgArgArena();
+
+    /**
+     * Destructor for GatewayMsgArgArena. Releases the arena
+     */
+    virtual ~GatewayMsgArgArena();
+
+    /**
+     * Make sure the arena can hand out the given number of MsgArgs and string
+     * pointers without allocating again
+     * @param numArgs - number of MsgArgs needed
+     * @param numStrings - number of string pointers needed
+     */
+    void reserve(size_t numArgs, size_t numStrings);
+
+    /**
+     * Get an array of MsgArgs from the arena. Falls back to a block of its own
+     * if not enough was reserved
+     * @param numArgs - size of the array
+     * @return args - NULL if numArgs is 0
+     */
+    MsgArg* allocArgs(size_t numArgs);
+
+    /**
+     * Get an array of string pointers from the arena. Falls back to a block of
+     * its own if not enough was reserved
+     * @param numStrings - size of the array
+     * @return strings - NULL if numStrings is 0
+     */
+    const char** allocStrings(size_t numStrings);
+
+    /**
+     * Release all the blocks of the arena
+     */
+    void release();
+
+    /**
+     * Get the number of blocks allocated since the arena was last released
+     * @return numAllocations
+     */
+    size_t getNumAllocations() const;
+
+  private:
+
+    /**
+     * Private copy constructor - an arena can not be copied
+     */
+    GatewayMsgArgArena(const GatewayMsgArgArena&);
+
+    /**
+     * Private assignment operator - an arena can not be copied
+     */
+    GatewayMsgArgArena& operator=(const GatewayMsgArgArena&);
+
+    /**
+     * The reserved MsgArgs
+     */
+    MsgArg* m_Args;
+
+    /**
+     * Number of reserved MsgArgs
+     */
+    size_t m_ArgsSize;
+
+    /**
+     * Number of reserved MsgArgs handed out
+     */
+    size_t m_ArgsUsed;
+
+    /**
+     * The reserved string pointers
+     */
+    const char** m_Strings;
+
+    /**
+     * Number of reserved string pointers
+     */
+    size_t m_StringsSize;
+
+    /**
+     * Number of reserved string pointers handed out
+     */
+    size_t m_StringsUsed;
+
+    /**
+     * Blocks of MsgArgs that did not fit in the reserved block
+     */
+    std::vector<MsgArg*> m_OverflowArgs;
+
+    /**
+     * Blocks of string pointers that did not fit in the reserved block
+     */
+    std::vector<const char**> m_OverflowStrings;
+
+    /**
+     * Number of blocks allocated since the arena was last released
+     */
+    size_t m_NumAllocations;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYMSGARGARENA_H_ */
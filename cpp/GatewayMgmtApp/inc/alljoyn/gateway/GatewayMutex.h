@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef GATEWAYMUTEX_H_
+#define GATEWAYMUTEX_H_
+
+#include <pthread.h>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * Recursive mutex used to guard state shared between threads
+ */
+class GatewayMutex {
+  public:
+
+    /**
+     * Constructor for GatewayMutex
+     */
+    GatewayMutex();
+
+    /**
+     * Destructor for GatewayMutex
+     */
+    virtual ~GatewayMutex();
+
+    /**
+     * Lock the mutex
+     */
+    void lock();
+
+    /**
+     * Unlock the mutex
+     */
+    void unlock();
+
+  private:
+
+    /**
+     * Private copy constructor - a mutex can not be copied
+     */
+    GatewayMutex(const GatewayMutex&);
+
+    /**
+     * Private assignment operator - a mutex can not be copied
+     */
+    GatewayMutex& operator=(const GatewayMutex&);
+
+    /**
+     * The underlying mutex
+     */
+    pthread_mutex_t m_Mutex;
+};
+
+/**
+ * Locks a GatewayMutex for the lifetime of the object
+ */
+class GatewayScopedLock {
+  public:
+
+    /**
+     * Constructor for GatewayScopedLock. Locks the mutex
+     * @param mutex - the mutex to lock
+     */
+    GatewayScopedLock(GatewayMutex& mutex);
+
+    /**
+     * Destructor for GatewayScopedLock. Unlocks the mutex
+     */
+    ~GatewayScopedLock();
+
+  private:
+
+    /**
+     * Private copy constructor - a lock can not be copied
+     */
+    GatewayScopedLock(const GatewayScopedLock&);
+
+    /**
+     * Private assignment operator - a lock can not be copied
+     */
+    GatewayScopedLock& operator=(const GatewayScopedLock&);
+
+    /**
+     * The locked mutex
+     */
+    GatewayMutex& m_Mutex;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYMUTEX_H_ */
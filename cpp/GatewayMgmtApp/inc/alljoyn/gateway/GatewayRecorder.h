@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef GATEWAYRECORDER_H_
+#define GATEWAYRECORDER_H_
+
+#include <qcc/platform.h>
+#include <qcc/String.h>
+#include <alljoyn/Message.h>
+#include <alljoyn/MsgArg.h>
+#include <alljoyn/Session.h>
+#include <alljoyn/InterfaceDescription.h>
+#include <string>
+#include <vector>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * Types of the events of a recording
+ */
+typedef enum {
+    GW_RECORD_METHOD_CALL = 1,      //!< METHOD_CALL
+    GW_RECORD_ANNOUNCEMENT = 2      //!< ANNOUNCEMENT
+} GatewayRecordType;
+
+/**
+ * An event read back from a recording
+ */
+struct GatewayRecordedEvent {
+
+    /**
+     * The type of the event
+     */
+    GatewayRecordType m_Type;
+
+    /**
+     * Time of the event in microseconds since the recording started
+     */
+    uint64_t m_TimestampUs;
+
+    /**
+     * Object path of a method call
+     */
+    qcc::String m_ObjectPath;
+
+    /**
+     * Interface of a method call
+     */
+    qcc::String m_Interface;
+
+    /**
+     * Member of a method call
+     */
+    qcc::String m_Member;
+
+    /**
+     * Bus name of an announcement
+     */
+    qcc::String m_BusName;
+
+    /**
+     * Version of an announcement
+     */
+    uint16_t m_Version;
+
+    /**
+     * Session port of an announcement
+     */
+    SessionPort m_Port;
+
+    /**
+     * Args of a method call, or the object description and the AboutData of an announcement
+     */
+    std::vector<MsgArg> m_Args;
+};
+
+/**
+ * Process-wide recording of the inbound management method calls and the
+ * announcements, with their args and arrival time, into a compact binary
+ * file. While recording is off recording an event costs a single branch
+ */
+class GatewayRecorder {
+  public:
+
+    /**
+     * Start recording. A recording in progress is stopped first
+     * @param fileName - the file to write, truncated
+     * @return status - success/failure
+     */
+    static QStatus start(qcc::String const& fileName);
+
+    /**
+     * Stop recording and close the file
+     */
+    static void stop();
+
+    /**
+     * Check whether events are recorded
+     * @return true/false
+     */
+    static bool isRecording()
+    {
+        return s_Recording;
+    }
+
+    /**
+     * Record an inbound method call
+     * @param member - the member that was called
+     * @param msg - the method call
+     */
+    static void recordMethodCall(const InterfaceDescription::Member* member, Message& msg);
+
+    /**
+     * Record an announcement
+     * @param busName - the bus name of the announcer
+     * @param version - the version of the announcement
+     * @param port - the session port of the announcer
+     * @param objectDescriptionArg - the object description
+     * @param aboutDataArg - the AboutData
+     */
+    static void recordAnnouncement(const char* busName, uint16_t version, SessionPort port, const MsgArg& objectDescriptionArg,
+                                   const MsgArg& aboutDataArg);
+
+  private:
+
+    /**
+     * Private constructor - GatewayRecorder only has static members
+     */
+    GatewayRecorder();
+
+    /**
+     * Whether events are recorded
+     */
+    static volatile bool s_Recording;
+};
+
+/**
+ * Reads the events of a recording back in the order they were recorded
+ */
+class GatewayRecordReader {
+  public:
+
+    /**
+     * Constructor for GatewayRecordReader
+     */
+    GatewayRecordReader();
+
+    /**
+     * Destructor for GatewayRecordReader
+     */
+    virtual ~GatewayRecordReader();
+
+    /**
+     * Read a recording into memory
+     * @param fileName - the recording
+     * @return status - success/failure
+     */
+    QStatus open(qcc::String const& fileName);
+
+    /**
+     * Read the next event
+     * @param event - the event to fill
+     * @return status - ER_OK, ER_EOF after the last event or ER_READ_ERROR if the recording is corrupt
+     */
+    QStatus next(GatewayRecordedEvent* event);
+
+  private:
+
+    /**
+     * The content of the recording
+     */
+    std::string m_Content;
+
+    /**
+     * Offset of the next event in m_Content
+     */
+    size_t m_Offset;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYRECORDER_H_ */
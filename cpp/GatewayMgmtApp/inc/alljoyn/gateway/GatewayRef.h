@@ -0,0 +1,180 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef GATEWAYREF_H_
+#define GATEWAYREF_H_
+
+#include <qcc/platform.h>
+#include <qcc/atomic.h>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * Base class for objects that are shared between threads by reference count.
+ * Objects deriving from it are immutable once published and are deleted
+ * when the last GatewayRef referencing them goes away
+ */
+class GatewayRefCounted {
+  public:
+
+    /**
+     * Constructor for GatewayRefCounted
+     */
+    GatewayRefCounted() : m_RefCount(0) { }
+
+    /**
+     * Destructor for GatewayRefCounted
+     */
+    virtual ~GatewayRefCounted() { }
+
+    /**
+     * Add a reference
+     */
+    void incRef() const
+    {
+        qcc::IncrementAndFetch(&m_RefCount);
+    }
+
+    /**
+     * Release a reference. Deletes the object when the last reference is released
+     */
+    void decRef() const
+    {
+        if (qcc::DecrementAndFetch(&m_RefCount) == 0) {
+            delete this;
+        }
+    }
+
+  private:
+
+    /**
+     * Private copy constructor - the reference count can not be copied
+     */
+    GatewayRefCounted(const GatewayRefCounted&);
+
+    /**
+     * Private assignment operator - the reference count can not be copied
+     */
+    GatewayRefCounted& operator=(const GatewayRefCounted&);
+
+    /**
+     * The reference count
+     */
+    mutable volatile int32_t m_RefCount;
+};
+
+/**
+ * Reference to a GatewayRefCounted object. Copying a GatewayRef shares the object
+ */
+template <typename T>
+class GatewayRef {
+  public:
+
+    /**
+     * Constructor for GatewayRef
+     * @param object - the object to reference. May be NULL
+     */
+    explicit GatewayRef(const T* object = NULL) : m_Object(object)
+    {
+        if (m_Object) {
+            m_Object->incRef();
+        }
+    }
+
+    /**
+     * Copy constructor for GatewayRef
+     * @param other - the reference to copy
+     */
+    GatewayRef(const GatewayRef& other) : m_Object(other.m_Object)
+    {
+        if (m_Object) {
+            m_Object->incRef();
+        }
+    }
+
+    /**
+     * Destructor for GatewayRef
+     */
+    ~GatewayRef()
+    {
+        if (m_Object) {
+            m_Object->decRef();
+        }
+    }
+
+    /**
+     * Assignment operator for GatewayRef
+     * @param other - the reference to copy
+     * @return this reference
+     */
+    GatewayRef& operator=(const GatewayRef& other)
+    {
+        GatewayRef copy(other);
+        swap(copy);
+        return *this;
+    }
+
+    /**
+     * Swap the referenced objects without touching the reference counts
+     * @param other - the reference to swap with
+     */
+    void swap(GatewayRef& other)
+    {
+        const T* object = m_Object;
+        m_Object = other.m_Object;
+        other.m_Object = object;
+    }
+
+    /**
+     * Get the referenced object
+     * @return object - may be NULL
+     */
+    const T* get() const
+    {
+        return m_Object;
+    }
+
+    /**
+     * Access the referenced object
+     * @return object
+     */
+    const T* operator->() const
+    {
+        return m_Object;
+    }
+
+    /**
+     * Access the referenced object
+     * @return object
+     */
+    const T& operator*() const
+    {
+        return *m_Object;
+    }
+
+  private:
+
+    /**
+     * The referenced object
+     */
+    const T* m_Object;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYREF_H_ */
@@ -23,6 +23,7 @@
 #include <qcc/String.h>
 #include <alljoyn/gateway/GatewayAclRules.h>
 #include <alljoyn/gateway/GatewayMgmt.h>
+#include <alljoyn/gateway/GatewayMutex.h>
 #include <alljoyn/about/AnnounceHandler.h>
 #include <libxml/tree.h>
 #include <libxml/xmlwriter.h>
@@ -30,9 +31,15 @@
 namespace ajn {
 namespace gw {
 
+/**
+ * Hash table of the announced apps to the bus names they announced with
+ */
+typedef std::unordered_map<GatewayAppIdentifier, qcc::String, GatewayAppIdentifierHash> GatewayAnnouncedDevices;
+
 /**
  * GatewayRouterPolicyManager - Class that manages policies defined and updates the
- * daemon config file accordingly
+ * daemon config file accordingly. It is the single owner of the policy files:
+ * all rule changes, file writes and ReloadConfig calls are serialized by its lock
  */
 class GatewayRouterPolicyManager : public AboutListener {
 
@@ -54,23 +61,32 @@ class GatewayRouterPolicyManager : public AboutListener {
      * @param bus - bus used to initialize
      * @return status - success/failure
      */
-    QStatus init(BusAttachment* bus);
+    QStatus init(GatewayBus* bus);
 
     /**
      * shutdown the GatewayRouterPolicyManager
      * @param bus - bus used for shutdown
      * @return status - success/failure
      */
-    QStatus shutdown(BusAttachment* bus);
+    QStatus shutdown(GatewayBus* bus);
 
     /**
-     * Add rules for a connector app
+     * Add rules for a connector app. The rules share their structure with
+     * the Acls they come from
      * @param connectorId - the connectorId to add
      * @param rules - the rules for that app
      * @return success/failure
      */
     bool addConnectorAppRules(qcc::String const& connectorId, std::vector<GatewayAclRules> const& rules);
 
+    /**
+     * Add rules for a set of connector apps. All changes are applied
+     * with a single commit when autocommit is on
+     * @param rules - map of connectorIds to the rules for that app
+     * @return success/failure
+     */
+    bool addConnectorAppRules(std::map<qcc::String, std::vector<GatewayAclRules> > const& rules);
+
     /**
      * Remove rules for a connector app
      * @param connectorId - connectorId to remove
@@ -78,6 +94,14 @@ class GatewayRouterPolicyManager : public AboutListener {
      */
     bool removeConnectorAppRules(qcc::String const& connectorId);
 
+    /**
+     * Remove rules for a set of connector apps. All removals are applied
+     * with a single commit when autocommit is on
+     * @param connectorIds - connectorIds to remove
+     * @return success/failure
+     */
+    bool removeConnectorAppRules(std::vector<qcc::String> const& connectorIds);
+
     /**
      * Commit all Rules as policies in the daemon config file
      * @return success/failure
@@ -108,7 +132,7 @@ class GatewayRouterPolicyManager : public AboutListener {
      * Get the map of announced devices
      * @return announced devices map
      */
-    const std::map<GatewayAppIdentifier, qcc::String>& getAnnouncedDevices() const;
+    const GatewayAnnouncedDevices& getAnnouncedDevices() const;
 
     /**
      * Get the currently defined AclRules for each connector App
@@ -124,6 +148,12 @@ class GatewayRouterPolicyManager : public AboutListener {
      */
     void setAutoCommit(bool autoCommit);
 
+    /**
+     * Get the AutoCommit flag
+     * @return autoCommit
+     */
+    bool getAutoCommit() const;
+
     /**
      * Set the name of the gateway default policy file
      * @param gatewayPolicyFile
@@ -136,8 +166,22 @@ class GatewayRouterPolicyManager : public AboutListener {
      */
     void setAppPolicyDirectory(const char* appPolicyDirectory);
 
+  protected:
+
+    /**
+     * Ask the bus of the GatewayMgmt to reload its config after the policy files
+     * were written. Called with the policy lock held
+     * @return success/failure
+     */
+    virtual QStatus reloadConfig();
+
   private:
 
+    /**
+     * Lock serializing rule changes and commits
+     */
+    mutable GatewayMutex m_PolicyLock;
+
     /**
      * Boolean to track whether the AboutListener was already registered
      */
@@ -152,7 +196,7 @@ class GatewayRouterPolicyManager : public AboutListener {
     /**
      * Map of Announced devices, mapped to their busName
      */
-    std::map<GatewayAppIdentifier, qcc::String> m_AnnouncedDevices;
+    GatewayAnnouncedDevices m_AnnouncedDevices;
 
     /**
      * AclRules. Map of ConnectorIds to their AclRules
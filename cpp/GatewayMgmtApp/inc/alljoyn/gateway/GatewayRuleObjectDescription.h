@@ -18,13 +18,16 @@
 #define GatewayRuleObjectDescription_H_
 
 #include <qcc/String.h>
+#include <alljoyn/gateway/GatewayInternedString.h>
 #include <vector>
 
 namespace ajn {
 namespace gw {
 
 /**
- * Class used to define an ObjectDescription
+ * Class used to define an ObjectDescription. The ObjectPath and Interfaces
+ * are held as interned strings, so rules share one copy of every path and
+ * interface name and compare them by handle
  */
 class GatewayRuleObjectDescription {
 
@@ -43,6 +46,14 @@ class GatewayRuleObjectDescription {
      */
     GatewayRuleObjectDescription(qcc::String const& objectPath, bool isPrefix, std::vector<qcc::String> const& interfaces);
 
+    /**
+     * Constructor for the GatewayRuleObjectDescription class
+     * @param objectPath - interned objectPath of the ObjectDescription
+     * @param isPrefix - isPrefix of the ObjectDescription
+     * @param interfaces - interned interfaces of the ObjectDescription
+     */
+    GatewayRuleObjectDescription(GatewayInternedString const& objectPath, bool isPrefix, GatewayInternedStrings const& interfaces);
+
     /**
      * Destructor of the GatewayRuleObjectDescription class
      */
@@ -52,13 +63,13 @@ class GatewayRuleObjectDescription {
      * Get the interfaces of the ObjectDescription
      * @return interfaces vector
      */
-    const std::vector<qcc::String>& getInterfaces() const;
+    const GatewayInternedStrings& getInterfaces() const;
 
     /**
      * Set the interfaces of the ObjectDescription
      * @param interfaces
      */
-    void setInterfaces(const std::vector<qcc::String>& interfaces);
+    void setInterfaces(const GatewayInternedStrings& interfaces);
 
     /**
      * Get the ObjectPath of the ObjectDescription
@@ -66,6 +77,12 @@ class GatewayRuleObjectDescription {
      */
     const qcc::String& getObjectPath() const;
 
+    /**
+     * Get the interned ObjectPath of the ObjectDescription
+     * @return objectPath
+     */
+    const GatewayInternedString& getObjectPathId() const;
+
     /**
      * Set the ObjectPath of the ObjectDescription
      * @param objectPath
@@ -89,7 +106,7 @@ class GatewayRuleObjectDescription {
     /**
      * The ObjectPath of the ObjectDescription
      */
-    qcc::String m_ObjectPath;
+    GatewayInternedString m_ObjectPath;
 
     /**
      * Is the ObjectPath a Prefix
@@ -99,7 +116,7 @@ class GatewayRuleObjectDescription {
     /**
      * The Interfaces of the ObjectDescription
      */
-    std::vector<qcc::String> m_Interfaces;
+    GatewayInternedStrings m_Interfaces;
 };
 
 } /* namespace gw */
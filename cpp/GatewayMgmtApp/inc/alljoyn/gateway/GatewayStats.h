@@ -0,0 +1,228 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef GATEWAYSTATS_H_
+#define GATEWAYSTATS_H_
+
+#include <qcc/platform.h>
+#include <qcc/String.h>
+#include <alljoyn/InterfaceDescription.h>
+#include <vector>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * Counters kept by GatewayStats
+ */
+typedef enum {
+    GW_STATS_POLICY_COMMITS = 0,            //!< POLICY_COMMITS
+    GW_STATS_POLICY_BYTES_WRITTEN,          //!< POLICY_BYTES_WRITTEN
+    GW_STATS_ANNOUNCEMENTS_RECEIVED,        //!< ANNOUNCEMENTS_RECEIVED
+    GW_STATS_ANNOUNCEMENTS_IGNORED,         //!< ANNOUNCEMENTS_IGNORED
+    GW_STATS_ANNOUNCEMENTS_APPLIED,         //!< ANNOUNCEMENTS_APPLIED
+    GW_STATS_ACL_CREATES,                   //!< ACL_CREATES
+    GW_STATS_ACL_UPDATES,                   //!< ACL_UPDATES
+    GW_STATS_ACL_PATCHES,                   //!< ACL_PATCHES
+    GW_STATS_ACL_STATUS_UPDATES,            //!< ACL_STATUS_UPDATES
+    GW_STATS_ACL_DELETES,                   //!< ACL_DELETES
+    GW_STATS_ACL_BATCHES,                   //!< ACL_BATCHES
+    GW_STATS_CONNECTOR_STARTS,              //!< CONNECTOR_STARTS
+    GW_STATS_CONNECTOR_EXITS,               //!< CONNECTOR_EXITS
+    GW_STATS_SESSIONS_JOINED,               //!< SESSIONS_JOINED
+    GW_STATS_SESSIONS_LOST,                 //!< SESSIONS_LOST
+    GW_STATS_NUM_COUNTERS                   //!< NUM_COUNTERS
+} GatewayStatsCounter;
+
+/**
+ * Latency histograms kept by GatewayStats, besides the per method ones
+ */
+typedef enum {
+    GW_STATS_POLICY_COMMIT_LATENCY = 0,     //!< POLICY_COMMIT_LATENCY
+    GW_STATS_RELOAD_CONFIG_LATENCY,         //!< RELOAD_CONFIG_LATENCY
+    GW_STATS_NUM_HISTOGRAMS                 //!< NUM_HISTOGRAMS
+} GatewayStatsHistogram;
+
+/**
+ * Number of buckets of a latency histogram. The last bucket has no upper bound
+ */
+static const size_t GW_STATS_NUM_BUCKETS = 14;
+
+/**
+ * Process-wide counters and latency histograms of the agent. Updates hold a
+ * process-wide lock for a few adds so they can be made from any thread on the
+ * hot path. The histograms have fixed buckets, see getBucketBoundsUs
+ */
+class GatewayStats {
+  public:
+
+    /**
+     * Value of a counter in a snapshot
+     */
+    struct CounterValue {
+
+        /**
+         * The name of the counter
+         */
+        qcc::String m_Name;
+
+        /**
+         * The value of the counter
+         */
+        uint64_t m_Value;
+    };
+
+    /**
+     * Value of a latency histogram in a snapshot
+     */
+    struct HistogramValue {
+
+        /**
+         * The name of the histogram
+         */
+        qcc::String m_Name;
+
+        /**
+         * Number of recorded samples
+         */
+        uint64_t m_Count;
+
+        /**
+         * Sum of the recorded samples in microseconds
+         */
+        uint64_t m_SumUs;
+
+        /**
+         * Largest recorded sample in microseconds
+         */
+        uint64_t m_MaxUs;
+
+        /**
+         * Number of samples per bucket
+         */
+        uint64_t m_Buckets[GW_STATS_NUM_BUCKETS];
+    };
+
+    /**
+     * Add to a counter
+     * @param counter - the counter
+     * @param value - the amount to add
+     */
+    static void increment(GatewayStatsCounter counter, uint64_t value = 1);
+
+    /**
+     * Record a latency sample
+     * @param histogram - the histogram
+     * @param latencyUs - the latency in microseconds
+     */
+    static void recordLatency(GatewayStatsHistogram histogram, uint64_t latencyUs);
+
+    /**
+     * Record the latency of a method handler. The histogram of the member is
+     * created on its first call
+     * @param member - the member that was called
+     * @param latencyUs - the latency in microseconds
+     */
+    static void recordMethodLatency(const InterfaceDescription::Member* member, uint64_t latencyUs);
+
+    /**
+     * Reset all counters and histograms to zero. Updates made while the reset
+     * runs may be partly lost
+     */
+    static void reset();
+
+    /**
+     * Get the current values of all counters and of the histograms that have samples
+     * @param counters - the counters, appended to
+     * @param histograms - the histograms, appended to
+     */
+    static void getSnapshot(std::vector<CounterValue>* counters, std::vector<HistogramValue>* histograms);
+
+    /**
+     * Get the upper bounds of the histogram buckets
+     * @return upper bounds in microseconds, GW_STATS_NUM_BUCKETS - 1 entries
+     */
+    static const uint64_t* getBucketBoundsUs();
+
+    /**
+     * Get a monotonic timestamp
+     * @return time in microseconds
+     */
+    static uint64_t getMonotonicUs();
+
+  private:
+
+    /**
+     * Private constructor - GatewayStats only has static members
+     */
+    GatewayStats();
+};
+
+/**
+ * Records the time from its construction to its destruction in a histogram
+ */
+class GatewayStatsTimer {
+  public:
+
+    /**
+     * Constructor for GatewayStatsTimer
+     * @param histogram - the histogram to record in
+     */
+    GatewayStatsTimer(GatewayStatsHistogram histogram) :
+        m_Histogram(histogram), m_Member(NULL), m_StartUs(GatewayStats::getMonotonicUs()) { }
+
+    /**
+     * Constructor for GatewayStatsTimer
+     * @param member - the member whose method latency is recorded
+     */
+    GatewayStatsTimer(const InterfaceDescription::Member* member) :
+        m_Histogram(GW_STATS_NUM_HISTOGRAMS), m_Member(member), m_StartUs(GatewayStats::getMonotonicUs()) { }
+
+    /**
+     * Destructor for GatewayStatsTimer. Records the latency
+     */
+    ~GatewayStatsTimer()
+    {
+        uint64_t latencyUs = GatewayStats::getMonotonicUs() - m_StartUs;
+        if (m_Member) {
+            GatewayStats::recordMethodLatency(m_Member, latencyUs);
+        } else {
+            GatewayStats::recordLatency(m_Histogram, latencyUs);
+        }
+    }
+
+  private:
+
+    /**
+     * The histogram to record in
+     */
+    GatewayStatsHistogram m_Histogram;
+
+    /**
+     * The member whose method latency is recorded, NULL for m_Histogram
+     */
+    const InterfaceDescription::Member* m_Member;
+
+    /**
+     * The time the timer was started
+     */
+    uint64_t m_StartUs;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYSTATS_H_ */
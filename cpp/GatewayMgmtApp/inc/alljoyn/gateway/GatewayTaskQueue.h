@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef GATEWAYTASKQUEUE_H_
+#define GATEWAYTASKQUEUE_H_
+
+#include <pthread.h>
+#include <deque>
+#include <alljoyn/Status.h>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * A unit of work executed by a GatewayTaskQueue
+ */
+class GatewayTask {
+  public:
+
+    /**
+     * Destructor for GatewayTask
+     */
+    virtual ~GatewayTask() { }
+
+    /**
+     * Execute the task. Called on the thread of the queue
+     */
+    virtual void run() = 0;
+
+    /**
+     * Called instead of run when the queue was stopped before the
+     * task could be executed
+     */
+    virtual void cancel() { }
+};
+
+/**
+ * Queue with a single worker thread that executes GatewayTasks in the order
+ * they were posted. Every GatewayConnectorApp owns one queue - its shard -
+ * and all state of the app and its Acls is only modified on that thread
+ */
+class GatewayTaskQueue {
+  public:
+
+    /**
+     * Constructor for GatewayTaskQueue
+     */
+    GatewayTaskQueue();
+
+    /**
+     * Destructor for GatewayTaskQueue. Stops the queue
+     */
+    virtual ~GatewayTaskQueue();
+
+    /**
+     * Start the worker thread. Tasks posted before start are kept
+     * and executed once the thread runs
+     * @return status - success/failure
+     */
+    QStatus start();
+
+    /**
+     * Stop the worker thread. Tasks that were already posted are still
+     * executed, tasks posted afterwards are cancelled
+     */
+    void stop();
+
+    /**
+     * Post a task to the queue. The queue takes ownership of the task
+     * @param task - the task to execute
+     */
+    void post(GatewayTask* task);
+
+    /**
+     * Post a task and wait until it was executed or cancelled. Runs the
+     * task directly if called from the worker thread itself.
+     * The queue takes ownership of the task
+     * @param task - the task to execute
+     */
+    void postAndWait(GatewayTask* task);
+
+    /**
+     * Check whether the caller runs on the worker thread of this queue
+     * @return true/false
+     */
+    bool isCurrentThread() const;
+
+  private:
+
+    /**
+     * Private copy constructor - a queue can not be copied
+     */
+    GatewayTaskQueue(const GatewayTaskQueue&);
+
+    /**
+     * Private assignment operator - a queue can not be copied
+     */
+    GatewayTaskQueue& operator=(const GatewayTaskQueue&);
+
+    /**
+     * static function for the worker thread
+     * @param queue - the GatewayTaskQueue
+     */
+    static void* Run(void* queue);
+
+    /**
+     * The worker thread
+     */
+    pthread_t m_Thread;
+
+    /**
+     * The tasks waiting to be executed
+     */
+    std::deque<GatewayTask*> m_Tasks;
+
+    /**
+     * Lock guarding the tasks and the flags
+     */
+    pthread_mutex_t m_Lock;
+
+    /**
+     * Signalled when a task was posted or the queue is stopping
+     */
+    pthread_cond_t m_TaskPosted;
+
+    /**
+     * Signalled when a task was executed
+     */
+    pthread_cond_t m_TaskDone;
+
+    /**
+     * Whether the worker thread was started
+     */
+    bool m_IsRunning;
+
+    /**
+     * Whether the queue was stopped
+     */
+    bool m_IsStopping;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYTASKQUEUE_H_ */
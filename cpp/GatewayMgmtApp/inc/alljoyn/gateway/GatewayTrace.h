@@ -0,0 +1,156 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef GATEWAYTRACE_H_
+#define GATEWAYTRACE_H_
+
+#include <qcc/platform.h>
+#include <qcc/String.h>
+#include <alljoyn/Status.h>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * Process-wide trace of begin and end events. Every thread writes binary
+ * events into its own fixed-size ring buffer without taking a lock, so only
+ * the most recent events of each thread are kept. The number of rings is
+ * capped, a thread hands its ring back when it exits and threads that find
+ * no ring left record nothing. The rings are written out as a Chrome trace
+ * (JSON) on demand. While tracing is disabled recording an event costs a
+ * single branch
+ */
+class GatewayTrace {
+  public:
+
+    /**
+     * Enable or disable recording of events
+     * @param enabled - true to record events
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * Check whether events are recorded
+     * @return true/false
+     */
+    static bool isEnabled()
+    {
+        return s_Enabled;
+    }
+
+    /**
+     * Record the begin of a span on the ring of the calling thread
+     * @param name - name of the span. Only the pointer is kept, so it has to
+     * stay valid for the lifetime of the process, see internName
+     */
+    static void begin(const char* name);
+
+    /**
+     * Record the end of a span on the ring of the calling thread
+     * @param name - name of the span, the same as passed to begin
+     */
+    static void end(const char* name);
+
+    /**
+     * Get a copy of a span name that stays valid for the lifetime of the
+     * process. Equal names share one copy, the copies are never freed
+     * @param name - name of the span, e.g. the name of a method member
+     * @return the copy to pass to begin and end
+     */
+    static const char* internName(qcc::String const& name);
+
+    /**
+     * Write the events of all rings to a file in the Chrome trace format.
+     * Events overwritten while the dump runs are left out
+     * @param fileName - the file to write
+     * @return status - success/failure
+     */
+    static QStatus dump(qcc::String const& fileName);
+
+  private:
+
+    /**
+     * Private constructor - GatewayTrace only has static members
+     */
+    GatewayTrace();
+
+    /**
+     * Whether events are recorded
+     */
+    static volatile bool s_Enabled;
+};
+
+/**
+ * Records a span from its construction to its destruction
+ */
+class GatewayTraceScope {
+  public:
+
+    /**
+     * Constructor for GatewayTraceScope. Records the begin of the span
+     * @param name - name of the span, see GatewayTrace::begin
+     */
+    GatewayTraceScope(const char* name) : m_Name(GatewayTrace::isEnabled() ? name : NULL)
+    {
+        if (m_Name) {
+            GatewayTrace::begin(m_Name);
+        }
+    }
+
+    /**
+     * Constructor for GatewayTraceScope. Records the begin of a span whose
+     * name may not outlive the span, see GatewayTrace::internName
+     * @param name - name of the span
+     */
+    GatewayTraceScope(qcc::String const& name) : m_Name(GatewayTrace::isEnabled() ? GatewayTrace::internName(name) : NULL)
+    {
+        if (m_Name) {
+            GatewayTrace::begin(m_Name);
+        }
+    }
+
+    /**
+     * Destructor for GatewayTraceScope. Records the end of the span
+     */
+    ~GatewayTraceScope()
+    {
+        if (m_Name) {
+            GatewayTrace::end(m_Name);
+        }
+    }
+
+  private:
+
+    /**
+     * Private copy constructor - a span can not be copied
+     */
+    GatewayTraceScope(const GatewayTraceScope&);
+
+    /**
+     * Private assignment operator - a span can not be copied
+     */
+    GatewayTraceScope& operator=(const GatewayTraceScope&);
+
+    /**
+     * Name of the span, NULL if tracing was disabled when the span began
+     */
+    const char* m_Name;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* GATEWAYTRACE_H_ */
@@ -18,6 +18,7 @@
 #include <alljoyn/gateway/GatewayConnectorApp.h>
 #include <alljoyn/gateway/GatewayMgmt.h>
 #include <alljoyn/gateway/GatewayMetadataManager.h>
+#include <alljoyn/gateway/GatewayStats.h>
 #include "busObjects/AclBusObject.h"
 #include "busObjects/AppBusObject.h"
 #include "GatewayConstants.h"
@@ -27,6 +28,9 @@
 #include <libxml/parser.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
 
 namespace ajn {
 namespace gw {
@@ -35,14 +39,16 @@ using namespace qcc;
 
 GatewayAcl::GatewayAcl(qcc::String const& aclId, GatewayConnectorApp* connectorApp) :
     m_AclId(aclId), m_AclName(""), m_ObjectPath(connectorApp->getObjectPath() + "/" + aclId),
-    m_AclStatus(GW_AS_INACTIVE), m_AclBusObject(NULL), m_ConnectorApp(connectorApp)
+    m_AclStatus(GW_AS_INACTIVE), m_AclBusObject(NULL), m_PatchSequence(0),
+    m_NumPendingPatches(0), m_ConnectorApp(connectorApp)
 {
 }
 
 GatewayAcl::GatewayAcl(qcc::String const& aclId, qcc::String const& aclName, GatewayConnectorApp* connectorApp,
                        GatewayAclRules const& aclRules, std::map<qcc::String, qcc::String> const& customMetadata, AclStatus aclStatus) :
     m_AclId(aclId), m_AclName(aclName), m_ObjectPath(connectorApp->getObjectPath() + "/" + aclId), m_AclRules(aclRules),
-    m_AclStatus(aclStatus), m_CustomMetadata(customMetadata), m_AclBusObject(NULL), m_ConnectorApp(connectorApp)
+    m_AclStatus(aclStatus), m_CustomMetadata(customMetadata), m_AclBusObject(NULL), m_PatchSequence(0),
+    m_NumPendingPatches(0), m_ConnectorApp(connectorApp)
 {
 }
 
@@ -51,13 +57,13 @@ GatewayAcl::~GatewayAcl()
 
 }
 
-QStatus GatewayAcl::init(BusAttachment* bus)
+QStatus GatewayAcl::init(GatewayBus* bus)
 {
     QStatus status = ER_OK;
 
-    if (!bus->IsStarted() || !bus->IsConnected()) {
+    if (!bus->isConnected()) {
         status = ER_BAD_ARG_1;
-        QCC_LogError(status, ("Could not accept this BusAttachment, busAttachment not started or not connected"));
+        QCC_LogError(status, ("Could not accept this Bus, bus not connected"));
         return status;
     }
 
@@ -66,13 +72,13 @@ QStatus GatewayAcl::init(BusAttachment* bus)
         return status;
     }
 
-    m_AclBusObject = new AclBusObject(bus, this, m_ObjectPath, &status);
+    m_AclBusObject = new AclBusObject(bus->getBusAttachment(), this, m_ObjectPath, &status);
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not create AppBusObject"));
         return status;
     }
 
-    status = bus->RegisterBusObject(*m_AclBusObject);
+    status = bus->registerBusObject(*m_AclBusObject);
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not register AppBusObject"));
         return status;
@@ -80,12 +86,12 @@ QStatus GatewayAcl::init(BusAttachment* bus)
     return status;
 }
 
-QStatus GatewayAcl::shutdown(BusAttachment* bus)
+QStatus GatewayAcl::shutdown(GatewayBus* bus)
 {
     QStatus status = ER_OK;
-    if (!bus->IsStarted() || !bus->IsConnected()) {
+    if (!bus->isConnected()) {
         status = ER_BAD_ARG_1;
-        QCC_LogError(status, ("Could not acccept this BusAttachment, busAttachment not started or not connected"));
+        QCC_LogError(status, ("Could not acccept this Bus, bus not connected"));
         return status;
     }
 
@@ -94,7 +100,7 @@ QStatus GatewayAcl::shutdown(BusAttachment* bus)
         return status;
     }
 
-    bus->UnregisterBusObject(*m_AclBusObject);
+    bus->unregisterBusObject(*m_AclBusObject);
     delete m_AclBusObject;
     m_AclBusObject = NULL;
 
@@ -126,6 +132,16 @@ const qcc::String& GatewayAcl::getObjectPath() const
     return m_ObjectPath;
 }
 
+GatewayConnectorApp* GatewayAcl::getConnectorApp() const
+{
+    return m_ConnectorApp;
+}
+
+AclBusObject* GatewayAcl::getAclBusObject() const
+{
+    return m_AclBusObject;
+}
+
 const std::map<qcc::String, qcc::String>& GatewayAcl::getCustomMetadata() const
 {
     return m_CustomMetadata;
@@ -133,18 +149,16 @@ const std::map<qcc::String, qcc::String>& GatewayAcl::getCustomMetadata() const
 
 AclResponseCode GatewayAcl::updateAclStatus(AclStatus aclStatus)
 {
+    GatewayStats::increment(GW_STATS_ACL_STATUS_UPDATES);
     bool hasActiveAcl = m_ConnectorApp->hasActiveAcl();
-    AclStatus previousStatus = m_AclStatus;
-    m_AclStatus = aclStatus;
 
-    QStatus status = writeToFile();
-    if (status != ER_OK) {
-        QCC_LogError(status, ("Could not persist aclStatus - rolling back changes"));
-        m_AclStatus = previousStatus;
-        return GW_ACL_RC_PERSISTENCE_ERROR;
+    AclResponseCode responseCode = persistAclStatus(aclStatus);
+    if (responseCode != GW_ACL_RC_SUCCESS) {
+        return responseCode;
     }
+    m_ConnectorApp->publishAclSnapshot();
 
-    status = m_ConnectorApp->updatePolicyManager();
+    QStatus status = m_ConnectorApp->updatePolicyManager();
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not update policies successfully"));
         return GW_ACL_RC_POLICYMANAGER_ERROR;
@@ -175,6 +189,7 @@ AclResponseCode GatewayAcl::updateAclStatus(AclStatus aclStatus)
 AclResponseCode GatewayAcl::updateAcl(qcc::String const& aclName, GatewayAclRules const& aclRules, std::map<qcc::String, qcc::String> const& metadata,
                                       std::map<qcc::String, qcc::String> const& customMetadata)
 {
+    GatewayStats::increment(GW_STATS_ACL_UPDATES);
     GatewayMetadataManager* metadataManager = GatewayMgmt::getInstance()->getMetadataManager();
     if (!metadataManager) {
         QCC_DbgHLPrintf(("metadataManager is NULL"));
@@ -187,6 +202,30 @@ AclResponseCode GatewayAcl::updateAcl(qcc::String const& aclName, GatewayAclRule
         return GW_ACL_RC_METADATA_ERROR;
     }
 
+    AclResponseCode responseCode = persistAcl(aclName, aclRules, customMetadata);
+    if (responseCode != GW_ACL_RC_SUCCESS) {
+        return responseCode;
+    }
+    m_ConnectorApp->publishAclSnapshot();
+
+    status = m_ConnectorApp->updatePolicyManager();
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not update policies successfully"));
+        return GW_ACL_RC_POLICYMANAGER_ERROR;
+    }
+
+    status = m_ConnectorApp->getAppBusObject()->SendAclUpdatedSignal();
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Sending AclUpdated Failed"));
+    }
+
+    return GW_ACL_RC_SUCCESS;
+}
+
+AclResponseCode GatewayAcl::persistAcl(qcc::String const& aclName, GatewayAclRules const& aclRules,
+                                       std::map<qcc::String, qcc::String> const& customMetadata)
+{
+    // the rules are shared by reference count, keeping them for the rollback copies nothing
     qcc::String previousName = m_AclName;
     GatewayAclRules previousRules = m_AclRules;
     std::map<qcc::String, qcc::String> previousCustomMetadata = m_CustomMetadata;
@@ -195,13 +234,68 @@ AclResponseCode GatewayAcl::updateAcl(qcc::String const& aclName, GatewayAclRule
     m_AclRules = aclRules;
     m_CustomMetadata = customMetadata;
 
-    status = writeToFile();
+    QStatus status = writeToFile();
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not persist acl - rolling back changes"));
         m_AclName = previousName;
         m_AclRules = previousRules;
+        m_CustomMetadata = previousCustomMetadata;
         return GW_ACL_RC_PERSISTENCE_ERROR;
     }
+    return GW_ACL_RC_SUCCESS;
+}
+
+AclResponseCode GatewayAcl::persistAclStatus(AclStatus aclStatus)
+{
+    AclStatus previousStatus = m_AclStatus;
+    m_AclStatus = aclStatus;
+
+    QStatus status = writeToFile();
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not persist aclStatus - rolling back changes"));
+        m_AclStatus = previousStatus;
+        return GW_ACL_RC_PERSISTENCE_ERROR;
+    }
+    return GW_ACL_RC_SUCCESS;
+}
+
+AclResponseCode GatewayAcl::patchAcl(GatewayAclRulesPatch const& patch, std::map<qcc::String, qcc::String> const& metadata)
+{
+    GatewayStats::increment(GW_STATS_ACL_PATCHES);
+    GatewayMetadataManager* metadataManager = GatewayMgmt::getInstance()->getMetadataManager();
+    if (!metadataManager) {
+        QCC_DbgHLPrintf(("metadataManager is NULL"));
+        return GW_ACL_RC_METADATA_ERROR;
+    }
+
+    QStatus status = metadataManager->updateMetadata(metadata);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not persist metadata"));
+        return GW_ACL_RC_METADATA_ERROR;
+    }
+
+    // the patch is persisted before it is applied - nothing to roll back if that fails
+    status = appendPatchToFile(patch, m_PatchSequence + 1);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not persist acl patch"));
+        return GW_ACL_RC_PERSISTENCE_ERROR;
+    }
+    m_PatchSequence++;
+    m_NumPendingPatches++;
+    m_AclRules.applyPatch(patch);
+
+    if (m_NumPendingPatches >= GATEWAY_ACL_PATCHES_BEFORE_REWRITE) {
+        status = writeToFile();
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Could not rewrite acl - keeping its patches"));
+        }
+    }
+    m_ConnectorApp->publishAclSnapshot();
+
+    // the rules of an inactive acl are neither in the policies nor in the merged acl
+    if (m_AclStatus != GW_AS_ACTIVE) {
+        return GW_ACL_RC_SUCCESS;
+    }
 
     status = m_ConnectorApp->updatePolicyManager();
     if (status != ER_OK) {
@@ -244,6 +338,7 @@ AclResponseCode GatewayAcl::updateCustomMetadata(std::map<qcc::String, qcc::Stri
         m_CustomMetadata = previousCustomMetadata;
         return GW_ACL_RC_PERSISTENCE_ERROR;
     }
+    m_ConnectorApp->publishAclSnapshot();
 
     status = m_ConnectorApp->getAppBusObject()->SendAclUpdatedSignal();
     if (status != ER_OK) {
@@ -315,10 +410,96 @@ QStatus GatewayAcl::loadFromFile(qcc::String const& fileName)
             m_AclRules.setRemoteAppRules(remoteAppRules);
         } else if (xmlStrEqual(keyName, (const xmlChar*)"customMetadata")) {
             parseMetadata(currentKey, m_CustomMetadata);
+        } else if (xmlStrEqual(keyName, (const xmlChar*)"patchSequence")) {
+            m_PatchSequence = strtoul((const char*)value, NULL, 10);
         }
     }
 
     xmlFreeParserCtxt(ctxt);
+    xmlFreeDoc(doc);
+
+    // without its patches the acl would silently lose acknowledged changes
+    QStatus status = loadPatchesFromFile();
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not apply the patches of acl %s", m_AclId.c_str()));
+    }
+    return status;
+}
+
+QStatus GatewayAcl::loadPatchesFromFile()
+{
+    std::ifstream ifs(getPatchFileName().c_str());
+    std::string content((std::istreambuf_iterator<char>(ifs)),
+                        (std::istreambuf_iterator<char>()));
+
+    size_t end = content.rfind("</patch>");
+    size_t completeSize = end == std::string::npos ? 0 : end + strlen("</patch>");
+
+    // a patch was cut short while it was appended - cut it off the file, or the next
+    // patch would be appended after it and the whole file would no longer parse
+    if (content.find_first_not_of(" \t\r\n", completeSize) != std::string::npos) {
+        QCC_DbgHLPrintf(("Dropping a partial patch of acl %s", m_AclId.c_str()));
+        if (truncate(getPatchFileName().c_str(), completeSize) != 0) {
+            QCC_DbgHLPrintf(("Could not truncate the patch file. errno is: %i", errno));
+            return ER_WRITE_ERROR;
+        }
+    }
+
+    if (completeSize == 0) {
+        return ER_OK;
+    }
+    content = "<patches>" + content.substr(0, completeSize) + "</patches>";
+
+    xmlDocPtr doc = xmlReadMemory(content.c_str(), content.size(), NULL, NULL, XML_PARSE_NOERROR | XML_PARSE_NOBLANKS);
+    if (doc == NULL) {
+        QCC_DbgHLPrintf(("Could not parse XML from patch file"));
+        return ER_XML_MALFORMED;
+    }
+
+    xmlNode* root_element = xmlDocGetRootElement(doc);
+    for  (xmlNode* patchKey = root_element->children; patchKey != NULL; patchKey = patchKey->next) {
+
+        if (patchKey->type != XML_ELEMENT_NODE || !xmlStrEqual(patchKey->name, (const xmlChar*)"patch")) {
+            continue;
+        }
+
+        xmlChar* sequenceValue = xmlGetProp(patchKey, (const xmlChar*)"sequence");
+        if (sequenceValue == NULL) {
+            continue;
+        }
+        uint32_t sequence = strtoul((const char*)sequenceValue, NULL, 10);
+        xmlFree(sequenceValue);
+
+        // the acl file already includes this patch
+        if (sequence <= m_PatchSequence) {
+            continue;
+        }
+
+        GatewayAclRulesPatch patch;
+        for  (xmlNode* currentKey = patchKey->children; currentKey != NULL; currentKey = currentKey->next) {
+
+            if (currentKey->type != XML_ELEMENT_NODE) {
+                continue;
+            }
+
+            const xmlChar* keyName = currentKey->name;
+
+            if (xmlStrEqual(keyName, (const xmlChar*)"addedExposedServices")) {
+                parseObjects(currentKey, patch.m_AddedExposedServices);
+            } else if (xmlStrEqual(keyName, (const xmlChar*)"removedExposedServices")) {
+                parseObjects(currentKey, patch.m_RemovedExposedServices);
+            } else if (xmlStrEqual(keyName, (const xmlChar*)"addedRemotedApps")) {
+                parseRemotedApp(currentKey, patch.m_AddedRemoteApps);
+            } else if (xmlStrEqual(keyName, (const xmlChar*)"removedRemotedApps")) {
+                parseRemotedApp(currentKey, patch.m_RemovedRemoteApps);
+            }
+        }
+
+        m_AclRules.applyPatch(patch);
+        m_PatchSequence = sequence;
+        m_NumPendingPatches++;
+    }
+
     xmlFreeDoc(doc);
     return ER_OK;
 }
@@ -465,6 +646,9 @@ QStatus GatewayAcl::writeToFile()
     std::stringstream statusStr;
     statusStr << m_AclStatus;
 
+    std::stringstream sequenceStr;
+    sequenceStr << m_PatchSequence;
+
     xmlDocPtr doc = xmlNewDoc((xmlChar*)XML_DEFAULT_VERSION);
     if (doc == NULL) {
         QCC_DbgHLPrintf(("Error creating the xml document tree"));
@@ -502,6 +686,10 @@ QStatus GatewayAcl::writeToFile()
     if (rc < 0) {
         goto exit;
     }
+    rc = xmlTextWriterWriteElement(writer, (xmlChar*)"patchSequence", (xmlChar*)sequenceStr.str().c_str());
+    if (rc < 0) {
+        goto exit;
+    }
     rc = xmlTextWriterStartElement(writer, (xmlChar*)"exposedServices");
     if (rc < 0) {
         goto exit;
@@ -563,6 +751,14 @@ QStatus GatewayAcl::writeToFile()
     }
     status = ER_OK;
 
+    // the acl file now includes all patches
+    if (m_NumPendingPatches) {
+        if (unlink(getPatchFileName().c_str()) != 0 && errno != ENOENT) {
+            QCC_DbgHLPrintf(("Could not remove the patch file - its patches are skipped on load"));
+        }
+        m_NumPendingPatches = 0;
+    }
+
 exit:
 
     xmlFreeTextWriter(writer);
@@ -571,6 +767,136 @@ exit:
     return status;
 }
 
+qcc::String GatewayAcl::getPatchFileName() const
+{
+    return GATEWAY_APPS_DIRECTORY + "/" + m_ConnectorApp->getConnectorId() + "/aclPatches/" + m_AclId;
+}
+
+QStatus GatewayAcl::appendPatchToFile(GatewayAclRulesPatch const& patch, uint32_t sequence)
+{
+    QStatus status = ER_FAIL;
+    int fd = -1;
+    off_t offset = 0;
+    ssize_t written = 0;
+
+    std::stringstream sequenceStr;
+    sequenceStr << sequence;
+
+    xmlBufferPtr buffer = xmlBufferCreate();
+    if (buffer == NULL) {
+        QCC_DbgHLPrintf(("Error creating the xml buffer"));
+        return status;
+    }
+
+    xmlTextWriterPtr writer = xmlNewTextWriterMemory(buffer, 0);
+    if (writer == NULL) {
+        QCC_DbgHLPrintf(("Error creating the xml writer\n"));
+        xmlBufferFree(buffer);
+        return status;
+    }
+
+    int rc = xmlTextWriterStartElement(writer, (xmlChar*)"patch");
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = xmlTextWriterWriteAttribute(writer, (xmlChar*)"sequence", (xmlChar*)sequenceStr.str().c_str());
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = xmlTextWriterStartElement(writer, (xmlChar*)"addedExposedServices");
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = writeObjectsToFile(writer, patch.m_AddedExposedServices);
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = xmlTextWriterEndElement(writer); //close addedExposedServices tag
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = xmlTextWriterStartElement(writer, (xmlChar*)"removedExposedServices");
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = writeObjectsToFile(writer, patch.m_RemovedExposedServices);
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = xmlTextWriterEndElement(writer); //close removedExposedServices tag
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = xmlTextWriterStartElement(writer, (xmlChar*)"addedRemotedApps");
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = writeRemotedAppsToFile(writer, patch.m_AddedRemoteApps);
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = xmlTextWriterEndElement(writer); //close addedRemotedApps tag
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = xmlTextWriterStartElement(writer, (xmlChar*)"removedRemotedApps");
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = writeRemotedAppsToFile(writer, patch.m_RemovedRemoteApps);
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = xmlTextWriterEndElement(writer); //close removedRemotedApps tag
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = xmlTextWriterEndElement(writer); //close patch tag
+    if (rc < 0) {
+        goto exit;
+    }
+    rc = xmlTextWriterFlush(writer);
+    if (rc < 0) {
+        goto exit;
+    }
+    xmlBufferCCat(buffer, "\n");
+
+    mkdir((GATEWAY_APPS_DIRECTORY + "/" + m_ConnectorApp->getConnectorId() + "/aclPatches").c_str(), 0755);
+    fd = open(getPatchFileName().c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        QCC_DbgHLPrintf(("Could not open the patch file. errno is: %i", errno));
+        status = ER_OPEN_FAILED;
+        goto exit;
+    }
+
+    offset = lseek(fd, 0, SEEK_END);
+    written = write(fd, xmlBufferContent(buffer), xmlBufferLength(buffer));
+    if (written != (ssize_t)xmlBufferLength(buffer)) {
+        QCC_DbgHLPrintf(("Could not write the patch file. errno is: %i", errno));
+        // cut off what was written so the next patch is not appended to a partial one
+        if (written > 0 && ftruncate(fd, offset) != 0) {
+            QCC_DbgHLPrintf(("Could not truncate the patch file"));
+        }
+        status = ER_WRITE_ERROR;
+    } else if (fsync(fd) != 0) {
+        // the patch is only acknowledged once it is on disk
+        QCC_DbgHLPrintf(("Could not sync the patch file. errno is: %i", errno));
+        if (ftruncate(fd, offset) != 0) {
+            QCC_DbgHLPrintf(("Could not truncate the patch file"));
+        }
+        status = ER_WRITE_ERROR;
+    } else {
+        status = ER_OK;
+    }
+    close(fd);
+
+exit:
+
+    xmlFreeTextWriter(writer);
+    xmlBufferFree(buffer);
+    return status;
+}
+
 int GatewayAcl::writeObjectsToFile(xmlTextWriterPtr writer, const GatewayRuleObjectDescriptions& objects)
 {
     int rc = 0;
@@ -593,9 +919,9 @@ int GatewayAcl::writeObjectsToFile(xmlTextWriterPtr writer, const GatewayRuleObj
             return rc;
         }
 
-        const std::vector<qcc::String>& interfaces = objects[objectsIndx].getInterfaces();
+        const GatewayInternedStrings& interfaces = objects[objectsIndx].getInterfaces();
         for (size_t interfacesIndx = 0; interfacesIndx < interfaces.size(); interfacesIndx++) {
-            rc = xmlTextWriterWriteElement(writer, (xmlChar*)"interface", (xmlChar*)interfaces[interfacesIndx].c_str());
+            rc = xmlTextWriterWriteElement(writer, (xmlChar*)"interface", (xmlChar*)interfaces[interfacesIndx].str().c_str());
             if (rc < 0) {
                 return rc;
             }
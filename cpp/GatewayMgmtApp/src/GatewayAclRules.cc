@@ -15,11 +15,44 @@
  ******************************************************************************/
 
 #include <alljoyn/gateway/GatewayAclRules.h>
+#include <algorithm>
 
 namespace ajn {
 namespace gw {
 using namespace qcc;
 
+static GatewayRuleObjectDescriptions::iterator findObject(GatewayRuleObjectDescriptions& objects, const GatewayRuleObjectDescription& object)
+{
+    GatewayRuleObjectDescriptions::iterator iter;
+    for (iter = objects.begin(); iter != objects.end(); iter++) {
+        if (iter->getObjectPathId() == object.getObjectPathId() && iter->getIsPrefix() == object.getIsPrefix()) {
+            break;
+        }
+    }
+    return iter;
+}
+
+static GatewayRuleObjectDescriptions::const_iterator findObject(const GatewayRuleObjectDescriptions& objects, const GatewayRuleObjectDescription& object)
+{
+    GatewayRuleObjectDescriptions::const_iterator iter;
+    for (iter = objects.begin(); iter != objects.end(); iter++) {
+        if (iter->getObjectPathId() == object.getObjectPathId() && iter->getIsPrefix() == object.getIsPrefix()) {
+            break;
+        }
+    }
+    return iter;
+}
+
+/**
+ * Returned for rules without exposed services
+ */
+static const GatewayRuleObjectDescriptions s_NoObjects;
+
+/**
+ * Returned for rules without remote app rules
+ */
+static const GatewayRemoteAppRules s_NoRemoteApps;
+
 GatewayAclRules::GatewayAclRules()
 {
 
@@ -31,22 +64,253 @@ GatewayAclRules::~GatewayAclRules() {
 
 const GatewayRuleObjectDescriptions& GatewayAclRules::getExposedServicesRules() const
 {
-    return m_ExposedServicesRules;
+    return m_ExposedServicesRules.get() ? m_ExposedServicesRules->m_Objects : s_NoObjects;
 }
 
 void GatewayAclRules::setExposedServicesRules(const GatewayRuleObjectDescriptions& exposedServicesRules)
 {
-    m_ExposedServicesRules = exposedServicesRules;
+    m_ExposedServicesRules = GatewayRef<SharedObjects>(exposedServicesRules.empty() ? NULL : new SharedObjects(exposedServicesRules));
 }
 
 const GatewayRemoteAppRules& GatewayAclRules::getRemoteAppRules() const
 {
-    return m_RemoteAppRules;
+    return m_RemoteAppRules.get() ? m_RemoteAppRules->m_RemoteApps : s_NoRemoteApps;
 }
 
 void GatewayAclRules::setRemoteAppRules(const GatewayRemoteAppRules& remoteAppRules)
 {
-    m_RemoteAppRules = remoteAppRules;
+    m_RemoteAppRules = GatewayRef<SharedRemoteApps>(remoteAppRules.empty() ? NULL : new SharedRemoteApps(remoteAppRules));
+}
+
+void GatewayAclRules::applyPatch(const GatewayAclRulesPatch& patch)
+{
+    if (!patch.m_RemovedExposedServices.empty() || !patch.m_AddedExposedServices.empty()) {
+        GatewayRuleObjectDescriptions exposedServices = getExposedServicesRules();
+        removeObjects(exposedServices, patch.m_RemovedExposedServices);
+        addObjects(exposedServices, patch.m_AddedExposedServices);
+        setExposedServicesRules(exposedServices);
+    }
+
+    if (patch.m_RemovedRemoteApps.empty() && patch.m_AddedRemoteApps.empty()) {
+        return;
+    }
+
+    GatewayRemoteAppRules remoteApps = getRemoteAppRules();
+    GatewayRemoteAppRules::const_iterator patchIter;
+    for (patchIter = patch.m_RemovedRemoteApps.begin(); patchIter != patch.m_RemovedRemoteApps.end(); patchIter++) {
+        GatewayRemoteAppRules::iterator iter = remoteApps.find(patchIter->first);
+        if (iter == remoteApps.end()) {
+            continue;
+        }
+
+        if (patchIter->second.empty()) {
+            remoteApps.erase(iter);
+            continue;
+        }
+
+        removeObjects(iter->second, patchIter->second);
+        if (iter->second.empty()) {
+            remoteApps.erase(iter);
+        }
+    }
+
+    addRemoteApps(remoteApps, patch.m_AddedRemoteApps);
+    setRemoteAppRules(remoteApps);
+}
+
+void GatewayAclRules::mergeRules(const GatewayAclRules& rules)
+{
+    // merging into empty rules shares the rules merged in
+    if (!m_ExposedServicesRules.get()) {
+        m_ExposedServicesRules = rules.m_ExposedServicesRules;
+    } else if (rules.m_ExposedServicesRules.get()) {
+        GatewayRuleObjectDescriptions exposedServices = getExposedServicesRules();
+        addObjects(exposedServices, rules.getExposedServicesRules());
+        setExposedServicesRules(exposedServices);
+    }
+
+    if (!m_RemoteAppRules.get()) {
+        m_RemoteAppRules = rules.m_RemoteAppRules;
+    } else if (rules.m_RemoteAppRules.get()) {
+        GatewayRemoteAppRules remoteApps = getRemoteAppRules();
+        addRemoteApps(remoteApps, rules.getRemoteAppRules());
+        setRemoteAppRules(remoteApps);
+    }
+}
+
+void GatewayAclRules::getPatchTo(const GatewayAclRules& target, GatewayAclRulesPatch* patch) const
+{
+    // shared parts are unchanged
+    if (m_ExposedServicesRules.get() != target.m_ExposedServicesRules.get()) {
+        diffObjects(getExposedServicesRules(), target.getExposedServicesRules(), &patch->m_RemovedExposedServices, &patch->m_AddedExposedServices);
+    }
+    if (m_RemoteAppRules.get() == target.m_RemoteAppRules.get()) {
+        return;
+    }
+
+    const GatewayRemoteAppRules& remoteApps = getRemoteAppRules();
+    const GatewayRemoteAppRules& targetRemoteApps = target.getRemoteAppRules();
+    GatewayRemoteAppRules::const_iterator iter;
+    for (iter = remoteApps.begin(); iter != remoteApps.end(); iter++) {
+        GatewayRemoteAppRules::const_iterator targetIter = targetRemoteApps.find(iter->first);
+        if (targetIter == targetRemoteApps.end()) {
+            patch->m_RemovedRemoteApps[iter->first];
+            continue;
+        }
+
+        // an app without objects can only be changed by removing it and adding it back
+        if (iter->second.empty() || targetIter->second.empty()) {
+            if (iter->second.empty() != targetIter->second.empty()) {
+                patch->m_RemovedRemoteApps[iter->first];
+                patch->m_AddedRemoteApps.insert(*targetIter);
+            }
+            continue;
+        }
+
+        GatewayRuleObjectDescriptions removed;
+        GatewayRuleObjectDescriptions added;
+        diffObjects(iter->second, targetIter->second, &removed, &added);
+        if (!removed.empty()) {
+            patch->m_RemovedRemoteApps[iter->first] = removed;
+        }
+        if (!added.empty()) {
+            patch->m_AddedRemoteApps[iter->first] = added;
+        }
+    }
+
+    for (iter = targetRemoteApps.begin(); iter != targetRemoteApps.end(); iter++) {
+        if (remoteApps.find(iter->first) == remoteApps.end()) {
+            patch->m_AddedRemoteApps.insert(*iter);
+        }
+    }
+}
+
+void GatewayAclRules::addRemoteApps(GatewayRemoteAppRules& remoteApps, const GatewayRemoteAppRules& added)
+{
+    GatewayRemoteAppRules::const_iterator addedIter;
+    for (addedIter = added.begin(); addedIter != added.end(); addedIter++) {
+        GatewayRemoteAppRules::iterator iter = remoteApps.find(addedIter->first);
+        if (iter == remoteApps.end()) {
+            remoteApps.insert(*addedIter);
+        } else {
+            addObjects(iter->second, addedIter->second);
+        }
+    }
+}
+
+void GatewayAclRules::addObjects(GatewayRuleObjectDescriptions& objects, const GatewayRuleObjectDescriptions& added)
+{
+    for (size_t i = 0; i < added.size(); i++) {
+        GatewayRuleObjectDescriptions::iterator iter = findObject(objects, added[i]);
+        if (iter == objects.end()) {
+            objects.push_back(added[i]);
+            continue;
+        }
+
+        // no interfaces means all interfaces
+        if (iter->getInterfaces().empty()) {
+            continue;
+        }
+        if (added[i].getInterfaces().empty()) {
+            iter->setInterfaces(GatewayInternedStrings());
+            continue;
+        }
+
+        GatewayInternedStrings interfaces = iter->getInterfaces();
+        const GatewayInternedStrings& addedInterfaces = added[i].getInterfaces();
+        for (size_t j = 0; j < addedInterfaces.size(); j++) {
+            if (std::find(interfaces.begin(), interfaces.end(), addedInterfaces[j]) == interfaces.end()) {
+                interfaces.push_back(addedInterfaces[j]);
+            }
+        }
+        iter->setInterfaces(interfaces);
+    }
+}
+
+void GatewayAclRules::removeObjects(GatewayRuleObjectDescriptions& objects, const GatewayRuleObjectDescriptions& removed)
+{
+    for (size_t i = 0; i < removed.size(); i++) {
+        GatewayRuleObjectDescriptions::iterator iter = findObject(objects, removed[i]);
+        if (iter == objects.end()) {
+            continue;
+        }
+
+        if (removed[i].getInterfaces().empty()) {
+            objects.erase(iter);
+            continue;
+        }
+
+        // single interfaces can not be removed from an object that allows all of them
+        if (iter->getInterfaces().empty()) {
+            continue;
+        }
+
+        GatewayInternedStrings interfaces = iter->getInterfaces();
+        const GatewayInternedStrings& removedInterfaces = removed[i].getInterfaces();
+        for (size_t j = 0; j < removedInterfaces.size(); j++) {
+            interfaces.erase(std::remove(interfaces.begin(), interfaces.end(), removedInterfaces[j]), interfaces.end());
+        }
+
+        if (interfaces.empty()) {
+            objects.erase(iter);
+        } else {
+            iter->setInterfaces(interfaces);
+        }
+    }
+}
+
+void GatewayAclRules::diffObjects(const GatewayRuleObjectDescriptions& from, const GatewayRuleObjectDescriptions& to,
+                                  GatewayRuleObjectDescriptions* removed, GatewayRuleObjectDescriptions* added)
+{
+    for (size_t i = 0; i < from.size(); i++) {
+        GatewayRuleObjectDescriptions::const_iterator iter = findObject(to, from[i]);
+        if (iter == to.end()) {
+            removed->push_back(GatewayRuleObjectDescription(from[i].getObjectPathId(), from[i].getIsPrefix(), GatewayInternedStrings()));
+            continue;
+        }
+
+        const GatewayInternedStrings& fromInterfaces = from[i].getInterfaces();
+        const GatewayInternedStrings& toInterfaces = iter->getInterfaces();
+
+        // widening to all interfaces is an addition, narrowing from all interfaces needs a removal first
+        if (toInterfaces.empty()) {
+            if (!fromInterfaces.empty()) {
+                added->push_back(*iter);
+            }
+            continue;
+        }
+        if (fromInterfaces.empty()) {
+            removed->push_back(from[i]);
+            added->push_back(*iter);
+            continue;
+        }
+
+        GatewayInternedStrings removedInterfaces;
+        for (size_t j = 0; j < fromInterfaces.size(); j++) {
+            if (std::find(toInterfaces.begin(), toInterfaces.end(), fromInterfaces[j]) == toInterfaces.end()) {
+                removedInterfaces.push_back(fromInterfaces[j]);
+            }
+        }
+        GatewayInternedStrings addedInterfaces;
+        for (size_t j = 0; j < toInterfaces.size(); j++) {
+            if (std::find(fromInterfaces.begin(), fromInterfaces.end(), toInterfaces[j]) == fromInterfaces.end()) {
+                addedInterfaces.push_back(toInterfaces[j]);
+            }
+        }
+
+        if (!removedInterfaces.empty()) {
+            removed->push_back(GatewayRuleObjectDescription(from[i].getObjectPathId(), from[i].getIsPrefix(), removedInterfaces));
+        }
+        if (!addedInterfaces.empty()) {
+            added->push_back(GatewayRuleObjectDescription(from[i].getObjectPathId(), from[i].getIsPrefix(), addedInterfaces));
+        }
+    }
+
+    for (size_t i = 0; i < to.size(); i++) {
+        if (findObject(from, to[i]) == from.end()) {
+            added->push_back(to[i]);
+        }
+    }
 }
 
 } /* namespace gw */
@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/gateway/GatewayAclSnapshot.h>
+#include <alljoyn/gateway/GatewayAcl.h>
+#include "busObjects/AclAdapter.h"
+#include "GatewayConstants.h"
+
+namespace ajn {
+namespace gw {
+
+using namespace gwConsts;
+
+GatewayAclSnapshot::GatewayAclSnapshot(GatewayAcl const& acl) :
+    m_AclId(acl.getAclId()), m_AclName(acl.getAclName()), m_ObjectPath(acl.getObjectPath()),
+    m_AclRules(acl.getAclRules()), m_AclStatus(acl.getAclStatus()), m_CustomMetadata(acl.getCustomMetadata())
+{
+}
+
+const qcc::String& GatewayAclSnapshot::getAclId() const
+{
+    return m_AclId;
+}
+
+const qcc::String& GatewayAclSnapshot::getAclName() const
+{
+    return m_AclName;
+}
+
+AclStatus GatewayAclSnapshot::getAclStatus() const
+{
+    return m_AclStatus;
+}
+
+const qcc::String& GatewayAclSnapshot::getObjectPath() const
+{
+    return m_ObjectPath;
+}
+
+const GatewayAclRules& GatewayAclSnapshot::getAclRules() const
+{
+    return m_AclRules;
+}
+
+const std::map<qcc::String, qcc::String>& GatewayAclSnapshot::getCustomMetadata() const
+{
+    return m_CustomMetadata;
+}
+
+GatewayAclSet::GatewayAclSet(uint32_t version, std::map<qcc::String, GatewayAcl*> const& acls, const GatewayAclSet* previous) :
+    m_Version(version), m_MergeSequence(1)
+{
+    std::map<qcc::String, GatewayAcl*>::const_iterator it;
+    for (it = acls.begin(); it != acls.end(); it++) {
+        m_Acls.insert(std::pair<qcc::String, GatewayAclSnapshot>(it->first, GatewayAclSnapshot(*it->second)));
+        if (it->second->getAclStatus() == GW_AS_ACTIVE) {
+            m_MergedRules.mergeRules(it->second->getAclRules());
+        }
+    }
+
+    if (previous) {
+        previous->getMergedRules().getPatchTo(m_MergedRules, &m_MergeDelta);
+        m_MergeSequence = m_MergeDelta.empty() ? previous->getMergeSequence() : previous->getMergeSequence() + 1;
+    } else {
+        GatewayAclRules().getPatchTo(m_MergedRules, &m_MergeDelta);
+    }
+
+    // the args point into m_MergedRules and m_MergeDelta, which do not change for the lifetime of the set
+    m_MergedAcl[0].Set(AJPARAM_UINT32.c_str(), m_MergeSequence);
+    m_MergedAcl[1].Set(AJPARAM_BOOL.c_str(), true);
+    m_MergedAclStatus = AclAdapter::marshalMergedAcl(*this, &m_MergedAcl[2], &m_MergedAclArena);
+    if (m_MergedAclStatus != ER_OK) {
+        QCC_LogError(m_MergedAclStatus, ("Could not marshal the merged Acl of version %u", m_Version));
+    }
+
+    m_MergedAclUpdatedStatus = AclAdapter::marshalMergedAclUpdate(m_MergeSequence, m_MergeDelta, m_MergedAclUpdated, &m_MergedAclUpdatedArena);
+    if (m_MergedAclUpdatedStatus != ER_OK) {
+        QCC_LogError(m_MergedAclUpdatedStatus, ("Could not marshal the merged Acl delta of version %u", m_Version));
+    }
+}
+
+uint32_t GatewayAclSet::getVersion() const
+{
+    return m_Version;
+}
+
+uint32_t GatewayAclSet::getMergeSequence() const
+{
+    return m_MergeSequence;
+}
+
+const GatewayAclRules& GatewayAclSet::getMergedRules() const
+{
+    return m_MergedRules;
+}
+
+const std::map<qcc::String, GatewayAclSnapshot>& GatewayAclSet::getAcls() const
+{
+    return m_Acls;
+}
+
+const GatewayAclSnapshot* GatewayAclSet::findAcl(qcc::String const& aclId) const
+{
+    std::map<qcc::String, GatewayAclSnapshot>::const_iterator it = m_Acls.find(aclId);
+    if (it == m_Acls.end()) {
+        return NULL;
+    }
+    return &it->second;
+}
+
+const MsgArg* GatewayAclSet::getMergedAcl() const
+{
+    if (m_MergedAclStatus != ER_OK) {
+        return NULL;
+    }
+    return &m_MergedAcl[2];
+}
+
+const MsgArg* GatewayAclSet::getMergedAclChangedReply() const
+{
+    if (m_MergedAclStatus != ER_OK) {
+        return NULL;
+    }
+    return m_MergedAcl;
+}
+
+const MsgArg* GatewayAclSet::getMergedAclUpdatedArgs() const
+{
+    if (m_MergedAclUpdatedStatus != ER_OK) {
+        return NULL;
+    }
+    return m_MergedAclUpdated;
+}
+
+} /* namespace gw */
+} /* namespace ajn */
@@ -21,45 +21,57 @@ namespace ajn {
 namespace gw {
 
 GatewayAppIdentifier::GatewayAppIdentifier(qcc::String const& appId, qcc::String const& deviceId) :
-    m_AppId(appId), m_DeviceId(deviceId)
+    m_DeviceId(deviceId)
 {
     memset(m_AppIdHex, 0, APPID_LENGTH);
     qcc::HexStringToBytes(appId, m_AppIdHex, APPID_LENGTH);
+    computeHash();
 }
 
-GatewayAppIdentifier::GatewayAppIdentifier(uint8_t* appId, size_t appIdLen, qcc::String const& deviceId) :
+GatewayAppIdentifier::GatewayAppIdentifier(const uint8_t* appId, size_t appIdLen, qcc::String const& deviceId) :
     m_DeviceId(deviceId)
 {
     memset(m_AppIdHex, 0, APPID_LENGTH);
     memcpy(m_AppIdHex, appId, appIdLen > APPID_LENGTH ? APPID_LENGTH : appIdLen);
-    m_AppId = qcc::BytesToHexString(appId, APPID_LENGTH);
+    computeHash();
 }
 
 GatewayAppIdentifier::~GatewayAppIdentifier()
 {
 }
 
+void GatewayAppIdentifier::computeHash()
+{
+    // FNV-1a over the appId, seeded with the hash of the DeviceId
+    size_t hash = m_DeviceId.getHash();
+    for (size_t i = 0; i < APPID_LENGTH; i++) {
+        hash = (hash ^ m_AppIdHex[i]) * 16777619u;
+    }
+    m_Hash = hash;
+}
+
 bool GatewayAppIdentifier::operator<(const GatewayAppIdentifier& other) const
 {
-    if (m_AppId.compare(other.m_AppId) == 0) {
-        return (m_DeviceId.compare(other.m_DeviceId) < 0);
+    int appIdCompare = memcmp(m_AppIdHex, other.m_AppIdHex, APPID_LENGTH);
+    if (appIdCompare == 0) {
+        return (m_DeviceId.str().compare(other.m_DeviceId.str()) < 0);
     }
 
-    return (m_AppId.compare(other.m_AppId) < 0);
+    return (appIdCompare < 0);
 }
 
 bool GatewayAppIdentifier::operator==(const GatewayAppIdentifier& other) const
 {
-    if (m_AppId.compare(other.m_AppId) != 0) {
+    if (m_Hash != other.m_Hash || m_DeviceId != other.m_DeviceId) {
         return false;
     }
 
-    return (m_DeviceId.compare(other.m_DeviceId) == 0);
+    return (memcmp(m_AppIdHex, other.m_AppIdHex, APPID_LENGTH) == 0);
 }
 
-const qcc::String& GatewayAppIdentifier::getAppId() const
+qcc::String GatewayAppIdentifier::getAppId() const
 {
-    return m_AppId;
+    return qcc::BytesToHexString(m_AppIdHex, APPID_LENGTH);
 }
 
 const uint8_t* GatewayAppIdentifier::getAppIdHex() const
@@ -69,7 +81,12 @@ const uint8_t* GatewayAppIdentifier::getAppIdHex() const
 
 const qcc::String& GatewayAppIdentifier::getDeviceId() const
 {
-    return m_DeviceId;
+    return m_DeviceId.str();
+}
+
+size_t GatewayAppIdentifier::getHash() const
+{
+    return m_Hash;
 }
 
 size_t GatewayAppIdentifier::getAppIdHexLength() const
@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/gateway/GatewayBus.h>
+#include <alljoyn/AllJoynStd.h>
+#include <alljoyn/DBusStd.h>
+#include "GatewayConstants.h"
+
+namespace ajn {
+namespace gw {
+
+using namespace gwConsts;
+
+GatewayBus::GatewayBus()
+{
+}
+
+GatewayBus::~GatewayBus()
+{
+}
+
+GatewayRouterBus::GatewayRouterBus(BusAttachment* bus) : m_Bus(bus)
+{
+}
+
+GatewayRouterBus::~GatewayRouterBus()
+{
+}
+
+BusAttachment* GatewayRouterBus::getBusAttachment() const
+{
+    return m_Bus;
+}
+
+bool GatewayRouterBus::isConnected() const
+{
+    return m_Bus->IsStarted() && m_Bus->IsConnected();
+}
+
+QStatus GatewayRouterBus::registerBusObject(BusObject& busObject)
+{
+    return m_Bus->RegisterBusObject(busObject);
+}
+
+void GatewayRouterBus::unregisterBusObject(BusObject& busObject)
+{
+    m_Bus->UnregisterBusObject(busObject);
+}
+
+void GatewayRouterBus::registerBusListener(BusListener& busListener)
+{
+    m_Bus->RegisterBusListener(busListener);
+}
+
+void GatewayRouterBus::unregisterBusListener(BusListener& busListener)
+{
+    m_Bus->UnregisterBusListener(busListener);
+}
+
+QStatus GatewayRouterBus::bindSessionPort(SessionPort& sessionPort, SessionOpts const& sessionOpts, SessionPortListener& listener)
+{
+    return m_Bus->BindSessionPort(sessionPort, sessionOpts, listener);
+}
+
+QStatus GatewayRouterBus::unbindSessionPort(SessionPort sessionPort)
+{
+    return m_Bus->UnbindSessionPort(sessionPort);
+}
+
+QStatus GatewayRouterBus::registerAboutListener(AboutListener& aboutListener)
+{
+    m_Bus->RegisterAboutListener(aboutListener);
+    return m_Bus->WhoImplements(NULL);
+}
+
+void GatewayRouterBus::unregisterAboutListener(AboutListener& aboutListener)
+{
+    m_Bus->UnregisterAboutListener(aboutListener);
+}
+
+QStatus GatewayRouterBus::reloadConfig()
+{
+    m_Bus->EnableConcurrentCallbacks();
+    Message reply(*m_Bus);
+    const ProxyBusObject& alljoynObj = m_Bus->GetAllJoynProxyObj();
+    QStatus status = alljoynObj.MethodCall(org::alljoyn::Bus::InterfaceName, "ReloadConfig", NULL, 0, reply);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not reload the config"));
+        return status;
+    }
+
+    bool success = false;
+    reply->GetArgs(AJPARAM_BOOL.c_str(), &success);
+    if (!success) {
+        QCC_DbgHLPrintf(("Could not reload the config"));
+        return ER_INIT_FAILED;
+    }
+
+    QCC_DbgPrintf(("Reloaded config successfully"));
+    return status;
+}
+
+bool GatewayRouterBus::deliverSignal(const char* objectPath, const char* destination, SessionId sessionId,
+                                     const InterfaceDescription::Member& signal, const MsgArg* args, size_t numArgs)
+{
+    return false;
+}
+
+bool GatewayRouterBus::getMethodArgs(const Message& msg, size_t* numArgs, const MsgArg** args)
+{
+    return false;
+}
+
+bool GatewayRouterBus::deliverMethodReply(const Message& msg, QStatus status, const MsgArg* args, size_t numArgs)
+{
+    return false;
+}
+
+} /* namespace gw */
+} /* namespace ajn */
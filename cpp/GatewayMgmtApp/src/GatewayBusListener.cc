@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include <alljoyn/gateway/GatewayBusListener.h>
+#include <alljoyn/gateway/GatewayStats.h>
 #include "GatewayConstants.h"
 #include <algorithm>
 
@@ -52,9 +53,11 @@ bool GatewayBusListener::AcceptSessionJoiner(SessionPort sessionPort, const char
 
 void GatewayBusListener::SessionJoined(SessionPort sessionPort, SessionId sessionId, const char* joiner)
 {
+    GatewayStats::increment(GW_STATS_SESSIONS_JOINED);
     if (m_Bus) {
         m_Bus->SetSessionListener(sessionId, this);
     }
+    GatewayScopedLock lock(m_SessionIdsLock);
     if (std::find(m_SessionIds.begin(), m_SessionIds.end(), sessionId) != m_SessionIds.end()) {
         return;
     }
@@ -63,6 +66,7 @@ void GatewayBusListener::SessionJoined(SessionPort sessionPort, SessionId sessio
 
 void GatewayBusListener::SessionMemberAdded(SessionId sessionId, const char* uniqueName)
 {
+    GatewayScopedLock lock(m_SessionIdsLock);
     if (std::find(m_SessionIds.begin(), m_SessionIds.end(), sessionId) != m_SessionIds.end()) {
         return;
     }
@@ -71,18 +75,23 @@ void GatewayBusListener::SessionMemberAdded(SessionId sessionId, const char* uni
 
 void GatewayBusListener::SessionMemberRemoved(SessionId sessionId, const char* uniqueName)
 {
+    GatewayScopedLock lock(m_SessionIdsLock);
     std::vector<SessionId>::iterator it = std::find(m_SessionIds.begin(), m_SessionIds.end(), sessionId);
     if (it != m_SessionIds.end()) {
         m_SessionIds.erase(it);
     }
+    m_AppSubscriptions.erase(sessionId);
 }
 
 void GatewayBusListener::SessionLost(SessionId sessionId, SessionLostReason reason)
 {
+    GatewayStats::increment(GW_STATS_SESSIONS_LOST);
+    GatewayScopedLock lock(m_SessionIdsLock);
     std::vector<SessionId>::iterator it = std::find(m_SessionIds.begin(), m_SessionIds.end(), sessionId);
     if (it != m_SessionIds.end()) {
         m_SessionIds.erase(it);
     }
+    m_AppSubscriptions.erase(sessionId);
 }
 
 void GatewayBusListener::BusDisconnected()
@@ -92,10 +101,47 @@ void GatewayBusListener::BusDisconnected()
     }
 }
 
-const std::vector<SessionId>& GatewayBusListener::getSessionIds() const
+std::vector<SessionId> GatewayBusListener::getSessionIds() const
 {
+    GatewayScopedLock lock(m_SessionIdsLock);
     return m_SessionIds;
 }
 
+std::vector<SessionId> GatewayBusListener::getSessionIds(qcc::String const& connectorId, bool* allSessions) const
+{
+    GatewayScopedLock lock(m_SessionIdsLock);
+    *allSessions = true;
+    if (m_AppSubscriptions.empty()) {
+        return m_SessionIds;
+    }
+
+    std::vector<SessionId> sessionIds;
+    for (size_t i = 0; i < m_SessionIds.size(); i++) {
+        std::map<SessionId, std::set<qcc::String> >::const_iterator it = m_AppSubscriptions.find(m_SessionIds[i]);
+        if (it != m_AppSubscriptions.end() && it->second.find(connectorId) == it->second.end()) {
+            *allSessions = false;
+            continue;
+        }
+        sessionIds.push_back(m_SessionIds[i]);
+    }
+    return sessionIds;
+}
+
+QStatus GatewayBusListener::setAppSubscriptions(SessionId sessionId, std::vector<qcc::String> const& connectorIds)
+{
+    GatewayScopedLock lock(m_SessionIdsLock);
+    if (std::find(m_SessionIds.begin(), m_SessionIds.end(), sessionId) == m_SessionIds.end()) {
+        QCC_DbgHLPrintf(("Session %u is not joined - ignoring subscriptions", sessionId));
+        return ER_BUS_NO_SESSION;
+    }
+
+    if (connectorIds.empty()) {
+        m_AppSubscriptions.erase(sessionId);
+        return ER_OK;
+    }
+    m_AppSubscriptions[sessionId] = std::set<qcc::String>(connectorIds.begin(), connectorIds.end());
+    return ER_OK;
+}
+
 } /* namespace gw */
 } /* namespace ajn */
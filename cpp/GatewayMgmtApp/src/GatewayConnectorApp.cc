@@ -16,10 +16,15 @@
 
 #include <alljoyn/gateway/GatewayConnectorApp.h>
 #include <alljoyn/gateway/GatewayMgmt.h>
+#include <alljoyn/gateway/GatewayEventLoop.h>
 #include <alljoyn/gateway/GatewayRouterPolicyManager.h>
 #include <alljoyn/gateway/GatewayMetadataManager.h>
+#include <alljoyn/gateway/GatewayStats.h>
+#include <alljoyn/gateway/GatewayTrace.h>
 #include "busObjects/AppBusObject.h"
+#include "busObjects/AclBusObject.h"
 #include "GatewayConstants.h"
+#include <qcc/StringUtil.h>
 #include <dirent.h>
 #include <stdio.h>
 #include <sstream>
@@ -31,6 +36,10 @@
 #include <sys/types.h>
 #include <errno.h>
 #include <pwd.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdlib.h>
+#include <sys/resource.h>
 
 namespace ajn {
 namespace gw {
@@ -38,9 +47,144 @@ using namespace gwConsts;
 using namespace qcc;
 using namespace services;
 
+static bool writeControlFile(qcc::String const& fileName, qcc::String const& value)
+{
+    int fd = open(fileName.c_str(), O_WRONLY);
+    if (fd < 0) {
+        return false;
+    }
+    ssize_t written = write(fd, value.c_str(), value.size());
+    close(fd);
+    return written == (ssize_t)value.size();
+}
+
+static bool readControlFile(qcc::String const& fileName, qcc::String& value)
+{
+    char buffer[512];
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    ssize_t bytesRead = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (bytesRead <= 0) {
+        return false;
+    }
+    buffer[bytesRead] = '\0';
+    value.assign(buffer);
+    return true;
+}
+
+/**
+ * Task running a member function of a GatewayConnectorApp on its task queue
+ */
+class ConnectorAppTask : public GatewayTask {
+  public:
+
+    typedef void (GatewayConnectorApp::*Action)();
+
+    ConnectorAppTask(GatewayConnectorApp* connectorApp, Action action) : m_ConnectorApp(connectorApp), m_Action(action) { }
+
+    void run()
+    {
+        (m_ConnectorApp->*m_Action)();
+    }
+
+  private:
+
+    GatewayConnectorApp* m_ConnectorApp;
+
+    Action m_Action;
+};
+
+/**
+ * Task starting a GatewayConnectorApp on its task queue
+ */
+class StartConnectorAppTask : public GatewayTask {
+  public:
+
+    StartConnectorAppTask(GatewayConnectorApp* connectorApp, bool* started) : m_ConnectorApp(connectorApp), m_Started(started) { }
+
+    void run()
+    {
+        if (m_ConnectorApp->getOperationalStatus() == GW_OS_RUNNING || !m_ConnectorApp->hasActiveAcl()) {
+            return;
+        }
+
+        *m_Started = true;
+        bool success = m_ConnectorApp->startConnectorApp();
+        if (!success) {
+            QCC_DbgHLPrintf(("Could not start the app %s", m_ConnectorApp->getConnectorId().c_str()));
+        }
+    }
+
+  private:
+
+    GatewayConnectorApp* m_ConnectorApp;
+
+    bool* m_Started;
+};
+
+/**
+ * Task applying the operations of an Acl batch on the task queue
+ */
+class ApplyAclBatchTask : public GatewayTask {
+  public:
+
+    ApplyAclBatchTask(GatewayConnectorApp* connectorApp, std::vector<GatewayAclBatchOperation*> const& operations,
+                      std::vector<GatewayAclRules>* activeRules, GatewayAclBatchUndo* undo, AclResponseCode* responseCode, bool* applied) :
+        m_ConnectorApp(connectorApp), m_Operations(operations), m_ActiveRules(activeRules), m_Undo(undo), m_ResponseCode(responseCode),
+        m_Applied(applied) { }
+
+    void run()
+    {
+        *m_ResponseCode = m_ConnectorApp->applyAclBatch(m_Operations, m_ActiveRules, m_Undo);
+        *m_Applied = true;
+    }
+
+  private:
+
+    GatewayConnectorApp* m_ConnectorApp;
+
+    std::vector<GatewayAclBatchOperation*> const& m_Operations;
+
+    std::vector<GatewayAclRules>* m_ActiveRules;
+
+    GatewayAclBatchUndo* m_Undo;
+
+    AclResponseCode* m_ResponseCode;
+
+    bool* m_Applied;
+};
+
+/**
+ * Task rolling back an applied Acl batch on the task queue
+ */
+class RollbackAclBatchTask : public GatewayTask {
+  public:
+
+    RollbackAclBatchTask(GatewayConnectorApp* connectorApp, GatewayAclBatchUndo* undo, std::vector<GatewayAclRules>* activeRules) :
+        m_ConnectorApp(connectorApp), m_Undo(undo), m_ActiveRules(activeRules) { }
+
+    void run()
+    {
+        m_ConnectorApp->rollbackAclBatch(m_Undo, m_ActiveRules);
+    }
+
+  private:
+
+    GatewayConnectorApp* m_ConnectorApp;
+
+    GatewayAclBatchUndo* m_Undo;
+
+    std::vector<GatewayAclRules>* m_ActiveRules;
+};
+
 GatewayConnectorApp::GatewayConnectorApp(qcc::String const& connectorId, GatewayConnectorAppManifest const& manifest) : m_ConnectorId(connectorId),
     m_ObjectPath(AJ_GW_OBJECTPATH + "/" + connectorId), m_ConnectionStatus(GW_CS_NOT_INITIALIZED), m_OperationalStatus(GW_OS_STOPPED),
-    m_InstallStatus(GW_IS_INSTALLED), m_InstallDescription(""), m_Manifest(manifest), m_AppBusObject(NULL), m_ProcessId(-1)
+    m_InstallStatus(GW_IS_INSTALLED), m_InstallDescription(""), m_Manifest(manifest), m_ManifestReplies(m_Manifest),
+    m_AppBusObject(NULL), m_ProcessId(-1),
+    m_AclSnapshot(new GatewayAclSet(0, std::map<qcc::String, GatewayAcl*>(), NULL)), m_AclSnapshotVersion(0)
 {
 }
 
@@ -48,13 +192,13 @@ GatewayConnectorApp::~GatewayConnectorApp()
 {
 }
 
-QStatus GatewayConnectorApp::init(BusAttachment* bus)
+QStatus GatewayConnectorApp::init(GatewayBus* bus)
 {
     QStatus status = ER_OK;
 
-    if (!bus || !bus->IsStarted() || !bus->IsConnected()) {
+    if (!bus || !bus->isConnected()) {
         status = ER_BAD_ARG_1;
-        QCC_LogError(status, ("Could not accept this BusAttachment, busAttachment not started or not connected"));
+        QCC_LogError(status, ("Could not accept this Bus, bus not connected"));
         return status;
     }
 
@@ -63,13 +207,13 @@ QStatus GatewayConnectorApp::init(BusAttachment* bus)
         return ER_OK;
     }
 
-    m_AppBusObject = new AppBusObject(bus, this, m_ObjectPath, &status);
+    m_AppBusObject = new AppBusObject(bus->getBusAttachment(), this, m_ObjectPath, &status);
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not create AppBusObject"));
         return status;
     }
 
-    status = bus->RegisterBusObject(*m_AppBusObject);
+    status = bus->registerBusObject(*m_AppBusObject);
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not register AppBusObject"));
         return status;
@@ -80,20 +224,17 @@ QStatus GatewayConnectorApp::init(BusAttachment* bus)
         QCC_LogError(status, ("Could not load App Acls"));
         return status;
     }
-
-    std::map<String, GatewayAcl*>::iterator it;
-    for (it = m_Acls.begin(); it != m_Acls.end(); it++) {
-        status = it->second->init(bus);
-        if (status != ER_OK) {
-            QCC_LogError(status, ("Could not register Acl %s", it->first.c_str()));
-            return status;
-        }
-    }
-
-    if (hasActiveAcl()) {
-        bool success = startConnectorApp();
-        if (!success) {
-            QCC_DbgHLPrintf(("Could not start the app %s", m_ConnectorId.c_str()));
+    publishAclSnapshot();
+
+    // in on demand mode the Acl objects are registered once their object paths are handed out
+    if (!GatewayMgmt::getInstance()->getAclObjectsOnDemand()) {
+        std::map<String, GatewayAcl*>::iterator it;
+        for (it = m_Acls.begin(); it != m_Acls.end(); it++) {
+            status = it->second->init(bus);
+            if (status != ER_OK) {
+                QCC_LogError(status, ("Could not register Acl %s", it->first.c_str()));
+                return status;
+            }
         }
     }
 
@@ -103,16 +244,22 @@ QStatus GatewayConnectorApp::init(BusAttachment* bus)
         return status;
     }
 
+    status = m_TaskQueue.start();
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not start the task queue of app %s", m_ConnectorId.c_str()));
+        return status;
+    }
+
     return status;
 }
 
-QStatus GatewayConnectorApp::shutdown(BusAttachment* bus)
+QStatus GatewayConnectorApp::shutdown(GatewayBus* bus)
 {
     QStatus returnStatus = ER_OK;
 
-    if (!bus || !bus->IsStarted() || !bus->IsConnected()) {
+    if (!bus || !bus->isConnected()) {
         returnStatus = ER_BAD_ARG_1;
-        QCC_LogError(returnStatus, ("Could not accept this BusAttachment, busAttachment not started or not connected"));
+        QCC_LogError(returnStatus, ("Could not accept this Bus, bus not connected"));
         return returnStatus;
     }
 
@@ -121,7 +268,11 @@ QStatus GatewayConnectorApp::shutdown(BusAttachment* bus)
         return ER_OK;
     }
 
-    bus->UnregisterBusObject(*m_AppBusObject);
+    bus->unregisterBusObject(*m_AppBusObject);
+
+    // let queued calls finish - nothing touches the App concurrently after this
+    m_TaskQueue.stop();
+
     delete m_AppBusObject;
     m_AppBusObject = NULL;
 
@@ -137,6 +288,7 @@ QStatus GatewayConnectorApp::shutdown(BusAttachment* bus)
         }
         delete acl;
     }
+    publishAclSnapshot();
 
     QStatus status = updatePolicyManager();
     if (status != ER_OK) {
@@ -181,16 +333,113 @@ const std::map<qcc::String, GatewayAcl*>& GatewayConnectorApp::getAcls() const
     return m_Acls;
 }
 
+GatewayRef<GatewayAclSet> GatewayConnectorApp::getAclSnapshot() const
+{
+    GatewayScopedLock lock(m_AclSnapshotLock);
+    return m_AclSnapshot;
+}
+
+void GatewayConnectorApp::publishAclSnapshot()
+{
+    // build the new set outside the lock - readers keep using the previous one meanwhile
+    // sets are only published from the task queue, so the current set can be read without the lock
+    GatewayRef<GatewayAclSet> aclSet(new GatewayAclSet(++m_AclSnapshotVersion, m_Acls, m_AclSnapshot.get()));
+    {
+        GatewayScopedLock lock(m_AclSnapshotLock);
+        m_AclSnapshot.swap(aclSet);
+    }
+    // the previous set is released here, once readers that still hold it are done
+}
+
 const GatewayConnectorAppManifest& GatewayConnectorApp::getManifest() const
 {
     return m_Manifest;
 }
 
+const GatewayManifestReplies& GatewayConnectorApp::getManifestReplies() const
+{
+    return m_ManifestReplies;
+}
+
 AppBusObject* GatewayConnectorApp::getAppBusObject() const
 {
     return m_AppBusObject;
 }
 
+GatewayTaskQueue* GatewayConnectorApp::getTaskQueue()
+{
+    return &m_TaskQueue;
+}
+
+ShardedBusObject* GatewayConnectorApp::getShardedBusObject(qcc::String const& objectPath)
+{
+    if (objectPath == m_ObjectPath) {
+        return m_AppBusObject;
+    }
+
+    // Acl object paths are the object path of the App followed by the aclId
+    size_t prefixSize = m_ObjectPath.size() + 1;
+    if (objectPath.size() <= prefixSize || objectPath.compare(0, m_ObjectPath.size(), m_ObjectPath) != 0 ||
+        objectPath[m_ObjectPath.size()] != '/') {
+        return NULL;
+    }
+
+    std::map<String, GatewayAcl*>::const_iterator it = m_Acls.find(objectPath.substr(prefixSize));
+    if (it == m_Acls.end()) {
+        return NULL;
+    }
+
+    // a client may still hold the object path from before a restart without listing the Acls again
+    if (!it->second->getAclBusObject() && materializeAclObject(it->first) != ER_OK) {
+        return NULL;
+    }
+    return it->second->getAclBusObject();
+}
+
+QStatus GatewayConnectorApp::materializeAclObject(qcc::String const& aclId)
+{
+    std::map<String, GatewayAcl*>::iterator it = m_Acls.find(aclId);
+    if (it == m_Acls.end()) {
+        return ER_BUS_NO_SUCH_OBJECT;
+    }
+
+    if (it->second->getAclBusObject()) {
+        return ER_OK;
+    }
+
+    GatewayBus* bus = GatewayMgmt::getInstance()->getBus();
+    QStatus status = it->second->init(bus);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not register Acl %s", aclId.c_str()));
+    }
+    return status;
+}
+
+bool GatewayConnectorApp::postStartConnectorApp()
+{
+    bool started = false;
+    m_TaskQueue.postAndWait(new StartConnectorAppTask(this, &started));
+    return started;
+}
+
+bool GatewayConnectorApp::postApplyAclBatch(std::vector<GatewayAclBatchOperation*> const& operations, std::vector<GatewayAclRules>* activeRules,
+                                            GatewayAclBatchUndo* undo, AclResponseCode* responseCode)
+{
+    bool applied = false;
+    m_TaskQueue.postAndWait(new ApplyAclBatchTask(this, operations, activeRules, undo, responseCode, &applied));
+    return applied;
+}
+
+void GatewayConnectorApp::postRollbackAclBatch(GatewayAclBatchUndo* undo, std::vector<GatewayAclRules>* activeRules)
+{
+    m_TaskQueue.postAndWait(new RollbackAclBatchTask(this, undo, activeRules));
+}
+
+void GatewayConnectorApp::postCompleteAclBatch()
+{
+    m_TaskQueue.post(new ConnectorAppTask(this, &GatewayConnectorApp::completeAclBatch));
+}
+
 pid_t GatewayConnectorApp::getProcessId() const
 {
     return m_ProcessId;
@@ -242,10 +491,17 @@ QStatus GatewayConnectorApp::loadAcls()
 }
 
 void GatewayConnectorApp::sigChildReceived()
+{
+    GatewayStats::increment(GW_STATS_CONNECTOR_EXITS);
+    m_TaskQueue.post(new ConnectorAppTask(this, &GatewayConnectorApp::processSigChild));
+}
+
+void GatewayConnectorApp::processSigChild()
 {
     m_ConnectionStatus = GW_CS_NOT_INITIALIZED;
     m_OperationalStatus = GW_OS_STOPPED;
     m_ProcessId = -1;
+    removeResourceLimits();
 
     QStatus status = m_AppBusObject->SendAppStatusChangedSignal();
     if (status != ER_OK) {
@@ -274,13 +530,13 @@ void* GatewayConnectorApp::Restart(void* arg)
         }
     }
 
-    bool success = myApp->startConnectorApp();
-    if (!success) {
-        QCC_DbgHLPrintf(("Could not start the Application successfully"));
+    bool started = myApp->postStartConnectorApp();
+    if (!started) {
+        QCC_DbgHLPrintf(("Did not start the Application - no active Acl"));
         return NULL;
     }
 
-    QCC_DbgPrintf(("Restarted the Application successfully"));
+    QCC_DbgPrintf(("Restarted the Application"));
     return NULL;
 }
 
@@ -324,6 +580,7 @@ bool GatewayConnectorApp::hasActiveAcl()
 
 bool GatewayConnectorApp::shutdownConnectorApp()
 {
+    GatewayTraceScope trace("shutdownConnectorApp");
     QStatus status = m_AppBusObject->SendShutdownAppSignal();
     if (status != ER_OK) {
         QCC_DbgHLPrintf(("Could not send shutdownAppSignal"));
@@ -350,6 +607,7 @@ bool GatewayConnectorApp::shutdownConnectorApp()
 
 bool GatewayConnectorApp::startConnectorApp()
 {
+    GatewayTraceScope trace("startConnectorApp");
     QCC_DbgPrintf(("Trying to start the App %s", m_ConnectorId.c_str()));
     pid_t pid = fork();
     if (pid == -1) {
@@ -359,6 +617,7 @@ bool GatewayConnectorApp::startConnectorApp()
 
         m_ProcessId = pid;
         m_OperationalStatus = GW_OS_RUNNING;
+        GatewayStats::increment(GW_STATS_CONNECTOR_STARTS);
         QCC_DbgPrintf(("App %s started with pid %i", m_ConnectorId.c_str(), m_ProcessId));
 
         QStatus status = m_AppBusObject->SendAppStatusChangedSignal();
@@ -367,12 +626,23 @@ bool GatewayConnectorApp::startConnectorApp()
         }
         return true;
     } else {
+        // the signals handled by the event loop are blocked and would stay blocked in the app
+        GatewayEventLoop* eventLoop = GatewayMgmt::getInstance()->getEventLoop();
+        if (eventLoop) {
+            eventLoop->unblockSignals();
+        }
+
         struct passwd* userInfo = getpwnam(m_ConnectorId.c_str());
         if (!userInfo) {
             QCC_DbgHLPrintf(("Could not get the UserInfo for the ConnectorId"));
             _Exit(0);
         }
 
+        if (m_Manifest.hasResourceLimits()) {
+            bool cgroupUsed = applyResourceLimits();
+            QCC_DbgPrintf(("Applied resource limits using %s", cgroupUsed ? "cgroup" : "rlimits"));
+        }
+
         uid_t userId = userInfo->pw_uid;
         int rc = setuid(userId);
         if (rc != 0) {
@@ -413,14 +683,130 @@ bool GatewayConnectorApp::startConnectorApp()
     return false;
 }
 
-AclResponseCode GatewayConnectorApp::createAcl(qcc::String* aclId, qcc::String const& aclName, GatewayAclRules const& aclRules,
-                                               std::map<qcc::String, qcc::String> const& metadata, std::map<qcc::String, qcc::String> const& customMetadata)
+bool GatewayConnectorApp::applyResourceLimits()
 {
-    BusAttachment* bus = GatewayMgmt::getInstance()->getBusAttachment();
+    qcc::String cgroupDirectory = GATEWAY_CGROUP_DIRECTORY + "/" + m_ConnectorId;
+    bool cgroupUsed = false;
+
+    if (mkdir(GATEWAY_CGROUP_DIRECTORY.c_str(), 0755) == 0 || errno == EEXIST) {
+        writeControlFile(GATEWAY_CGROUP_DIRECTORY + "/cgroup.subtree_control", "+cpu +memory");
+        if (mkdir(cgroupDirectory.c_str(), 0755) == 0 || errno == EEXIST) {
+            cgroupUsed = true;
+            if (m_Manifest.getCpuWeight()) {
+                cgroupUsed = writeControlFile(cgroupDirectory + "/cpu.weight", U32ToString(m_Manifest.getCpuWeight()));
+            }
+            if (cgroupUsed && m_Manifest.getMemoryMax()) {
+                cgroupUsed = writeControlFile(cgroupDirectory + "/memory.max", U64ToString(m_Manifest.getMemoryMax()));
+            }
+            if (cgroupUsed) {
+                cgroupUsed = writeControlFile(cgroupDirectory + "/cgroup.procs", I32ToString(getpid()));
+            }
+        }
+    }
 
-    *aclId = generateAclId(aclName);
-    QCC_DbgTrace(("Creating Acl with AclId %s", aclId->c_str()));
+    // cgroups do not limit file descriptors - always use the rlimit for those
+    if (m_Manifest.getOpenFiles()) {
+        struct rlimit limit;
+        limit.rlim_cur = limit.rlim_max = m_Manifest.getOpenFiles();
+        if (setrlimit(RLIMIT_NOFILE, &limit) != 0) {
+            QCC_DbgHLPrintf(("Could not set the open files limit. error no: %i", errno));
+        }
+    }
+
+    if (cgroupUsed) {
+        return true;
+    }
+
+    if (m_Manifest.getMemoryMax()) {
+        struct rlimit limit;
+        limit.rlim_cur = limit.rlim_max = m_Manifest.getMemoryMax();
+        if (setrlimit(RLIMIT_AS, &limit) != 0) {
+            QCC_DbgHLPrintf(("Could not set the memory limit. error no: %i", errno));
+        }
+    }
+
+    if (m_Manifest.getCpuWeight()) {
+        // a weight of 100 is the default and every nice level is a factor of 1.25
+        int niceValue = (int)-floor(log(m_Manifest.getCpuWeight() / 100.0) / log(1.25) + 0.5);
+        niceValue = niceValue < -20 ? -20 : (niceValue > 19 ? 19 : niceValue);
+        if (setpriority(PRIO_PROCESS, 0, niceValue) != 0) {
+            QCC_DbgHLPrintf(("Could not set the process priority. error no: %i", errno));
+        }
+    }
+    return false;
+}
+
+void GatewayConnectorApp::removeResourceLimits()
+{
+    if (!m_Manifest.hasResourceLimits()) {
+        return;
+    }
+
+    qcc::String cgroupDirectory = GATEWAY_CGROUP_DIRECTORY + "/" + m_ConnectorId;
+    if (rmdir(cgroupDirectory.c_str()) != 0 && errno != ENOENT) {
+        QCC_DbgHLPrintf(("Could not remove the cgroup of app %s. error no: %i", m_ConnectorId.c_str(), errno));
+    }
+}
 
+QStatus GatewayConnectorApp::getResourceUsage(uint64_t* cpuUsage, uint64_t* memoryUsage) const
+{
+    *cpuUsage = 0;
+    *memoryUsage = 0;
+
+    if (m_ProcessId == -1) {
+        return ER_OK;
+    }
+
+    qcc::String cgroupDirectory = GATEWAY_CGROUP_DIRECTORY + "/" + m_ConnectorId;
+    qcc::String cpuStat;
+    qcc::String memoryCurrent;
+    if (readControlFile(cgroupDirectory + "/cpu.stat", cpuStat) && readControlFile(cgroupDirectory + "/memory.current", memoryCurrent)) {
+        size_t pos = cpuStat.find("usage_usec ");
+        if (pos != qcc::String::npos) {
+            *cpuUsage = strtoull(cpuStat.c_str() + pos + strlen("usage_usec "), NULL, 10);
+        }
+        *memoryUsage = strtoull(memoryCurrent.c_str(), NULL, 10);
+        return ER_OK;
+    }
+
+    qcc::String procDirectory = "/proc/" + I32ToString(m_ProcessId);
+    qcc::String procStat;
+    if (!readControlFile(procDirectory + "/stat", procStat)) {
+        QCC_DbgHLPrintf(("Could not read the stat file of app %s", m_ConnectorId.c_str()));
+        return ER_READ_ERROR;
+    }
+
+    // utime and stime are fields 14 and 15, counted after the parenthesized command name
+    size_t pos = procStat.find_last_of(')');
+    if (pos == qcc::String::npos) {
+        return ER_READ_ERROR;
+    }
+    const char* field = procStat.c_str() + pos + 1;
+    for (int i = 0; i < 11 && field; i++) {
+        field = strchr(field + 1, ' ');
+    }
+    if (!field) {
+        return ER_READ_ERROR;
+    }
+    char* next = NULL;
+    uint64_t ticks = strtoull(field, &next, 10);
+    ticks += strtoull(next, NULL, 10);
+    *cpuUsage = ticks * 1000000 / sysconf(_SC_CLK_TCK);
+
+    qcc::String procStatm;
+    if (readControlFile(procDirectory + "/statm", procStatm)) {
+        const char* resident = strchr(procStatm.c_str(), ' ');
+        if (resident) {
+            *memoryUsage = strtoull(resident, NULL, 10) * sysconf(_SC_PAGESIZE);
+        }
+    }
+    return ER_OK;
+}
+
+AclResponseCode GatewayConnectorApp::createAcl(qcc::String* aclId, qcc::String const& aclName, GatewayAclRules const& aclRules,
+                                               std::map<qcc::String, qcc::String> const& metadata, std::map<qcc::String, qcc::String> const& customMetadata)
+{
+    GatewayStats::increment(GW_STATS_ACL_CREATES);
     GatewayMetadataManager* metadataManager = GatewayMgmt::getInstance()->getMetadataManager();
     if (!metadataManager) {
         QCC_DbgHLPrintf(("metadataManager is NULL"));
@@ -433,24 +819,17 @@ AclResponseCode GatewayConnectorApp::createAcl(qcc::String* aclId, qcc::String c
         return GW_ACL_RC_METADATA_ERROR;
     }
 
-    GatewayAcl* acl = new GatewayAcl(*aclId, aclName, this, aclRules, customMetadata, GW_AS_INACTIVE);
-    status = acl->init(bus);
-    if (status != ER_OK) {
-        QCC_LogError(status, ("Could not register acl"));
-        delete acl;
-        return GW_ACL_RC_REGISTER_ERROR;
+    AclResponseCode responseCode = addAcl(aclId, aclName, aclRules, customMetadata);
+    if (responseCode != GW_ACL_RC_SUCCESS) {
+        return responseCode;
     }
+    publishAclSnapshot();
 
-    status = acl->writeToFile();
-    if (status != ER_OK) {
-        QCC_LogError(status, ("Could not persist acl"));
-        acl->shutdown(bus);
-        delete acl;
-        return GW_ACL_RC_PERSISTENCE_ERROR;
+    // the reply hands out the object path of the Acl, so it has to be reachable
+    if (materializeAclObject(*aclId) != ER_OK) {
+        QCC_DbgHLPrintf(("Could not register the object of Acl %s", aclId->c_str()));
     }
 
-    m_Acls.insert(std::pair<qcc::String, GatewayAcl*>(*aclId, acl));
-
     if (m_OperationalStatus != GW_OS_RUNNING && hasActiveAcl()) {
         bool success = startConnectorApp();
         if (!success) {
@@ -461,6 +840,41 @@ AclResponseCode GatewayConnectorApp::createAcl(qcc::String* aclId, qcc::String c
     return GW_ACL_RC_SUCCESS;
 }
 
+AclResponseCode GatewayConnectorApp::addAcl(qcc::String* aclId, qcc::String const& aclName, GatewayAclRules const& aclRules,
+                                            std::map<qcc::String, qcc::String> const& customMetadata)
+{
+    *aclId = generateAclId(aclName);
+    QCC_DbgTrace(("Creating Acl with AclId %s", aclId->c_str()));
+
+    return insertAcl(new GatewayAcl(*aclId, aclName, this, aclRules, customMetadata, GW_AS_INACTIVE));
+}
+
+AclResponseCode GatewayConnectorApp::insertAcl(GatewayAcl* acl)
+{
+    GatewayBus* bus = GatewayMgmt::getInstance()->getBus();
+
+    QStatus status = ER_OK;
+    if (!GatewayMgmt::getInstance()->getAclObjectsOnDemand()) {
+        status = acl->init(bus);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Could not register acl"));
+            delete acl;
+            return GW_ACL_RC_REGISTER_ERROR;
+        }
+    }
+
+    status = acl->writeToFile();
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not persist acl"));
+        acl->shutdown(bus);
+        delete acl;
+        return GW_ACL_RC_PERSISTENCE_ERROR;
+    }
+
+    m_Acls.insert(std::pair<qcc::String, GatewayAcl*>(acl->getAclId(), acl));
+    return GW_ACL_RC_SUCCESS;
+}
+
 qcc::String GatewayConnectorApp::generateAclId(qcc::String const& aclName)
 {
     qcc::String aclId = "";
@@ -497,8 +911,7 @@ qcc::String GatewayConnectorApp::generateAclId(qcc::String const& aclName)
 
 AclResponseCode GatewayConnectorApp::deleteAcl(qcc::String const& aclId)
 {
-    BusAttachment* bus = GatewayMgmt::getInstance()->getBusAttachment();
-
+    GatewayStats::increment(GW_STATS_ACL_DELETES);
     std::map<String, GatewayAcl*>::iterator it;
     it = m_Acls.find(aclId);
     if (it == m_Acls.end()) {
@@ -506,27 +919,17 @@ AclResponseCode GatewayConnectorApp::deleteAcl(qcc::String const& aclId)
         return GW_ACL_RC_ACL_NOT_FOUND;
     }
 
-    GatewayAcl* acl = it->second;
-    AclStatus aclStatus = acl->getAclStatus();
-
-    int rc = remove((GATEWAY_APPS_DIRECTORY + "/" + m_ConnectorId + "/acls/" + aclId).c_str());
-    if (rc != 0) {
-        QCC_DbgHLPrintf(("Could not remove acl successfully"));
-        return GW_ACL_RC_PERSISTENCE_ERROR;
-    }
+    AclStatus aclStatus = it->second->getAclStatus();
 
-    QStatus status = acl->shutdown(bus);
-    if (status != ER_OK) {
-        QCC_LogError(status, ("Could not unregister acl"));
-        //Not returning an error - we should be able to recover from this
+    AclResponseCode responseCode = removeAcl(it);
+    if (responseCode != GW_ACL_RC_SUCCESS) {
+        return responseCode;
     }
-
-    m_Acls.erase(it);
-    delete acl;
+    publishAclSnapshot();
 
     if (aclStatus == GW_AS_ACTIVE) {
         //acl was active - update policies and let app know acls changed
-        status = updatePolicyManager();
+        QStatus status = updatePolicyManager();
         if (status != ER_OK) {
             QCC_LogError(status, ("Could not update policies successfully"));
             return GW_ACL_RC_POLICYMANAGER_ERROR;
@@ -557,13 +960,7 @@ QStatus GatewayConnectorApp::updatePolicyManager()
     }
 
     std::vector<GatewayAclRules> aclRules;
-    std::map<String, GatewayAcl*>::iterator it;
-
-    for (it = m_Acls.begin(); it != m_Acls.end(); it++) {
-        if (it->second->getAclStatus() == GW_AS_ACTIVE) {
-            aclRules.push_back(it->second->getAclRules());
-        }
-    }
+    getActiveAclRules(&aclRules);
 
     bool success = policyManager->addConnectorAppRules(m_ConnectorId, aclRules);
     if (!success) {
@@ -573,6 +970,195 @@ QStatus GatewayConnectorApp::updatePolicyManager()
     return ER_OK;
 }
 
+void GatewayConnectorApp::getActiveAclRules(std::vector<GatewayAclRules>* aclRules) const
+{
+    std::map<String, GatewayAcl*>::const_iterator it;
+    for (it = m_Acls.begin(); it != m_Acls.end(); it++) {
+        if (it->second->getAclStatus() == GW_AS_ACTIVE) {
+            aclRules->push_back(it->second->getAclRules());
+        }
+    }
+}
+
+AclResponseCode GatewayConnectorApp::removeAcl(std::map<qcc::String, GatewayAcl*>::iterator it)
+{
+    GatewayBus* bus = GatewayMgmt::getInstance()->getBus();
+    GatewayAcl* acl = it->second;
+
+    // remove the patches first - a new acl with the same aclId must not pick them up
+    int rc = remove((GATEWAY_APPS_DIRECTORY + "/" + m_ConnectorId + "/aclPatches/" + acl->getAclId()).c_str());
+    if (rc != 0 && errno != ENOENT) {
+        QCC_DbgHLPrintf(("Could not remove acl patches successfully"));
+        return GW_ACL_RC_PERSISTENCE_ERROR;
+    }
+
+    rc = remove((GATEWAY_APPS_DIRECTORY + "/" + m_ConnectorId + "/acls/" + acl->getAclId()).c_str());
+    if (rc != 0) {
+        QCC_DbgHLPrintf(("Could not remove acl successfully"));
+        return GW_ACL_RC_PERSISTENCE_ERROR;
+    }
+
+    QStatus status = acl->shutdown(bus);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not unregister acl"));
+        //Not returning an error - we should be able to recover from this
+    }
+
+    m_Acls.erase(it);
+    delete acl;
+    return GW_ACL_RC_SUCCESS;
+}
+
+AclResponseCode GatewayConnectorApp::applyAclBatch(std::vector<GatewayAclBatchOperation*> const& operations, std::vector<GatewayAclRules>* activeRules,
+                                                   GatewayAclBatchUndo* undo)
+{
+    AclResponseCode responseCode = GW_ACL_RC_SUCCESS;
+
+    for (size_t i = 0; i < operations.size() && responseCode == GW_ACL_RC_SUCCESS; i++) {
+        GatewayAclBatchOperation* operation = operations[i];
+
+        std::map<String, GatewayAcl*>::iterator it = m_Acls.find(operation->m_AclId);
+        if (operation->m_Type != GW_BO_CREATE_ACL && it == m_Acls.end()) {
+            QCC_DbgHLPrintf(("Could not find acl %s of the batch", operation->m_AclId.c_str()));
+            operation->m_ResponseCode = GW_ACL_RC_ACL_NOT_FOUND;
+            responseCode = GW_ACL_RC_ACL_NOT_FOUND;
+            break;
+        }
+
+        // an acl is changed at most once per batch, so this is its state before the batch
+        GatewayAclBatchUndo::AclState aclState;
+        bool wasActive = false;
+        if (operation->m_Type != GW_BO_CREATE_ACL) {
+            aclState.m_AclId = it->first;
+            aclState.m_AclName = it->second->getAclName();
+            aclState.m_AclRules = it->second->getAclRules();
+            aclState.m_CustomMetadata = it->second->getCustomMetadata();
+            aclState.m_AclStatus = it->second->getAclStatus();
+            wasActive = aclState.m_AclStatus == GW_AS_ACTIVE;
+        }
+
+        bool isActive = wasActive;
+        switch (operation->m_Type) {
+        case GW_BO_CREATE_ACL:
+            responseCode = addAcl(&operation->m_AclId, operation->m_AclName, operation->m_AclRules, operation->m_CustomMetadata);
+            aclState.m_AclId = operation->m_AclId;
+            aclState.m_Created = true;
+
+            // the reply hands out the object path of the Acl, so it has to be reachable
+            if (responseCode == GW_ACL_RC_SUCCESS && materializeAclObject(operation->m_AclId) != ER_OK) {
+                QCC_DbgHLPrintf(("Could not register the object of Acl %s", operation->m_AclId.c_str()));
+            }
+            break;
+
+        case GW_BO_UPDATE_ACL:
+            responseCode = it->second->persistAcl(operation->m_AclName, operation->m_AclRules, operation->m_CustomMetadata);
+            break;
+
+        case GW_BO_ACTIVATE_ACL:
+            responseCode = it->second->persistAclStatus(GW_AS_ACTIVE);
+            isActive = true;
+            break;
+
+        case GW_BO_DEACTIVATE_ACL:
+            responseCode = it->second->persistAclStatus(GW_AS_INACTIVE);
+            isActive = false;
+            break;
+
+        case GW_BO_DELETE_ACL:
+            responseCode = removeAcl(it);
+            isActive = false;
+            break;
+
+        default:
+            responseCode = GW_ACL_RC_INVALID;
+            break;
+        }
+
+        operation->m_ResponseCode = responseCode;
+        if (responseCode == GW_ACL_RC_SUCCESS) {
+            undo->m_AclStates.push_back(aclState);
+            undo->m_ActiveRulesChanged = undo->m_ActiveRulesChanged || wasActive != isActive ||
+                                         (isActive && operation->m_Type == GW_BO_UPDATE_ACL);
+        }
+    }
+
+    if (responseCode != GW_ACL_RC_SUCCESS) {
+        // the operations before the failing one are undone - they report that they were not applied
+        for (size_t i = 0; i < operations.size() && operations[i]->m_ResponseCode == GW_ACL_RC_SUCCESS; i++) {
+            operations[i]->m_ResponseCode = GW_ACL_RC_INVALID;
+            if (operations[i]->m_Type == GW_BO_CREATE_ACL) {
+                operations[i]->m_AclId.clear();
+            }
+        }
+        rollbackAclBatch(undo, activeRules);
+        return responseCode;
+    }
+
+    if (!undo->m_AclStates.empty()) {
+        publishAclSnapshot();
+    }
+    getActiveAclRules(activeRules);
+    return responseCode;
+}
+
+void GatewayConnectorApp::rollbackAclBatch(GatewayAclBatchUndo* undo, std::vector<GatewayAclRules>* activeRules)
+{
+    if (undo->m_AclStates.empty()) {
+        getActiveAclRules(activeRules);
+        return;
+    }
+
+    for (size_t i = undo->m_AclStates.size(); i > 0; i--) {
+        GatewayAclBatchUndo::AclState const& aclState = undo->m_AclStates[i - 1];
+        std::map<String, GatewayAcl*>::iterator it = m_Acls.find(aclState.m_AclId);
+
+        AclResponseCode responseCode = GW_ACL_RC_SUCCESS;
+        if (aclState.m_Created) {
+            if (it != m_Acls.end()) {
+                responseCode = removeAcl(it);
+            }
+        } else if (it == m_Acls.end()) {
+            responseCode = insertAcl(new GatewayAcl(aclState.m_AclId, aclState.m_AclName, this, aclState.m_AclRules,
+                                                    aclState.m_CustomMetadata, aclState.m_AclStatus));
+        } else {
+            responseCode = it->second->persistAcl(aclState.m_AclName, aclState.m_AclRules, aclState.m_CustomMetadata);
+            if (responseCode == GW_ACL_RC_SUCCESS) {
+                responseCode = it->second->persistAclStatus(aclState.m_AclStatus);
+            }
+        }
+
+        if (responseCode != GW_ACL_RC_SUCCESS) {
+            QCC_DbgHLPrintf(("Could not roll back acl %s of the batch", aclState.m_AclId.c_str()));
+        }
+    }
+
+    undo->m_AclStates.clear();
+    undo->m_ActiveRulesChanged = false;
+    publishAclSnapshot();
+    getActiveAclRules(activeRules);
+}
+
+void GatewayConnectorApp::completeAclBatch()
+{
+    QStatus status = m_AppBusObject->SendAclUpdatedSignal();
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Sending AclUpdated Failed"));
+    }
+
+    if (m_OperationalStatus != GW_OS_RUNNING && hasActiveAcl()) {
+        bool success = startConnectorApp();
+        if (!success) {
+            QCC_DbgHLPrintf(("Could not start the app %s", m_ConnectorId.c_str()));
+        }
+    } else if (m_OperationalStatus == GW_OS_RUNNING && !hasActiveAcl()) {
+        pthread_t thread;
+        bool success = shutdownConnectorApp(&thread);
+        if (!success) {
+            QCC_DbgHLPrintf(("Could not stop the app %s", m_ConnectorId.c_str()));
+        }
+    }
+}
+
 } /* namespace gw */
 } /* namespace ajn */
 
@@ -16,18 +16,48 @@
 
 #include <alljoyn/gateway/GatewayConnectorApp.h>
 #include <alljoyn/gateway/GatewayConnectorAppManager.h>
+#include <alljoyn/gateway/GatewayEventLoop.h>
 #include <alljoyn/gateway/GatewayMgmt.h>
 #include <alljoyn/gateway/GatewayRouterPolicyManager.h>
+#include <alljoyn/gateway/GatewayMetadataManager.h>
+#include <alljoyn/gateway/GatewayStats.h>
 #include "busObjects/AppMgmtBusObject.h"
 #include "GatewayConstants.h"
 #include <dirent.h>
+#include <unistd.h>
+#include <algorithm>
+#include <set>
 
 namespace ajn {
 namespace gw {
 using namespace qcc;
 using namespace gwConsts;
 
-GatewayConnectorAppManager::GatewayConnectorAppManager() : m_AppMgmtBusObject(NULL)
+static bool compareStartPriority(GatewayConnectorApp* app1, GatewayConnectorApp* app2)
+{
+    return app1->getManifest().getPriority() > app2->getManifest().getPriority();
+}
+
+/**
+ * Timer of the event loop starting the next batch of apps
+ */
+class StartAppsTask : public GatewayTask {
+  public:
+
+    StartAppsTask(GatewayConnectorAppManager* manager) : m_Manager(manager) { }
+
+    void run()
+    {
+        m_Manager->startNextApps();
+    }
+
+  private:
+
+    GatewayConnectorAppManager* m_Manager;
+};
+
+GatewayConnectorAppManager::GatewayConnectorAppManager() : m_AppMgmtBusObject(NULL), m_NextStartApp(0), m_StartAppsTimerId(0),
+    m_StartingApps(false), m_StopStartingApps(false), m_StartConcurrency(GATEWAY_CONNECTOR_START_CONCURRENCY), m_StartStaggerMs(GATEWAY_CONNECTOR_START_STAGGER_MS)
 {
 }
 
@@ -35,18 +65,18 @@ GatewayConnectorAppManager::~GatewayConnectorAppManager()
 {
 }
 
-std::map<String, GatewayConnectorApp*> GatewayConnectorAppManager::getConnectorApps() const
+const std::map<String, GatewayConnectorApp*>& GatewayConnectorAppManager::getConnectorApps() const
 {
     return m_ConnectorApps;
 }
 
-QStatus GatewayConnectorAppManager::init(BusAttachment* bus)
+QStatus GatewayConnectorAppManager::init(GatewayBus* bus)
 {
     QStatus status = ER_OK;
 
-    if (!bus || !bus->IsStarted() || !bus->IsConnected()) {
+    if (!bus || !bus->isConnected()) {
         status = ER_BAD_ARG_1;
-        QCC_LogError(status, ("Could not accept this BusAttachment, busAttachment not started or not connected"));
+        QCC_LogError(status, ("Could not accept this Bus, bus not connected"));
         return status;
     }
 
@@ -55,13 +85,13 @@ QStatus GatewayConnectorAppManager::init(BusAttachment* bus)
         return ER_OK;
     }
 
-    m_AppMgmtBusObject = new AppMgmtBusObject(bus, this, &status);
+    m_AppMgmtBusObject = new AppMgmtBusObject(bus->getBusAttachment(), this, &status);
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not create GatewayConnectorAppMgmt BusObject"));
         return status;
     }
 
-    status = bus->RegisterBusObject(*m_AppMgmtBusObject);
+    status = bus->registerBusObject(*m_AppMgmtBusObject);
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not register GatewayConnectorAppMgmt BusObject"));
         return status;
@@ -85,13 +115,13 @@ QStatus GatewayConnectorAppManager::init(BusAttachment* bus)
     return status;
 }
 
-QStatus GatewayConnectorAppManager::shutdown(BusAttachment* bus)
+QStatus GatewayConnectorAppManager::shutdown(GatewayBus* bus)
 {
     QStatus returnStatus = ER_OK;
 
-    if (!bus || !bus->IsStarted() || !bus->IsConnected()) {
+    if (!bus || !bus->isConnected()) {
         returnStatus = ER_BAD_ARG_1;
-        QCC_LogError(returnStatus, ("Could not acccept this BusAttachment, busAttachment not started or not connected"));
+        QCC_LogError(returnStatus, ("Could not acccept this Bus, bus not connected"));
         return returnStatus;
     }
 
@@ -106,7 +136,9 @@ QStatus GatewayConnectorAppManager::shutdown(BusAttachment* bus)
         return ER_FAIL;
     }
 
-    bus->UnregisterBusObject(*m_AppMgmtBusObject);
+    stopStartingApps();
+
+    bus->unregisterBusObject(*m_AppMgmtBusObject);
     delete m_AppMgmtBusObject;
     m_AppMgmtBusObject = NULL;
 
@@ -125,6 +157,11 @@ QStatus GatewayConnectorAppManager::shutdown(BusAttachment* bus)
         pthread_join(shutdownThreads[i], NULL);
     }
 
+    // hold back commits while the apps shut down and remove all their rules in one go
+    bool autoCommit = policyManager->getAutoCommit();
+    policyManager->setAutoCommit(false);
+
+    std::vector<qcc::String> connectorIds;
     for (it = m_ConnectorApps.begin(); it != m_ConnectorApps.end();) {
         GatewayConnectorApp* app = it->second;
 
@@ -135,14 +172,17 @@ QStatus GatewayConnectorAppManager::shutdown(BusAttachment* bus)
         }
         m_ConnectorApps.erase(it++);
 
-        bool success = policyManager->removeConnectorAppRules(app->getConnectorId());
-        if (!success) {
-            QCC_DbgHLPrintf(("Updating the Policies failed"));
-            returnStatus =  ER_FAIL;
-        }
+        connectorIds.push_back(app->getConnectorId());
         delete app;
     }
 
+    policyManager->setAutoCommit(autoCommit);
+    bool success = policyManager->removeConnectorAppRules(connectorIds);
+    if (!success) {
+        QCC_DbgHLPrintf(("Updating the Policies failed"));
+        returnStatus =  ER_FAIL;
+    }
+
     return returnStatus;
 }
 
@@ -183,6 +223,233 @@ QStatus GatewayConnectorAppManager::loadConnectorApps()
     return ER_OK;
 }
 
+QStatus GatewayConnectorAppManager::startConnectorApps(uint32_t concurrency, uint32_t staggerMs)
+{
+    GatewayEventLoop* eventLoop = GatewayMgmt::getInstance()->getEventLoop();
+    {
+        GatewayScopedLock lock(m_StartAppsLock);
+        if (m_StartingApps) {
+            QCC_DbgPrintf(("Apps are already being started. Ignoring request"));
+            return ER_OK;
+        }
+        m_StartingApps = true;
+        m_StopStartingApps = false;
+        m_StartConcurrency = concurrency ? concurrency : 1;
+        m_StartStaggerMs = staggerMs;
+
+        m_StartApps.clear();
+        std::map<String, GatewayConnectorApp*>::iterator it;
+        for (it = m_ConnectorApps.begin(); it != m_ConnectorApps.end(); it++) {
+            m_StartApps.push_back(it->second);
+        }
+        std::stable_sort(m_StartApps.begin(), m_StartApps.end(), compareStartPriority);
+        m_NextStartApp = 0;
+
+        if (eventLoop) {
+            m_StartAppsTimerId = eventLoop->addTimer(new StartAppsTask(this), 0);
+            if (!m_StartAppsTimerId) {
+                QCC_DbgHLPrintf(("Could not schedule starting the apps"));
+                m_StartingApps = false;
+                return ER_FAIL;
+            }
+            return ER_OK;
+        }
+    }
+
+    // nothing to stagger the batches with
+    for (size_t i = 0; i < m_StartApps.size() && !m_StopStartingApps; i++) {
+        m_StartApps[i]->postStartConnectorApp();
+    }
+    QCC_DbgPrintf(("Finished starting the apps"));
+    return ER_OK;
+}
+
+void GatewayConnectorAppManager::startNextApps()
+{
+    uint32_t startedInBatch = 0;
+    size_t next = m_NextStartApp;
+    while (next < m_StartApps.size() && startedInBatch < m_StartConcurrency && !m_StopStartingApps) {
+        if (m_StartApps[next++]->postStartConnectorApp()) {
+            startedInBatch++;
+        }
+    }
+
+    GatewayScopedLock lock(m_StartAppsLock);
+    m_NextStartApp = next;
+    m_StartAppsTimerId = 0;
+    if (next == m_StartApps.size()) {
+        QCC_DbgPrintf(("Finished starting the apps"));
+        return;
+    }
+    if (m_StopStartingApps) {
+        return;
+    }
+
+    GatewayEventLoop* eventLoop = GatewayMgmt::getInstance()->getEventLoop();
+    m_StartAppsTimerId = eventLoop->addTimer(new StartAppsTask(this), m_StartStaggerMs);
+}
+
+void GatewayConnectorAppManager::stopStartingApps()
+{
+    uint32_t timerId = 0;
+    {
+        GatewayScopedLock lock(m_StartAppsLock);
+        if (!m_StartingApps) {
+            return;
+        }
+        m_StopStartingApps = true;
+        timerId = m_StartAppsTimerId;
+    }
+
+    // a batch that is being started is waited for - it sees the flag and schedules no other batch
+    GatewayEventLoop* eventLoop = GatewayMgmt::getInstance()->getEventLoop();
+    if (eventLoop && timerId) {
+        eventLoop->cancelTimer(timerId);
+    }
+
+    GatewayScopedLock lock(m_StartAppsLock);
+    m_StartAppsTimerId = 0;
+    m_StartingApps = false;
+}
+
+AclResponseCode GatewayConnectorAppManager::batchUpdate(std::vector<GatewayAclBatchOperation>& operations)
+{
+    GatewayStats::increment(GW_STATS_ACL_BATCHES);
+    GatewayMetadataManager* metadataManager = GatewayMgmt::getInstance()->getMetadataManager();
+    if (!metadataManager) {
+        QCC_DbgHLPrintf(("metadataManager is NULL"));
+        return GW_ACL_RC_METADATA_ERROR;
+    }
+
+    GatewayRouterPolicyManager* policyManager = GatewayMgmt::getInstance()->getRouterPolicyManager();
+    if (!policyManager) {
+        QCC_DbgHLPrintf(("PolicyManager not defined"));
+        return GW_ACL_RC_POLICYMANAGER_ERROR;
+    }
+
+    // validate all operations before any of them is applied
+    std::map<String, std::vector<GatewayAclBatchOperation*> > appOperations;
+    std::set<String> changedAcls;
+    std::map<String, String> metadata;
+    for (size_t i = 0; i < operations.size(); i++) {
+        GatewayAclBatchOperation& operation = operations[i];
+        operation.m_ResponseCode = GW_ACL_RC_INVALID;
+
+        std::map<String, GatewayConnectorApp*>::iterator appIter = m_ConnectorApps.find(operation.m_ConnectorId);
+        if (appIter == m_ConnectorApps.end()) {
+            QCC_DbgHLPrintf(("Could not find app %s of the batch", operation.m_ConnectorId.c_str()));
+            return GW_ACL_RC_INVALID;
+        }
+
+        if (operation.m_Type != GW_BO_CREATE_ACL) {
+            if (!appIter->second->getAclSnapshot()->findAcl(operation.m_AclId)) {
+                QCC_DbgHLPrintf(("Could not find acl %s of the batch", operation.m_AclId.c_str()));
+                operation.m_ResponseCode = GW_ACL_RC_ACL_NOT_FOUND;
+                return GW_ACL_RC_ACL_NOT_FOUND;
+            }
+
+            // an acl can only be changed once per batch
+            if (!changedAcls.insert(operation.m_ConnectorId + "/" + operation.m_AclId).second) {
+                QCC_DbgHLPrintf(("Acl %s is changed more than once in the batch", operation.m_AclId.c_str()));
+                return GW_ACL_RC_INVALID;
+            }
+        }
+
+        if (operation.m_Type == GW_BO_CREATE_ACL || operation.m_Type == GW_BO_UPDATE_ACL) {
+            metadata.insert(operation.m_Metadata.begin(), operation.m_Metadata.end());
+        }
+        appOperations[operation.m_ConnectorId].push_back(&operation);
+    }
+
+    // every app applies its operations on its own task queue and undoes them itself if one fails.
+    // The apps that applied their operations are rolled back if a later part of the batch fails
+    AclResponseCode responseCode = GW_ACL_RC_SUCCESS;
+    std::map<String, GatewayAclBatchUndo> undos;
+    std::map<String, std::vector<GatewayAclRules> > activeRules;
+    std::map<String, std::vector<GatewayAclBatchOperation*> >::iterator iter;
+    for (iter = appOperations.begin(); iter != appOperations.end(); iter++) {
+        std::vector<GatewayAclRules> appRules;
+        GatewayAclBatchUndo undo;
+        bool applied = m_ConnectorApps[iter->first]->postApplyAclBatch(iter->second, &appRules, &undo, &responseCode);
+        if (!applied) {
+            QCC_DbgHLPrintf(("App %s stopped before the batch was applied", iter->first.c_str()));
+            responseCode = GW_ACL_RC_REGISTER_ERROR;
+        }
+        if (responseCode != GW_ACL_RC_SUCCESS) {
+            break;
+        }
+
+        // only apps whose active rules changed need new policies and a notification
+        if (undo.m_ActiveRulesChanged) {
+            activeRules[iter->first].swap(appRules);
+        }
+        undos[iter->first] = undo;
+    }
+
+    // the metadata is only persisted once all operations are applied
+    if (responseCode == GW_ACL_RC_SUCCESS) {
+        QStatus status = metadataManager->updateMetadata(metadata);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Could not persist metadata"));
+            responseCode = GW_ACL_RC_METADATA_ERROR;
+        }
+    }
+
+    bool policiesChanged = false;
+    if (responseCode == GW_ACL_RC_SUCCESS && !activeRules.empty()) {
+        policiesChanged = true;
+        bool success = policyManager->addConnectorAppRules(activeRules);
+        if (!success) {
+            QCC_DbgHLPrintf(("Updating the Policies failed"));
+            responseCode = GW_ACL_RC_POLICYMANAGER_ERROR;
+        }
+    }
+
+    if (responseCode != GW_ACL_RC_SUCCESS) {
+        rollbackBatch(operations, undos, policiesChanged);
+        return responseCode;
+    }
+
+    std::map<String, std::vector<GatewayAclRules> >::iterator rulesIter;
+    for (rulesIter = activeRules.begin(); rulesIter != activeRules.end(); rulesIter++) {
+        m_ConnectorApps[rulesIter->first]->postCompleteAclBatch();
+    }
+
+    return responseCode;
+}
+
+void GatewayConnectorAppManager::rollbackBatch(std::vector<GatewayAclBatchOperation>& operations, std::map<qcc::String, GatewayAclBatchUndo>& undos,
+                                               bool policiesChanged)
+{
+    std::map<String, std::vector<GatewayAclRules> > activeRules;
+    std::map<String, GatewayAclBatchUndo>::iterator undoIter;
+    for (undoIter = undos.begin(); undoIter != undos.end(); undoIter++) {
+        std::vector<GatewayAclRules> appRules;
+        bool activeRulesChanged = undoIter->second.m_ActiveRulesChanged;
+        m_ConnectorApps[undoIter->first]->postRollbackAclBatch(&undoIter->second, &appRules);
+        if (activeRulesChanged) {
+            activeRules[undoIter->first].swap(appRules);
+        }
+    }
+
+    // the operations of the rolled back apps report that they were not applied
+    for (size_t i = 0; i < operations.size(); i++) {
+        if (undos.find(operations[i].m_ConnectorId) == undos.end()) {
+            continue;
+        }
+        operations[i].m_ResponseCode = GW_ACL_RC_INVALID;
+        if (operations[i].m_Type == GW_BO_CREATE_ACL) {
+            operations[i].m_AclId.clear();
+        }
+    }
+
+    // the policies were overwritten with the rules of the batch - put back the restored ones
+    GatewayRouterPolicyManager* policyManager = GatewayMgmt::getInstance()->getRouterPolicyManager();
+    if (policiesChanged && policyManager && !policyManager->addConnectorAppRules(activeRules)) {
+        QCC_DbgHLPrintf(("Could not restore the Policies of the batch"));
+    }
+}
+
 void GatewayConnectorAppManager::sigChildReceived(pid_t pid)
 {
     std::map<String, GatewayConnectorApp*>::iterator it;
@@ -17,6 +17,7 @@
 #include <alljoyn/gateway/GatewayConnectorAppManifest.h>
 #include <alljoyn/gateway/GatewayMgmt.h>
 #include <fstream>
+#include <stdlib.h>
 #include "GatewayConstants.h"
 #include <libxml/xmlschemas.h>
 
@@ -25,7 +26,7 @@ namespace gw {
 using namespace gwConsts;
 
 GatewayConnectorAppManifest::GatewayConnectorAppManifest() : m_ManifestData(""), m_PackageName(""), m_FriendlyName(""),
-    m_ExecutableName(""), m_Version(""), m_MinAjSdkVersion("")
+    m_ExecutableName(""), m_Version(""), m_MinAjSdkVersion(""), m_Priority(0), m_CpuWeight(0), m_MemoryMax(0), m_OpenFiles(0)
 {
 }
 
@@ -83,6 +84,31 @@ const std::vector<qcc::String>& GatewayConnectorAppManifest::getAppArguments() c
     return m_AppArguments;
 }
 
+uint32_t GatewayConnectorAppManifest::getPriority() const
+{
+    return m_Priority;
+}
+
+uint32_t GatewayConnectorAppManifest::getCpuWeight() const
+{
+    return m_CpuWeight;
+}
+
+uint64_t GatewayConnectorAppManifest::getMemoryMax() const
+{
+    return m_MemoryMax;
+}
+
+uint32_t GatewayConnectorAppManifest::getOpenFiles() const
+{
+    return m_OpenFiles;
+}
+
+bool GatewayConnectorAppManifest::hasResourceLimits() const
+{
+    return m_CpuWeight != 0 || m_MemoryMax != 0 || m_OpenFiles != 0;
+}
+
 QStatus GatewayConnectorAppManifest::parseManifestFile(qcc::String const& manifestFileName)
 {
     std::ifstream ifs(manifestFileName.c_str());
@@ -160,6 +186,8 @@ QStatus GatewayConnectorAppManifest::parseManifestFile(qcc::String const& manife
             parseObjects(currentKey, m_RemotedServices);
         } else if (xmlStrEqual(keyName, (const xmlChar*)"executionInfo")) {
             parseExecutionInfo(currentKey);
+        } else if (xmlStrEqual(keyName, (const xmlChar*)"resourceLimits")) {
+            parseResourceLimits(currentKey);
         }
     }
 
@@ -274,6 +302,29 @@ void GatewayConnectorAppManifest::parseExecutionInfo(xmlNode* currentKey)
                 qcc::String argValue = (const char*)argumentKey->children->content;
                 m_AppArguments.push_back(argValue);
             }
+        } else if (xmlStrEqual(execInfoKeyName, (const xmlChar*)"priority")) {
+            m_Priority = (uint32_t)strtoul((const char*)execInfoKey->children->content, NULL, 10);
+        }
+    }
+}
+
+void GatewayConnectorAppManifest::parseResourceLimits(xmlNode* currentKey)
+{
+    for  (xmlNode* limitKey = currentKey->children; limitKey != NULL; limitKey = limitKey->next) {
+
+        if (limitKey->type != XML_ELEMENT_NODE || limitKey->children == NULL) {
+            continue;
+        }
+
+        const xmlChar* limitKeyName = limitKey->name;
+        const char* value = (const char*)limitKey->children->content;
+
+        if (xmlStrEqual(limitKeyName, (const xmlChar*)"cpuWeight")) {
+            m_CpuWeight = (uint32_t)strtoul(value, NULL, 10);
+        } else if (xmlStrEqual(limitKeyName, (const xmlChar*)"memoryMax")) {
+            m_MemoryMax = (uint64_t)strtoull(value, NULL, 10);
+        } else if (xmlStrEqual(limitKeyName, (const xmlChar*)"openFiles")) {
+            m_OpenFiles = (uint32_t)strtoul(value, NULL, 10);
         }
     }
 }
@@ -33,6 +33,32 @@ static const uint16_t GATEWAY_PORT = 1020;
 static const uint16_t GATEWAY_MANAGEMENT_VERSION = 1;
 
 static const qcc::String GATEWAY_APPS_DIRECTORY = "/opt/alljoyn/apps";
+static const qcc::String GATEWAY_CGROUP_DIRECTORY = "/sys/fs/cgroup/alljoyn-gwagent";
+
+static const uint32_t GATEWAY_CONNECTOR_START_CONCURRENCY = 2;
+static const uint32_t GATEWAY_CONNECTOR_START_STAGGER_MS = 500;
+
+static const uint32_t GATEWAY_APP_STATUS_COALESCE_MS = 250;
+static const uint32_t GATEWAY_SESSION_ID_ALL_HOSTED = 0xFFFFFFFF;
+
+static const uint32_t GATEWAY_LIST_PAGE_SIZE_DEFAULT = 100;
+static const uint32_t GATEWAY_LIST_PAGE_SIZE_MAX = 1000;
+
+static const uint32_t GATEWAY_ACL_PATCHES_BEFORE_REWRITE = 64;
+
+static const uint32_t GATEWAY_EVENT_LOOP_TICK_MS = 10;
+static const uint32_t GATEWAY_EVENT_LOOP_WHEEL_SLOTS = 512;
+
+static const uint32_t GATEWAY_LOOPBACK_CALL_TIMEOUT_MS = 25000;
+
+static const uint32_t GATEWAY_STATS_MAX_METHODS = 64;
+
+static const uint32_t GATEWAY_TRACE_RING_EVENTS = 4096;
+static const uint32_t GATEWAY_TRACE_MAX_RINGS = 64;
+static const qcc::String GATEWAY_TRACE_FILE = "/tmp/alljoyn-gwagent-trace.json";
+
+static const qcc::String GATEWAY_RECORD_MAGIC = "GWRC";
+static const uint32_t GATEWAY_RECORD_VERSION = 1;
 
 static const qcc::String AJPARAM_EMPTY = "";
 static const qcc::String AJPARAM_BOOL = "b";
@@ -40,9 +66,12 @@ static const qcc::String AJPARAM_STR = "s";
 static const qcc::String AJPARAM_OBJECTPATH = "o";
 static const qcc::String AJPARAM_UINT16 = "q";
 static const qcc::String AJPARAM_UINT32 = "u";
+static const qcc::String AJPARAM_UINT64 = "t";
 static const qcc::String AJPARAM_ARRAY_UINT16 = "aq";
+static const qcc::String AJPARAM_ARRAY_UINT64 = "at";
 static const qcc::String AJPARAM_ARRAY_STR = "as";
 static const qcc::String AJPARAM_BINARY_ARR = "ay";
+static const qcc::String AJPARAM_VAR = "v";
 
 static const qcc::String AJPARAM_MANIFEST_INTERFACE_STRUCT = "(ssb)";
 static const qcc::String AJPARAM_MANIFEST_INTERFACE_INFO = "((obs)a(ssb))";
@@ -57,6 +86,19 @@ static const qcc::String AJPARAM_ACL_METADATA = "{ss}";
 static const qcc::String AJPARAM_ACL_METADATA_ARRAY = "a{ss}";
 static const qcc::String AJPARAM_ACLS_STRUCT = "(ssqo)";
 static const qcc::String AJPARAM_ACLS_STRUCT_ARRAY = "a(ssqo)";
+static const qcc::String AJPARAM_ID_STATUS_STRUCT = "(sq)";
+static const qcc::String AJPARAM_ID_STATUS_STRUCT_ARRAY = "a(sq)";
+static const qcc::String AJPARAM_ACL_BATCH_OPERATION = "(qss" + AJPARAM_STR + AJPARAM_INTERFACE_INFO_ARRAY + AJPARAM_REMOTED_APPS_ARRAY +
+                                                       AJPARAM_ACL_METADATA_ARRAY + AJPARAM_ACL_METADATA_ARRAY + ")";
+static const qcc::String AJPARAM_ACL_BATCH_OPERATION_ARRAY = "a" + AJPARAM_ACL_BATCH_OPERATION;
+static const qcc::String AJPARAM_ACL_BATCH_RESULT = "(qs)";
+static const qcc::String AJPARAM_ACL_BATCH_RESULT_ARRAY = "a(qs)";
+static const qcc::String AJPARAM_PAGE_REQUEST = AJPARAM_STR + AJPARAM_UINT32 + AJPARAM_UINT16;
+static const qcc::String AJPARAM_PAGE_REPLY = AJPARAM_VAR + AJPARAM_STR;
+static const qcc::String AJPARAM_STATS_COUNTER = "(st)";
+static const qcc::String AJPARAM_STATS_COUNTER_ARRAY = "a(st)";
+static const qcc::String AJPARAM_STATS_HISTOGRAM = "(stttat)";
+static const qcc::String AJPARAM_STATS_HISTOGRAM_ARRAY = "a(stttat)";
 
 static const qcc::String AJ_GW_OBJECTPATH = "/gw";
 static const qcc::String AJ_GW_APP_WKN_PREFIX = "org.alljoyn.GWAgent.Connector.";
@@ -67,12 +109,38 @@ static const qcc::String AJ_GW_APP_INTERFACE = "org.alljoyn.gwagent.ctrl.App";
 static const qcc::String AJ_GW_APP_CONNECTOR_INTERFACE = "org.alljoyn.gwagent.connector.App";
 static const qcc::String AJ_GW_ACL_MGMT_INTERFACE = "org.alljoyn.gwagent.ctrl.AclMgmt";
 static const qcc::String AJ_GW_ACL_INTERFACE = "org.alljoyn.gwagent.ctrl.Acl";
+static const qcc::String AJ_GW_STATS_INTERFACE = "org.alljoyn.gwagent.ctrl.Stats";
 
 static const qcc::String AJ_METHOD_GET_INSTALLED_APPS = "GetInstalledApps";
 static const qcc::String& AJ_GET_INSTALLED_APPS_PARAMS_IN = AJPARAM_EMPTY;
 static const qcc::String& AJ_GET_INSTALLED_APPS_PARAMS_OUT = AJPARAM_INSTALLED_APPS_INFO_ARRAY;
 static const qcc::String AJ_GET_INSTALLED_APPS_PARAM_NAMES = "installedAppsInfoArray";
 
+static const qcc::String AJ_METHOD_GET_INSTALLED_APPS_PAGED = "GetInstalledAppsPaged";
+static const qcc::String& AJ_GET_INSTALLED_APPS_PAGED_PARAMS_IN = AJPARAM_PAGE_REQUEST;
+static const qcc::String& AJ_GET_INSTALLED_APPS_PAGED_PARAMS_OUT = AJPARAM_PAGE_REPLY;
+static const qcc::String AJ_GET_INSTALLED_APPS_PAGED_PARAM_NAMES = "cursor,pageSize,projection,installedAppsInfoArray,nextCursor";
+
+static const qcc::String AJ_METHOD_SET_APP_STATUS_SUBSCRIPTIONS = "SetAppStatusSubscriptions";
+static const qcc::String& AJ_SET_APP_STATUS_SUBSCRIPTIONS_PARAMS_IN = AJPARAM_ARRAY_STR;
+static const qcc::String& AJ_SET_APP_STATUS_SUBSCRIPTIONS_PARAMS_OUT = AJPARAM_EMPTY;
+static const qcc::String AJ_SET_APP_STATUS_SUBSCRIPTIONS_PARAM_NAMES = "connectorIds";
+
+static const qcc::String AJ_METHOD_BATCH_UPDATE = "BatchUpdate";
+static const qcc::String& AJ_BATCH_UPDATE_PARAMS_IN = AJPARAM_ACL_BATCH_OPERATION_ARRAY;
+static const qcc::String AJ_BATCH_UPDATE_PARAMS_OUT = AJPARAM_UINT16 + AJPARAM_ACL_BATCH_RESULT_ARRAY;
+static const qcc::String AJ_BATCH_UPDATE_PARAM_NAMES = "operations,aclResponseCode,results";
+
+static const qcc::String AJ_METHOD_GET_STATS = "GetStats";
+static const qcc::String& AJ_GET_STATS_PARAMS_IN = AJPARAM_EMPTY;
+static const qcc::String AJ_GET_STATS_PARAMS_OUT = AJPARAM_ARRAY_UINT64 + AJPARAM_STATS_COUNTER_ARRAY + AJPARAM_STATS_HISTOGRAM_ARRAY;
+static const qcc::String AJ_GET_STATS_PARAM_NAMES = "bucketBoundsUs,counters,histograms";
+
+static const qcc::String AJ_METHOD_RESET_STATS = "ResetStats";
+static const qcc::String& AJ_RESET_STATS_PARAMS_IN = AJPARAM_EMPTY;
+static const qcc::String& AJ_RESET_STATS_PARAMS_OUT = AJPARAM_EMPTY;
+static const qcc::String& AJ_RESET_STATS_PARAM_NAMES = AJPARAM_EMPTY;
+
 static const qcc::String AJ_METHOD_GET_APP_STATUS = "GetAppStatus";
 static const qcc::String& AJ_GET_APP_STATUS_PARAMS_IN = AJPARAM_EMPTY;
 static const qcc::String AJ_GET_APP_STATUS_PARAMS_OUT = AJPARAM_UINT16 + AJPARAM_STR + AJPARAM_UINT16 + AJPARAM_UINT16;
@@ -93,6 +161,11 @@ static const qcc::String& AJ_GET_MANIFEST_INTERFACES_PARAMS_IN = AJPARAM_EMPTY;
 static const qcc::String AJ_GET_MANIFEST_INTERFACES_PARAMS_OUT = AJPARAM_MANIFEST_INTERFACE_INFO_ARRAY + AJPARAM_MANIFEST_INTERFACE_INFO_ARRAY;
 static const qcc::String AJ_GET_MANIFEST_INTERFACES_PARAM_NAMES = "exposedServices,remotedServices";
 
+static const qcc::String AJ_METHOD_GET_APP_RESOURCE_USAGE = "GetAppResourceUsage";
+static const qcc::String& AJ_GET_APP_RESOURCE_USAGE_PARAMS_IN = AJPARAM_EMPTY;
+static const qcc::String AJ_GET_APP_RESOURCE_USAGE_PARAMS_OUT = AJPARAM_UINT64 + AJPARAM_UINT64;
+static const qcc::String AJ_GET_APP_RESOURCE_USAGE_PARAM_NAMES = "cpuUsage,memoryUsage";
+
 static const qcc::String AJ_SIGNAL_APP_STATUS_CHANGED = "AppStatusChanged";
 static const qcc::String& AJ_APP_STATUS_CHANGED_PARAMS = AJPARAM_UINT16 + AJPARAM_STR + AJPARAM_UINT16 + AJPARAM_UINT16;
 static const qcc::String AJ_APP_STATUS_CHANGED_PARAM_NAMES = "installStatus,installDescription,connectionStatus,operationalStatus";
@@ -113,6 +186,11 @@ static const qcc::String& AJ_LIST_ACLS_PARAMS_IN = AJPARAM_EMPTY;
 static const qcc::String AJ_LIST_ACLS_PARAMS_OUT = AJPARAM_ACLS_STRUCT_ARRAY;
 static const qcc::String AJ_LIST_ACLS_PARAM_NAMES = "aclsList";
 
+static const qcc::String AJ_METHOD_LIST_ACLS_PAGED = "ListAclsPaged";
+static const qcc::String& AJ_LIST_ACLS_PAGED_PARAMS_IN = AJPARAM_PAGE_REQUEST;
+static const qcc::String& AJ_LIST_ACLS_PAGED_PARAMS_OUT = AJPARAM_PAGE_REPLY;
+static const qcc::String AJ_LIST_ACLS_PAGED_PARAM_NAMES = "cursor,pageSize,projection,aclsList,nextCursor";
+
 static const qcc::String AJ_METHOD_ACTIVATE_ACL = "ActivateAcl";
 static const qcc::String& AJ_ACTIVATE_ACL_PARAMS_IN = AJPARAM_EMPTY;
 static const qcc::String AJ_ACTIVATE_ACL_PARAMS_OUT = AJPARAM_UINT16;
@@ -141,6 +219,12 @@ static const qcc::String AJ_UPDATE_METADATA_PARAMS_IN = AJPARAM_ACL_METADATA_ARR
 static const qcc::String AJ_UPDATE_METADATA_PARAMS_OUT = AJPARAM_UINT16;
 static const qcc::String AJ_UPDATE_METADATA_PARAM_NAMES = "metadata,aclResponseCode";
 
+static const qcc::String AJ_METHOD_PATCH_ACL = "PatchAcl";
+static const qcc::String AJ_PATCH_ACL_PARAMS_IN = AJPARAM_INTERFACE_INFO_ARRAY + AJPARAM_INTERFACE_INFO_ARRAY + AJPARAM_REMOTED_APPS_ARRAY +
+                                                  AJPARAM_REMOTED_APPS_ARRAY + AJPARAM_ACL_METADATA_ARRAY;
+static const qcc::String AJ_PATCH_ACL_PARAMS_OUT = AJPARAM_UINT16;
+static const qcc::String AJ_PATCH_ACL_PARAM_NAMES = "addedExposedServices,removedExposedServices,addedRemotedApps,removedRemotedApps,metadata,aclResponseCode";
+
 static const qcc::String AJ_METHOD_DEACTIVATE_ACL = "DeactivateAcl";
 static const qcc::String& AJ_DEACTIVATE_ACL_PARAMS_IN = AJPARAM_EMPTY;
 static const qcc::String AJ_DEACTIVATE_ACL_PARAMS_OUT = AJPARAM_UINT16;
@@ -151,14 +235,21 @@ static const qcc::String& AJ_GET_MERGED_ACL_PARAMS_IN = AJPARAM_EMPTY;
 static const qcc::String AJ_GET_MERGED_ACL_PARAMS_OUT = AJPARAM_INTERFACE_INFO_ARRAY + AJPARAM_REMOTED_APPS_ARRAY;
 static const qcc::String AJ_GET_MERGED_ACL_PARAM_NAMES = "exposedServices,remotedApps";
 
+static const qcc::String AJ_METHOD_GET_MERGED_ACL_IF_CHANGED = "GetMergedAclIfChanged";
+static const qcc::String AJ_GET_MERGED_ACL_IF_CHANGED_PARAMS_IN = AJPARAM_UINT32;
+static const qcc::String AJ_GET_MERGED_ACL_IF_CHANGED_PARAMS_OUT = AJPARAM_UINT32 + AJPARAM_BOOL + AJPARAM_INTERFACE_INFO_ARRAY +
+                                                                   AJPARAM_REMOTED_APPS_ARRAY;
+static const qcc::String AJ_GET_MERGED_ACL_IF_CHANGED_PARAM_NAMES = "version,currentVersion,changed,exposedServices,remotedApps";
+
 static const qcc::String AJ_METHOD_UPDATE_CONNECTION_STATUS = "UpdateConnectionStatus";
 static const qcc::String AJ_UPDATE_CONNECTION_STATUS_PARAMS_IN = AJPARAM_UINT16;
 static const qcc::String& AJ_UPDATE_CONNECTION_STATUS_PARAMS_OUT = AJPARAM_EMPTY;
 static const qcc::String AJ_UPDATE_CONNECTION_STATUS_PARAM_NAMES = "connectionStatus";
 
 static const qcc::String AJ_SIGNAL_ACL_UPDATED = "MergedAclUpdated";
-static const qcc::String& AJ_ACL_UPDATED_PARAMS = AJPARAM_EMPTY;
-static const qcc::String& AJ_ACL_UPDATED_PARAM_NAMES = AJPARAM_EMPTY;
+static const qcc::String AJ_ACL_UPDATED_PARAMS = AJPARAM_UINT32 + AJPARAM_INTERFACE_INFO_ARRAY + AJPARAM_INTERFACE_INFO_ARRAY +
+                                                AJPARAM_REMOTED_APPS_ARRAY + AJPARAM_REMOTED_APPS_ARRAY;
+static const qcc::String AJ_ACL_UPDATED_PARAM_NAMES = "mergeSequence,addedExposedServices,removedExposedServices,addedRemotedApps,removedRemotedApps";
 
 static const qcc::String AJ_SIGNAL_SHUTDOWN_APP = "ShutdownApp";
 static const qcc::String& AJ_SHUTDOWN_APP_PARAMS = AJPARAM_EMPTY;
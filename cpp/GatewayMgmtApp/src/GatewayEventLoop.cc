@@ -0,0 +1,412 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/gateway/GatewayEventLoop.h>
+#include "GatewayConstants.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace ajn {
+namespace gw {
+
+using namespace gwConsts;
+
+/**
+ * Get the monotonic time in milliseconds
+ * @return time
+ */
+static uint64_t GetMonotonicMs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+GatewayEventLoop::GatewayEventLoop() : m_EpollFd(-1), m_WakeFd(-1), m_SignalFd(-1),
+    m_Wheel(GATEWAY_EVENT_LOOP_WHEEL_SLOTS), m_FiringTimerId(0), m_CurrentSlot(0), m_WheelTime(GetMonotonicMs()), m_LastTimerId(0),
+    m_IsRunning(false), m_IsStopping(false)
+{
+    sigemptyset(&m_SignalMask);
+    pthread_mutex_init(&m_Lock, NULL);
+    pthread_cond_init(&m_TimerFired, NULL);
+}
+
+GatewayEventLoop::~GatewayEventLoop()
+{
+    stop();
+
+    if (m_SignalFd != -1) {
+        close(m_SignalFd);
+    }
+    if (m_WakeFd != -1) {
+        close(m_WakeFd);
+    }
+    if (m_EpollFd != -1) {
+        close(m_EpollFd);
+    }
+    pthread_cond_destroy(&m_TimerFired);
+    pthread_mutex_destroy(&m_Lock);
+}
+
+QStatus GatewayEventLoop::init()
+{
+    m_EpollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_EpollFd == -1) {
+        QCC_LogError(ER_OS_ERROR, ("Could not create the epoll descriptor. errno is: %i", errno));
+        return ER_OS_ERROR;
+    }
+
+    m_WakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_WakeFd == -1) {
+        QCC_LogError(ER_OS_ERROR, ("Could not create the eventfd. errno is: %i", errno));
+        return ER_OS_ERROR;
+    }
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = m_WakeFd;
+    if (epoll_ctl(m_EpollFd, EPOLL_CTL_ADD, m_WakeFd, &event) == -1) {
+        QCC_LogError(ER_OS_ERROR, ("Could not add the eventfd to epoll. errno is: %i", errno));
+        return ER_OS_ERROR;
+    }
+    return ER_OK;
+}
+
+QStatus GatewayEventLoop::addSignalHandler(int32_t signum, GatewaySignalHandler handler)
+{
+    if (m_EpollFd == -1 || m_IsRunning || !handler) {
+        return ER_FAIL;
+    }
+
+    sigset_t signalMask;
+    sigemptyset(&signalMask);
+    sigaddset(&signalMask, signum);
+    if (pthread_sigmask(SIG_BLOCK, &signalMask, NULL) != 0) {
+        return ER_OS_ERROR;
+    }
+    sigaddset(&m_SignalMask, signum);
+
+    // an existing signalfd takes the new mask
+    int signalFd = signalfd(m_SignalFd, &m_SignalMask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signalFd == -1) {
+        QCC_LogError(ER_OS_ERROR, ("Could not create the signalfd. errno is: %i", errno));
+        return ER_OS_ERROR;
+    }
+    if (m_SignalFd == -1) {
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = signalFd;
+        if (epoll_ctl(m_EpollFd, EPOLL_CTL_ADD, signalFd, &event) == -1) {
+            QCC_LogError(ER_OS_ERROR, ("Could not add the signalfd to epoll. errno is: %i", errno));
+            close(signalFd);
+            return ER_OS_ERROR;
+        }
+        m_SignalFd = signalFd;
+    }
+
+    m_SignalHandlers[signum] = handler;
+    return ER_OK;
+}
+
+void GatewayEventLoop::unblockSignals() const
+{
+    pthread_sigmask(SIG_UNBLOCK, &m_SignalMask, NULL);
+}
+
+QStatus GatewayEventLoop::start()
+{
+    if (m_EpollFd == -1) {
+        return ER_FAIL;
+    }
+
+    pthread_mutex_lock(&m_Lock);
+    if (m_IsRunning || m_IsStopping) {
+        pthread_mutex_unlock(&m_Lock);
+        return ER_FAIL;
+    }
+    m_IsRunning = true;
+    pthread_mutex_unlock(&m_Lock);
+
+    int rc = pthread_create(&m_Thread, NULL, GatewayEventLoop::Run, this);
+    if (rc != 0) {
+        QCC_LogError(ER_OS_ERROR, ("Could not create the thread of the event loop. error is: %i", rc));
+        pthread_mutex_lock(&m_Lock);
+        m_IsRunning = false;
+        pthread_mutex_unlock(&m_Lock);
+        return ER_OS_ERROR;
+    }
+    return ER_OK;
+}
+
+void GatewayEventLoop::stop()
+{
+    pthread_mutex_lock(&m_Lock);
+    bool isRunning = m_IsRunning;
+    m_IsStopping = true;
+    pthread_mutex_unlock(&m_Lock);
+
+    if (isRunning && !isCurrentThread()) {
+        wakeUp();
+        pthread_join(m_Thread, NULL);
+        pthread_mutex_lock(&m_Lock);
+        m_IsRunning = false;
+        pthread_mutex_unlock(&m_Lock);
+    }
+
+    std::vector<GatewayTask*> timerTasks;
+    pthread_mutex_lock(&m_Lock);
+    for (size_t i = 0; i < m_Wheel.size(); i++) {
+        std::map<uint32_t, Timer>::iterator it;
+        for (it = m_Wheel[i].begin(); it != m_Wheel[i].end(); it++) {
+            timerTasks.push_back(it->second.m_Task);
+        }
+        m_Wheel[i].clear();
+    }
+    m_TimerSlots.clear();
+    std::map<uint32_t, GatewayTask*>::iterator dueIt;
+    for (dueIt = m_DueTimers.begin(); dueIt != m_DueTimers.end(); dueIt++) {
+        timerTasks.push_back(dueIt->second);
+    }
+    m_DueTimers.clear();
+    pthread_mutex_unlock(&m_Lock);
+
+    for (size_t i = 0; i < timerTasks.size(); i++) {
+        timerTasks[i]->cancel();
+        delete timerTasks[i];
+    }
+}
+
+uint32_t GatewayEventLoop::addTimer(GatewayTask* task, uint32_t delayMs)
+{
+    pthread_mutex_lock(&m_Lock);
+    if (m_IsStopping) {
+        pthread_mutex_unlock(&m_Lock);
+        task->cancel();
+        delete task;
+        return 0;
+    }
+
+    uint64_t now = GetMonotonicMs();
+    if (m_TimerSlots.empty()) {
+        m_WheelTime = now;
+    }
+
+    // the wheel may lag behind by up to a tick - count the delay from its time
+    uint64_t ticks = (now - m_WheelTime + delayMs + GATEWAY_EVENT_LOOP_TICK_MS - 1) / GATEWAY_EVENT_LOOP_TICK_MS;
+    if (ticks == 0) {
+        ticks = 1;
+    }
+    size_t slot = (m_CurrentSlot + ticks) % m_Wheel.size();
+
+    if (++m_LastTimerId == 0) {
+        m_LastTimerId = 1;
+    }
+    Timer timer;
+    timer.m_Task = task;
+    timer.m_Rounds = (uint32_t)((ticks - 1) / m_Wheel.size());
+    m_Wheel[slot][m_LastTimerId] = timer;
+    m_TimerSlots[m_LastTimerId] = slot;
+    uint32_t timerId = m_LastTimerId;
+    pthread_mutex_unlock(&m_Lock);
+
+    // the loop may be sleeping past the new timer
+    if (!isCurrentThread()) {
+        wakeUp();
+    }
+    return timerId;
+}
+
+bool GatewayEventLoop::cancelTimer(uint32_t timerId)
+{
+    GatewayTask* task = NULL;
+    pthread_mutex_lock(&m_Lock);
+    std::map<uint32_t, size_t>::iterator slotIt = m_TimerSlots.find(timerId);
+    std::map<uint32_t, GatewayTask*>::iterator dueIt = m_DueTimers.find(timerId);
+    if (slotIt != m_TimerSlots.end()) {
+        std::map<uint32_t, Timer>::iterator timerIt = m_Wheel[slotIt->second].find(timerId);
+        task = timerIt->second.m_Task;
+        m_Wheel[slotIt->second].erase(timerIt);
+        m_TimerSlots.erase(slotIt);
+    } else if (dueIt != m_DueTimers.end()) {
+        task = dueIt->second;
+        m_DueTimers.erase(dueIt);
+    } else {
+        // a timer cancelled by its own task can not wait for itself
+        while (m_FiringTimerId == timerId && !isCurrentThread()) {
+            pthread_cond_wait(&m_TimerFired, &m_Lock);
+        }
+        pthread_mutex_unlock(&m_Lock);
+        return false;
+    }
+    pthread_mutex_unlock(&m_Lock);
+
+    task->cancel();
+    delete task;
+    return true;
+}
+
+bool GatewayEventLoop::isCurrentThread() const
+{
+    return m_IsRunning && pthread_equal(m_Thread, pthread_self());
+}
+
+void GatewayEventLoop::wakeUp()
+{
+    uint64_t one = 1;
+    if (write(m_WakeFd, &one, sizeof(one)) != sizeof(one) && errno != EAGAIN) {
+        QCC_LogError(ER_OS_ERROR, ("Could not wake the event loop up. errno is: %i", errno));
+    }
+}
+
+void GatewayEventLoop::dispatchSignals()
+{
+    struct signalfd_siginfo info;
+    while (read(m_SignalFd, &info, sizeof(info)) == sizeof(info)) {
+        std::map<int32_t, GatewaySignalHandler>::const_iterator it = m_SignalHandlers.find((int32_t)info.ssi_signo);
+        if (it != m_SignalHandlers.end()) {
+            it->second((int32_t)info.ssi_signo);
+        }
+    }
+}
+
+void GatewayEventLoop::advanceWheel()
+{
+    uint64_t now = GetMonotonicMs();
+    while (!m_TimerSlots.empty() && m_WheelTime + GATEWAY_EVENT_LOOP_TICK_MS <= now) {
+        m_WheelTime += GATEWAY_EVENT_LOOP_TICK_MS;
+        m_CurrentSlot = (m_CurrentSlot + 1) % m_Wheel.size();
+
+        std::map<uint32_t, Timer>& slot = m_Wheel[m_CurrentSlot];
+        std::map<uint32_t, Timer>::iterator it = slot.begin();
+        while (it != slot.end()) {
+            if (it->second.m_Rounds > 0) {
+                it->second.m_Rounds--;
+                it++;
+                continue;
+            }
+            m_DueTimers[it->first] = it->second.m_Task;
+            m_TimerSlots.erase(it->first);
+            slot.erase(it++);
+        }
+    }
+
+    // an empty wheel does not need to catch up
+    if (m_TimerSlots.empty()) {
+        m_WheelTime = now;
+    }
+}
+
+bool GatewayEventLoop::runDueTimers()
+{
+    bool ranTimer = false;
+    while (true) {
+        pthread_mutex_lock(&m_Lock);
+        if (m_DueTimers.empty()) {
+            pthread_mutex_unlock(&m_Lock);
+            return ranTimer;
+        }
+        std::map<uint32_t, GatewayTask*>::iterator it = m_DueTimers.begin();
+        GatewayTask* task = it->second;
+        m_FiringTimerId = it->first;
+        m_DueTimers.erase(it);
+        pthread_mutex_unlock(&m_Lock);
+
+        task->run();
+        delete task;
+        ranTimer = true;
+
+        pthread_mutex_lock(&m_Lock);
+        m_FiringTimerId = 0;
+        pthread_cond_broadcast(&m_TimerFired);
+        pthread_mutex_unlock(&m_Lock);
+    }
+}
+
+int GatewayEventLoop::getWheelTimeout() const
+{
+    if (m_TimerSlots.empty()) {
+        return -1;
+    }
+
+    // the next timer is due in the slot with the fewest ticks left
+    uint64_t minTicks = 0;
+    for (size_t offset = 1; offset <= m_Wheel.size(); offset++) {
+        const std::map<uint32_t, Timer>& slot = m_Wheel[(m_CurrentSlot + offset) % m_Wheel.size()];
+        std::map<uint32_t, Timer>::const_iterator it;
+        for (it = slot.begin(); it != slot.end(); it++) {
+            uint64_t ticks = offset + (uint64_t)it->second.m_Rounds * m_Wheel.size();
+            if (minTicks == 0 || ticks < minTicks) {
+                minTicks = ticks;
+            }
+        }
+    }
+
+    uint64_t due = m_WheelTime + minTicks * GATEWAY_EVENT_LOOP_TICK_MS;
+    uint64_t now = GetMonotonicMs();
+    return due > now ? (int)(due - now) : 0;
+}
+
+void* GatewayEventLoop::Run(void* arg)
+{
+    GatewayEventLoop* loop = (GatewayEventLoop*)arg;
+
+    while (true) {
+        pthread_mutex_lock(&loop->m_Lock);
+        bool isStopping = loop->m_IsStopping;
+        if (!isStopping) {
+            loop->advanceWheel();
+        }
+        pthread_mutex_unlock(&loop->m_Lock);
+
+        if (isStopping) {
+            break;
+        }
+
+        // the timers may have scheduled more timers
+        if (loop->runDueTimers()) {
+            continue;
+        }
+
+        pthread_mutex_lock(&loop->m_Lock);
+        int timeout = loop->getWheelTimeout();
+        pthread_mutex_unlock(&loop->m_Lock);
+
+        struct epoll_event events[2];
+        int numEvents = epoll_wait(loop->m_EpollFd, events, 2, timeout);
+        if (numEvents == -1 && errno != EINTR) {
+            QCC_LogError(ER_OS_ERROR, ("Waiting for events failed. errno is: %i", errno));
+            break;
+        }
+
+        for (int i = 0; i < numEvents; i++) {
+            if (events[i].data.fd == loop->m_WakeFd) {
+                uint64_t count;
+                while (read(loop->m_WakeFd, &count, sizeof(count)) == sizeof(count)) {
+                }
+            } else if (events[i].data.fd == loop->m_SignalFd) {
+                loop->dispatchSignals();
+            }
+        }
+    }
+    return NULL;
+}
+
+} /* namespace gw */
+} /* namespace ajn */
@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#include <alljoyn/gateway/GatewayInternedString.h>
+#include <qcc/STLContainer.h>
+#include <pthread.h>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * Hash functor for the keys of the intern table
+ */
+struct InternedStringHash {
+    size_t operator()(qcc::String const& value) const
+    {
+        return GatewayInternedString::hashString(value);
+    }
+};
+
+typedef std::unordered_map<qcc::String, GatewayInternedString::Entry*, InternedStringHash> InternTable;
+
+/**
+ * The intern table is created on first use. The lock is statically
+ * initialized so interning works during static initialization as well
+ */
+static pthread_mutex_t s_InternLock = PTHREAD_MUTEX_INITIALIZER;
+static InternTable* s_InternTable = NULL;
+
+/**
+ * Look a string up in the intern table and add a reference to its entry,
+ * adding the entry if the string is not there yet
+ * @param value - the string to intern
+ * @return entry
+ */
+static const GatewayInternedString::Entry* intern(qcc::String const& value)
+{
+    pthread_mutex_lock(&s_InternLock);
+    if (!s_InternTable) {
+        s_InternTable = new InternTable();
+    }
+
+    GatewayInternedString::Entry* entry;
+    InternTable::iterator it = s_InternTable->find(value);
+    if (it == s_InternTable->end()) {
+        entry = new GatewayInternedString::Entry();
+        entry->m_Value = value;
+        entry->m_Hash = GatewayInternedString::hashString(value);
+        entry->m_RefCount = 1;
+        // the key shares the buffer of the entry
+        s_InternTable->insert(std::pair<qcc::String, GatewayInternedString::Entry*>(entry->m_Value, entry));
+    } else {
+        entry = it->second;
+        qcc::IncrementAndFetch(&entry->m_RefCount);
+    }
+    pthread_mutex_unlock(&s_InternLock);
+    return entry;
+}
+
+GatewayInternedString::GatewayInternedString() : m_Entry(intern(""))
+{
+}
+
+GatewayInternedString::GatewayInternedString(qcc::String const& value) : m_Entry(intern(value))
+{
+}
+
+void GatewayInternedString::release(const Entry* entry)
+{
+    // references other than the last one are dropped without the table lock.
+    // The last one is dropped under the lock, so interning can not revive an
+    // entry that is being removed
+    for (;;) {
+        int32_t refCount = entry->m_RefCount;
+        if (refCount <= 1) {
+            break;
+        }
+        if (qcc::CompareAndExchange(&entry->m_RefCount, refCount, refCount - 1)) {
+            return;
+        }
+    }
+
+    pthread_mutex_lock(&s_InternLock);
+    if (qcc::DecrementAndFetch(&entry->m_RefCount) == 0) {
+        s_InternTable->erase(entry->m_Value);
+        delete entry;
+    }
+    pthread_mutex_unlock(&s_InternLock);
+}
+
+void GatewayInternedString::getTableStats(TableStats* stats)
+{
+    stats->m_NumStrings = 0;
+    stats->m_NumHandles = 0;
+    stats->m_InternedBytes = 0;
+    stats->m_CopiedBytes = 0;
+
+    pthread_mutex_lock(&s_InternLock);
+    if (s_InternTable) {
+        InternTable::const_iterator it;
+        for (it = s_InternTable->begin(); it != s_InternTable->end(); it++) {
+            size_t stringBytes = it->second->m_Value.size() + 1;
+            size_t refCount = (size_t)it->second->m_RefCount;
+            stats->m_NumStrings++;
+            stats->m_NumHandles += refCount;
+            stats->m_InternedBytes += sizeof(Entry) + stringBytes;
+            stats->m_CopiedBytes += refCount * stringBytes;
+        }
+    }
+    pthread_mutex_unlock(&s_InternLock);
+}
+
+size_t GatewayInternedString::hashString(qcc::String const& value)
+{
+    // FNV-1a
+    size_t hash = 2166136261u;
+    const char* data = value.c_str();
+    for (size_t i = 0; i < value.size(); i++) {
+        hash = (hash ^ (uint8_t)data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+} /* namespace gw */
+} /* namespace ajn */
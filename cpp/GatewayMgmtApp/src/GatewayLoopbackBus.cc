@@ -0,0 +1,319 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/gateway/GatewayLoopbackBus.h>
+#include <alljoyn/gateway/GatewayConnectorApp.h>
+#include <alljoyn/gateway/GatewayConnectorAppManager.h>
+#include <alljoyn/gateway/GatewayTaskQueue.h>
+#include "busObjects/ShardedBusObject.h"
+#include "GatewayConstants.h"
+#include <algorithm>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace ajn {
+namespace gw {
+
+using namespace qcc;
+using namespace gwConsts;
+
+struct GatewayLoopbackBus::PendingCall {
+
+    PendingCall(const MsgArg* args, size_t numArgs, GatewayLoopbackReply* reply) :
+        m_Args(args), m_NumArgs(numArgs), m_Reply(reply), m_Replied(false) { }
+
+    const MsgArg* m_Args;
+
+    size_t m_NumArgs;
+
+    GatewayLoopbackReply* m_Reply;
+
+    bool m_Replied;
+};
+
+GatewayLoopbackBus::GatewayLoopbackBus(uint32_t reloadUs) : m_Bus(new BusAttachment("GatewayLoopbackBus")),
+    m_ReloadUs(reloadUs), m_NumReloads(0), m_NumSignals(0)
+{
+    pthread_mutex_init(&m_CallLock, NULL);
+    pthread_condattr_t condAttr;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&m_CallReplied, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+}
+
+GatewayLoopbackBus::~GatewayLoopbackBus()
+{
+    pthread_cond_destroy(&m_CallReplied);
+    pthread_mutex_destroy(&m_CallLock);
+    delete m_Bus;
+}
+
+BusAttachment* GatewayLoopbackBus::getBusAttachment() const
+{
+    return m_Bus;
+}
+
+bool GatewayLoopbackBus::isConnected() const
+{
+    return true;
+}
+
+QStatus GatewayLoopbackBus::registerBusObject(BusObject& busObject)
+{
+    GatewayScopedLock lock(m_Lock);
+    String objectPath = busObject.GetPath();
+    if (m_BusObjects.find(objectPath) != m_BusObjects.end()) {
+        return ER_BUS_OBJ_ALREADY_EXISTS;
+    }
+    m_BusObjects[objectPath] = &busObject;
+    return ER_OK;
+}
+
+void GatewayLoopbackBus::unregisterBusObject(BusObject& busObject)
+{
+    GatewayScopedLock lock(m_Lock);
+    std::map<String, BusObject*>::iterator it = m_BusObjects.find(busObject.GetPath());
+    if (it != m_BusObjects.end() && it->second == &busObject) {
+        m_BusObjects.erase(it);
+    }
+}
+
+void GatewayLoopbackBus::registerBusListener(BusListener& busListener)
+{
+    GatewayScopedLock lock(m_Lock);
+    m_BusListeners.push_back(&busListener);
+}
+
+void GatewayLoopbackBus::unregisterBusListener(BusListener& busListener)
+{
+    GatewayScopedLock lock(m_Lock);
+    m_BusListeners.erase(std::remove(m_BusListeners.begin(), m_BusListeners.end(), &busListener), m_BusListeners.end());
+}
+
+QStatus GatewayLoopbackBus::bindSessionPort(SessionPort& sessionPort, SessionOpts const& sessionOpts, SessionPortListener& listener)
+{
+    GatewayScopedLock lock(m_Lock);
+    if (m_SessionPorts.find(sessionPort) != m_SessionPorts.end()) {
+        return ER_ALLJOYN_BINDSESSIONPORT_REPLY_ALREADY_EXISTS;
+    }
+    m_SessionPorts[sessionPort] = &listener;
+    return ER_OK;
+}
+
+QStatus GatewayLoopbackBus::unbindSessionPort(SessionPort sessionPort)
+{
+    GatewayScopedLock lock(m_Lock);
+    if (m_SessionPorts.erase(sessionPort) == 0) {
+        return ER_ALLJOYN_UNBINDSESSION_REPLY_BAD_PORT;
+    }
+    return ER_OK;
+}
+
+QStatus GatewayLoopbackBus::registerAboutListener(AboutListener& aboutListener)
+{
+    GatewayScopedLock lock(m_Lock);
+    m_AboutListeners.push_back(&aboutListener);
+    return ER_OK;
+}
+
+void GatewayLoopbackBus::unregisterAboutListener(AboutListener& aboutListener)
+{
+    GatewayScopedLock lock(m_Lock);
+    m_AboutListeners.erase(std::remove(m_AboutListeners.begin(), m_AboutListeners.end(), &aboutListener), m_AboutListeners.end());
+}
+
+QStatus GatewayLoopbackBus::reloadConfig()
+{
+    if (m_ReloadUs) {
+        usleep(m_ReloadUs);
+    }
+    GatewayScopedLock lock(m_Lock);
+    m_NumReloads++;
+    return ER_OK;
+}
+
+bool GatewayLoopbackBus::deliverSignal(const char* objectPath, const char* destination, SessionId sessionId,
+                                       const InterfaceDescription::Member& signal, const MsgArg* args, size_t numArgs)
+{
+    // the handlers are called outside the lock, the way the router calls them on its own thread
+    std::vector<GatewayLoopbackSignalHandler*> signalHandlers;
+    {
+        GatewayScopedLock lock(m_Lock);
+        m_NumSignals++;
+        signalHandlers = m_SignalHandlers;
+    }
+    for (size_t i = 0; i < signalHandlers.size(); i++) {
+        signalHandlers[i]->signalReceived(objectPath, destination, sessionId, signal, args, numArgs);
+    }
+    return true;
+}
+
+bool GatewayLoopbackBus::getMethodArgs(const Message& msg, size_t* numArgs, const MsgArg** args)
+{
+    pthread_mutex_lock(&m_CallLock);
+    std::map<const _Message*, PendingCall*>::iterator it = m_Calls.find(&*msg);
+    bool found = it != m_Calls.end();
+    if (found) {
+        *numArgs = it->second->m_NumArgs;
+        *args = it->second->m_Args;
+    }
+    pthread_mutex_unlock(&m_CallLock);
+    return found;
+}
+
+bool GatewayLoopbackBus::deliverMethodReply(const Message& msg, QStatus status, const MsgArg* args, size_t numArgs)
+{
+    pthread_mutex_lock(&m_CallLock);
+    std::map<const _Message*, PendingCall*>::iterator it = m_Calls.find(&*msg);
+    bool found = it != m_Calls.end();
+    if (found && !it->second->m_Replied) {
+        // the reply args are usually locals of the handler, copying a MsgArg clones its data
+        it->second->m_Reply->m_Status = status;
+        it->second->m_Reply->m_Args.assign(args, args + numArgs);
+        it->second->m_Replied = true;
+        pthread_cond_broadcast(&m_CallReplied);
+    }
+    pthread_mutex_unlock(&m_CallLock);
+    return found;
+}
+
+QStatus GatewayLoopbackBus::callMethod(qcc::String const& objectPath, qcc::String const& interfaceName, qcc::String const& methodName,
+                                       const MsgArg* args, size_t numArgs, GatewayLoopbackReply* reply)
+{
+    const InterfaceDescription* interfaceDescription = m_Bus->GetInterface(interfaceName.c_str());
+    const InterfaceDescription::Member* member = interfaceDescription ? interfaceDescription->GetMember(methodName.c_str()) : NULL;
+    if (!member) {
+        return ER_BUS_INTERFACE_NO_SUCH_MEMBER;
+    }
+
+    // the App owns its own object path and the object paths of its Acls below it
+    GatewayConnectorApp* connectorApp = NULL;
+    const std::map<String, GatewayConnectorApp*>& connectorApps = GatewayMgmt::getInstance()->getConnectorAppManager()->getConnectorApps();
+    std::map<String, GatewayConnectorApp*>::const_iterator it;
+    for (it = connectorApps.begin(); it != connectorApps.end() && !connectorApp; it++) {
+        const String& appObjectPath = it->second->getObjectPath();
+        if (objectPath == appObjectPath || (objectPath.size() > appObjectPath.size() &&
+                                            objectPath.compare(0, appObjectPath.size(), appObjectPath) == 0 &&
+                                            objectPath[appObjectPath.size()] == '/')) {
+            connectorApp = it->second;
+        }
+    }
+    if (!connectorApp) {
+        return ER_BUS_NO_SUCH_OBJECT;
+    }
+
+    if (connectorApp->getTaskQueue()->isCurrentThread()) {
+        return ER_BUS_BLOCKING_CALL_NOT_ALLOWED;
+    }
+
+    ShardedBusObject* appBusObject = connectorApp->getShardedBusObject(connectorApp->getObjectPath());
+    if (!appBusObject) {
+        return ER_BUS_NO_SUCH_OBJECT;
+    }
+
+    // the message only identifies the call, its args and reply go through the pending call
+    Message msg(*m_Bus);
+    PendingCall call(args, numArgs, reply);
+    pthread_mutex_lock(&m_CallLock);
+    m_Calls[&*msg] = &call;
+    pthread_mutex_unlock(&m_CallLock);
+
+    appBusObject->DispatchToShard(objectPath, member, msg);
+
+    // the task releases the call once the handler returns, the timeout only
+    // guards against a task queue that never runs it
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += GATEWAY_LOOPBACK_CALL_TIMEOUT_MS / 1000;
+    deadline.tv_nsec += (GATEWAY_LOOPBACK_CALL_TIMEOUT_MS % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&m_CallLock);
+    while (!call.m_Replied) {
+        if (pthread_cond_timedwait(&m_CallReplied, &m_CallLock, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    // once the call is erased a late reply is dropped, so the pending call can go out of scope
+    m_Calls.erase(&*msg);
+    bool replied = call.m_Replied;
+    pthread_mutex_unlock(&m_CallLock);
+
+    if (!replied) {
+        QCC_LogError(ER_TIMEOUT, ("%s on %s got no reply", methodName.c_str(), objectPath.c_str()));
+        reply->m_Status = ER_TIMEOUT;
+        reply->m_Args.clear();
+    }
+    return reply->m_Status;
+}
+
+void GatewayLoopbackBus::announce(const char* busName, uint16_t version, SessionPort port, const MsgArg& objectDescriptionArg,
+                                  const MsgArg& aboutDataArg)
+{
+    std::vector<AboutListener*> aboutListeners;
+    {
+        GatewayScopedLock lock(m_Lock);
+        aboutListeners = m_AboutListeners;
+    }
+    for (size_t i = 0; i < aboutListeners.size(); i++) {
+        aboutListeners[i]->Announced(busName, version, port, objectDescriptionArg, aboutDataArg);
+    }
+}
+
+void GatewayLoopbackBus::registerSignalHandler(GatewayLoopbackSignalHandler* signalHandler)
+{
+    GatewayScopedLock lock(m_Lock);
+    m_SignalHandlers.push_back(signalHandler);
+}
+
+void GatewayLoopbackBus::unregisterSignalHandler(GatewayLoopbackSignalHandler* signalHandler)
+{
+    GatewayScopedLock lock(m_Lock);
+    m_SignalHandlers.erase(std::remove(m_SignalHandlers.begin(), m_SignalHandlers.end(), signalHandler), m_SignalHandlers.end());
+}
+
+BusObject* GatewayLoopbackBus::getBusObject(qcc::String const& objectPath)
+{
+    GatewayScopedLock lock(m_Lock);
+    std::map<String, BusObject*>::iterator it = m_BusObjects.find(objectPath);
+    return it != m_BusObjects.end() ? it->second : NULL;
+}
+
+size_t GatewayLoopbackBus::getNumBusObjects()
+{
+    GatewayScopedLock lock(m_Lock);
+    return m_BusObjects.size();
+}
+
+uint64_t GatewayLoopbackBus::getNumReloads()
+{
+    GatewayScopedLock lock(m_Lock);
+    return m_NumReloads;
+}
+
+uint64_t GatewayLoopbackBus::getNumSignals()
+{
+    GatewayScopedLock lock(m_Lock);
+    return m_NumSignals;
+}
+
+} /* namespace gw */
+} /* namespace ajn */
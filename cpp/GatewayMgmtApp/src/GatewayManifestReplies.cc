@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#include <alljoyn/gateway/GatewayManifestReplies.h>
+#include "GatewayConstants.h"
+
+namespace ajn {
+namespace gw {
+
+using namespace gwConsts;
+
+GatewayManifestReplies::GatewayManifestReplies(GatewayConnectorAppManifest const& manifest)
+{
+    // the args point into the manifest, which does not change while the App is loaded
+    m_ManifestFileStatus = m_ManifestFile[0].Set(AJPARAM_STR.c_str(), manifest.getManifestData().c_str());
+    if (m_ManifestFileStatus != ER_OK) {
+        QCC_LogError(m_ManifestFileStatus, ("Could not marshal the ManifestFile"));
+    }
+
+    m_Arena.reserve(countCapabilityArgs(manifest.getExposedServices()) + countCapabilityArgs(manifest.getRemotedServices()), 0);
+
+    m_ManifestInterfacesStatus = marshalCapabilities(manifest.getExposedServices(), &m_ManifestInterfaces[0], &m_Arena);
+    if (m_ManifestInterfacesStatus != ER_OK) {
+        QCC_LogError(m_ManifestInterfacesStatus, ("Could not marshal the ExposedServices of the Manifest"));
+        return;
+    }
+
+    m_ManifestInterfacesStatus = marshalCapabilities(manifest.getRemotedServices(), &m_ManifestInterfaces[1], &m_Arena);
+    if (m_ManifestInterfacesStatus != ER_OK) {
+        QCC_LogError(m_ManifestInterfacesStatus, ("Could not marshal the RemotedServices of the Manifest"));
+    }
+}
+
+const MsgArg* GatewayManifestReplies::getManifestFileReply() const
+{
+    if (m_ManifestFileStatus != ER_OK) {
+        return NULL;
+    }
+    return m_ManifestFile;
+}
+
+const MsgArg* GatewayManifestReplies::getManifestInterfacesReply() const
+{
+    if (m_ManifestInterfacesStatus != ER_OK) {
+        return NULL;
+    }
+    return m_ManifestInterfaces;
+}
+
+size_t GatewayManifestReplies::countCapabilityArgs(const GatewayConnectorAppManifest::Capabilities& capabilities)
+{
+    size_t numArgs = capabilities.size();
+    GatewayConnectorAppManifest::Capabilities::const_iterator it;
+    for (it = capabilities.begin(); it != capabilities.end(); it++) {
+        numArgs += it->getInterfaces().size();
+    }
+    return numArgs;
+}
+
+QStatus GatewayManifestReplies::marshalCapabilities(const GatewayConnectorAppManifest::Capabilities& capabilities, MsgArg* msgArg,
+                                                    GatewayMsgArgArena* arena)
+{
+    QStatus status = ER_OK;
+    GatewayConnectorAppManifest::Capabilities::const_iterator it;
+    MsgArg* objectsArray = arena->allocArgs(capabilities.size());
+    size_t objectsIndex = 0;
+
+    for (it = capabilities.begin(); it != capabilities.end(); it++) {
+
+        const std::vector<GatewayConnectorAppCapability::InterfaceDesc>& interfaces = it->getInterfaces();
+        MsgArg* interfacesArray = arena->allocArgs(interfaces.size());
+        size_t interfaceIndex = 0;
+
+        for (size_t i = 0; i < interfaces.size(); i++) {
+            status = interfacesArray[interfaceIndex++].Set(AJPARAM_MANIFEST_INTERFACE_STRUCT.c_str(), interfaces[i].interfaceName.c_str(),
+                                                           interfaces[i].interfaceFriendlyName.c_str(), interfaces[i].isSecured);
+            if (status != ER_OK) {
+                return status;
+            }
+        }
+
+        status = objectsArray[objectsIndex++].Set(AJPARAM_MANIFEST_INTERFACE_INFO.c_str(), it->getObjectPath().c_str(),
+                                                  it->getIsObjectPathPrefix(), it->getObjectPathFriendlyName().c_str(),
+                                                  interfaceIndex, interfacesArray);
+        if (status != ER_OK) {
+            return status;
+        }
+    }
+
+    status = msgArg->Set(AJPARAM_MANIFEST_INTERFACE_INFO_ARRAY.c_str(), objectsIndex, objectsArray);
+    return status;
+}
+
+} /* namespace gw */
+} /* namespace ajn */
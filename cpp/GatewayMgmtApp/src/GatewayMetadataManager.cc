@@ -35,6 +35,7 @@ GatewayMetadataManager::~GatewayMetadataManager()
 
 QStatus GatewayMetadataManager::init()
 {
+    GatewayScopedLock lock(m_MetadataLock);
     std::ifstream ifs((GATEWAY_APPS_DIRECTORY + "/Metadata.xml").c_str());
     if (ifs.fail()) {
         QCC_DbgHLPrintf(("Metadata File doesn't exist"));
@@ -117,8 +118,9 @@ QStatus GatewayMetadataManager::init()
 
 QStatus GatewayMetadataManager::cleanup()
 {
+    GatewayScopedLock lock(m_MetadataLock);
     bool metadataUpdated = false;
-    std::map<GatewayAppIdentifier, MetadataValues>::iterator iter;
+    MetadataMap::iterator iter;
     for (iter = m_Metadata.begin(); iter != m_Metadata.end();) {
         if (!iter->second.refCount) {
             m_Metadata.erase(iter++);
@@ -137,6 +139,7 @@ QStatus GatewayMetadataManager::cleanup()
 
 QStatus GatewayMetadataManager::updateMetadata(std::map<qcc::String, qcc::String> const& metadata)
 {
+    GatewayScopedLock lock(m_MetadataLock);
     bool metadataUpdated = false;
 
     std::map<qcc::String, qcc::String>::const_iterator iter;
@@ -166,7 +169,7 @@ QStatus GatewayMetadataManager::updateMetadata(std::map<qcc::String, qcc::String
         qcc::String type = key.substr(typePos + 1);
 
         GatewayAppIdentifier appDeviceKey(appId, deviceId);
-        std::map<GatewayAppIdentifier, MetadataValues>::iterator it;
+        MetadataMap::iterator it;
         if ((it = m_Metadata.find(appDeviceKey)) != m_Metadata.end()) {
             if (type.compare("APP_NAME") == 0) {
                 if (!metadataUpdated && it->second.appName.compare(iter->second) != 0) {
@@ -214,7 +217,8 @@ QStatus GatewayMetadataManager::updateMetadata(std::map<qcc::String, qcc::String
 
 void GatewayMetadataManager::addMetadataValues(GatewayAppIdentifier const& key, std::map<qcc::String, qcc::String>* metadata)
 {
-    std::map<GatewayAppIdentifier, MetadataValues>::iterator iter;
+    GatewayScopedLock lock(m_MetadataLock);
+    MetadataMap::iterator iter;
     if ((iter = m_Metadata.find(key)) != m_Metadata.end()) {
         metadata->insert(std::pair<qcc::String, qcc::String>(iter->second.appNameKey, iter->second.appName));
         metadata->insert(std::pair<qcc::String, qcc::String>(iter->second.deviceNameKey, iter->second.deviceName));
@@ -223,7 +227,8 @@ void GatewayMetadataManager::addMetadataValues(GatewayAppIdentifier const& key,
 
 void GatewayMetadataManager::incRemoteAppRefCount(GatewayAppIdentifier const& key)
 {
-    std::map<GatewayAppIdentifier, MetadataValues>::iterator iter;
+    GatewayScopedLock lock(m_MetadataLock);
+    MetadataMap::iterator iter;
     if ((iter = m_Metadata.find(key)) != m_Metadata.end()) {
         iter->second.refCount++;
     }
@@ -232,7 +237,7 @@ void GatewayMetadataManager::incRemoteAppRefCount(GatewayAppIdentifier const& ke
 QStatus GatewayMetadataManager::writeToFile()
 {
     QStatus status = ER_FAIL;
-    std::map<GatewayAppIdentifier, MetadataValues>::iterator iter;
+    MetadataMap::iterator iter;
 
     xmlDocPtr doc = xmlNewDoc((xmlChar*)XML_DEFAULT_VERSION);
     if (doc == NULL) {
@@ -38,9 +38,11 @@ GatewayMgmt* GatewayMgmt::getInstance()
     return s_Instance;
 }
 
-GatewayMgmt::GatewayMgmt() : m_Bus(NULL), m_BusListener(NULL),
+GatewayMgmt::GatewayMgmt() : m_Bus(NULL), m_RouterBus(NULL), m_BusListener(NULL),
     m_RouterPolicyManager(NULL), m_ConnectorAppManager(NULL), m_MetadataManager(NULL),
-    m_gatewayPolicyFile(""), m_appPolicyDirectory("")
+    m_gatewayPolicyFile(""), m_appPolicyDirectory(""), m_connectorStartConcurrency(GATEWAY_CONNECTOR_START_CONCURRENCY),
+    m_connectorStartStagger(GATEWAY_CONNECTOR_START_STAGGER_MS), m_sessioncastSignals(false),
+    m_aclObjectsOnDemand(false), m_eventLoop(NULL)
 {
 }
 
@@ -69,15 +71,16 @@ void GatewayMgmt::sigChildCallback(int32_t signum)
         return;
     }
 
-    pid_t pid = wait(NULL);
-    QCC_DbgPrintf(("Received SigChild for Process %i", pid));
-    appManager->sigChildReceived(pid);
+    pid_t pid;
+    while ((pid = waitpid(-1, NULL, WNOHANG)) > 0) {
+        QCC_DbgPrintf(("Received SigChild for Process %i", pid));
+        appManager->sigChildReceived(pid);
+    }
 }
 
 QStatus GatewayMgmt::initGatewayMgmt(BusAttachment* bus)
 {
     QStatus status = ER_OK;
-    QCC_DbgTrace(("Initializing GatewayManagementApp"));
 
     if (!bus) {
         status = ER_BAD_ARG_1;
@@ -91,15 +94,38 @@ QStatus GatewayMgmt::initGatewayMgmt(BusAttachment* bus)
         return status;
     }
 
-    if (!bus->IsConnected()) {
+    if (m_RouterBus && m_RouterBus->getBusAttachment()->GetUniqueName().compare(bus->GetUniqueName()) != 0) {
+        status = ER_BAD_ARG_1;
+        QCC_LogError(status, ("Bus is already set to different BusAttachment"));
+        return status;
+    }
+
+    if (!m_RouterBus) {
+        m_RouterBus = new GatewayRouterBus(bus);
+    }
+    return initGatewayMgmt(m_RouterBus);
+}
+
+QStatus GatewayMgmt::initGatewayMgmt(GatewayBus* bus)
+{
+    QStatus status = ER_OK;
+    QCC_DbgTrace(("Initializing GatewayManagementApp"));
+
+    if (!bus) {
+        status = ER_BAD_ARG_1;
+        QCC_LogError(status, ("Bus cannot be NULL"));
+        return status;
+    }
+
+    if (!bus->isConnected()) {
         status = ER_BAD_ARG_1;
         QCC_LogError(status, ("Bus is not connected"));
         return status;
     }
 
-    if (m_Bus && m_Bus->GetUniqueName().compare(bus->GetUniqueName()) != 0) {
+    if (m_Bus && m_Bus != bus) {
         status = ER_BAD_ARG_1;
-        QCC_LogError(status, ("Bus is already set to different BusAttachment"));
+        QCC_LogError(status, ("Bus is already set to different Bus"));
         return status;
     }
 
@@ -110,14 +136,14 @@ QStatus GatewayMgmt::initGatewayMgmt(BusAttachment* bus)
         return status;
     }
 
-    m_BusListener = new GatewayBusListener(m_Bus);
+    m_BusListener = new GatewayBusListener(m_Bus->getBusAttachment());
     m_BusListener->setSessionPort(GATEWAY_PORT);
-    m_Bus->RegisterBusListener(*m_BusListener);
+    m_Bus->registerBusListener(*m_BusListener);
 
     SessionPort servicePort = GATEWAY_PORT;
     SessionOpts sessionOpts(SessionOpts::TRAFFIC_MESSAGES, false, SessionOpts::PROXIMITY_ANY, TRANSPORT_ANY);
 
-    status = m_Bus->BindSessionPort(servicePort, sessionOpts, *m_BusListener);
+    status = m_Bus->bindSessionPort(servicePort, sessionOpts, *m_BusListener);
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not bind Session Port successfully"));
         return status;
@@ -131,14 +157,14 @@ QStatus GatewayMgmt::initGatewayMgmt(BusAttachment* bus)
     }
 
     m_RouterPolicyManager = new GatewayRouterPolicyManager();
-    status = m_RouterPolicyManager->init(bus);
+    status = m_RouterPolicyManager->init(m_Bus);
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not initialize the Policy Manager"));
         return status;
     }
 
     m_ConnectorAppManager = new GatewayConnectorAppManager();
-    status = m_ConnectorAppManager->init(bus);
+    status = m_ConnectorAppManager->init(m_Bus);
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not initialize the App Manager"));
         return status;
@@ -167,6 +193,16 @@ QStatus GatewayMgmt::initGatewayMgmt(BusAttachment* bus)
     return status;
 }
 
+QStatus GatewayMgmt::startConnectorApps()
+{
+    if (!m_ConnectorAppManager) {
+        QCC_DbgHLPrintf(("ConnectorAppManager not initialized"));
+        return ER_BUS_BUS_NOT_STARTED;
+    }
+
+    return m_ConnectorAppManager->startConnectorApps(m_connectorStartConcurrency, m_connectorStartStagger);
+}
+
 QStatus GatewayMgmt::shutdownGatewayMgmt()
 {
     QStatus returnStatus = ER_OK;
@@ -214,13 +250,13 @@ QStatus GatewayMgmt::shutdownGatewayMgmt()
     }
 
     if (m_BusListener) {
-        m_Bus->UnregisterBusListener(*m_BusListener);
+        m_Bus->unregisterBusListener(*m_BusListener);
         delete m_BusListener;
         m_BusListener = NULL;
 
         SessionPort sp = GATEWAY_PORT;
 
-        QStatus status = m_Bus->UnbindSessionPort(sp);
+        QStatus status = m_Bus->unbindSessionPort(sp);
         if (status != ER_OK) {
             QCC_LogError(status, ("Could not unbind the SessionPort"));
             returnStatus = status;
@@ -229,10 +265,19 @@ QStatus GatewayMgmt::shutdownGatewayMgmt()
 
     xmlCleanupParser();
     m_Bus = NULL;
+    if (m_RouterBus) {
+        delete m_RouterBus;
+        m_RouterBus = NULL;
+    }
     return returnStatus;
 }
 
 BusAttachment* GatewayMgmt::getBusAttachment() const
+{
+    return m_Bus ? m_Bus->getBusAttachment() : NULL;
+}
+
+GatewayBus* GatewayMgmt::getBus() const
 {
     return m_Bus;
 }
@@ -267,6 +312,45 @@ void GatewayMgmt::setAppPolicyDir(const char* appPolicyDirectory)
     m_appPolicyDirectory = appPolicyDirectory;
 }
 
+void GatewayMgmt::setConnectorStartConcurrency(uint32_t concurrency)
+{
+    m_connectorStartConcurrency = concurrency;
+}
+
+void GatewayMgmt::setConnectorStartStagger(uint32_t staggerMs)
+{
+    m_connectorStartStagger = staggerMs;
+}
+
+void GatewayMgmt::setSessioncastSignals(bool sessioncast)
+{
+    m_sessioncastSignals = sessioncast;
+}
+
+bool GatewayMgmt::getSessioncastSignals() const
+{
+    return m_sessioncastSignals;
+}
+
+void GatewayMgmt::setAclObjectsOnDemand(bool onDemand)
+{
+    m_aclObjectsOnDemand = onDemand;
+}
+
+bool GatewayMgmt::getAclObjectsOnDemand() const
+{
+    return m_aclObjectsOnDemand;
+}
+
+void GatewayMgmt::setEventLoop(GatewayEventLoop* eventLoop)
+{
+    m_eventLoop = eventLoop;
+}
+
+GatewayEventLoop* GatewayMgmt::getEventLoop() const
+{
+    return m_eventLoop;
+}
 
 } /* namespace gw */
 } /* namespace ajn */
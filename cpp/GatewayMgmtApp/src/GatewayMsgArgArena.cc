@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/gateway/GatewayMsgArgArena.h>
+
+namespace ajn {
+namespace gw {
+
+GatewayMsgArgArena::GatewayMsgArgArena() : m_Args(NULL), m_ArgsSize(0), m_ArgsUsed(0),
+    m_Strings(NULL), m_StringsSize(0), m_StringsUsed(0), m_NumAllocations(0)
+{
+}
+
+GatewayMsgArgArena::~GatewayMsgArgArena()
+{
+    release();
+}
+
+void GatewayMsgArgArena::reserve(size_t numArgs, size_t numStrings)
+{
+    // a block that was already handed out can not grow - anything that does not fit goes into overflow blocks
+    if (numArgs > 0 && !m_Args) {
+        m_Args = new MsgArg[numArgs];
+        m_ArgsSize = numArgs;
+        m_NumAllocations++;
+    }
+    if (numStrings > 0 && !m_Strings) {
+        m_Strings = new const char*[numStrings];
+        m_StringsSize = numStrings;
+        m_NumAllocations++;
+    }
+}
+
+MsgArg* GatewayMsgArgArena::allocArgs(size_t numArgs)
+{
+    if (numArgs == 0) {
+        return NULL;
+    }
+
+    if (m_ArgsUsed + numArgs <= m_ArgsSize) {
+        MsgArg* args = m_Args + m_ArgsUsed;
+        m_ArgsUsed += numArgs;
+        return args;
+    }
+
+    MsgArg* args = new MsgArg[numArgs];
+    m_OverflowArgs.push_back(args);
+    m_NumAllocations++;
+    return args;
+}
+
+const char** GatewayMsgArgArena::allocStrings(size_t numStrings)
+{
+    if (numStrings == 0) {
+        return NULL;
+    }
+
+    if (m_StringsUsed + numStrings <= m_StringsSize) {
+        const char** strings = m_Strings + m_StringsUsed;
+        m_StringsUsed += numStrings;
+        return strings;
+    }
+
+    const char** strings = new const char*[numStrings];
+    m_OverflowStrings.push_back(strings);
+    m_NumAllocations++;
+    return strings;
+}
+
+void GatewayMsgArgArena::release()
+{
+    for (size_t i = 0; i < m_OverflowArgs.size(); i++) {
+        delete[] m_OverflowArgs[i];
+    }
+    m_OverflowArgs.clear();
+
+    for (size_t i = 0; i < m_OverflowStrings.size(); i++) {
+        delete[] m_OverflowStrings[i];
+    }
+    m_OverflowStrings.clear();
+
+    delete[] m_Args;
+    m_Args = NULL;
+    m_ArgsSize = 0;
+    m_ArgsUsed = 0;
+
+    delete[] m_Strings;
+    m_Strings = NULL;
+    m_StringsSize = 0;
+    m_StringsUsed = 0;
+
+    m_NumAllocations = 0;
+}
+
+size_t GatewayMsgArgArena::getNumAllocations() const
+{
+    return m_NumAllocations;
+}
+
+} /* namespace gw */
+} /* namespace ajn */
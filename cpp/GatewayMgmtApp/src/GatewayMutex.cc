@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/gateway/GatewayMutex.h>
+
+namespace ajn {
+namespace gw {
+
+GatewayMutex::GatewayMutex()
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&m_Mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+GatewayMutex::~GatewayMutex()
+{
+    pthread_mutex_destroy(&m_Mutex);
+}
+
+void GatewayMutex::lock()
+{
+    pthread_mutex_lock(&m_Mutex);
+}
+
+void GatewayMutex::unlock()
+{
+    pthread_mutex_unlock(&m_Mutex);
+}
+
+GatewayScopedLock::GatewayScopedLock(GatewayMutex& mutex) : m_Mutex(mutex)
+{
+    m_Mutex.lock();
+}
+
+GatewayScopedLock::~GatewayScopedLock()
+{
+    m_Mutex.unlock();
+}
+
+} /* namespace gw */
+} /* namespace ajn */
@@ -0,0 +1,534 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/gateway/GatewayRecorder.h>
+#include <alljoyn/gateway/GatewayStats.h>
+#include "GatewayConstants.h"
+#include <fstream>
+#include <iterator>
+#include <pthread.h>
+#include <stdio.h>
+
+namespace ajn {
+namespace gw {
+
+using namespace gwConsts;
+
+/**
+ * Nesting depth up to which args are read back, guards against corrupt recordings
+ */
+static const uint32_t MAX_ARG_DEPTH = 64;
+
+volatile bool GatewayRecorder::s_Recording = false;
+
+static FILE* s_File = NULL;
+
+static uint64_t s_StartUs = 0;
+
+static pthread_mutex_t s_FileLock = PTHREAD_MUTEX_INITIALIZER;
+
+// all values are written in host byte order, a recording is replayed on the machine type it was made on
+template <typename T>
+static void put(std::string& buf, T value)
+{
+    buf.append((const char*)&value, sizeof(value));
+}
+
+static void putString(std::string& buf, const char* str)
+{
+    uint32_t len = str ? strlen(str) : 0;
+    put(buf, len);
+    buf.append(str ? str : "", len);
+}
+
+template <typename T>
+static bool get(std::string const& buf, size_t* offset, T* value)
+{
+    if (buf.size() - *offset < sizeof(T)) {
+        return false;
+    }
+    memcpy(value, buf.data() + *offset, sizeof(T));
+    *offset += sizeof(T);
+    return true;
+}
+
+static bool getString(std::string const& buf, size_t* offset, qcc::String* str)
+{
+    uint32_t len;
+    if (!get(buf, offset, &len) || buf.size() - *offset < len) {
+        return false;
+    }
+    str->assign(buf.data() + *offset, len);
+    *offset += len;
+    return true;
+}
+
+/**
+ * Get the element signature and size of a scalar array type
+ * @param typeId - the type
+ * @param size - the size of an element
+ * @return signature of the array, NULL if the type is not a scalar array
+ */
+static const char* getScalarArrayInfo(AllJoynTypeId typeId, size_t* size)
+{
+    switch (typeId) {
+    case ALLJOYN_BYTE_ARRAY:
+        *size = 1;
+        return "ay";
+
+    case ALLJOYN_BOOLEAN_ARRAY:
+        *size = sizeof(bool);
+        return "ab";
+
+    case ALLJOYN_INT16_ARRAY:
+        *size = 2;
+        return "an";
+
+    case ALLJOYN_UINT16_ARRAY:
+        *size = 2;
+        return "aq";
+
+    case ALLJOYN_INT32_ARRAY:
+        *size = 4;
+        return "ai";
+
+    case ALLJOYN_UINT32_ARRAY:
+        *size = 4;
+        return "au";
+
+    case ALLJOYN_INT64_ARRAY:
+        *size = 8;
+        return "ax";
+
+    case ALLJOYN_UINT64_ARRAY:
+        *size = 8;
+        return "at";
+
+    case ALLJOYN_DOUBLE_ARRAY:
+        *size = 8;
+        return "ad";
+
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * Append an arg to a buffer
+ * @param buf - the buffer
+ * @param arg - the arg
+ * @return true, false if the arg has a type that can not be recorded
+ */
+static bool writeArg(std::string& buf, const MsgArg& arg)
+{
+    put(buf, (uint16_t)arg.typeId);
+
+    size_t size;
+    const char* arraySignature = getScalarArrayInfo(arg.typeId, &size);
+    if (arraySignature) {
+        put(buf, (uint32_t)arg.v_scalarArray.numElements);
+        buf.append((const char*)arg.v_scalarArray.v_byte, arg.v_scalarArray.numElements * size);
+        return true;
+    }
+
+    switch (arg.typeId) {
+    case ALLJOYN_BYTE:
+        put(buf, arg.v_byte);
+        return true;
+
+    case ALLJOYN_BOOLEAN:
+        put(buf, (uint8_t)(arg.v_bool ? 1 : 0));
+        return true;
+
+    case ALLJOYN_INT16:
+        put(buf, arg.v_int16);
+        return true;
+
+    case ALLJOYN_UINT16:
+        put(buf, arg.v_uint16);
+        return true;
+
+    case ALLJOYN_INT32:
+        put(buf, arg.v_int32);
+        return true;
+
+    case ALLJOYN_UINT32:
+        put(buf, arg.v_uint32);
+        return true;
+
+    case ALLJOYN_INT64:
+        put(buf, arg.v_int64);
+        return true;
+
+    case ALLJOYN_UINT64:
+        put(buf, arg.v_uint64);
+        return true;
+
+    case ALLJOYN_DOUBLE:
+        put(buf, arg.v_double);
+        return true;
+
+    case ALLJOYN_STRING:
+        putString(buf, arg.v_string.str);
+        return true;
+
+    case ALLJOYN_OBJECT_PATH:
+        putString(buf, arg.v_objPath.str);
+        return true;
+
+    case ALLJOYN_SIGNATURE:
+        putString(buf, arg.v_signature.sig);
+        return true;
+
+    case ALLJOYN_VARIANT:
+        return writeArg(buf, *arg.v_variant.val);
+
+    case ALLJOYN_DICT_ENTRY:
+        return writeArg(buf, *arg.v_dictEntry.key) && writeArg(buf, *arg.v_dictEntry.val);
+
+    case ALLJOYN_STRUCT:
+        put(buf, (uint32_t)arg.v_struct.numMembers);
+        for (size_t i = 0; i < arg.v_struct.numMembers; i++) {
+            if (!writeArg(buf, arg.v_struct.members[i])) {
+                return false;
+            }
+        }
+        return true;
+
+    case ALLJOYN_ARRAY: {
+            putString(buf, arg.v_array.GetElemSig());
+            put(buf, (uint32_t)arg.v_array.GetNumElements());
+            const MsgArg* elements = arg.v_array.GetElements();
+            for (size_t i = 0; i < arg.v_array.GetNumElements(); i++) {
+                if (!writeArg(buf, elements[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    default:
+        return false;
+    }
+}
+
+/**
+ * Read an arg back from a recording. Nested args are owned by the arg
+ * @param buf - the recording
+ * @param offset - offset of the arg, moved past it
+ * @param arg - the arg to fill
+ * @param depth - the nesting depth of the arg
+ * @return true, false if the recording is corrupt
+ */
+static bool readArg(std::string const& buf, size_t* offset, MsgArg* arg, uint32_t depth)
+{
+    uint16_t typeId;
+    if (depth > MAX_ARG_DEPTH || !get(buf, offset, &typeId)) {
+        return false;
+    }
+
+    size_t size;
+    const char* arraySignature = getScalarArrayInfo((AllJoynTypeId)typeId, &size);
+    if (arraySignature) {
+        uint32_t numElements;
+        if (!get(buf, offset, &numElements) || (buf.size() - *offset) / size < numElements) {
+            return false;
+        }
+        // copied out of the buffer, the elements may not be aligned in it
+        std::vector<uint64_t> elements(numElements * size / sizeof(uint64_t) + 1);
+        memcpy(&elements[0], buf.data() + *offset, numElements * size);
+        *offset += numElements * size;
+        if (arg->Set(arraySignature, (size_t)numElements, &elements[0]) != ER_OK) {
+            return false;
+        }
+        arg->Stabilize();
+        return true;
+    }
+
+    qcc::String str;
+    switch (typeId) {
+    case ALLJOYN_BYTE: {
+            uint8_t value;
+            return get(buf, offset, &value) && arg->Set("y", value) == ER_OK;
+        }
+
+    case ALLJOYN_BOOLEAN: {
+            uint8_t value;
+            return get(buf, offset, &value) && arg->Set("b", value != 0) == ER_OK;
+        }
+
+    case ALLJOYN_INT16: {
+            int16_t value;
+            return get(buf, offset, &value) && arg->Set("n", value) == ER_OK;
+        }
+
+    case ALLJOYN_UINT16: {
+            uint16_t value;
+            return get(buf, offset, &value) && arg->Set("q", value) == ER_OK;
+        }
+
+    case ALLJOYN_INT32: {
+            int32_t value;
+            return get(buf, offset, &value) && arg->Set("i", value) == ER_OK;
+        }
+
+    case ALLJOYN_UINT32: {
+            uint32_t value;
+            return get(buf, offset, &value) && arg->Set("u", value) == ER_OK;
+        }
+
+    case ALLJOYN_INT64: {
+            int64_t value;
+            return get(buf, offset, &value) && arg->Set("x", value) == ER_OK;
+        }
+
+    case ALLJOYN_UINT64: {
+            uint64_t value;
+            return get(buf, offset, &value) && arg->Set("t", value) == ER_OK;
+        }
+
+    case ALLJOYN_DOUBLE: {
+            double value;
+            return get(buf, offset, &value) && arg->Set("d", value) == ER_OK;
+        }
+
+    case ALLJOYN_STRING:
+    case ALLJOYN_OBJECT_PATH:
+    case ALLJOYN_SIGNATURE: {
+            const char* signature = typeId == ALLJOYN_STRING ? "s" : (typeId == ALLJOYN_OBJECT_PATH ? "o" : "g");
+            if (!getString(buf, offset, &str) || arg->Set(signature, str.c_str()) != ER_OK) {
+                return false;
+            }
+            arg->Stabilize();
+            return true;
+        }
+
+    case ALLJOYN_VARIANT:
+        arg->typeId = ALLJOYN_VARIANT;
+        arg->v_variant.val = new MsgArg();
+        arg->SetOwnershipFlags(MsgArg::OwnsArgs);
+        return readArg(buf, offset, arg->v_variant.val, depth + 1);
+
+    case ALLJOYN_DICT_ENTRY:
+        arg->typeId = ALLJOYN_DICT_ENTRY;
+        arg->v_dictEntry.key = new MsgArg();
+        arg->v_dictEntry.val = new MsgArg();
+        arg->SetOwnershipFlags(MsgArg::OwnsArgs);
+        return readArg(buf, offset, arg->v_dictEntry.key, depth + 1) && readArg(buf, offset, arg->v_dictEntry.val, depth + 1);
+
+    case ALLJOYN_STRUCT: {
+            uint32_t numMembers;
+            if (!get(buf, offset, &numMembers) || numMembers > buf.size() - *offset) {
+                return false;
+            }
+            arg->typeId = ALLJOYN_STRUCT;
+            arg->v_struct.numMembers = numMembers;
+            arg->v_struct.members = new MsgArg[numMembers];
+            arg->SetOwnershipFlags(MsgArg::OwnsArgs);
+            for (uint32_t i = 0; i < numMembers; i++) {
+                if (!readArg(buf, offset, &arg->v_struct.members[i], depth + 1)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    case ALLJOYN_ARRAY: {
+            uint32_t numElements;
+            if (!getString(buf, offset, &str) || !get(buf, offset, &numElements) || numElements > buf.size() - *offset) {
+                return false;
+            }
+            if (!numElements) {
+                return arg->Set(("a" + str).c_str(), (size_t)0, (MsgArg*)NULL) == ER_OK;
+            }
+
+            MsgArg* elements = new MsgArg[numElements];
+            for (uint32_t i = 0; i < numElements; i++) {
+                if (!readArg(buf, offset, &elements[i], depth + 1)) {
+                    delete[] elements;
+                    return false;
+                }
+            }
+            if (arg->Set("a*", (size_t)numElements, elements) != ER_OK) {
+                delete[] elements;
+                return false;
+            }
+            arg->SetOwnershipFlags(MsgArg::OwnsArgs);
+            return true;
+        }
+
+    default:
+        return false;
+    }
+}
+
+/**
+ * Append a record to the file
+ * @param buf - the record
+ */
+static void writeRecord(std::string const& buf)
+{
+    pthread_mutex_lock(&s_FileLock);
+    if (s_File && fwrite(buf.data(), 1, buf.size(), s_File) != buf.size()) {
+        QCC_DbgHLPrintf(("Could not write a record, stopping the recording"));
+        fclose(s_File);
+        s_File = NULL;
+    }
+    pthread_mutex_unlock(&s_FileLock);
+}
+
+QStatus GatewayRecorder::start(qcc::String const& fileName)
+{
+    stop();
+
+    pthread_mutex_lock(&s_FileLock);
+    s_File = fopen(fileName.c_str(), "wb");
+    if (!s_File) {
+        pthread_mutex_unlock(&s_FileLock);
+        QCC_DbgHLPrintf(("Could not open the recording file %s", fileName.c_str()));
+        return ER_OPEN_FAILED;
+    }
+
+    std::string header(GATEWAY_RECORD_MAGIC.c_str());
+    put(header, GATEWAY_RECORD_VERSION);
+    fwrite(header.data(), 1, header.size(), s_File);
+    s_StartUs = GatewayStats::getMonotonicUs();
+    s_Recording = true;
+    pthread_mutex_unlock(&s_FileLock);
+
+    QCC_DbgPrintf(("Recording management calls to %s", fileName.c_str()));
+    return ER_OK;
+}
+
+void GatewayRecorder::stop()
+{
+    pthread_mutex_lock(&s_FileLock);
+    s_Recording = false;
+    if (s_File) {
+        fclose(s_File);
+        s_File = NULL;
+    }
+    pthread_mutex_unlock(&s_FileLock);
+}
+
+void GatewayRecorder::recordMethodCall(const InterfaceDescription::Member* member, Message& msg)
+{
+    std::string buf;
+    put(buf, (uint8_t)GW_RECORD_METHOD_CALL);
+    put(buf, GatewayStats::getMonotonicUs() - s_StartUs);
+    putString(buf, msg->GetObjectPath());
+    putString(buf, msg->GetInterface());
+    putString(buf, member->name.c_str());
+
+    size_t numArgs = 0;
+    const MsgArg* args = NULL;
+    msg->GetArgs(numArgs, args);
+    put(buf, (uint32_t)numArgs);
+    for (size_t i = 0; i < numArgs; i++) {
+        if (!writeArg(buf, args[i])) {
+            QCC_DbgPrintf(("Not recording a call of %s, it has an arg that can not be recorded", member->name.c_str()));
+            return;
+        }
+    }
+    writeRecord(buf);
+}
+
+void GatewayRecorder::recordAnnouncement(const char* busName, uint16_t version, SessionPort port, const MsgArg& objectDescriptionArg,
+                                         const MsgArg& aboutDataArg)
+{
+    std::string buf;
+    put(buf, (uint8_t)GW_RECORD_ANNOUNCEMENT);
+    put(buf, GatewayStats::getMonotonicUs() - s_StartUs);
+    putString(buf, busName);
+    put(buf, version);
+    put(buf, port);
+    if (!writeArg(buf, objectDescriptionArg) || !writeArg(buf, aboutDataArg)) {
+        QCC_DbgPrintf(("Not recording an announcement of %s, it has an arg that can not be recorded", busName));
+        return;
+    }
+    writeRecord(buf);
+}
+
+GatewayRecordReader::GatewayRecordReader() : m_Offset(0)
+{
+}
+
+GatewayRecordReader::~GatewayRecordReader()
+{
+}
+
+QStatus GatewayRecordReader::open(qcc::String const& fileName)
+{
+    std::ifstream ifs(fileName.c_str(), std::ios::binary);
+    if (!ifs.is_open()) {
+        QCC_DbgHLPrintf(("Could not open the recording %s", fileName.c_str()));
+        return ER_OPEN_FAILED;
+    }
+    m_Content.assign((std::istreambuf_iterator<char>(ifs)), (std::istreambuf_iterator<char>()));
+
+    uint32_t version;
+    m_Offset = GATEWAY_RECORD_MAGIC.size();
+    if (m_Content.compare(0, GATEWAY_RECORD_MAGIC.size(), GATEWAY_RECORD_MAGIC.c_str()) != 0 ||
+        !get(m_Content, &m_Offset, &version) || version != GATEWAY_RECORD_VERSION) {
+        QCC_DbgHLPrintf(("%s is not a recording of this version", fileName.c_str()));
+        return ER_INVALID_DATA;
+    }
+    return ER_OK;
+}
+
+QStatus GatewayRecordReader::next(GatewayRecordedEvent* event)
+{
+    if (m_Offset >= m_Content.size()) {
+        return ER_EOF;
+    }
+
+    uint8_t type;
+    bool valid = get(m_Content, &m_Offset, &type) && get(m_Content, &m_Offset, &event->m_TimestampUs);
+    event->m_Type = (GatewayRecordType)type;
+    event->m_Args.clear();
+
+    if (valid && type == GW_RECORD_METHOD_CALL) {
+        uint32_t numArgs = 0;
+        valid = getString(m_Content, &m_Offset, &event->m_ObjectPath) && getString(m_Content, &m_Offset, &event->m_Interface) &&
+                getString(m_Content, &m_Offset, &event->m_Member) && get(m_Content, &m_Offset, &numArgs) &&
+                numArgs <= m_Content.size() - m_Offset;
+        if (valid) {
+            event->m_Args.resize(numArgs);
+        }
+    } else if (valid && type == GW_RECORD_ANNOUNCEMENT) {
+        valid = getString(m_Content, &m_Offset, &event->m_BusName) && get(m_Content, &m_Offset, &event->m_Version) &&
+                get(m_Content, &m_Offset, &event->m_Port);
+        if (valid) {
+            event->m_Args.resize(2);
+        }
+    } else {
+        valid = false;
+    }
+
+    for (size_t i = 0; valid && i < event->m_Args.size(); i++) {
+        valid = readArg(m_Content, &m_Offset, &event->m_Args[i], 0);
+    }
+
+    if (!valid) {
+        QCC_DbgHLPrintf(("The recording is corrupt at offset %u", (unsigned int)m_Offset));
+        m_Offset = m_Content.size();
+        return ER_READ_ERROR;
+    }
+    return ER_OK;
+}
+
+} /* namespace gw */
+} /* namespace ajn */
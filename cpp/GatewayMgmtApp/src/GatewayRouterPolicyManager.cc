@@ -15,12 +15,13 @@
  ******************************************************************************/
 
 #include <alljoyn/AboutData.h>
-#include <alljoyn/AllJoynStd.h>
 #include <alljoyn/about/AnnouncementRegistrar.h>
+#include <alljoyn/gateway/GatewayRecorder.h>
 #include <alljoyn/gateway/GatewayRouterPolicyManager.h>
+#include <alljoyn/gateway/GatewayStats.h>
+#include <alljoyn/gateway/GatewayTrace.h>
 #include "GatewayConstants.h"
 #include <libxml/parser.h>
-#include <alljoyn/DBusStd.h>
 
 namespace ajn {
 namespace gw {
@@ -30,6 +31,11 @@ using namespace gwConsts;
 
 static const qcc::String GATEWAY_POLICIES_DIRECTORY = "/opt/alljoyn/alljoyn-daemon.d";
 
+/**
+ * The wildcard objectPath, interned once so rules are checked against it by handle
+ */
+static const GatewayInternedString s_WildcardPath("*");
+
 GatewayRouterPolicyManager::GatewayRouterPolicyManager() : m_AboutListenerRegistered(false), m_AutoCommit(false),
     m_gatewayPolicyFile(GATEWAY_POLICIES_DIRECTORY + "/gwagent-config.xml"), m_appPolicyDirectory(GATEWAY_POLICIES_DIRECTORY + "/apps")
 {
@@ -40,19 +46,18 @@ GatewayRouterPolicyManager::~GatewayRouterPolicyManager()
 
 }
 
-QStatus GatewayRouterPolicyManager::init(BusAttachment* bus)
+QStatus GatewayRouterPolicyManager::init(GatewayBus* bus)
 {
     QStatus status = ER_OK;
 
-    if (!bus->IsStarted() || !bus->IsConnected()) {
+    if (!bus->isConnected()) {
         status = ER_BAD_ARG_1;
-        QCC_LogError(status, ("Could not accept this BusAttachment, busAttachment not started or not connected"));
+        QCC_LogError(status, ("Could not accept this Bus, bus not connected"));
         return status;
     }
 
     if (!m_AboutListenerRegistered) {
-        bus->RegisterAboutListener(*this);
-        status = bus->WhoImplements(NULL);
+        status = bus->registerAboutListener(*this);
         if (status != ER_OK) {
             QCC_LogError(status, ("WhoImplements call FAILED. GatewayRouterPolicyManager not initialized"));
             return status;
@@ -62,23 +67,23 @@ QStatus GatewayRouterPolicyManager::init(BusAttachment* bus)
     return status;
 }
 
-QStatus GatewayRouterPolicyManager::shutdown(BusAttachment* bus)
+QStatus GatewayRouterPolicyManager::shutdown(GatewayBus* bus)
 {
     QStatus status = ER_OK;
-    if (!bus->IsStarted() || !bus->IsConnected()) {
+    if (!bus->isConnected()) {
         status = ER_BAD_ARG_1;
-        QCC_LogError(status, ("Could not accept this BusAttachment, busAttachment not started or not connected"));
+        QCC_LogError(status, ("Could not accept this Bus, bus not connected"));
         return status;
     }
 
     if (m_AboutListenerRegistered) {
-        bus->UnregisterAboutListener(*this);
+        bus->unregisterAboutListener(*this);
         m_AboutListenerRegistered = false;
     }
     return status;
 }
 
-const std::map<GatewayAppIdentifier, qcc::String>& GatewayRouterPolicyManager::getAnnouncedDevices() const
+const GatewayAnnouncedDevices& GatewayRouterPolicyManager::getAnnouncedDevices() const
 {
     return m_AnnouncedDevices;
 }
@@ -90,9 +95,16 @@ const std::map<qcc::String, std::vector<GatewayAclRules> >& GatewayRouterPolicyM
 
 void GatewayRouterPolicyManager::setAutoCommit(bool autoCommit)
 {
+    GatewayScopedLock lock(m_PolicyLock);
     m_AutoCommit = autoCommit;
 }
 
+bool GatewayRouterPolicyManager::getAutoCommit() const
+{
+    GatewayScopedLock lock(m_PolicyLock);
+    return m_AutoCommit;
+}
+
 void GatewayRouterPolicyManager::setGatewayPolicyFile(const char* gatewayPolicyFile)
 {
     m_gatewayPolicyFile = gatewayPolicyFile;
@@ -106,9 +118,11 @@ void GatewayRouterPolicyManager::setAppPolicyDirectory(const char* appPolicyDire
 
 bool GatewayRouterPolicyManager::addConnectorAppRules(String const& connectorId, std::vector<GatewayAclRules> const& rules)
 {
+    GatewayScopedLock lock(m_PolicyLock);
+
     std::map<qcc::String, std::vector<GatewayAclRules> >::iterator iter;
     if ((iter = m_ConnectorAppRules.find(connectorId)) == m_ConnectorAppRules.end()) {
-        m_ConnectorAppRules.insert(std::pair<qcc::String, std::vector<GatewayAclRules> >(connectorId, rules));
+        iter = m_ConnectorAppRules.insert(std::pair<qcc::String, std::vector<GatewayAclRules> >(connectorId, rules)).first;
     } else {
         iter->second = rules;         //overwrite rules
     }
@@ -119,8 +133,42 @@ bool GatewayRouterPolicyManager::addConnectorAppRules(String const& connectorId,
     return true;
 }
 
+bool GatewayRouterPolicyManager::addConnectorAppRules(std::map<qcc::String, std::vector<GatewayAclRules> > const& rules)
+{
+    GatewayScopedLock lock(m_PolicyLock);
+
+    std::map<qcc::String, std::vector<GatewayAclRules> >::const_iterator rulesIter;
+    for (rulesIter = rules.begin(); rulesIter != rules.end(); rulesIter++) {
+        m_ConnectorAppRules[rulesIter->first] = rulesIter->second;         //overwrite rules
+    }
+
+    if (!m_AutoCommit || rules.empty()) {
+        return true;
+    }
+
+    GatewayStats::increment(GW_STATS_POLICY_COMMITS);
+    GatewayStatsTimer timer(GW_STATS_POLICY_COMMIT_LATENCY);
+    QStatus status = writeDefaultPolicies();
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not write the Default Policies"));
+        return false;
+    }
+
+    for (rulesIter = rules.begin(); rulesIter != rules.end(); rulesIter++) {
+        status = writeAppPolicies(m_ConnectorAppRules.find(rulesIter->first));
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Could not write the App Policies of %s", rulesIter->first.c_str()));
+            return false;
+        }
+    }
+
+    return (reloadConfig() == ER_OK);
+}
+
 bool GatewayRouterPolicyManager::removeConnectorAppRules(qcc::String const& connectorId)
 {
+    GatewayScopedLock lock(m_PolicyLock);
+
     std::map<qcc::String, std::vector<GatewayAclRules> >::iterator iter;
     if ((iter = m_ConnectorAppRules.find(connectorId)) == m_ConnectorAppRules.end()) {
         return false;
@@ -139,14 +187,37 @@ bool GatewayRouterPolicyManager::removeConnectorAppRules(qcc::String const& conn
     return true;
 }
 
-QStatus GatewayRouterPolicyManager::commitAppPolicies(std::map<qcc::String, std::vector<GatewayAclRules> >::iterator iter)
+bool GatewayRouterPolicyManager::removeConnectorAppRules(std::vector<qcc::String> const& connectorIds)
 {
-    BusAttachment* bus = GatewayMgmt::getInstance()->getBusAttachment();
-    if (!bus) {
-        QCC_LogError(ER_FAIL, ("BusAttachment is null"));
-        return ER_FAIL;
+    GatewayScopedLock lock(m_PolicyLock);
+
+    bool removed = false;
+    for (size_t i = 0; i < connectorIds.size(); i++) {
+        std::map<qcc::String, std::vector<GatewayAclRules> >::iterator iter;
+        if ((iter = m_ConnectorAppRules.find(connectorIds[i])) == m_ConnectorAppRules.end()) {
+            continue;
+        }
+
+        m_ConnectorAppRules.erase(iter);
+        removed = true;
+
+        int rc = remove((m_appPolicyDirectory + "/" + connectorIds[i] + ".xml").c_str());
+        if (rc != 0) {
+            QCC_DbgHLPrintf(("Could not remove app policy file for %s successfully", connectorIds[i].c_str()));
+        }
+    }
+
+    if (removed && m_AutoCommit) {
+        return (commitAppPolicies(m_ConnectorAppRules.end()) == ER_OK);
     }
+    return true;
+}
 
+QStatus GatewayRouterPolicyManager::commitAppPolicies(std::map<qcc::String, std::vector<GatewayAclRules> >::iterator iter)
+{
+    GatewayTraceScope trace("commitAppPolicies");
+    GatewayStats::increment(GW_STATS_POLICY_COMMITS);
+    GatewayStatsTimer timer(GW_STATS_POLICY_COMMIT_LATENCY);
     QStatus status = writeDefaultPolicies();
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not write the Default Policies"));
@@ -161,34 +232,28 @@ QStatus GatewayRouterPolicyManager::commitAppPolicies(std::map<qcc::String, std:
         }
     }
 
-    bus->EnableConcurrentCallbacks();
-    Message reply(*bus);
-    const ProxyBusObject& alljoynObj = bus->GetAllJoynProxyObj();
-    status = alljoynObj.MethodCall(org::alljoyn::Bus::InterfaceName, "ReloadConfig", NULL, 0, reply);
-    if (status != ER_OK) {
-        QCC_LogError(status, ("Could not reload the config"));
-        return status;
-    }
+    return reloadConfig();
+}
 
-    bool success = false;
-    reply->GetArgs(AJPARAM_BOOL.c_str(), &success);
-    if (!success) {
-        QCC_DbgHLPrintf(("Could not reload the config"));
-        return ER_INIT_FAILED;
+QStatus GatewayRouterPolicyManager::reloadConfig()
+{
+    GatewayTraceScope trace("ReloadConfig");
+    GatewayStatsTimer timer(GW_STATS_RELOAD_CONFIG_LATENCY);
+    GatewayBus* bus = GatewayMgmt::getInstance()->getBus();
+    if (!bus) {
+        QCC_LogError(ER_FAIL, ("Bus is null"));
+        return ER_FAIL;
     }
 
-    QCC_DbgPrintf(("Reloaded config successfully"));
-
-    return status;
+    return bus->reloadConfig();
 }
 
 QStatus GatewayRouterPolicyManager::commit()
 {
-    BusAttachment* bus = GatewayMgmt::getInstance()->getBusAttachment();
-    if (!bus) {
-        QCC_LogError(ER_FAIL, ("BusAttachment is null"));
-        return ER_FAIL;
-    }
+    GatewayScopedLock lock(m_PolicyLock);
+    GatewayTraceScope trace("commit");
+    GatewayStats::increment(GW_STATS_POLICY_COMMITS);
+    GatewayStatsTimer timer(GW_STATS_POLICY_COMMIT_LATENCY);
 
     QStatus status = writeDefaultPolicies();
     if (status != ER_OK) {
@@ -205,30 +270,12 @@ QStatus GatewayRouterPolicyManager::commit()
         }
     }
 
-
-    bus->EnableConcurrentCallbacks();
-    Message reply(*bus);
-    const ProxyBusObject& alljoynObj = bus->GetAllJoynProxyObj();
-    status = alljoynObj.MethodCall(org::alljoyn::Bus::InterfaceName, "ReloadConfig", NULL, 0, reply);
-    if (status != ER_OK) {
-        QCC_LogError(status, ("Could not reload the config"));
-        return status;
-    }
-
-    bool success = false;
-    reply->GetArgs(AJPARAM_BOOL.c_str(), &success);
-    if (!success) {
-        QCC_DbgHLPrintf(("Could not reload the config"));
-        return ER_INIT_FAILED;
-    }
-
-    QCC_DbgPrintf(("Reloaded config successfully"));
-
-    return status;
+    return reloadConfig();
 }
 
 QStatus GatewayRouterPolicyManager::writeAppPolicies(std::map<qcc::String, std::vector<GatewayAclRules> >::iterator iter)
 {
+    GatewayTraceScope trace("writeAppPolicies");
     QStatus status = ER_FAIL;
     xmlDocPtr doc = xmlNewDoc((xmlChar*)XML_DEFAULT_VERSION);
     if (doc == NULL) {
@@ -277,6 +324,7 @@ QStatus GatewayRouterPolicyManager::writeAppPolicies(std::map<qcc::String, std::
         status = ER_WRITE_ERROR;
         goto exit;
     }
+    GatewayStats::increment(GW_STATS_POLICY_BYTES_WRITTEN, rc);
     status = ER_OK;
 
 exit:
@@ -348,6 +396,7 @@ QStatus GatewayRouterPolicyManager::writeDefaultPolicies()
         status = ER_WRITE_ERROR;
         goto exit;
     }
+    GatewayStats::increment(GW_STATS_POLICY_BYTES_WRITTEN, rc);
     status = ER_OK;
 
 exit:
@@ -576,7 +625,7 @@ int GatewayRouterPolicyManager::writeAclUserPolicies(xmlTextWriterPtr writer, st
         GatewayRemoteAppRules::const_iterator iter;
         for (iter = remoteAppPerms.begin(); iter != remoteAppPerms.end(); iter++) {
 
-            std::map<GatewayAppIdentifier, qcc::String>::const_iterator announceIter;
+            GatewayAnnouncedDevices::const_iterator announceIter;
             if ((announceIter = m_AnnouncedDevices.find(iter->first)) == m_AnnouncedDevices.end()) {
                 continue;
             }
@@ -592,8 +641,8 @@ int GatewayRouterPolicyManager::writeExposedServices(xmlTextWriterPtr writer, co
     for (size_t objectsIndx = 0; objectsIndx < objects.size(); objectsIndx++) {
         const qcc::String& objectPath = objects[objectsIndx].getObjectPath();
         bool isPrefix = objects[objectsIndx].getIsPrefix();
-        const std::vector<qcc::String>& interfaces = objects[objectsIndx].getInterfaces();
-        if (!interfaces.size() && objectPath.compare("*") != 0) {
+        const GatewayInternedStrings& interfaces = objects[objectsIndx].getInterfaces();
+        if (!interfaces.size() && objects[objectsIndx].getObjectPathId() != s_WildcardPath) {
             //receive_type = method_call
             rc = xmlTextWriterStartElement(writer, (xmlChar*)"allow");
             if (rc < 0) {
@@ -651,7 +700,7 @@ int GatewayRouterPolicyManager::writeExposedServices(xmlTextWriterPtr writer, co
                 if (rc < 0) {
                     return rc;
                 }
-                rc = xmlTextWriterWriteAttribute(writer, (xmlChar*)"receive_interface", (xmlChar*)interfaces[interfaceIndx].c_str());
+                rc = xmlTextWriterWriteAttribute(writer, (xmlChar*)"receive_interface", (xmlChar*)interfaces[interfaceIndx].str().c_str());
                 if (rc < 0) {
                     return rc;
                 }
@@ -676,7 +725,7 @@ int GatewayRouterPolicyManager::writeExposedServices(xmlTextWriterPtr writer, co
                 if (rc < 0) {
                     return rc;
                 }
-                rc = xmlTextWriterWriteAttribute(writer, (xmlChar*)"send_interface", (xmlChar*)interfaces[interfaceIndx].c_str());
+                rc = xmlTextWriterWriteAttribute(writer, (xmlChar*)"send_interface", (xmlChar*)interfaces[interfaceIndx].str().c_str());
                 if (rc < 0) {
                     return rc;
                 }
@@ -700,8 +749,8 @@ int GatewayRouterPolicyManager::writeRemotedApps(xmlTextWriterPtr writer, const
     for (size_t objectsIndx = 0; objectsIndx < objects.size(); objectsIndx++) {
         const qcc::String& objectPath = objects[objectsIndx].getObjectPath();
         bool isPrefix = objects[objectsIndx].getIsPrefix();
-        const std::vector<qcc::String>& interfaces = objects[objectsIndx].getInterfaces();
-        if (!interfaces.size() && objectPath.compare("*") != 0) {
+        const GatewayInternedStrings& interfaces = objects[objectsIndx].getInterfaces();
+        if (!interfaces.size() && objects[objectsIndx].getObjectPathId() != s_WildcardPath) {
             //send_type = method_call
             rc = xmlTextWriterStartElement(writer, (xmlChar*)"allow");
             if (rc < 0) {
@@ -767,7 +816,7 @@ int GatewayRouterPolicyManager::writeRemotedApps(xmlTextWriterPtr writer, const
                 if (rc < 0) {
                     return rc;
                 }
-                rc = xmlTextWriterWriteAttribute(writer, (xmlChar*)"send_interface", (xmlChar*)interfaces[interfaceIndx].c_str());
+                rc = xmlTextWriterWriteAttribute(writer, (xmlChar*)"send_interface", (xmlChar*)interfaces[interfaceIndx].str().c_str());
                 if (rc < 0) {
                     return rc;
                 }
@@ -796,7 +845,7 @@ int GatewayRouterPolicyManager::writeRemotedApps(xmlTextWriterPtr writer, const
                 if (rc < 0) {
                     return rc;
                 }
-                rc = xmlTextWriterWriteAttribute(writer, (xmlChar*)"receive_interface", (xmlChar*)interfaces[interfaceIndx].c_str());
+                rc = xmlTextWriterWriteAttribute(writer, (xmlChar*)"receive_interface", (xmlChar*)interfaces[interfaceIndx].str().c_str());
                 if (rc < 0) {
                     return rc;
                 }
@@ -821,6 +870,11 @@ int GatewayRouterPolicyManager::writeRemotedApps(xmlTextWriterPtr writer, const
 void GatewayRouterPolicyManager::Announced(const char* busName, uint16_t version, SessionPort port, const MsgArg& objectDescs, const MsgArg& aboutDataArg)
 {
     QCC_DbgTrace(("Received Announcement from %s", busName));
+    GatewayTraceScope trace("Announced");
+    GatewayStats::increment(GW_STATS_ANNOUNCEMENTS_RECEIVED);
+    if (GatewayRecorder::isRecording()) {
+        GatewayRecorder::recordAnnouncement(busName, version, port, objectDescs, aboutDataArg);
+    }
 
     char* deviceId;
     uint8_t* appIdBuffer = NULL;
@@ -836,20 +890,25 @@ void GatewayRouterPolicyManager::Announced(const char* busName, uint16_t version
 
     if (!numElements || !deviceIdValue.length()) {
         QCC_DbgHLPrintf(("Announcement missing appId or deviceId - ignoring the announcement"));
+        GatewayStats::increment(GW_STATS_ANNOUNCEMENTS_IGNORED);
         return;
     }
 
     GatewayAppIdentifier key(appIdBuffer, numElements, deviceIdValue);
-    std::map<GatewayAppIdentifier, qcc::String>::iterator iter;
+    GatewayScopedLock lock(m_PolicyLock);
+
+    GatewayAnnouncedDevices::iterator iter;
     iter = m_AnnouncedDevices.find(key);
     if (iter == m_AnnouncedDevices.end()) {
         m_AnnouncedDevices.insert(std::pair<GatewayAppIdentifier, qcc::String>(key, busName));
     } else {
         if (iter->second.compare(busName) == 0) {         //busName didn't change in announce
+            GatewayStats::increment(GW_STATS_ANNOUNCEMENTS_IGNORED);
             return;
         }
         iter->second = busName;
     }
+    GatewayStats::increment(GW_STATS_ANNOUNCEMENTS_APPLIED);
 
     if (m_AutoCommit) {
         commit();         //update config file
@@ -19,12 +19,21 @@
 namespace ajn {
 namespace gw {
 
-GatewayRuleObjectDescription::GatewayRuleObjectDescription() : m_ObjectPath(""), m_IsPrefix(false)
+GatewayRuleObjectDescription::GatewayRuleObjectDescription() : m_IsPrefix(false)
 {
 
 }
 
 GatewayRuleObjectDescription::GatewayRuleObjectDescription(qcc::String const& objectPath, bool isPrefix, std::vector<qcc::String> const& interfaces) :
+    m_ObjectPath(objectPath), m_IsPrefix(isPrefix)
+{
+    m_Interfaces.reserve(interfaces.size());
+    for (size_t i = 0; i < interfaces.size(); i++) {
+        m_Interfaces.push_back(GatewayInternedString(interfaces[i]));
+    }
+}
+
+GatewayRuleObjectDescription::GatewayRuleObjectDescription(GatewayInternedString const& objectPath, bool isPrefix, GatewayInternedStrings const& interfaces) :
     m_ObjectPath(objectPath), m_IsPrefix(isPrefix), m_Interfaces(interfaces)
 {
 
@@ -35,24 +44,29 @@ GatewayRuleObjectDescription::~GatewayRuleObjectDescription()
 
 }
 
-const std::vector<qcc::String>& GatewayRuleObjectDescription::getInterfaces() const
+const GatewayInternedStrings& GatewayRuleObjectDescription::getInterfaces() const
 {
     return m_Interfaces;
 }
 
-void GatewayRuleObjectDescription::setInterfaces(const std::vector<qcc::String>& interfaces)
+void GatewayRuleObjectDescription::setInterfaces(const GatewayInternedStrings& interfaces)
 {
     m_Interfaces = interfaces;
 }
 
 const qcc::String& GatewayRuleObjectDescription::getObjectPath() const
+{
+    return m_ObjectPath.str();
+}
+
+const GatewayInternedString& GatewayRuleObjectDescription::getObjectPathId() const
 {
     return m_ObjectPath;
 }
 
 void GatewayRuleObjectDescription::setObjectPath(const qcc::String& objectPath)
 {
-    m_ObjectPath = objectPath;
+    m_ObjectPath = GatewayInternedString(objectPath);
 }
 
 bool GatewayRuleObjectDescription::getIsPrefix() const
@@ -0,0 +1,227 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/gateway/GatewayStats.h>
+#include "GatewayConstants.h"
+#include <pthread.h>
+#include <time.h>
+
+namespace ajn {
+namespace gw {
+
+using namespace gwConsts;
+
+/**
+ * Samples and buckets of a latency histogram
+ */
+struct HistogramData {
+    uint64_t m_Count;
+    uint64_t m_SumUs;
+    uint64_t m_MaxUs;
+    uint64_t m_Buckets[GW_STATS_NUM_BUCKETS];
+};
+
+/**
+ * Latency histogram of a method member
+ */
+struct MethodHistogram {
+    const InterfaceDescription::Member* m_Member;
+    qcc::String m_Name;
+    HistogramData m_Data;
+};
+
+static const uint64_t s_BucketBoundsUs[GW_STATS_NUM_BUCKETS - 1] = {
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000
+};
+
+static const char* s_CounterNames[GW_STATS_NUM_COUNTERS] = {
+    "policy.commits",
+    "policy.bytesWritten",
+    "announcements.received",
+    "announcements.ignored",
+    "announcements.applied",
+    "acl.creates",
+    "acl.updates",
+    "acl.patches",
+    "acl.statusUpdates",
+    "acl.deletes",
+    "acl.batches",
+    "connector.starts",
+    "connector.exits",
+    "sessions.joined",
+    "sessions.lost"
+};
+
+static const char* s_HistogramNames[GW_STATS_NUM_HISTOGRAMS] = {
+    "policy.commitLatency",
+    "policy.reloadConfigLatency"
+};
+
+// qcc only has 32 bit atomics and not every target has an 8 byte CAS, so the
+// 64 bit counters and histograms are updated under s_StatsLock. Every update
+// only holds it for a few adds
+static pthread_mutex_t s_StatsLock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint64_t s_Counters[GW_STATS_NUM_COUNTERS];
+
+static HistogramData s_Histograms[GW_STATS_NUM_HISTOGRAMS];
+
+static MethodHistogram s_MethodHistograms[GATEWAY_STATS_MAX_METHODS];
+
+static size_t s_NumMethods = 0;
+
+static void record(HistogramData* data, uint64_t latencyUs)
+{
+    size_t bucket = 0;
+    while (bucket < GW_STATS_NUM_BUCKETS - 1 && latencyUs > s_BucketBoundsUs[bucket]) {
+        bucket++;
+    }
+    data->m_Buckets[bucket]++;
+    data->m_Count++;
+    data->m_SumUs += latencyUs;
+    if (latencyUs > data->m_MaxUs) {
+        data->m_MaxUs = latencyUs;
+    }
+}
+
+static void clear(HistogramData* data)
+{
+    for (size_t i = 0; i < GW_STATS_NUM_BUCKETS; i++) {
+        data->m_Buckets[i] = 0;
+    }
+    data->m_Count = 0;
+    data->m_SumUs = 0;
+    data->m_MaxUs = 0;
+}
+
+static void copy(qcc::String const& name, const HistogramData* data, std::vector<GatewayStats::HistogramValue>* histograms)
+{
+    if (!data->m_Count) {
+        return;
+    }
+
+    GatewayStats::HistogramValue value;
+    value.m_Name = name;
+    value.m_Count = data->m_Count;
+    value.m_SumUs = data->m_SumUs;
+    value.m_MaxUs = data->m_MaxUs;
+    for (size_t i = 0; i < GW_STATS_NUM_BUCKETS; i++) {
+        value.m_Buckets[i] = data->m_Buckets[i];
+    }
+    histograms->push_back(value);
+}
+
+static HistogramData* findMethodHistogram(const InterfaceDescription::Member* member)
+{
+    for (size_t i = 0; i < s_NumMethods; i++) {
+        if (s_MethodHistograms[i].m_Member == member) {
+            return &s_MethodHistograms[i].m_Data;
+        }
+    }
+    return NULL;
+}
+
+void GatewayStats::increment(GatewayStatsCounter counter, uint64_t value)
+{
+    if (counter < GW_STATS_NUM_COUNTERS) {
+        pthread_mutex_lock(&s_StatsLock);
+        s_Counters[counter] += value;
+        pthread_mutex_unlock(&s_StatsLock);
+    }
+}
+
+void GatewayStats::recordLatency(GatewayStatsHistogram histogram, uint64_t latencyUs)
+{
+    if (histogram < GW_STATS_NUM_HISTOGRAMS) {
+        pthread_mutex_lock(&s_StatsLock);
+        record(&s_Histograms[histogram], latencyUs);
+        pthread_mutex_unlock(&s_StatsLock);
+    }
+}
+
+void GatewayStats::recordMethodLatency(const InterfaceDescription::Member* member, uint64_t latencyUs)
+{
+    if (!member) {
+        return;
+    }
+
+    pthread_mutex_lock(&s_StatsLock);
+    HistogramData* data = findMethodHistogram(member);
+    if (!data && s_NumMethods < GATEWAY_STATS_MAX_METHODS) {
+        MethodHistogram& entry = s_MethodHistograms[s_NumMethods++];
+        entry.m_Member = member;
+        entry.m_Name = qcc::String(member->iface ? member->iface->GetName() : "") + "." + member->name;
+        data = &entry.m_Data;
+    }
+    if (data) {
+        record(data, latencyUs);
+    }
+    pthread_mutex_unlock(&s_StatsLock);
+
+    if (!data) {
+        QCC_DbgPrintf(("No histogram left for member %s", member->name.c_str()));
+    }
+}
+
+void GatewayStats::reset()
+{
+    pthread_mutex_lock(&s_StatsLock);
+    for (size_t i = 0; i < GW_STATS_NUM_COUNTERS; i++) {
+        s_Counters[i] = 0;
+    }
+    for (size_t i = 0; i < GW_STATS_NUM_HISTOGRAMS; i++) {
+        clear(&s_Histograms[i]);
+    }
+    for (size_t i = 0; i < s_NumMethods; i++) {
+        clear(&s_MethodHistograms[i].m_Data);
+    }
+    pthread_mutex_unlock(&s_StatsLock);
+}
+
+void GatewayStats::getSnapshot(std::vector<CounterValue>* counters, std::vector<HistogramValue>* histograms)
+{
+    pthread_mutex_lock(&s_StatsLock);
+    for (size_t i = 0; i < GW_STATS_NUM_COUNTERS; i++) {
+        CounterValue value;
+        value.m_Name = s_CounterNames[i];
+        value.m_Value = s_Counters[i];
+        counters->push_back(value);
+    }
+
+    for (size_t i = 0; i < GW_STATS_NUM_HISTOGRAMS; i++) {
+        copy(s_HistogramNames[i], &s_Histograms[i], histograms);
+    }
+
+    for (size_t i = 0; i < s_NumMethods; i++) {
+        copy(s_MethodHistograms[i].m_Name, &s_MethodHistograms[i].m_Data, histograms);
+    }
+    pthread_mutex_unlock(&s_StatsLock);
+}
+
+const uint64_t* GatewayStats::getBucketBoundsUs()
+{
+    return s_BucketBoundsUs;
+}
+
+uint64_t GatewayStats::getMonotonicUs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+} /* namespace gw */
+} /* namespace ajn */
@@ -0,0 +1,191 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/gateway/GatewayTaskQueue.h>
+#include "GatewayConstants.h"
+
+namespace ajn {
+namespace gw {
+
+/**
+ * Wraps a task posted with postAndWait and flags its completion
+ */
+class GatewayWaitTask : public GatewayTask {
+  public:
+
+    GatewayWaitTask(GatewayTask* task, bool* done) : m_Task(task), m_Done(done) { }
+
+    ~GatewayWaitTask()
+    {
+        delete m_Task;
+        *m_Done = true;
+    }
+
+    void run()
+    {
+        m_Task->run();
+    }
+
+    void cancel()
+    {
+        m_Task->cancel();
+    }
+
+  private:
+
+    GatewayTask* m_Task;
+
+    bool* m_Done;
+};
+
+GatewayTaskQueue::GatewayTaskQueue() : m_IsRunning(false), m_IsStopping(false)
+{
+    pthread_mutex_init(&m_Lock, NULL);
+    pthread_cond_init(&m_TaskPosted, NULL);
+    pthread_cond_init(&m_TaskDone, NULL);
+}
+
+GatewayTaskQueue::~GatewayTaskQueue()
+{
+    stop();
+    pthread_cond_destroy(&m_TaskDone);
+    pthread_cond_destroy(&m_TaskPosted);
+    pthread_mutex_destroy(&m_Lock);
+}
+
+QStatus GatewayTaskQueue::start()
+{
+    pthread_mutex_lock(&m_Lock);
+    if (m_IsRunning) {
+        pthread_mutex_unlock(&m_Lock);
+        return ER_OK;
+    }
+
+    m_IsStopping = false;
+    int rc = pthread_create(&m_Thread, NULL, GatewayTaskQueue::Run, this);
+    if (rc != 0) {
+        pthread_mutex_unlock(&m_Lock);
+        QCC_DbgHLPrintf(("Could not create the thread of the task queue"));
+        return ER_OS_ERROR;
+    }
+    m_IsRunning = true;
+    pthread_mutex_unlock(&m_Lock);
+    return ER_OK;
+}
+
+void GatewayTaskQueue::stop()
+{
+    pthread_mutex_lock(&m_Lock);
+    if (!m_IsRunning) {
+        // never started - cancel whatever was posted in the meantime
+        std::deque<GatewayTask*> tasks;
+        tasks.swap(m_Tasks);
+        m_IsStopping = true;
+        pthread_mutex_unlock(&m_Lock);
+        for (size_t i = 0; i < tasks.size(); i++) {
+            tasks[i]->cancel();
+            delete tasks[i];
+        }
+        pthread_mutex_lock(&m_Lock);
+        pthread_cond_broadcast(&m_TaskDone);
+        pthread_mutex_unlock(&m_Lock);
+        return;
+    }
+    if (m_IsStopping) {
+        pthread_mutex_unlock(&m_Lock);
+        return;
+    }
+    m_IsStopping = true;
+    pthread_cond_broadcast(&m_TaskPosted);
+    pthread_mutex_unlock(&m_Lock);
+
+    if (!isCurrentThread()) {
+        pthread_join(m_Thread, NULL);
+    } else {
+        pthread_detach(m_Thread);
+    }
+
+    pthread_mutex_lock(&m_Lock);
+    m_IsRunning = false;
+    pthread_mutex_unlock(&m_Lock);
+}
+
+void GatewayTaskQueue::post(GatewayTask* task)
+{
+    pthread_mutex_lock(&m_Lock);
+    if (m_IsStopping) {
+        pthread_mutex_unlock(&m_Lock);
+        task->cancel();
+        delete task;
+        return;
+    }
+    m_Tasks.push_back(task);
+    pthread_cond_signal(&m_TaskPosted);
+    pthread_mutex_unlock(&m_Lock);
+}
+
+void GatewayTaskQueue::postAndWait(GatewayTask* task)
+{
+    if (isCurrentThread()) {
+        task->run();
+        delete task;
+        return;
+    }
+
+    bool done = false;
+    post(new GatewayWaitTask(task, &done));
+
+    pthread_mutex_lock(&m_Lock);
+    while (!done) {
+        pthread_cond_wait(&m_TaskDone, &m_Lock);
+    }
+    pthread_mutex_unlock(&m_Lock);
+}
+
+bool GatewayTaskQueue::isCurrentThread() const
+{
+    return m_IsRunning && pthread_equal(m_Thread, pthread_self());
+}
+
+void* GatewayTaskQueue::Run(void* arg)
+{
+    GatewayTaskQueue* queue = (GatewayTaskQueue*)arg;
+
+    pthread_mutex_lock(&queue->m_Lock);
+    while (true) {
+        while (queue->m_Tasks.empty() && !queue->m_IsStopping) {
+            pthread_cond_wait(&queue->m_TaskPosted, &queue->m_Lock);
+        }
+        if (queue->m_Tasks.empty()) {
+            break;
+        }
+
+        GatewayTask* task = queue->m_Tasks.front();
+        queue->m_Tasks.pop_front();
+        pthread_mutex_unlock(&queue->m_Lock);
+
+        task->run();
+
+        pthread_mutex_lock(&queue->m_Lock);
+        delete task;
+        pthread_cond_broadcast(&queue->m_TaskDone);
+    }
+    pthread_mutex_unlock(&queue->m_Lock);
+    return NULL;
+}
+
+} /* namespace gw */
+} /* namespace ajn */
@@ -0,0 +1,239 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <alljoyn/gateway/GatewayTrace.h>
+#include <alljoyn/gateway/GatewayStats.h>
+#include "GatewayConstants.h"
+#include <fstream>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace ajn {
+namespace gw {
+
+using namespace gwConsts;
+
+/**
+ * A begin or end event in a ring
+ */
+struct TraceEvent {
+    uint64_t m_TimestampUs;
+    const char* m_Name;
+    char m_Phase;
+};
+
+/**
+ * The ring of a thread. Only the owning thread writes, m_Next counts all
+ * events ever written so a reader can tell which slots were overwritten
+ */
+struct TraceRing {
+    pid_t m_ThreadId;
+    volatile uint64_t m_Next;
+    TraceEvent m_Events[GATEWAY_TRACE_RING_EVENTS];
+};
+
+/**
+ * An event of a ring copied for a dump
+ */
+struct TraceDumpEvent {
+    pid_t m_ThreadId;
+    TraceEvent m_Event;
+};
+
+volatile bool GatewayTrace::s_Enabled = false;
+
+// at most GATEWAY_TRACE_MAX_RINGS rings are allocated. A thread hands its ring
+// back to s_FreeRings when it exits, the events of the thread can still be
+// dumped until another thread reuses the ring
+static std::vector<TraceRing*> s_Rings;
+
+static std::vector<TraceRing*> s_FreeRings;
+
+// number of rings a thread can still get, read without the lock so a thread
+// that got no ring only retries once one is available
+static volatile size_t s_NumAvailableRings = GATEWAY_TRACE_MAX_RINGS;
+
+static pthread_mutex_t s_RingsLock = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_once_t s_RingKeyOnce = PTHREAD_ONCE_INIT;
+
+static pthread_key_t s_RingKey;
+
+static __thread TraceRing* s_ThreadRing = NULL;
+
+// the names of spans that are not string literals, e.g. method members whose
+// interfaces go away with the BusAttachment on a restart
+static std::set<qcc::String> s_Names;
+
+static pthread_mutex_t s_NamesLock = PTHREAD_MUTEX_INITIALIZER;
+
+static void releaseRing(void* arg)
+{
+    TraceRing* ring = (TraceRing*)arg;
+    pthread_mutex_lock(&s_RingsLock);
+    s_FreeRings.push_back(ring);
+    s_NumAvailableRings = s_NumAvailableRings + 1;
+    pthread_mutex_unlock(&s_RingsLock);
+    s_ThreadRing = NULL;
+}
+
+static void createRingKey()
+{
+    pthread_key_create(&s_RingKey, releaseRing);
+}
+
+static TraceRing* getThreadRing()
+{
+    if (s_ThreadRing || !s_NumAvailableRings) {
+        return s_ThreadRing;
+    }
+
+    pthread_once(&s_RingKeyOnce, createRingKey);
+
+    TraceRing* ring = NULL;
+    pthread_mutex_lock(&s_RingsLock);
+    if (!s_FreeRings.empty()) {
+        ring = s_FreeRings.back();
+        s_FreeRings.pop_back();
+    } else if (s_Rings.size() < GATEWAY_TRACE_MAX_RINGS) {
+        ring = new TraceRing();
+        s_Rings.push_back(ring);
+    }
+    if (ring) {
+        ring->m_ThreadId = (pid_t)syscall(SYS_gettid);
+        ring->m_Next = 0;
+        s_NumAvailableRings = s_NumAvailableRings - 1;
+    }
+    pthread_mutex_unlock(&s_RingsLock);
+
+    if (ring) {
+        pthread_setspecific(s_RingKey, ring);
+        s_ThreadRing = ring;
+    }
+    return ring;
+}
+
+static void record(const char* name, char phase)
+{
+    TraceRing* ring = getThreadRing();
+    if (!ring) {
+        return;
+    }
+    TraceEvent& event = ring->m_Events[ring->m_Next % GATEWAY_TRACE_RING_EVENTS];
+    event.m_TimestampUs = GatewayStats::getMonotonicUs();
+    event.m_Name = name;
+    event.m_Phase = phase;
+    __sync_synchronize();
+    ring->m_Next = ring->m_Next + 1;
+}
+
+static void writeJsonString(std::ofstream& ofs, const char* value)
+{
+    ofs << '"';
+    for (const char* c = value; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            ofs << '\\' << *c;
+        } else if ((unsigned char)*c >= 0x20) {
+            ofs << *c;
+        }
+    }
+    ofs << '"';
+}
+
+void GatewayTrace::setEnabled(bool enabled)
+{
+    s_Enabled = enabled;
+}
+
+void GatewayTrace::begin(const char* name)
+{
+    record(name, 'B');
+}
+
+void GatewayTrace::end(const char* name)
+{
+    record(name, 'E');
+}
+
+const char* GatewayTrace::internName(qcc::String const& name)
+{
+    pthread_mutex_lock(&s_NamesLock);
+    const char* internedName = s_Names.insert(name).first->c_str();
+    pthread_mutex_unlock(&s_NamesLock);
+    return internedName;
+}
+
+QStatus GatewayTrace::dump(qcc::String const& fileName)
+{
+    std::ofstream ofs(fileName.c_str());
+    if (!ofs.is_open()) {
+        QCC_DbgHLPrintf(("Could not open the trace file %s", fileName.c_str()));
+        return ER_OPEN_FAILED;
+    }
+
+    // the events are copied under the lock so a ring is not reused while it is copied
+    std::vector<TraceDumpEvent> events;
+    pthread_mutex_lock(&s_RingsLock);
+    for (size_t i = 0; i < s_Rings.size(); i++) {
+        TraceRing* ring = s_Rings[i];
+        size_t firstEvent = events.size();
+        uint64_t last = ring->m_Next;
+        __sync_synchronize();
+        uint64_t first = last > GATEWAY_TRACE_RING_EVENTS ? last - GATEWAY_TRACE_RING_EVENTS : 0;
+        for (uint64_t j = first; j < last; j++) {
+            TraceDumpEvent event;
+            event.m_ThreadId = ring->m_ThreadId;
+            event.m_Event = ring->m_Events[j % GATEWAY_TRACE_RING_EVENTS];
+            events.push_back(event);
+        }
+
+        // the owner kept writing while the events were copied, drop the slots it overwrote
+        __sync_synchronize();
+        uint64_t next = ring->m_Next;
+        uint64_t valid = next > GATEWAY_TRACE_RING_EVENTS ? next - GATEWAY_TRACE_RING_EVENTS : 0;
+        if (valid > first) {
+            events.erase(events.begin() + firstEvent, events.begin() + firstEvent + (size_t)(std::min(valid, last) - first));
+        }
+    }
+    pthread_mutex_unlock(&s_RingsLock);
+
+    pid_t processId = getpid();
+    ofs << "{\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); i++) {
+        const TraceEvent& event = events[i].m_Event;
+        ofs << (i ? ",\n" : "\n") << "{\"name\":";
+        writeJsonString(ofs, event.m_Name);
+        ofs << ",\"ph\":\"" << event.m_Phase << "\",\"ts\":" << event.m_TimestampUs
+            << ",\"pid\":" << processId << ",\"tid\":" << events[i].m_ThreadId << "}";
+    }
+    ofs << "\n]}\n";
+    ofs.close();
+
+    if (ofs.fail()) {
+        QCC_DbgHLPrintf(("Could not write the trace file %s", fileName.c_str()));
+        return ER_WRITE_ERROR;
+    }
+
+    QCC_DbgPrintf(("Wrote %u trace events to %s", (unsigned int)events.size(), fileName.c_str()));
+    return ER_OK;
+}
+
+} /* namespace gw */
+} /* namespace ajn */
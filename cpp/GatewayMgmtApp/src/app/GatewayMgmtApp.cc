@@ -21,7 +21,11 @@
 #include <alljoyn/Init.h>
 #include <alljoyn/gateway/GatewayMgmt.h>
 #include <alljoyn/gateway/GatewayBusListener.h>
+#include <alljoyn/gateway/GatewayEventLoop.h>
+#include <alljoyn/gateway/GatewayTrace.h>
+#include <alljoyn/gateway/GatewayRecorder.h>
 #include "../GatewayConstants.h"
+#include <qcc/StringUtil.h>
 #include "SrpKeyXListener.h"
 #include "GuidUtil.h"
 
@@ -36,18 +40,33 @@ BusAttachment* bus = NULL;
 AboutData* aboutData = NULL;
 GatewayBusListener*  busListener = NULL;
 SrpKeyXListener* keyListener = NULL;
+GatewayEventLoop* eventLoop = NULL;
+qcc::String traceFile = gwConsts::GATEWAY_TRACE_FILE;
+qcc::String recordFile;
 static volatile sig_atomic_t s_interrupt = false;
 static volatile sig_atomic_t s_restart = false;
+static pthread_mutex_t s_waitLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_waitCond = PTHREAD_COND_INITIALIZER;
+
+static void WakeMainThread()
+{
+    pthread_mutex_lock(&s_waitLock);
+    pthread_cond_signal(&s_waitCond);
+    pthread_mutex_unlock(&s_waitLock);
+}
 
 static void DaemonDisconnectHandler()
 {
     s_restart = true;
+    WakeMainThread();
 }
 
 void WaitForSigInt(void) {
+    pthread_mutex_lock(&s_waitLock);
     while (s_interrupt == false && s_restart == false) {
-        usleep(100 * 1000);
+        pthread_cond_wait(&s_waitCond, &s_waitLock);
     }
+    pthread_mutex_unlock(&s_waitLock);
 }
 
 QStatus prepareBusAttachment()
@@ -180,40 +199,81 @@ void cleanup()
         delete bus;
         bus = NULL;
     }
+    // the recording spans restarts after a daemon disconnect
+    if (!s_restart) {
+        GatewayRecorder::stop();
+    }
 }
 
 void signal_callback_handler(int32_t signum)
 {
     if (signum == SIGCHLD) {
-        signal(SIGCHLD, signal_callback_handler); //reset signal handler
         GatewayMgmt::sigChildCallback(signum);
+    } else if (signum == SIGUSR1) {
+        if (GatewayTrace::isEnabled()) {
+            GatewayTrace::dump(traceFile);
+        }
     } else {
         s_interrupt = true;
+        WakeMainThread();
     }
 }
+
+QStatus prepareEventLoop()
+{
+    eventLoop = new GatewayEventLoop();
+    QStatus status = eventLoop->init();
+    if (status != ER_OK) {
+        return status;
+    }
+
+    // Allow CTRL+C to end application
+    // SIGUSR1 dumps the trace
+    const int32_t signals[] = { SIGINT, SIGTERM, SIGCHLD, SIGUSR1 };
+    for (size_t i = 0; i < sizeof(signals) / sizeof(signals[0]); i++) {
+        status = eventLoop->addSignalHandler(signals[i], signal_callback_handler);
+        if (status != ER_OK) {
+            return status;
+        }
+    }
+    return eventLoop->start();
+}
 qcc::String policyFileOption = "--gwagent-policy-file=";
 qcc::String appsPolicyDirOption = "--apps-policy-dir=";
+qcc::String startConcurrencyOption = "--connector-start-concurrency=";
+qcc::String startStaggerOption = "--connector-start-stagger-ms=";
+qcc::String sessioncastOption = "--sessioncast-signals";
+qcc::String aclObjectsOnDemandOption = "--acl-objects-on-demand";
+qcc::String traceOption = "--trace";
+qcc::String traceFileOption = "--trace-file=";
+qcc::String recordOption = "--record=";
 
 int main(int argc, char** argv)
 {
+    // the signals are blocked before any thread is started, so only the event loop receives them
+    if (prepareEventLoop() != ER_OK) {
+        std::cout << "Could not start the event loop" << std::endl;
+        delete eventLoop;
+        return 1;
+    }
+
     if (AllJoynInit() != ER_OK) {
+        delete eventLoop;
         return 1;
     }
 #ifdef ROUTER
     if (AllJoynRouterInit() != ER_OK) {
         AllJoynShutdown();
+        delete eventLoop;
         return 1;
     }
 #endif
-    // Allow CTRL+C to end application
-    signal(SIGINT, signal_callback_handler);
-    signal(SIGTERM, signal_callback_handler);
-    signal(SIGCHLD, signal_callback_handler);
 
 start:
 
     // Initialize GatewayMgmt object
     gatewayMgmt = GatewayMgmt::getInstance();
+    gatewayMgmt->setEventLoop(eventLoop);
 
     for (int i = 1; i < argc; i++) {
         qcc::String arg(argv[i]);
@@ -227,6 +287,43 @@ start:
             QCC_DbgPrintf(("Setting appsPolicyDir to: %s", policyDir.c_str()));
             gatewayMgmt->setAppPolicyDir(policyDir.c_str());
         }
+        if (arg.compare(0, startConcurrencyOption.size(), startConcurrencyOption) == 0) {
+            uint32_t concurrency = StringToU32(arg.substr(startConcurrencyOption.size()), 10, gwConsts::GATEWAY_CONNECTOR_START_CONCURRENCY);
+            QCC_DbgPrintf(("Setting connector start concurrency to: %u", concurrency));
+            gatewayMgmt->setConnectorStartConcurrency(concurrency);
+        }
+        if (arg.compare(0, startStaggerOption.size(), startStaggerOption) == 0) {
+            uint32_t stagger = StringToU32(arg.substr(startStaggerOption.size()), 10, gwConsts::GATEWAY_CONNECTOR_START_STAGGER_MS);
+            QCC_DbgPrintf(("Setting connector start stagger to: %u ms", stagger));
+            gatewayMgmt->setConnectorStartStagger(stagger);
+        }
+        if (arg == sessioncastOption) {
+            QCC_DbgPrintf(("Sending signals to all hosted sessions at once"));
+            gatewayMgmt->setSessioncastSignals(true);
+        }
+        if (arg == aclObjectsOnDemandOption) {
+            QCC_DbgPrintf(("Registering Acl objects when their object path is handed out"));
+            gatewayMgmt->setAclObjectsOnDemand(true);
+        }
+        if (arg == traceOption) {
+            QCC_DbgPrintf(("Tracing enabled, send SIGUSR1 to write the trace to %s", traceFile.c_str()));
+            GatewayTrace::setEnabled(true);
+        }
+        if (arg.compare(0, traceFileOption.size(), traceFileOption) == 0) {
+            traceFile = arg.substr(traceFileOption.size());
+            QCC_DbgPrintf(("Setting traceFile to: %s", traceFile.c_str()));
+        }
+        if (arg.compare(0, recordOption.size(), recordOption) == 0) {
+            recordFile = arg.substr(recordOption.size());
+            QCC_DbgPrintf(("Recording management traffic to: %s", recordFile.c_str()));
+        }
+    }
+
+    if (!recordFile.empty() && !GatewayRecorder::isRecording()) {
+        QStatus recordStatus = GatewayRecorder::start(recordFile);
+        if (recordStatus != ER_OK) {
+            QCC_LogError(recordStatus, ("Could not start recording to %s", recordFile.c_str()));
+        }
     }
 
     QStatus status = prepareBusAttachment();
@@ -298,6 +395,11 @@ start:
         return 1;
     }
 
+    status = gatewayMgmt->startConnectorApps();
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not start the Connector Apps"));
+    }
+
     QCC_DbgPrintf(("Finished initializing Gateway App"));
 
     WaitForSigInt();
@@ -308,5 +410,6 @@ start:
         goto start;
     }
     AllJoynShutdown();
+    delete eventLoop;
     return 0;
 }
@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include "AclAdapter.h"
+#include "ShardedBusObject.h"
 #include "../GatewayConstants.h"
 #include <alljoyn/gateway/GatewayMgmt.h>
 #include <alljoyn/gateway/GatewayMetadataManager.h>
@@ -83,14 +84,20 @@ QStatus AclAdapter::unmarshalMetadata(const MsgArg* metadataArg, std::map<qcc::S
 
 QStatus AclAdapter::unmarshalAcl(Message& msg, qcc::String* aclName, GatewayAclRules* aclRules, std::map<qcc::String, qcc::String>* metadata,
                                  std::map<qcc::String, qcc::String>* customMetadata)
+{
+    const ajn::MsgArg* args = 0;
+    size_t numArgs = 0;
+    ShardedBusObject::GetMethodArgs(msg, numArgs, args);
+    return unmarshalAcl(args, numArgs, aclName, aclRules, metadata, customMetadata);
+}
+
+QStatus AclAdapter::unmarshalAcl(const MsgArg* args, size_t numArgs, qcc::String* aclName, GatewayAclRules* aclRules,
+                                 std::map<qcc::String, qcc::String>* metadata, std::map<qcc::String, qcc::String>* customMetadata)
 {
     if (aclName == 0 || aclRules == 0) {
         return ER_INVALID_DATA;
     }
 
-    const ajn::MsgArg* args = 0;
-    size_t numArgs = 0;
-    msg->GetArgs(numArgs, args);
     if (numArgs != 5) {
         return ER_INVALID_DATA;
     }
@@ -119,9 +126,26 @@ QStatus AclAdapter::unmarshalAcl(Message& msg, qcc::String* aclName, GatewayAclR
     aclRules->setExposedServicesRules(exposedServices);
 
     GatewayRemoteAppRules remoteAppRules;
+    status = unmarshalRemotedApps(&args[argsIndx++], remoteAppRules);
+    if (status != ER_OK) {
+        return status;
+    }
+    aclRules->setRemoteAppRules(remoteAppRules);
+
+    status = unmarshalMetadata(&args[argsIndx++], metadata);
+    if (status != ER_OK) {
+        return status;
+    }
+
+    status = unmarshalMetadata(&args[argsIndx++], customMetadata);
+    return status;
+}
+
+QStatus AclAdapter::unmarshalRemotedApps(const MsgArg* remotedAppsArg, GatewayRemoteAppRules& remoteAppRules)
+{
     MsgArg* remotedAppsArray;
     size_t remotedAppsSize;
-    status = args[argsIndx++].Get(AJPARAM_REMOTED_APPS_ARRAY.c_str(), &remotedAppsSize, &remotedAppsArray);
+    QStatus status = remotedAppsArg->Get(AJPARAM_REMOTED_APPS_ARRAY.c_str(), &remotedAppsSize, &remotedAppsArray);
     if (status != ER_OK) {
         return status;
     }
@@ -152,38 +176,130 @@ QStatus AclAdapter::unmarshalAcl(Message& msg, qcc::String* aclName, GatewayAclR
             remoteAppRules.insert(std::pair<GatewayAppIdentifier, GatewayRuleObjectDescriptions>(appkey, remotedServices));
         }
     }
-    aclRules->setRemoteAppRules(remoteAppRules);
+    return ER_OK;
+}
 
-    status = unmarshalMetadata(&args[argsIndx++], metadata);
+QStatus AclAdapter::unmarshalAclPatch(Message& msg, GatewayAclRulesPatch* patch, std::map<qcc::String, qcc::String>* metadata)
+{
+    if (patch == 0) {
+        return ER_INVALID_DATA;
+    }
+
+    const ajn::MsgArg* args = 0;
+    size_t numArgs = 0;
+    ShardedBusObject::GetMethodArgs(msg, numArgs, args);
+    if (numArgs != 5) {
+        return ER_INVALID_DATA;
+    }
+
+    MsgArg* objectsArray;
+    size_t objectsSize;
+    QStatus status = args[0].Get(AJPARAM_INTERFACE_INFO_ARRAY.c_str(), &objectsSize, &objectsArray);
     if (status != ER_OK) {
         return status;
     }
 
-    status = unmarshalMetadata(&args[argsIndx++], customMetadata);
-    return status;
+    status = unmarshalObjectDesciptions(objectsArray, objectsSize, patch->m_AddedExposedServices);
+    if (status != ER_OK) {
+        return status;
+    }
+
+    status = args[1].Get(AJPARAM_INTERFACE_INFO_ARRAY.c_str(), &objectsSize, &objectsArray);
+    if (status != ER_OK) {
+        return status;
+    }
+
+    status = unmarshalObjectDesciptions(objectsArray, objectsSize, patch->m_RemovedExposedServices);
+    if (status != ER_OK) {
+        return status;
+    }
+
+    status = unmarshalRemotedApps(&args[2], patch->m_AddedRemoteApps);
+    if (status != ER_OK) {
+        return status;
+    }
+
+    status = unmarshalRemotedApps(&args[3], patch->m_RemovedRemoteApps);
+    if (status != ER_OK) {
+        return status;
+    }
+
+    return unmarshalMetadata(&args[4], metadata);
 }
 
-QStatus AclAdapter::marshalObjectDesciptions(const GatewayRuleObjectDescriptions& objects, MsgArg* objectsArray, size_t* objectsIndx)
+QStatus AclAdapter::unmarshalAclBatchOperation(const MsgArg& operationArg, GatewayAclBatchOperation* operation)
+{
+    if (!operation || operationArg.typeId != ALLJOYN_STRUCT || operationArg.v_struct.numMembers != 8) {
+        return ER_INVALID_DATA;
+    }
+
+    const MsgArg* members = operationArg.v_struct.members;
+
+    uint16_t type;
+    QStatus status = members[0].Get(AJPARAM_UINT16.c_str(), &type);
+    if (status != ER_OK) {
+        return status;
+    }
+
+    if (type > GW_BO_MAX_BATCH_OPERATION) {
+        QCC_DbgHLPrintf(("Batch operation type %u is not a valid value", type));
+        return ER_INVALID_DATA;
+    }
+    operation->m_Type = (AclBatchOperationType)type;
+
+    char* connectorId = NULL;
+    status = members[1].Get(AJPARAM_STR.c_str(), &connectorId);
+    if (status != ER_OK) {
+        return status;
+    }
+    operation->m_ConnectorId.assign(connectorId);
+
+    char* aclId = NULL;
+    status = members[2].Get(AJPARAM_STR.c_str(), &aclId);
+    if (status != ER_OK) {
+        return status;
+    }
+    operation->m_AclId.assign(aclId);
+
+    // the acl itself is only read by the operations that write it
+    if (operation->m_Type != GW_BO_CREATE_ACL && operation->m_Type != GW_BO_UPDATE_ACL) {
+        return ER_OK;
+    }
+
+    return unmarshalAcl(&members[3], 5, &operation->m_AclName, &operation->m_AclRules, &operation->m_Metadata, &operation->m_CustomMetadata);
+}
+
+size_t AclAdapter::countObjectDesciptionInterfaces(const GatewayRuleObjectDescriptions& objects)
+{
+    size_t numInterfaces = 0;
+    for (size_t i = 0; i < objects.size(); i++) {
+        numInterfaces += objects[i].getInterfaces().size();
+    }
+    return numInterfaces;
+}
+
+QStatus AclAdapter::marshalObjectDesciptions(const GatewayRuleObjectDescriptions& objects, MsgArg* objectsArray, size_t* objectsIndx,
+                                             GatewayMsgArgArena* arena)
 {
     QStatus status = ER_OK;
 
-    if (!objectsIndx || !objectsArray) {
+    if (!objectsIndx || (!objectsArray && objects.size()) || !arena) {
         return ER_FAIL;
     }
 
     for (size_t i = 0; i < objects.size(); i++) {
 
-        const std::vector<qcc::String>& interfaces = objects[i].getInterfaces();
-        std::vector<const char*> interfacesVector(interfaces.size());
-        std::vector<qcc::String>::const_iterator interfaceIt;
+        const GatewayInternedStrings& interfaces = objects[i].getInterfaces();
+        const char** interfacesArray = arena->allocStrings(interfaces.size());
+        GatewayInternedStrings::const_iterator interfaceIt;
         int interfaceIndex = 0;
 
         for (interfaceIt = interfaces.begin(); interfaceIt != interfaces.end(); ++interfaceIt) {
-            interfacesVector[interfaceIndex++] = interfaceIt->c_str();
+            interfacesArray[interfaceIndex++] = interfaceIt->str().c_str();
         }
 
         status = objectsArray[(*objectsIndx)++].Set(AJPARAM_INTERFACE_INFO.c_str(), objects[i].getObjectPath().c_str(),
-                                                    objects[i].getIsPrefix(), interfaceIndex, interfacesVector.data());
+                                                    objects[i].getIsPrefix(), interfaceIndex, interfacesArray);
         if (status != ER_OK) {
             return status;
         }
@@ -195,7 +311,7 @@ QStatus AclAdapter::marshalMetadata(const std::map<qcc::String, qcc::String>& me
 {
     QStatus status = ER_OK;
 
-    if (!metadataIndx || !metadataArray) {
+    if (!metadataIndx || (!metadataArray && metadata.size())) {
         return ER_FAIL;
     }
 
@@ -211,203 +327,220 @@ QStatus AclAdapter::marshalMetadata(const std::map<qcc::String, qcc::String>& me
     return status;
 }
 
-QStatus AclAdapter::marshalAcl(GatewayAcl* acl, ajn::MsgArg* msgArg)
+QStatus AclAdapter::marshalAcl(GatewayAclSnapshot const& acl, ajn::MsgArg* msgArg, GatewayMsgArgArena* arena)
+{
+    return marshalAcl(acl, GatewayMgmt::getInstance()->getMetadataManager(), msgArg, arena);
+}
+
+QStatus AclAdapter::marshalAcl(GatewayAclSnapshot const& acl, GatewayMetadataManager* metadataManager, ajn::MsgArg* msgArg,
+                               GatewayMsgArgArena* arena)
 {
-    if (acl == 0 || msgArg == 0) {
+    if (msgArg == 0 || arena == 0) {
         return ER_INVALID_DATA;
     }
 
-    GatewayMetadataManager* metadataManager = GatewayMgmt::getInstance()->getMetadataManager();
     if (!metadataManager) {
         QCC_DbgHLPrintf(("metadataManager is NULL"));
         return ER_FAIL;
     }
 
+    const GatewayRuleObjectDescriptions& exposedServices = acl.getAclRules().getExposedServicesRules();
+    const GatewayRemoteAppRules& remoteAppPerm = acl.getAclRules().getRemoteAppRules();
+    const std::map<qcc::String, qcc::String>& customMetadata = acl.getCustomMetadata();
+    GatewayRemoteAppRules::const_iterator it;
+
+    // size the reply in one pass, collecting the metadata of the remote apps on the way
+    std::map<qcc::String, qcc::String> metadata;
+    size_t numArgs = exposedServices.size() + remoteAppPerm.size();
+    size_t numStrings = countObjectDesciptionInterfaces(exposedServices);
+    for (it = remoteAppPerm.begin(); it != remoteAppPerm.end(); it++) {
+        metadataManager->addMetadataValues(it->first, &metadata);
+        numArgs += it->second.size();
+        numStrings += countObjectDesciptionInterfaces(it->second);
+    }
+    numArgs += metadata.size() + customMetadata.size();
+    arena->reserve(numArgs, numStrings);
+
     QStatus status = ER_OK;
     size_t indx = 0;
 
-    status = msgArg[indx++].Set(AJPARAM_STR.c_str(), acl->getAclName().c_str());
+    status = msgArg[indx++].Set(AJPARAM_STR.c_str(), acl.getAclName().c_str());
     if (status != ER_OK) {
         return status;
     }
 
-    const GatewayRuleObjectDescriptions& exposedServices = acl->getAclRules().getExposedServicesRules();
-    MsgArg* exposedServicesArray = new MsgArg[exposedServices.size()];
+    MsgArg* exposedServicesArray = arena->allocArgs(exposedServices.size());
     size_t exposedServicesIndx = 0;
 
-    status = marshalObjectDesciptions(exposedServices, exposedServicesArray, &exposedServicesIndx);
+    status = marshalObjectDesciptions(exposedServices, exposedServicesArray, &exposedServicesIndx, arena);
     if (status != ER_OK) {
-        delete[] exposedServicesArray;
         return status;
     }
 
-    status = msgArg[indx].Set(AJPARAM_INTERFACE_INFO_ARRAY.c_str(), exposedServicesIndx, exposedServicesArray);
+    status = msgArg[indx++].Set(AJPARAM_INTERFACE_INFO_ARRAY.c_str(), exposedServicesIndx, exposedServicesArray);
     if (status != ER_OK) {
-        delete[] exposedServicesArray;
         return status;
     }
-    msgArg[indx++].SetOwnershipFlags(MsgArg::OwnsArgs, true);
 
-    const GatewayRemoteAppRules& remoteAppPerm = acl->getAclRules().getRemoteAppRules();
-    GatewayRemoteAppRules::const_iterator it;
-
-    MsgArg* remoteAppPermsArray = new MsgArg[remoteAppPerm.size()];
+    MsgArg* remoteAppPermsArray = arena->allocArgs(remoteAppPerm.size());
     size_t remoteAppPermsIndx = 0;
 
-    std::map<qcc::String, qcc::String> metadata;
-
     for (it = remoteAppPerm.begin(); it != remoteAppPerm.end(); it++) {
 
-        //add metadata values for this remoteApp to map
-        metadataManager->addMetadataValues(it->first, &metadata);
-
-        MsgArg* remotedObjectsArray = new MsgArg[it->second.size()];
+        MsgArg* remotedObjectsArray = arena->allocArgs(it->second.size());
         size_t remotedObjectsIndx = 0;
-        status = marshalObjectDesciptions(it->second, remotedObjectsArray, &remotedObjectsIndx);
+        status = marshalObjectDesciptions(it->second, remotedObjectsArray, &remotedObjectsIndx, arena);
         if (status != ER_OK) {
-            delete[] remotedObjectsArray;
-            delete[] remoteAppPermsArray;
             return status;
         }
 
-        status = remoteAppPermsArray[remoteAppPermsIndx].Set(AJPARAM_REMOTED_APPS.c_str(), it->first.getDeviceId().c_str(),
-                                                             it->first.getAppIdHexLength(), it->first.getAppIdHex(),
-                                                             remotedObjectsIndx, remotedObjectsArray);
+        status = remoteAppPermsArray[remoteAppPermsIndx++].Set(AJPARAM_REMOTED_APPS.c_str(), it->first.getDeviceId().c_str(),
+                                                               it->first.getAppIdHexLength(), it->first.getAppIdHex(),
+                                                               remotedObjectsIndx, remotedObjectsArray);
         if (status != ER_OK) {
-            delete[] remotedObjectsArray;
-            delete[] remoteAppPermsArray;
             return status;
         }
-        remoteAppPermsArray[remoteAppPermsIndx++].SetOwnershipFlags(MsgArg::OwnsArgs, true);
     }
-    status = msgArg[indx].Set(AJPARAM_REMOTED_APPS_ARRAY.c_str(), remoteAppPermsIndx, remoteAppPermsArray);
+    status = msgArg[indx++].Set(AJPARAM_REMOTED_APPS_ARRAY.c_str(), remoteAppPermsIndx, remoteAppPermsArray);
     if (status != ER_OK) {
-        delete[] remoteAppPermsArray;
         return status;
     }
-    msgArg[indx++].SetOwnershipFlags(MsgArg::OwnsArgs, true);
 
-    MsgArg* metadataArray = new MsgArg[metadata.size()];
+    MsgArg* metadataArray = arena->allocArgs(metadata.size());
     size_t metadataIndx = 0;
 
     status = marshalMetadata(metadata, metadataArray, &metadataIndx);
     if (status != ER_OK) {
-        delete[] metadataArray;
         return status;
     }
 
-    status = msgArg[indx].Set(AJPARAM_ACL_METADATA_ARRAY.c_str(), metadataIndx, metadataArray);
+    status = msgArg[indx++].Set(AJPARAM_ACL_METADATA_ARRAY.c_str(), metadataIndx, metadataArray);
     if (status != ER_OK) {
-        delete[] metadataArray;
         return status;
     }
-    msgArg[indx++].SetOwnershipFlags(MsgArg::OwnsArgs, true);
 
-    const std::map<qcc::String, qcc::String>& customMetadata = acl->getCustomMetadata();
-    MsgArg* customMetadataArray = new MsgArg[customMetadata.size()];
+    MsgArg* customMetadataArray = arena->allocArgs(customMetadata.size());
     size_t customMetadataIndx = 0;
 
     status = marshalMetadata(customMetadata, customMetadataArray, &customMetadataIndx);
     if (status != ER_OK) {
-        delete[] customMetadataArray;
         return status;
     }
 
-    status = msgArg[indx].Set(AJPARAM_ACL_METADATA_ARRAY.c_str(), customMetadataIndx, customMetadataArray);
+    status = msgArg[indx++].Set(AJPARAM_ACL_METADATA_ARRAY.c_str(), customMetadataIndx, customMetadataArray);
+    return status;
+}
+
+QStatus AclAdapter::marshalMergedAcl(GatewayAclSet const& aclSet, ajn::MsgArg* msgArg, GatewayMsgArgArena* arena)
+{
+    if (msgArg == 0 || arena == 0) {
+        return ER_INVALID_DATA;
+    }
+
+    const GatewayAclRules& mergedRules = aclSet.getMergedRules();
+    size_t numArgs = 0;
+    size_t numStrings = 0;
+    countRules(mergedRules.getExposedServicesRules(), mergedRules.getRemoteAppRules(), &numArgs, &numStrings);
+    arena->reserve(numArgs, numStrings);
+
+    QStatus status = marshalExposedServices(mergedRules.getExposedServicesRules(), &msgArg[0], arena);
     if (status != ER_OK) {
-        delete[] customMetadataArray;
         return status;
     }
-    msgArg[indx++].SetOwnershipFlags(MsgArg::OwnsArgs, true);
 
+    status = marshalRemotedApps(mergedRules.getRemoteAppRules(), &msgArg[1], arena);
     return status;
 }
 
-QStatus AclAdapter::marshalMergedAcl(std::map<qcc::String, GatewayAcl*> const& acls, ajn::MsgArg* msgArg)
+QStatus AclAdapter::marshalMergedAclUpdate(uint32_t mergeSequence, GatewayAclRulesPatch const& delta, ajn::MsgArg* msgArg,
+                                           GatewayMsgArgArena* arena)
 {
-    QStatus status = ER_OK;
-    size_t exposedServicesSize = 0;
-    size_t remotedAppsSize = 0;
-    std::map<qcc::String, GatewayAcl*>::const_iterator it;
-    for (it = acls.begin(); it != acls.end(); it++) {
-
-        if (it->second->getAclStatus() != GW_AS_ACTIVE) {
-            continue;
-        }
-        exposedServicesSize += it->second->getAclRules().getExposedServicesRules().size();
-        remotedAppsSize += it->second->getAclRules().getRemoteAppRules().size();
+    if (msgArg == 0 || arena == 0) {
+        return ER_INVALID_DATA;
     }
 
-    MsgArg* exposedServicesArray = new MsgArg[exposedServicesSize];
-    size_t exposedServicesIndx = 0;
-    MsgArg* remoteAppPermsArray = new MsgArg[remotedAppsSize];
-    size_t remoteAppPermsIndx = 0;
-
-    for (it = acls.begin(); it != acls.end(); it++) {
+    size_t numArgs = 0;
+    size_t numStrings = 0;
+    countRules(delta.m_AddedExposedServices, delta.m_AddedRemoteApps, &numArgs, &numStrings);
+    countRules(delta.m_RemovedExposedServices, delta.m_RemovedRemoteApps, &numArgs, &numStrings);
+    arena->reserve(numArgs, numStrings);
 
-        if (it->second->getAclStatus() != GW_AS_ACTIVE) {
-            continue;
-        }
+    QStatus status = msgArg[0].Set(AJPARAM_UINT32.c_str(), mergeSequence);
+    if (status != ER_OK) {
+        return status;
+    }
 
-        const GatewayRuleObjectDescriptions& exposedServices = it->second->getAclRules().getExposedServicesRules();
-        status = marshalObjectDesciptions(exposedServices, exposedServicesArray, &exposedServicesIndx);
-        if (status != ER_OK) {
-            delete[] exposedServicesArray;
-            delete[] remoteAppPermsArray;
-            return status;
-        }
+    status = marshalExposedServices(delta.m_AddedExposedServices, &msgArg[1], arena);
+    if (status != ER_OK) {
+        return status;
+    }
 
-        const GatewayRemoteAppRules& remoteAppRules = it->second->getAclRules().getRemoteAppRules();
-        GatewayRemoteAppRules::const_iterator iter;
+    status = marshalExposedServices(delta.m_RemovedExposedServices, &msgArg[2], arena);
+    if (status != ER_OK) {
+        return status;
+    }
 
-        for (iter = remoteAppRules.begin(); iter != remoteAppRules.end(); iter++) {
+    status = marshalRemotedApps(delta.m_AddedRemoteApps, &msgArg[3], arena);
+    if (status != ER_OK) {
+        return status;
+    }
 
-            if (status != ER_OK) {
-                delete[] exposedServicesArray;
-                delete[] remoteAppPermsArray;
-                return status;
-            }
+    status = marshalRemotedApps(delta.m_RemovedRemoteApps, &msgArg[4], arena);
+    return status;
+}
 
-            MsgArg* remotedObjectsArray = new MsgArg[iter->second.size()];
-            size_t remotedObjectsIndx = 0;
-            status = marshalObjectDesciptions(iter->second, remotedObjectsArray, &remotedObjectsIndx);
-            if (status != ER_OK) {
-                delete[] exposedServicesArray;
-                delete[] remoteAppPermsArray;
-                delete[] remotedObjectsArray;
-                return status;
-            }
+void AclAdapter::countRules(const GatewayRuleObjectDescriptions& exposedServices, const GatewayRemoteAppRules& remoteAppRules,
+                            size_t* numArgs, size_t* numStrings)
+{
+    *numArgs += exposedServices.size() + remoteAppRules.size();
+    *numStrings += countObjectDesciptionInterfaces(exposedServices);
 
-            status = remoteAppPermsArray[remoteAppPermsIndx].Set(AJPARAM_REMOTED_APPS.c_str(), iter->first.getDeviceId().c_str(),
-                                                                 iter->first.getAppIdHexLength(), iter->first.getAppIdHex(),
-                                                                 remotedObjectsIndx, remotedObjectsArray);
-            if (status != ER_OK) {
-                delete[] exposedServicesArray;
-                delete[] remoteAppPermsArray;
-                delete[] remotedObjectsArray;
-                return status;
-            }
-            remoteAppPermsArray[remoteAppPermsIndx++].SetOwnershipFlags(MsgArg::OwnsArgs, true);
-        }
+    GatewayRemoteAppRules::const_iterator iter;
+    for (iter = remoteAppRules.begin(); iter != remoteAppRules.end(); iter++) {
+        *numArgs += iter->second.size();
+        *numStrings += countObjectDesciptionInterfaces(iter->second);
     }
+}
 
-    status = msgArg[0].Set(AJPARAM_INTERFACE_INFO_ARRAY.c_str(), exposedServicesIndx, exposedServicesArray);
+QStatus AclAdapter::marshalExposedServices(const GatewayRuleObjectDescriptions& exposedServices, ajn::MsgArg* msgArg,
+                                           GatewayMsgArgArena* arena)
+{
+    MsgArg* exposedServicesArray = arena->allocArgs(exposedServices.size());
+    size_t exposedServicesIndx = 0;
+    QStatus status = marshalObjectDesciptions(exposedServices, exposedServicesArray, &exposedServicesIndx, arena);
     if (status != ER_OK) {
-        delete[] exposedServicesArray;
-        delete[] remoteAppPermsArray;
         return status;
     }
 
-    status = msgArg[1].Set(AJPARAM_REMOTED_APPS_ARRAY.c_str(), remoteAppPermsIndx, remoteAppPermsArray);
-    if (status != ER_OK) {
-        delete[] exposedServicesArray;
-        delete[] remoteAppPermsArray;
-        return status;
-    }
+    status = msgArg->Set(AJPARAM_INTERFACE_INFO_ARRAY.c_str(), exposedServicesIndx, exposedServicesArray);
+    return status;
+}
+
+QStatus AclAdapter::marshalRemotedApps(const GatewayRemoteAppRules& remoteAppRules, ajn::MsgArg* msgArg, GatewayMsgArgArena* arena)
+{
+    QStatus status = ER_OK;
+    MsgArg* remoteAppPermsArray = arena->allocArgs(remoteAppRules.size());
+    size_t remoteAppPermsIndx = 0;
 
-    msgArg[0].SetOwnershipFlags(MsgArg::OwnsArgs, true);
-    msgArg[1].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+    GatewayRemoteAppRules::const_iterator iter;
+    for (iter = remoteAppRules.begin(); iter != remoteAppRules.end(); iter++) {
+
+        MsgArg* remotedObjectsArray = arena->allocArgs(iter->second.size());
+        size_t remotedObjectsIndx = 0;
+        status = marshalObjectDesciptions(iter->second, remotedObjectsArray, &remotedObjectsIndx, arena);
+        if (status != ER_OK) {
+            return status;
+        }
+
+        status = remoteAppPermsArray[remoteAppPermsIndx++].Set(AJPARAM_REMOTED_APPS.c_str(), iter->first.getDeviceId().c_str(),
+                                                               iter->first.getAppIdHexLength(), iter->first.getAppIdHex(),
+                                                               remotedObjectsIndx, remotedObjectsArray);
+        if (status != ER_OK) {
+            return status;
+        }
+    }
 
+    status = msgArg->Set(AJPARAM_REMOTED_APPS_ARRAY.c_str(), remoteAppPermsIndx, remoteAppPermsArray);
     return status;
 }
 
@@ -20,6 +20,10 @@
 #include <alljoyn/about/AnnounceHandler.h>
 #include <alljoyn/gateway/GatewayAclRules.h>
 #include <alljoyn/gateway/GatewayAcl.h>
+#include <alljoyn/gateway/GatewayAclBatchOperation.h>
+#include <alljoyn/gateway/GatewayAclSnapshot.h>
+#include <alljoyn/gateway/GatewayMetadataManager.h>
+#include <alljoyn/gateway/GatewayMsgArgArena.h>
 
 namespace ajn {
 namespace gw {
@@ -53,6 +57,44 @@ class AclAdapter {
     static QStatus unmarshalAcl(Message& msg, qcc::String* aclName, GatewayAclRules* aclRules, std::map<qcc::String, qcc::String>* metadata,
                                 std::map<qcc::String, qcc::String>* customMetadata);
 
+    /**
+     * UnmarshalAcl - static function to unmarshal an acl from its args
+     * @param args - the aclName, exposedServices, remotedApps, metadata and customMetadata args
+     * @param numArgs - the number of args
+     * @param aclName - the aclName of the Acl
+     * @param aclRules - the rules of the Acl
+     * @param metadata - the metadata of the Acl
+     * @param customMetadata - the customMetadata of the Acl
+     * @return status - success/failure
+     */
+    static QStatus unmarshalAcl(const MsgArg* args, size_t numArgs, qcc::String* aclName, GatewayAclRules* aclRules,
+                                std::map<qcc::String, qcc::String>* metadata, std::map<qcc::String, qcc::String>* customMetadata);
+
+    /**
+     * Unmarshal the remoted apps of an acl
+     * @param remotedAppsArg - the arg containing the remoted apps
+     * @param remoteAppRules - the remoteAppRules to fill
+     * @return status - success/failure
+     */
+    static QStatus unmarshalRemotedApps(const MsgArg* remotedAppsArg, GatewayRemoteAppRules& remoteAppRules);
+
+    /**
+     * Unmarshal a PatchAcl method call
+     * @param msg - message to unmarshal
+     * @param patch - the patch to fill
+     * @param metadata - the metadata to fill
+     * @return status - success/failure
+     */
+    static QStatus unmarshalAclPatch(Message& msg, GatewayAclRulesPatch* patch, std::map<qcc::String, qcc::String>* metadata);
+
+    /**
+     * Unmarshal one operation of a BatchUpdate call
+     * @param operationArg - the arg containing the operation
+     * @param operation - the operation to fill
+     * @return status - success/failure
+     */
+    static QStatus unmarshalAclBatchOperation(const MsgArg& operationArg, GatewayAclBatchOperation* operation);
+
     /**
      * Unmarshal an ObjectDescription from the message
      * @param objDescArgs - the msgArgArray containing the objectDescription
@@ -72,28 +114,91 @@ class AclAdapter {
 
     /**
      * MarshalAcl - static function to marshal an acl
-     * @param acl - the acl to marshal
+     * @param acl - snapshot of the acl to marshal
+     * @param msgArg - the messageArg to put it into
+     * @param arena - arena holding the arrays of the msgArg. Must outlive the msgArg
+     * @return status - success/failure
+     */
+    static QStatus marshalAcl(GatewayAclSnapshot const& acl, ajn::MsgArg* msgArg, GatewayMsgArgArena* arena);
+
+    /**
+     * MarshalAcl - static function to marshal an acl with the metadata of the given manager
+     * @param acl - snapshot of the acl to marshal
+     * @param metadataManager - the manager holding the metadata of the remote apps
      * @param msgArg - the messageArg to put it into
+     * @param arena - arena holding the arrays of the msgArg. Must outlive the msgArg
+     * @return status - success/failure
+     */
+    static QStatus marshalAcl(GatewayAclSnapshot const& acl, GatewayMetadataManager* metadataManager, ajn::MsgArg* msgArg,
+                              GatewayMsgArgArena* arena);
+
+    /**
+     * MarshalMergedAcl - marshal the merged rules of all the active acls
+     * @param aclSet - snapshot of the acls to marshal the merged rules of
+     * @param msgArg - exposedServices and remotedApps args to fill
+     * @param arena - arena holding the arrays of the msgArg. Must outlive the msgArg
+     * @return status - success/failure
+     */
+    static QStatus marshalMergedAcl(GatewayAclSet const& aclSet, ajn::MsgArg* msgArg, GatewayMsgArgArena* arena);
+
+    /**
+     * MarshalMergedAclUpdate - marshal the args of the MergedAclUpdated signal
+     * @param mergeSequence - merge sequence the delta leads to
+     * @param delta - the delta from the previous merge sequence
+     * @param msgArg - mergeSequence, addedExposedServices, removedExposedServices,
+     * addedRemotedApps and removedRemotedApps args to fill
+     * @param arena - arena holding the arrays of the msgArg. Must outlive the msgArg
      * @return status - success/failure
      */
-    static QStatus marshalAcl(GatewayAcl* acl, ajn::MsgArg* msgArg);
+    static QStatus marshalMergedAclUpdate(uint32_t mergeSequence, GatewayAclRulesPatch const& delta, ajn::MsgArg* msgArg,
+                                          GatewayMsgArgArena* arena);
+
+    /**
+     * Count the MsgArgs and interfaces needed to marshal rules, used to size the arena
+     * @param exposedServices - the exposed services to count
+     * @param remoteAppRules - the remoted apps to count
+     * @param numArgs - number of MsgArgs, added to
+     * @param numStrings - number of interfaces, added to
+     */
+    static void countRules(const GatewayRuleObjectDescriptions& exposedServices, const GatewayRemoteAppRules& remoteAppRules,
+                           size_t* numArgs, size_t* numStrings);
 
     /**
-     * MarshalMergedAcl - marshal a combination of all the active acls
-     * @param acls - array of acls to possibly marshal
-     * @param msgArg - msgArg to fill
+     * Marshal exposed services into an array arg
+     * @param exposedServices - the exposed services to marshal
+     * @param msgArg - the arg to fill
+     * @param arena - arena for the arrays of the msgArg
      * @return status - success/failure
      */
-    static QStatus marshalMergedAcl(std::map<qcc::String, GatewayAcl*> const& acls, ajn::MsgArg* msgArg);
+    static QStatus marshalExposedServices(const GatewayRuleObjectDescriptions& exposedServices, ajn::MsgArg* msgArg,
+                                          GatewayMsgArgArena* arena);
+
+    /**
+     * Marshal remoted apps into an array arg
+     * @param remoteAppRules - the remoted apps to marshal
+     * @param msgArg - the arg to fill
+     * @param arena - arena for the arrays of the msgArg
+     * @return status - success/failure
+     */
+    static QStatus marshalRemotedApps(const GatewayRemoteAppRules& remoteAppRules, ajn::MsgArg* msgArg, GatewayMsgArgArena* arena);
+
+    /**
+     * Count the interfaces of objectDescriptions, used to size the arena
+     * @param objects - the objects to count
+     * @return numInterfaces
+     */
+    static size_t countObjectDesciptionInterfaces(const GatewayRuleObjectDescriptions& objects);
 
     /**
      * MarshalObjectDescriptions - a static function to marshal objectDescriptions
      * @param objects - the objects to marshal
      * @param objectsArray - the array to marshal it into
      * @param objectsIndx - the index in the array to start marshaling into
+     * @param arena - arena for the interface name arrays
      * @return status - success/failure
      */
-    static QStatus marshalObjectDesciptions(const GatewayRuleObjectDescriptions& objects, MsgArg* objectsArray, size_t* objectsIndx);
+    static QStatus marshalObjectDesciptions(const GatewayRuleObjectDescriptions& objects, MsgArg* objectsArray, size_t* objectsIndx,
+                                            GatewayMsgArgArena* arena);
 
     /**
      * marshalMetadata - static function to Marshal the Metadata Array
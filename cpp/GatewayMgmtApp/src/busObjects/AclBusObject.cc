@@ -17,6 +17,7 @@
 #include "AclBusObject.h"
 #include "../GatewayConstants.h"
 #include "AclAdapter.h"
+#include <alljoyn/gateway/GatewayConnectorApp.h>
 #include <alljoyn/gateway/GatewayMgmt.h>
 
 namespace ajn {
@@ -26,7 +27,7 @@ using namespace services;
 using namespace gwConsts;
 
 AclBusObject::AclBusObject(BusAttachment* bus, GatewayAcl* acl, String const& objectPath, QStatus* status) :
-    BusObject(objectPath.c_str()), m_Acl(acl), m_ObjectPath(objectPath)
+    ShardedBusObject(objectPath), m_Acl(acl), m_ObjectPath(objectPath)
 {
     InterfaceDescription* interfaceDescription = (InterfaceDescription*) bus->GetInterface(AJ_GW_ACL_INTERFACE.c_str());
     if (!interfaceDescription) {
@@ -73,6 +74,11 @@ AclBusObject::AclBusObject(BusAttachment* bus, GatewayAcl* acl, String const& ob
         if (*status != ER_OK) {
             goto postCreate;
         }
+        *status = interfaceDescription->AddMethod(AJ_METHOD_PATCH_ACL.c_str(), AJ_PATCH_ACL_PARAMS_IN.c_str(),
+                                                  AJ_PATCH_ACL_PARAMS_OUT.c_str(), AJ_PATCH_ACL_PARAM_NAMES.c_str());
+        if (*status != ER_OK) {
+            goto postCreate;
+        }
         interfaceDescription->Activate();
     }
 
@@ -89,12 +95,13 @@ postCreate:
     }
 
     const ajn::InterfaceDescription::Member* methodMember = interfaceDescription->GetMember(AJ_METHOD_ACTIVATE_ACL.c_str());
-    *status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AclBusObject::ActivateAcl));
+    *status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AclBusObject::ActivateAcl));
     if (*status != ER_OK) {
         QCC_LogError(*status, ("Could not register the ActivateAcl MethodHandler"));
         return;
     }
 
+    // read-only methods are served from the Acl snapshot without going through the task queue
     methodMember = interfaceDescription->GetMember(AJ_METHOD_GET_ACL.c_str());
     *status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AclBusObject::GetAcl));
     if (*status != ER_OK) {
@@ -110,28 +117,35 @@ postCreate:
     }
 
     methodMember = interfaceDescription->GetMember(AJ_METHOD_UPDATE_ACL.c_str());
-    *status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AclBusObject::UpdateAcl));
+    *status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AclBusObject::UpdateAcl));
     if (*status != ER_OK) {
         QCC_LogError(*status, ("Could not register the UpdateAcl MethodHandler"));
         return;
     }
 
+    methodMember = interfaceDescription->GetMember(AJ_METHOD_PATCH_ACL.c_str());
+    *status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AclBusObject::PatchAcl));
+    if (*status != ER_OK) {
+        QCC_LogError(*status, ("Could not register the PatchAcl MethodHandler"));
+        return;
+    }
+
     methodMember = interfaceDescription->GetMember(AJ_METHOD_UPDATE_METADATA.c_str());
-    *status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AclBusObject::UpdateMetadata));
+    *status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AclBusObject::UpdateMetadata));
     if (*status != ER_OK) {
         QCC_LogError(*status, ("Could not register the UpdateMetadata MethodHandler"));
         return;
     }
 
     methodMember = interfaceDescription->GetMember(AJ_METHOD_UPDATE_CUSTOM_METADATA.c_str());
-    *status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AclBusObject::UpdateCustomMetadata));
+    *status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AclBusObject::UpdateCustomMetadata));
     if (*status != ER_OK) {
         QCC_LogError(*status, ("Could not register the UpdateCustomMetadata MethodHandler"));
         return;
     }
 
     methodMember = interfaceDescription->GetMember(AJ_METHOD_DEACTIVATE_ACL.c_str());
-    *status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AclBusObject::DeactivateAcl));
+    *status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AclBusObject::DeactivateAcl));
     if (*status != ER_OK) {
         QCC_LogError(*status, ("Could not register the DeactivateAcl MethodHandler"));
         return;
@@ -144,6 +158,11 @@ AclBusObject::~AclBusObject()
 {
 }
 
+GatewayConnectorApp* AclBusObject::getShardOwner() const
+{
+    return m_Acl->getConnectorApp();
+}
+
 QStatus AclBusObject::Get(const char* interfaceName, const char* propName, MsgArg& val)
 {
     QCC_DbgTrace(("Get property was called in GatewayAclBusObject class:"));
@@ -182,8 +201,18 @@ void AclBusObject::GetAcl(const InterfaceDescription::Member* member, Message& m
 {
     QCC_DbgTrace(("Received GetAcl method call"));
 
+    GatewayRef<GatewayAclSet> aclSet = m_Acl->getConnectorApp()->getAclSnapshot();
+    const GatewayAclSnapshot* acl = aclSet->findAcl(m_Acl->getAclId());
+    if (!acl) {
+        QCC_DbgHLPrintf(("Acl is being deleted - responding with error"));
+        MethodReply(msg, ER_BUS_NO_SUCH_OBJECT);
+        return;
+    }
+
+    // the arena is declared first so it is released after the reply args
+    GatewayMsgArgArena arena;
     ajn::MsgArg replyArg[5];
-    QStatus status = AclAdapter::marshalAcl(m_Acl, replyArg);
+    QStatus status = AclAdapter::marshalAcl(*acl, replyArg, &arena);
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not marshal Acl for GetAcl method"));
         MethodReply(msg, status);
@@ -200,8 +229,16 @@ void AclBusObject::GetAclStatus(const InterfaceDescription::Member* member, Mess
 {
     QCC_DbgTrace(("Received GetAclStatus method call"));
 
+    GatewayRef<GatewayAclSet> aclSet = m_Acl->getConnectorApp()->getAclSnapshot();
+    const GatewayAclSnapshot* acl = aclSet->findAcl(m_Acl->getAclId());
+    if (!acl) {
+        QCC_DbgHLPrintf(("Acl is being deleted - responding with error"));
+        MethodReply(msg, ER_BUS_NO_SUCH_OBJECT);
+        return;
+    }
+
     ajn::MsgArg replyArg[1];
-    QStatus status = replyArg[0].Set(AJPARAM_UINT16.c_str(), m_Acl->getAclStatus());
+    QStatus status = replyArg[0].Set(AJPARAM_UINT16.c_str(), acl->getAclStatus());
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not marshal response for GetAclStatus method"));
         MethodReply(msg, status);
@@ -245,13 +282,42 @@ void AclBusObject::UpdateAcl(const InterfaceDescription::Member* member, Message
     }
 }
 
+void AclBusObject::PatchAcl(const InterfaceDescription::Member* member, Message& msg)
+{
+    QCC_DbgTrace(("Received PatchAcl method call"));
+
+    GatewayAclRulesPatch patch;
+    std::map<qcc::String, qcc::String> metadata;
+    QStatus status = AclAdapter::unmarshalAclPatch(msg, &patch, &metadata);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not unmarshal PatchAcl method call"));
+        MethodReply(msg, status);
+        return;
+    }
+
+    uint16_t responseCode = m_Acl->patchAcl(patch, metadata);
+
+    ajn::MsgArg replyArg[1];
+    status = replyArg[0].Set(AJPARAM_UINT16.c_str(), responseCode);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not marshal responseCode for PatchAcl method"));
+        MethodReply(msg, status);
+        return;
+    }
+
+    status = MethodReply(msg, replyArg, 1);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("PatchAcl reply call failed"));
+    }
+}
+
 void AclBusObject::UpdateMetadata(const InterfaceDescription::Member* member, Message& msg)
 {
     QCC_DbgTrace(("Received UpdateMetadata method call"));
 
     const ajn::MsgArg* args = 0;
     size_t numArgs = 0;
-    msg->GetArgs(numArgs, args);
+    ShardedBusObject::GetMethodArgs(msg, numArgs, args);
     if (numArgs < 1) {
         QCC_DbgHLPrintf(("Could not UpdateMetadata"));
         return;
@@ -287,7 +353,7 @@ void AclBusObject::UpdateCustomMetadata(const InterfaceDescription::Member* memb
 
     const ajn::MsgArg* args = 0;
     size_t numArgs = 0;
-    msg->GetArgs(numArgs, args);
+    ShardedBusObject::GetMethodArgs(msg, numArgs, args);
     if (numArgs < 1) {
         QCC_DbgHLPrintf(("Could not UpdateCustomMetadata"));
         return;
@@ -19,6 +19,7 @@
 
 #include <alljoyn/BusAttachment.h>
 #include <alljoyn/BusObject.h>
+#include "ShardedBusObject.h"
 #include <alljoyn/InterfaceDescription.h>
 #include <alljoyn/gateway/GatewayAcl.h>
 
@@ -28,7 +29,7 @@ namespace gw {
 /**
  * AclBusObject - BusObject for Acls
  */
-class AclBusObject : public BusObject  {
+class AclBusObject : public ShardedBusObject  {
   public:
 
     /**
@@ -52,14 +53,16 @@ class AclBusObject : public BusObject  {
     void ActivateAcl(const InterfaceDescription::Member* member, Message& msg);
 
     /**
-     * Callback for the GetAcl method
+     * Callback for the GetAcl method. Served from the Acl snapshot
+     * of the Connector App, not on its task queue
      * @param member - the member called
      * @param msg - the message of the method
      */
     void GetAcl(const InterfaceDescription::Member* member, Message& msg);
 
     /**
-     * Callback for the GetAclStatus method
+     * Callback for the GetAclStatus method. Served from the Acl snapshot
+     * of the Connector App, not on its task queue
      * @param member - the member called
      * @param msg - the message of the method
      */
@@ -72,6 +75,14 @@ class AclBusObject : public BusObject  {
      */
     void UpdateAcl(const InterfaceDescription::Member* member, Message& msg);
 
+    /**
+     * Callback for the PatchAcl method. Adds and removes single remoted apps,
+     * objects or interfaces instead of replacing all rules
+     * @param member - the member called
+     * @param msg - the message of the method
+     */
+    void PatchAcl(const InterfaceDescription::Member* member, Message& msg);
+
     /**
      * Callback for the UpdateMetadata method
      * @param member - the member called
@@ -93,6 +104,12 @@ class AclBusObject : public BusObject  {
      */
     void DeactivateAcl(const InterfaceDescription::Member* member, Message& msg);
 
+    /**
+     * Get the Connector App whose task queue executes the method calls
+     * @return connectorApp
+     */
+    GatewayConnectorApp* getShardOwner() const;
+
     /**
      * Get Property
      * @param interfaceName - name of the interface
@@ -17,7 +17,10 @@
 #include "AppBusObject.h"
 #include "../GatewayConstants.h"
 #include "AclAdapter.h"
+#include "PageRequest.h"
+#include <alljoyn/gateway/GatewayEventLoop.h>
 #include <alljoyn/gateway/GatewayMgmt.h>
+#include <algorithm>
 
 namespace ajn {
 namespace gw {
@@ -25,9 +28,51 @@ using namespace services;
 using namespace qcc;
 using namespace gwConsts;
 
+/**
+ * Sends the coalesced AppStatusChanged signal on the task queue of the App
+ */
+class AppStatusChangedTask : public GatewayTask {
+  public:
+
+    AppStatusChangedTask(AppBusObject* appBusObject) : m_AppBusObject(appBusObject) { }
+
+    void run()
+    {
+        QStatus status = m_AppBusObject->FlushAppStatusChangedSignal();
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Could not send AppStatusChangedSignal"));
+        }
+    }
+
+  private:
+
+    AppBusObject* m_AppBusObject;
+};
+
+/**
+ * Timer of the event loop ending the coalescing window. The signal itself is
+ * sent on the task queue of the App, which owns the state of the App
+ */
+class AppStatusChangedTimerTask : public GatewayTask {
+  public:
+
+    AppStatusChangedTimerTask(AppBusObject* appBusObject, GatewayTaskQueue* taskQueue) : m_AppBusObject(appBusObject), m_TaskQueue(taskQueue) { }
+
+    void run()
+    {
+        m_TaskQueue->post(new AppStatusChangedTask(m_AppBusObject));
+    }
+
+  private:
+
+    AppBusObject* m_AppBusObject;
+
+    GatewayTaskQueue* m_TaskQueue;
+};
+
 AppBusObject::AppBusObject(BusAttachment* bus, GatewayConnectorApp* connectorApp, String const& objectPath, QStatus* status) :
-    BusObject(objectPath.c_str()), m_ConnectorApp(connectorApp), m_ObjectPath(objectPath), m_AppStatusChanged(NULL),
-    m_AclUpdated(NULL), m_ShutdownApp(NULL)
+    ShardedBusObject(objectPath), m_ConnectorApp(connectorApp), m_ObjectPath(objectPath), m_AppStatusChanged(NULL),
+    m_AclUpdated(NULL), m_ShutdownApp(NULL), m_AppStatusChangedPending(false), m_AppStatusChangedTimerId(0)
 {
     *status = createAppInterface(bus);
     if (*status != ER_OK) {
@@ -84,6 +129,11 @@ QStatus AppBusObject::createAppInterface(BusAttachment* bus)
         if (status != ER_OK) {
             goto postCreate;
         }
+        status = interfaceDescription->AddMethod(AJ_METHOD_GET_APP_RESOURCE_USAGE.c_str(), AJ_GET_APP_RESOURCE_USAGE_PARAMS_IN.c_str(),
+                                                 AJ_GET_APP_RESOURCE_USAGE_PARAMS_OUT.c_str(), AJ_GET_APP_RESOURCE_USAGE_PARAM_NAMES.c_str());
+        if (status != ER_OK) {
+            goto postCreate;
+        }
         status = interfaceDescription->AddSignal(AJ_SIGNAL_APP_STATUS_CHANGED.c_str(), AJ_APP_STATUS_CHANGED_PARAMS.c_str(), AJ_APP_STATUS_CHANGED_PARAM_NAMES.c_str());
         if (status != ER_OK) {
             goto postCreate;
@@ -104,19 +154,20 @@ postCreate:
     }
 
     const ajn::InterfaceDescription::Member* methodMember = interfaceDescription->GetMember(AJ_METHOD_GET_APP_STATUS.c_str());
-    status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::GetAppStatus));
+    status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::GetAppStatus));
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not register the GetAppStatus MethodHandler"));
         return status;
     }
 
     methodMember = interfaceDescription->GetMember(AJ_METHOD_RESTART_APP.c_str());
-    status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::RestartApp));
+    status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::RestartApp));
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not register the RestartApp MethodHandler"));
         return status;
     }
 
+    // GetManifestFile and GetManifestInterfaces are served from the replies built when the Manifest was loaded
     methodMember = interfaceDescription->GetMember(AJ_METHOD_GET_MANIFEST_FILE.c_str());
     status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::GetManifestFile));
     if (status != ER_OK) {
@@ -131,6 +182,13 @@ postCreate:
         return status;
     }
 
+    methodMember = interfaceDescription->GetMember(AJ_METHOD_GET_APP_RESOURCE_USAGE.c_str());
+    status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::GetAppResourceUsage));
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not register the GetAppResourceUsage MethodHandler"));
+        return status;
+    }
+
     m_AppStatusChanged = interfaceDescription->GetMember(AJ_SIGNAL_APP_STATUS_CHANGED.c_str());
 
     QCC_DbgTrace(("Created AppBusObject successfully"));
@@ -153,6 +211,11 @@ QStatus AppBusObject::createAppConnectorInterface(BusAttachment* bus)
         if (status != ER_OK) {
             goto postCreate;
         }
+        status = interfaceDescription->AddMethod(AJ_METHOD_GET_MERGED_ACL_IF_CHANGED.c_str(), AJ_GET_MERGED_ACL_IF_CHANGED_PARAMS_IN.c_str(),
+                                                 AJ_GET_MERGED_ACL_IF_CHANGED_PARAMS_OUT.c_str(), AJ_GET_MERGED_ACL_IF_CHANGED_PARAM_NAMES.c_str());
+        if (status != ER_OK) {
+            goto postCreate;
+        }
         status = interfaceDescription->AddMethod(AJ_METHOD_UPDATE_CONNECTION_STATUS.c_str(), AJ_UPDATE_CONNECTION_STATUS_PARAMS_IN.c_str(),
                                                  AJ_UPDATE_CONNECTION_STATUS_PARAMS_OUT.c_str(), AJ_UPDATE_CONNECTION_STATUS_PARAM_NAMES.c_str(), MEMBER_ANNOTATE_NO_REPLY);
         if (status != ER_OK) {
@@ -180,6 +243,7 @@ postCreate:
         return status;
     }
 
+    // GetMergedAcl and GetMergedAclIfChanged are served from the Acl snapshot without going through the task queue
     const ajn::InterfaceDescription::Member* methodMember = interfaceDescription->GetMember(AJ_METHOD_GET_MERGED_ACL.c_str());
     status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::GetMergedAcl));
     if (status != ER_OK) {
@@ -187,8 +251,15 @@ postCreate:
         return status;
     }
 
+    methodMember = interfaceDescription->GetMember(AJ_METHOD_GET_MERGED_ACL_IF_CHANGED.c_str());
+    status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::GetMergedAclIfChanged));
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not register the GetMergedAclIfChanged MethodHandler"));
+        return status;
+    }
+
     methodMember = interfaceDescription->GetMember(AJ_METHOD_UPDATE_CONNECTION_STATUS.c_str());
-    status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::UpdateConnectionStatus));
+    status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::UpdateConnectionStatus));
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not register the UpdateConnectionStatus MethodHandler"));
         return status;
@@ -231,6 +302,11 @@ QStatus AppBusObject::createAclMgmtInterface(BusAttachment* bus)
         if (status != ER_OK) {
             goto postCreate;
         }
+        status = interfaceDescription->AddMethod(AJ_METHOD_LIST_ACLS_PAGED.c_str(), AJ_LIST_ACLS_PAGED_PARAMS_IN.c_str(),
+                                                 AJ_LIST_ACLS_PAGED_PARAMS_OUT.c_str(), AJ_LIST_ACLS_PAGED_PARAM_NAMES.c_str());
+        if (status != ER_OK) {
+            goto postCreate;
+        }
         interfaceDescription->Activate();
     }
 postCreate:
@@ -246,32 +322,60 @@ postCreate:
     }
 
     const ajn::InterfaceDescription::Member* methodMember = interfaceDescription->GetMember(AJ_METHOD_CREATE_ACL.c_str());
-    status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::CreateAcl));
+    status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::CreateAcl));
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not register the CreateAcl MethodHandler"));
         return status;
     }
 
     methodMember = interfaceDescription->GetMember(AJ_METHOD_DELETE_ACL.c_str());
-    status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::DeleteAcl));
+    status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::DeleteAcl));
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not register the DeleteAcl MethodHandler"));
         return status;
     }
 
+    // ListAcls and ListAclsPaged are served from the Acl snapshot without going through the task queue,
+    // unless the Acl objects are registered on demand - the listed Acls are then registered on the task queue
+    bool onDemand = GatewayMgmt::getInstance()->getAclObjectsOnDemand();
     methodMember = interfaceDescription->GetMember(AJ_METHOD_LIST_ACLS.c_str());
-    status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::ListAcls));
+    if (onDemand) {
+        status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::ListAcls));
+    } else {
+        status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::ListAcls));
+    }
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not register the ListAcls MethodHandler"));
         return status;
     }
 
+    methodMember = interfaceDescription->GetMember(AJ_METHOD_LIST_ACLS_PAGED.c_str());
+    if (onDemand) {
+        status = AddShardedMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::ListAclsPaged));
+    } else {
+        status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppBusObject::ListAclsPaged));
+    }
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not register the ListAclsPaged MethodHandler"));
+        return status;
+    }
+
     QCC_DbgTrace(("Created GatewayAclBusObject successfully"));
     return status;
 }
 
 AppBusObject::~AppBusObject()
 {
+    // the App is shut down and its task queue stopped, so the timer id no longer changes
+    GatewayEventLoop* eventLoop = GatewayMgmt::getInstance()->getEventLoop();
+    if (eventLoop && m_AppStatusChangedTimerId) {
+        eventLoop->cancelTimer(m_AppStatusChangedTimerId);
+    }
+}
+
+GatewayConnectorApp* AppBusObject::getShardOwner() const
+{
+    return m_ConnectorApp;
 }
 
 QStatus AppBusObject::Get(const char* interfaceName, const char* propName, MsgArg& val)
@@ -353,16 +457,14 @@ void AppBusObject::GetManifestFile(const InterfaceDescription::Member* member, M
 {
     QCC_DbgTrace(("Received GetManifestFile method call"));
 
-    qcc::String manifestData = m_ConnectorApp->getManifest().getManifestData();
-    ajn::MsgArg replyArg[1];
-    QStatus status = replyArg[0].Set(AJPARAM_STR.c_str(), manifestData.c_str());
-    if (status != ER_OK) {
-        QCC_LogError(status, ("Could not marshal response to GetManifestFile"));
-        MethodReply(msg, status);
+    const MsgArg* replyArg = m_ConnectorApp->getManifestReplies().getManifestFileReply();
+    if (!replyArg) {
+        QCC_LogError(ER_FAIL, ("Could not marshal response to GetManifestFile"));
+        MethodReply(msg, ER_FAIL);
         return;
     }
 
-    status = MethodReply(msg, replyArg, 1);
+    QStatus status = MethodReply(msg, replyArg, 1);
     if (status != ER_OK) {
         QCC_LogError(status, ("GetManifestFile reply call failed"));
     }
@@ -372,73 +474,85 @@ void AppBusObject::GetManifestInterfaces(const InterfaceDescription::Member* mem
 {
     QCC_DbgTrace(("Received GetManifestInterfaces method call"));
 
+    const MsgArg* replyArg = m_ConnectorApp->getManifestReplies().getManifestInterfacesReply();
+    if (!replyArg) {
+        QCC_LogError(ER_FAIL, ("Could not marshal response to GetManifestInterfaces"));
+        MethodReply(msg, ER_FAIL);
+        return;
+    }
+
+    QStatus status = MethodReply(msg, replyArg, 2);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("GetManifestInterfaces reply call failed"));
+    }
+}
+
+void AppBusObject::GetAppResourceUsage(const InterfaceDescription::Member* member, Message& msg)
+{
+    QCC_DbgTrace(("Received GetAppResourceUsage method call"));
+
+    uint64_t cpuUsage = 0;
+    uint64_t memoryUsage = 0;
+    QStatus status = m_ConnectorApp->getResourceUsage(&cpuUsage, &memoryUsage);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not retrieve the resource usage for GetAppResourceUsage"));
+        MethodReply(msg, status);
+        return;
+    }
+
     ajn::MsgArg replyArg[2];
-    QStatus status = marshalCapabilities(m_ConnectorApp->getManifest().getExposedServices(), &replyArg[0]);
+    status = replyArg[0].Set(AJPARAM_UINT64.c_str(), cpuUsage);
     if (status != ER_OK) {
-        QCC_LogError(status, ("Could not marshal ExposedServices for response to GetManifestInterfaces"));
+        QCC_LogError(status, ("Could not marshal response to GetAppResourceUsage"));
         MethodReply(msg, status);
         return;
     }
 
-    status = marshalCapabilities(m_ConnectorApp->getManifest().getRemotedServices(), &replyArg[1]);
+    status = replyArg[1].Set(AJPARAM_UINT64.c_str(), memoryUsage);
     if (status != ER_OK) {
-        QCC_LogError(status, ("Could not marshal RemotedServices for response to GetManifestInterfaces"));
+        QCC_LogError(status, ("Could not marshal response to GetAppResourceUsage"));
         MethodReply(msg, status);
         return;
     }
 
     status = MethodReply(msg, replyArg, 2);
     if (status != ER_OK) {
-        QCC_LogError(status, ("GetManifestInterfaces reply call failed"));
+        QCC_LogError(status, ("GetAppResourceUsage reply call failed"));
     }
 }
 
-QStatus AppBusObject::marshalCapabilities(const GatewayConnectorAppManifest::Capabilities& capabilities, MsgArg* msgArg)
+QStatus AppBusObject::SendAppStatusChangedSignal()
 {
-    QStatus status = ER_OK;
-    GatewayConnectorAppManifest::Capabilities::const_iterator it;
-    MsgArg* objectsArray = new MsgArg[capabilities.size()];
-    size_t objectsIndex = 0;
-
-    for (it = capabilities.begin(); it != capabilities.end(); it++) {
-
-        const std::vector<GatewayConnectorAppCapability::InterfaceDesc>& interfaces = it->getInterfaces();
-        MsgArg* interfacesArray = new MsgArg[interfaces.size()];
-        size_t interfaceIndex = 0;
-
-        for (size_t i = 0; i < interfaces.size(); i++) {
-            status = interfacesArray[interfaceIndex++].Set(AJPARAM_MANIFEST_INTERFACE_STRUCT.c_str(), interfaces[i].interfaceName.c_str(),
-                                                           interfaces[i].interfaceFriendlyName.c_str(), interfaces[i].isSecured);
-            if (status != ER_OK) {
-                delete[] objectsArray;
-                delete[] interfacesArray;
-                return status;
-            }
-        }
+    QCC_DbgTrace(("In SendAppStatusChangedSignal"));
 
-        status = objectsArray[objectsIndex].Set(AJPARAM_MANIFEST_INTERFACE_INFO.c_str(), it->getObjectPath().c_str(),
-                                                it->getIsObjectPathPrefix(), it->getObjectPathFriendlyName().c_str(),
-                                                interfaceIndex, interfacesArray);
-        if (status != ER_OK) {
-            delete[] objectsArray;
-            delete[] interfacesArray;
-            return status;
-        }
-        objectsArray[objectsIndex++].SetOwnershipFlags(MsgArg::OwnsArgs, true);
+    if (!m_AppStatusChanged) {
+        QCC_DbgHLPrintf(("Can't send m_AppStatusChanged signal. Signal not set"));
+        return ER_BUS_PROPERTY_VALUE_NOT_SET;
     }
-    status = msgArg->Set(AJPARAM_MANIFEST_INTERFACE_INFO_ARRAY.c_str(), objectsIndex, objectsArray);
-    if (status != ER_OK) {
-        delete[] objectsArray;
-        return status;
+
+    if (m_AppStatusChangedPending) {
+        QCC_DbgPrintf(("AppStatusChanged signal already pending - coalescing"));
+        return ER_OK;
     }
 
-    msgArg->SetOwnershipFlags(MsgArg::OwnsArgs, true);
-    return status;
+    m_AppStatusChangedPending = true;
+
+    // without an event loop the signal only coalesces with the changes queued before it
+    GatewayEventLoop* eventLoop = GatewayMgmt::getInstance()->getEventLoop();
+    if (!eventLoop) {
+        m_ConnectorApp->getTaskQueue()->post(new AppStatusChangedTask(this));
+        return ER_OK;
+    }
+    m_AppStatusChangedTimerId = eventLoop->addTimer(new AppStatusChangedTimerTask(this, m_ConnectorApp->getTaskQueue()),
+                                                    GATEWAY_APP_STATUS_COALESCE_MS);
+    return ER_OK;
 }
 
-QStatus AppBusObject::SendAppStatusChangedSignal()
+QStatus AppBusObject::FlushAppStatusChangedSignal()
 {
-    QCC_DbgTrace(("In SendAppStatusChangedSignal"));
+    QCC_DbgTrace(("In FlushAppStatusChangedSignal"));
+    m_AppStatusChangedPending = false;
+    m_AppStatusChangedTimerId = 0;
 
     GatewayBusListener* busListener = GatewayMgmt::getInstance()->getBusListener();
     QStatus status = ER_BUS_PROPERTY_VALUE_NOT_SET;
@@ -476,11 +590,20 @@ QStatus AppBusObject::SendAppStatusChangedSignal()
         return status;
     }
 
-    const std::vector<SessionId>& sessionIds = busListener->getSessionIds();
+    bool allSessions = false;
+    std::vector<SessionId> sessionIds = busListener->getSessionIds(m_ConnectorApp->getConnectorId(), &allSessions);
+    if (sessionIds.size() > 1 && allSessions && GatewayMgmt::getInstance()->getSessioncastSignals()) {
+        status = SendSignal(NULL, GATEWAY_SESSION_ID_ALL_HOSTED, *m_AppStatusChanged, msgArg, indx);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Could not send m_AppStatusChanged Signal to all hosted sessions"));
+        }
+        return status;
+    }
+
     for (size_t i = 0; i < sessionIds.size(); i++) {
-        status = Signal(NULL, sessionIds[i], *m_AppStatusChanged, msgArg, indx);
+        status = SendSignal(NULL, sessionIds[i], *m_AppStatusChanged, msgArg, indx);
         if (status != ER_OK) {
-            QCC_LogError(status, ("Could not send m_AppStatusChanged Signal for sessionId: %i" + sessionIds[i]));
+            QCC_LogError(status, ("Could not send m_AppStatusChanged Signal for sessionId: %u", sessionIds[i]));
         }
     }
     return status;
@@ -490,17 +613,64 @@ void AppBusObject::GetMergedAcl(const InterfaceDescription::Member* member, Mess
 {
     QCC_DbgTrace(("Received GetMergedAcl method call"));
 
-    ajn::MsgArg replyArg[2];
-    QStatus status = AclAdapter::marshalMergedAcl(m_ConnectorApp->getAcls(), replyArg);
+    GatewayRef<GatewayAclSet> aclSet = m_ConnectorApp->getAclSnapshot();
+
+    const MsgArg* mergedAcl = aclSet->getMergedAcl();
+    if (!mergedAcl) {
+        QCC_LogError(ER_FAIL, ("Could not marshal Acl for GetMergedAcl method"));
+        MethodReply(msg, ER_FAIL);
+        return;
+    }
+
+    QStatus status = MethodReply(msg, mergedAcl, 2);
     if (status != ER_OK) {
-        QCC_LogError(status, ("Could not marshal Acl for GetMergedAcl method"));
+        QCC_LogError(status, ("GetMergedAcl reply call failed"));
+    }
+}
+
+void AppBusObject::GetMergedAclIfChanged(const InterfaceDescription::Member* member, Message& msg)
+{
+    QCC_DbgTrace(("Received GetMergedAclIfChanged method call"));
+
+    const ajn::MsgArg* args = 0;
+    size_t numArgs = 0;
+    ShardedBusObject::GetMethodArgs(msg, numArgs, args);
+
+    if (numArgs != 1) {
+        QCC_DbgHLPrintf(("Could not receive GetMergedAclIfChanged"));
+        MethodReply(msg, ER_INVALID_DATA);
+        return;
+    }
+
+    uint32_t version;
+    QStatus status = args[0].Get(AJPARAM_UINT32.c_str(), &version);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not unmarshal argument of GetMergedAclIfChanged method"));
         MethodReply(msg, status);
         return;
     }
 
-    status = MethodReply(msg, replyArg, 2);
+    GatewayRef<GatewayAclSet> aclSet = m_ConnectorApp->getAclSnapshot();
+
+    // the version is the merge sequence, which starts at 1, so version 0 always fetches the merged Acl
+    if (version != 0 && version == aclSet->getMergeSequence()) {
+        ajn::MsgArg replyArg[4];
+        replyArg[0].Set(AJPARAM_UINT32.c_str(), version);
+        replyArg[1].Set(AJPARAM_BOOL.c_str(), false);
+        replyArg[2].Set(AJPARAM_INTERFACE_INFO_ARRAY.c_str(), 0, NULL);
+        replyArg[3].Set(AJPARAM_REMOTED_APPS_ARRAY.c_str(), 0, NULL);
+        status = MethodReply(msg, replyArg, 4);
+    } else {
+        const MsgArg* changedReply = aclSet->getMergedAclChangedReply();
+        if (!changedReply) {
+            QCC_LogError(ER_FAIL, ("Could not marshal Acl for GetMergedAclIfChanged method"));
+            MethodReply(msg, ER_FAIL);
+            return;
+        }
+        status = MethodReply(msg, changedReply, 4);
+    }
     if (status != ER_OK) {
-        QCC_LogError(status, ("GetMergedAcl reply call failed"));
+        QCC_LogError(status, ("GetMergedAclIfChanged reply call failed"));
     }
 }
 
@@ -510,7 +680,7 @@ void AppBusObject::UpdateConnectionStatus(const InterfaceDescription::Member* me
 
     const ajn::MsgArg* args = 0;
     size_t numArgs = 0;
-    msg->GetArgs(numArgs, args);
+    ShardedBusObject::GetMethodArgs(msg, numArgs, args);
     if (numArgs < 1) {
         QCC_DbgHLPrintf(("Could not receive UpdateConnectionStatus"));
         return;
@@ -542,8 +712,16 @@ QStatus AppBusObject::SendAclUpdatedSignal()
         return status;
     }
 
+    // the signal carries the delta of the current set, connectors that missed a merge sequence fetch the merged Acl instead
+    GatewayRef<GatewayAclSet> aclSet = m_ConnectorApp->getAclSnapshot();
+    const MsgArg* signalArgs = aclSet->getMergedAclUpdatedArgs();
+    if (!signalArgs) {
+        QCC_LogError(ER_FAIL, ("Could not marshal the args of the AclUpdated Signal"));
+        return ER_FAIL;
+    }
+
     qcc::String destination = AJ_GW_APP_WKN_PREFIX + m_ConnectorApp->getConnectorId();
-    status = Signal(destination.c_str(), 0, *m_AclUpdated);
+    status = SendSignal(destination.c_str(), 0, *m_AclUpdated, signalArgs, 5);
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not send AclUpdated Signal"));
     }
@@ -561,7 +739,7 @@ QStatus AppBusObject::SendShutdownAppSignal()
     }
 
     qcc::String destination = AJ_GW_APP_WKN_PREFIX + m_ConnectorApp->getConnectorId();
-    status = Signal(destination.c_str(), 0, *m_ShutdownApp);
+    status = SendSignal(destination.c_str(), 0, *m_ShutdownApp);
     if (status != ER_OK) {
         QCC_LogError(status, ("Could not send ShutdownApp Signal"));
     }
@@ -621,7 +799,7 @@ void AppBusObject::DeleteAcl(const InterfaceDescription::Member* member, Message
 
     const ajn::MsgArg* args = 0;
     size_t numArgs = 0;
-    msg->GetArgs(numArgs, args);
+    ShardedBusObject::GetMethodArgs(msg, numArgs, args);
     if (numArgs < 1) {
         QCC_DbgHLPrintf(("Could not handle DeleteAcl - no arguments given"));
         MethodReply(msg, ER_INVALID_DATA);
@@ -659,13 +837,19 @@ void AppBusObject::ListAcls(const InterfaceDescription::Member* member, Message&
     QStatus status;
     ajn::MsgArg replyArg[1];
 
-    std::map<String, GatewayAcl*>::iterator it;
-    std::map<String, GatewayAcl*> acls = m_ConnectorApp->getAcls();
+    GatewayRef<GatewayAclSet> aclSet = m_ConnectorApp->getAclSnapshot();
+    bool onDemand = GatewayMgmt::getInstance()->getAclObjectsOnDemand();
+
+    std::map<String, GatewayAclSnapshot>::const_iterator it;
+    const std::map<String, GatewayAclSnapshot>& acls = aclSet->getAcls();
     std::vector<MsgArg> aclInfo(acls.size());
     size_t aclInfoSize = 0;
     for (it = acls.begin(); it != acls.end(); it++) {
-        status = aclInfo[aclInfoSize++].Set(AJPARAM_ACLS_STRUCT.c_str(), it->first.c_str(), it->second->getAclName().c_str(),
-                                            it->second->getAclStatus(), it->second->getObjectPath().c_str());
+        if (onDemand) {
+            m_ConnectorApp->materializeAclObject(it->first);
+        }
+        status = aclInfo[aclInfoSize++].Set(AJPARAM_ACLS_STRUCT.c_str(), it->first.c_str(), it->second.getAclName().c_str(),
+                                            it->second.getAclStatus(), it->second.getObjectPath().c_str());
         if (status != ER_OK) {
             QCC_LogError(status, ("Can't marshal response to ListAcls - responding with error "));
             MethodReply(msg, status);
@@ -687,5 +871,66 @@ void AppBusObject::ListAcls(const InterfaceDescription::Member* member, Message&
     return;
 }
 
+void AppBusObject::ListAclsPaged(const InterfaceDescription::Member* member, Message& msg)
+{
+    QCC_DbgTrace(("Received ListAclsPaged method call"));
+
+    PageRequest pageRequest;
+    QStatus status = pageRequest.unmarshal(msg);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not unmarshal arguments of ListAclsPaged method"));
+        MethodReply(msg, status);
+        return;
+    }
+
+    GatewayRef<GatewayAclSet> aclSet = m_ConnectorApp->getAclSnapshot();
+    bool onDemand = GatewayMgmt::getInstance()->getAclObjectsOnDemand();
+
+    const std::map<String, GatewayAclSnapshot>& acls = aclSet->getAcls();
+    std::map<String, GatewayAclSnapshot>::const_iterator it = pageRequest.getCursor().empty() ? acls.begin() :
+                                                              acls.upper_bound(pageRequest.getCursor());
+    std::vector<MsgArg> aclInfo(std::min<size_t>(pageRequest.getPageSize(), acls.size()));
+    size_t aclInfoSize = 0;
+    String lastAclId;
+    for (; it != acls.end() && aclInfoSize < aclInfo.size(); it++) {
+        lastAclId = it->first;
+        if (pageRequest.getProjection() == GW_LP_ID_STATUS) {
+            status = aclInfo[aclInfoSize++].Set(AJPARAM_ID_STATUS_STRUCT.c_str(), it->first.c_str(), it->second.getAclStatus());
+        } else {
+            if (onDemand) {
+                m_ConnectorApp->materializeAclObject(it->first);
+            }
+            status = aclInfo[aclInfoSize++].Set(AJPARAM_ACLS_STRUCT.c_str(), it->first.c_str(), it->second.getAclName().c_str(),
+                                                it->second.getAclStatus(), it->second.getObjectPath().c_str());
+        }
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Can't marshal response to ListAclsPaged - responding with error "));
+            MethodReply(msg, status);
+            return;
+        }
+    }
+
+    // an empty cursor tells the caller this was the last page
+    String nextCursor = it != acls.end() ? lastAclId : "";
+
+    MsgArg pageArg;
+    status = pageArg.Set(pageRequest.getProjection() == GW_LP_ID_STATUS ? AJPARAM_ID_STATUS_STRUCT_ARRAY.c_str() : AJPARAM_ACLS_STRUCT_ARRAY.c_str(),
+                         aclInfoSize, aclInfo.data());
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Can't marshal response to ListAclsPaged - responding with error "));
+        MethodReply(msg, status);
+        return;
+    }
+
+    ajn::MsgArg replyArg[2];
+    replyArg[0].Set(AJPARAM_VAR.c_str(), &pageArg);
+    replyArg[1].Set(AJPARAM_STR.c_str(), nextCursor.c_str());
+
+    status = MethodReply(msg, replyArg, 2);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("ListAclsPaged reply call failed"));
+    }
+}
+
 } /* namespace gw */
 } /* namespace ajn */
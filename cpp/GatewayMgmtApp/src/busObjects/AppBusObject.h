@@ -19,6 +19,7 @@
 
 #include <alljoyn/BusAttachment.h>
 #include <alljoyn/BusObject.h>
+#include "ShardedBusObject.h"
 #include <alljoyn/InterfaceDescription.h>
 #include <alljoyn/gateway/GatewayConnectorApp.h>
 #include <alljoyn/gateway/GatewayConnectorAppManifest.h>
@@ -29,7 +30,7 @@ namespace gw {
 /**
  * AppBusObject - BusObject for ConnectorApp
  */
-class AppBusObject : public BusObject  {
+class AppBusObject : public ShardedBusObject  {
   public:
 
     /**
@@ -74,12 +75,28 @@ class AppBusObject : public BusObject  {
     void GetManifestInterfaces(const InterfaceDescription::Member* member, Message& msg);
 
     /**
-     * Callback for the GetMergedAcl method
+     * Callback for the GetAppResourceUsage method
+     * @param member - the member called
+     * @param msg - the message of the method
+     */
+    void GetAppResourceUsage(const InterfaceDescription::Member* member, Message& msg);
+
+    /**
+     * Callback for the GetMergedAcl method. Served from the Acl snapshot
+     * of the Connector App, not on its task queue
      * @param member - the member called
      * @param msg - the message of the method
      */
     void GetMergedAcl(const InterfaceDescription::Member* member, Message& msg);
 
+    /**
+     * Callback for the GetMergedAclIfChanged method. Replies with the merged Acl
+     * only if the caller's version is not the current one
+     * @param member - the member called
+     * @param msg - the message of the method
+     */
+    void GetMergedAclIfChanged(const InterfaceDescription::Member* member, Message& msg);
+
     /**
      * Callback for the UpdateConnectionStatus method
      * @param member - the member called
@@ -102,14 +119,24 @@ class AppBusObject : public BusObject  {
     void DeleteAcl(const InterfaceDescription::Member* member, Message& msg);
 
     /**
-     * Callback for the ListAcls method
+     * Callback for the ListAcls method. Served from the Acl snapshot
+     * of the Connector App, not on its task queue
      * @param member - the member called
      * @param msg - the message of the method
      */
     void ListAcls(const InterfaceDescription::Member* member, Message& msg);
 
     /**
-     * Send a signal that the Acls were updated
+     * Callback for the ListAclsPaged method. Returns one page of the Acls,
+     * starting after the given cursor. Served from the Acl snapshot
+     * @param member - the member called
+     * @param msg - the message of the method
+     */
+    void ListAclsPaged(const InterfaceDescription::Member* member, Message& msg);
+
+    /**
+     * Send a signal that the merged Acl was updated, carrying the merge sequence
+     * of the current Acl set and its delta from the previous merge sequence
      * @return status - success/failure
      */
     QStatus SendAclUpdatedSignal();
@@ -121,11 +148,26 @@ class AppBusObject : public BusObject  {
     QStatus SendShutdownAppSignal();
 
     /**
-     * Send a signal that the AppStatus has changed
+     * Send a signal that the AppStatus has changed. Changes within a short
+     * window are coalesced into one signal carrying the latest status.
+     * Called on the task queue of the App
      * @return status - success/failure
      */
     QStatus SendAppStatusChangedSignal();
 
+    /**
+     * Send the coalesced AppStatusChanged signal to the sessions interested
+     * in this App. Called on the task queue of the App once the window expired
+     * @return status - success/failure
+     */
+    QStatus FlushAppStatusChangedSignal();
+
+    /**
+     * Get the Connector App whose task queue executes the method calls
+     * @return connectorApp
+     */
+    GatewayConnectorApp* getShardOwner() const;
+
     /**
      * Get Property
      * @param interfaceName - name of the interface
@@ -171,6 +213,16 @@ class AppBusObject : public BusObject  {
      */
     const ajn::InterfaceDescription::Member* m_ShutdownApp;
 
+    /**
+     * Whether an AppStatusChanged signal is waiting for the coalescing window to expire
+     */
+    bool m_AppStatusChangedPending;
+
+    /**
+     * The timer of the event loop ending the coalescing window, 0 if none
+     */
+    uint32_t m_AppStatusChangedTimerId;
+
     /**
      * Private function to create the App Interface
      * @param bus - bus used to create the interface
@@ -192,14 +244,6 @@ class AppBusObject : public BusObject  {
      */
     QStatus createAclMgmtInterface(BusAttachment* bus);
 
-    /**
-     * private function to marshal ManifestCapability
-     * @param capabilities - map to marshal
-     * @param msgArg - msgArg to marshal it into
-     * @return status - success/failure
-     */
-    QStatus marshalCapabilities(const GatewayConnectorAppManifest::Capabilities& capabilities, MsgArg* msgArg);
-
 };
 
 } /* namespace gw */
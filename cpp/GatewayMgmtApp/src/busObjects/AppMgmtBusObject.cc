@@ -18,7 +18,14 @@
 #include "../GatewayConstants.h"
 #include <alljoyn/gateway/GatewayMgmt.h>
 #include <alljoyn/gateway/GatewayConnectorApp.h>
+#include <alljoyn/gateway/GatewayBusListener.h>
+#include <alljoyn/gateway/GatewayRecorder.h>
+#include <alljoyn/gateway/GatewayStats.h>
+#include <alljoyn/gateway/GatewayTrace.h>
+#include "PageRequest.h"
+#include "AclAdapter.h"
 #include <vector>
+#include <algorithm>
 
 namespace ajn {
 namespace gw {
@@ -43,6 +50,21 @@ AppMgmtBusObject::AppMgmtBusObject(BusAttachment* bus, GatewayConnectorAppManage
         if (*status != ER_OK) {
             goto postCreate;
         }
+        *status = interfaceDescription->AddMethod(AJ_METHOD_GET_INSTALLED_APPS_PAGED.c_str(), AJ_GET_INSTALLED_APPS_PAGED_PARAMS_IN.c_str(),
+                                                  AJ_GET_INSTALLED_APPS_PAGED_PARAMS_OUT.c_str(), AJ_GET_INSTALLED_APPS_PAGED_PARAM_NAMES.c_str());
+        if (*status != ER_OK) {
+            goto postCreate;
+        }
+        *status = interfaceDescription->AddMethod(AJ_METHOD_SET_APP_STATUS_SUBSCRIPTIONS.c_str(), AJ_SET_APP_STATUS_SUBSCRIPTIONS_PARAMS_IN.c_str(),
+                                                  AJ_SET_APP_STATUS_SUBSCRIPTIONS_PARAMS_OUT.c_str(), AJ_SET_APP_STATUS_SUBSCRIPTIONS_PARAM_NAMES.c_str());
+        if (*status != ER_OK) {
+            goto postCreate;
+        }
+        *status = interfaceDescription->AddMethod(AJ_METHOD_BATCH_UPDATE.c_str(), AJ_BATCH_UPDATE_PARAMS_IN.c_str(),
+                                                  AJ_BATCH_UPDATE_PARAMS_OUT.c_str(), AJ_BATCH_UPDATE_PARAM_NAMES.c_str());
+        if (*status != ER_OK) {
+            goto postCreate;
+        }
         interfaceDescription->Activate();
     }
 
@@ -65,6 +87,32 @@ postCreate:
         return;
     }
 
+    methodMember = interfaceDescription->GetMember(AJ_METHOD_GET_INSTALLED_APPS_PAGED.c_str());
+    *status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppMgmtBusObject::GetInstalledAppsPaged));
+    if (*status != ER_OK) {
+        QCC_LogError(*status, ("Could not register the GetInstalledAppsPaged MethodHandler"));
+        return;
+    }
+
+    methodMember = interfaceDescription->GetMember(AJ_METHOD_SET_APP_STATUS_SUBSCRIPTIONS.c_str());
+    *status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppMgmtBusObject::SetAppStatusSubscriptions));
+    if (*status != ER_OK) {
+        QCC_LogError(*status, ("Could not register the SetAppStatusSubscriptions MethodHandler"));
+        return;
+    }
+
+    methodMember = interfaceDescription->GetMember(AJ_METHOD_BATCH_UPDATE.c_str());
+    *status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppMgmtBusObject::BatchUpdate));
+    if (*status != ER_OK) {
+        QCC_LogError(*status, ("Could not register the BatchUpdate MethodHandler"));
+        return;
+    }
+
+    *status = AddStatsInterface(bus);
+    if (*status != ER_OK) {
+        return;
+    }
+
     std::vector<String> interfaces;
     interfaces.push_back(AJ_GW_APP_MGMT_INTERFACE);
 
@@ -76,6 +124,64 @@ AppMgmtBusObject::~AppMgmtBusObject()
 {
 }
 
+QStatus AppMgmtBusObject::AddStatsInterface(BusAttachment* bus)
+{
+    QStatus status = ER_OK;
+    InterfaceDescription* interfaceDescription = (InterfaceDescription*) bus->GetInterface(AJ_GW_STATS_INTERFACE.c_str());
+    if (!interfaceDescription) {
+        status = bus->CreateInterface(AJ_GW_STATS_INTERFACE.c_str(), interfaceDescription, true);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Could not create the Stats interface"));
+            return status;
+        }
+        status = interfaceDescription->AddMethod(AJ_METHOD_GET_STATS.c_str(), AJ_GET_STATS_PARAMS_IN.c_str(),
+                                                 AJ_GET_STATS_PARAMS_OUT.c_str(), AJ_GET_STATS_PARAM_NAMES.c_str());
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Could not add the GetStats method"));
+            return status;
+        }
+        status = interfaceDescription->AddMethod(AJ_METHOD_RESET_STATS.c_str(), AJ_RESET_STATS_PARAMS_IN.c_str(),
+                                                 AJ_RESET_STATS_PARAMS_OUT.c_str(), AJ_RESET_STATS_PARAM_NAMES.c_str());
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Could not add the ResetStats method"));
+            return status;
+        }
+        interfaceDescription->Activate();
+    }
+
+    status = AddInterface(*interfaceDescription);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not add the Stats interface"));
+        return status;
+    }
+
+    const ajn::InterfaceDescription::Member* methodMember = interfaceDescription->GetMember(AJ_METHOD_GET_STATS.c_str());
+    status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppMgmtBusObject::GetStats));
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not register the GetStats MethodHandler"));
+        return status;
+    }
+
+    methodMember = interfaceDescription->GetMember(AJ_METHOD_RESET_STATS.c_str());
+    status = AddMethodHandler(methodMember, static_cast<MessageReceiver::MethodHandler>(&AppMgmtBusObject::ResetStats));
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not register the ResetStats MethodHandler"));
+        return status;
+    }
+    return status;
+}
+
+void AppMgmtBusObject::CallMethodHandler(MessageReceiver::MethodHandler handler, const InterfaceDescription::Member* member, Message& message, void* context)
+{
+    if (GatewayRecorder::isRecording()) {
+        GatewayRecorder::recordMethodCall(member, message);
+    }
+
+    GatewayTraceScope trace(member->name);
+    GatewayStatsTimer timer(member);
+    BusObject::CallMethodHandler(handler, member, message, context);
+}
+
 QStatus AppMgmtBusObject::Get(const char* interfaceName, const char* propName, MsgArg& val)
 {
     QCC_DbgTrace(("Get property was called in AppMgmtBusObject class:"));
@@ -98,8 +204,8 @@ void AppMgmtBusObject::GetInstalledApps(const InterfaceDescription::Member* memb
     QStatus status;
     ajn::MsgArg replyArg[1];
 
-    std::map<String, GatewayConnectorApp*>::iterator it;
-    std::map<String, GatewayConnectorApp*> apps = m_ConnectorAppManager->getConnectorApps();
+    std::map<String, GatewayConnectorApp*>::const_iterator it;
+    const std::map<String, GatewayConnectorApp*>& apps = m_ConnectorAppManager->getConnectorApps();
     std::vector<MsgArg> appInfo(apps.size());
     size_t appInfoSize = 0;
     for (it = apps.begin(); it != apps.end(); it++) {
@@ -127,6 +233,237 @@ void AppMgmtBusObject::GetInstalledApps(const InterfaceDescription::Member* memb
     }
 }
 
+void AppMgmtBusObject::GetInstalledAppsPaged(const InterfaceDescription::Member* member, Message& msg)
+{
+    QCC_DbgTrace(("Received GetInstalledAppsPaged method call"));
+
+    PageRequest pageRequest;
+    QStatus status = pageRequest.unmarshal(msg);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not unmarshal arguments of GetInstalledAppsPaged method"));
+        MethodReply(msg, status);
+        return;
+    }
+
+    const std::map<String, GatewayConnectorApp*>& apps = m_ConnectorAppManager->getConnectorApps();
+    std::map<String, GatewayConnectorApp*>::const_iterator it = pageRequest.getCursor().empty() ? apps.begin() :
+                                                                apps.upper_bound(pageRequest.getCursor());
+    std::vector<MsgArg> appInfo(std::min<size_t>(pageRequest.getPageSize(), apps.size()));
+    size_t appInfoSize = 0;
+    String lastConnectorId;
+    for (; it != apps.end() && appInfoSize < appInfo.size(); it++) {
+        lastConnectorId = it->first;
+        if (pageRequest.getProjection() == GW_LP_ID_STATUS) {
+            status = appInfo[appInfoSize++].Set(AJPARAM_ID_STATUS_STRUCT.c_str(), it->second->getConnectorId().c_str(),
+                                                it->second->getOperationalStatus());
+        } else {
+            status = appInfo[appInfoSize++].Set(AJPARAM_INSTALLED_APPS_INFO.c_str(), it->second->getConnectorId().c_str(),
+                                                it->second->getManifest().getFriendlyName().c_str(),
+                                                it->second->getObjectPath().c_str(),
+                                                it->second->getManifest().getVersion().c_str());
+        }
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Can't marshal InstalledAppInfo - responding with error"));
+            MethodReply(msg, status);
+            return;
+        }
+    }
+
+    // an empty cursor tells the caller this was the last page
+    String nextCursor = it != apps.end() ? lastConnectorId : "";
+
+    MsgArg pageArg;
+    status = pageArg.Set(pageRequest.getProjection() == GW_LP_ID_STATUS ? AJPARAM_ID_STATUS_STRUCT_ARRAY.c_str() : AJPARAM_INSTALLED_APPS_INFO_ARRAY.c_str(),
+                         appInfoSize, appInfo.data());
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Can't marshal InstalledAppInfo - responding with error"));
+        MethodReply(msg, status);
+        return;
+    }
+
+    ajn::MsgArg replyArg[2];
+    replyArg[0].Set(AJPARAM_VAR.c_str(), &pageArg);
+    replyArg[1].Set(AJPARAM_STR.c_str(), nextCursor.c_str());
+
+    status = MethodReply(msg, replyArg, 2);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("GetInstalledAppsPaged reply call failed"));
+    }
+}
+
+void AppMgmtBusObject::SetAppStatusSubscriptions(const InterfaceDescription::Member* member, Message& msg)
+{
+    QCC_DbgTrace(("Received SetAppStatusSubscriptions method call"));
+
+    GatewayBusListener* busListener = GatewayMgmt::getInstance()->getBusListener();
+    if (!busListener) {
+        QCC_DbgHLPrintf(("BusListener not set - responding with error"));
+        MethodReply(msg, ER_BUS_BUS_NOT_STARTED);
+        return;
+    }
+
+    const ajn::MsgArg* args = 0;
+    size_t numArgs = 0;
+    msg->GetArgs(numArgs, args);
+    if (numArgs != 1) {
+        QCC_DbgHLPrintf(("Received unexpected amount of args - responding with error"));
+        MethodReply(msg, ER_BAD_ARG_1);
+        return;
+    }
+
+    size_t numConnectorIds = 0;
+    MsgArg* connectorIdArgs = 0;
+    QStatus status = args[0].Get(AJPARAM_ARRAY_STR.c_str(), &numConnectorIds, &connectorIdArgs);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Can't unmarshal connectorIds - responding with error"));
+        MethodReply(msg, status);
+        return;
+    }
+
+    std::vector<String> connectorIds;
+    for (size_t i = 0; i < numConnectorIds; i++) {
+        char* connectorId;
+        status = connectorIdArgs[i].Get(AJPARAM_STR.c_str(), &connectorId);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Can't unmarshal connectorId - responding with error"));
+            MethodReply(msg, status);
+            return;
+        }
+        connectorIds.push_back(connectorId);
+    }
+
+    status = busListener->setAppSubscriptions(msg->GetSessionId(), connectorIds);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Could not set the AppStatus subscriptions - responding with error"));
+        MethodReply(msg, status);
+        return;
+    }
+
+    status = MethodReply(msg);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("SetAppStatusSubscriptions reply call failed"));
+    }
+}
+
+void AppMgmtBusObject::BatchUpdate(const InterfaceDescription::Member* member, Message& msg)
+{
+    QCC_DbgTrace(("Received BatchUpdate method call"));
+
+    const ajn::MsgArg* args = 0;
+    size_t numArgs = 0;
+    msg->GetArgs(numArgs, args);
+    if (numArgs != 1) {
+        QCC_DbgHLPrintf(("Received unexpected amount of args - responding with error"));
+        MethodReply(msg, ER_BAD_ARG_1);
+        return;
+    }
+
+    size_t numOperations = 0;
+    MsgArg* operationArgs = 0;
+    QStatus status = args[0].Get(AJPARAM_ACL_BATCH_OPERATION_ARRAY.c_str(), &numOperations, &operationArgs);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Can't unmarshal the batch operations - responding with error"));
+        MethodReply(msg, status);
+        return;
+    }
+
+    std::vector<GatewayAclBatchOperation> operations(numOperations);
+    for (size_t i = 0; i < numOperations; i++) {
+        status = AclAdapter::unmarshalAclBatchOperation(operationArgs[i], &operations[i]);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Can't unmarshal batch operation %u - responding with error", (unsigned int)i));
+            MethodReply(msg, status);
+            return;
+        }
+    }
+
+    uint16_t responseCode = m_ConnectorAppManager->batchUpdate(operations);
+
+    std::vector<MsgArg> resultArgs(numOperations);
+    for (size_t i = 0; i < numOperations; i++) {
+        status = resultArgs[i].Set(AJPARAM_ACL_BATCH_RESULT.c_str(), operations[i].m_ResponseCode, operations[i].m_AclId.c_str());
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Can't marshal the batch results - responding with error"));
+            MethodReply(msg, status);
+            return;
+        }
+    }
+
+    ajn::MsgArg replyArg[2];
+    replyArg[0].Set(AJPARAM_UINT16.c_str(), responseCode);
+    status = replyArg[1].Set(AJPARAM_ACL_BATCH_RESULT_ARRAY.c_str(), resultArgs.size(), resultArgs.data());
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Can't marshal the batch results - responding with error"));
+        MethodReply(msg, status);
+        return;
+    }
+
+    status = MethodReply(msg, replyArg, 2);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("BatchUpdate reply call failed"));
+    }
+}
+
+void AppMgmtBusObject::GetStats(const InterfaceDescription::Member* member, Message& msg)
+{
+    QCC_DbgTrace(("Received GetStats method call"));
+
+    std::vector<GatewayStats::CounterValue> counters;
+    std::vector<GatewayStats::HistogramValue> histograms;
+    GatewayStats::getSnapshot(&counters, &histograms);
+
+    // the number of open sessions is a gauge, it is read from the BusListener instead of counted
+    GatewayBusListener* busListener = GatewayMgmt::getInstance()->getBusListener();
+    GatewayStats::CounterValue sessions;
+    sessions.m_Name = "sessions.active";
+    sessions.m_Value = busListener ? busListener->getSessionIds().size() : 0;
+    counters.push_back(sessions);
+
+    QStatus status;
+    std::vector<MsgArg> counterArgs(counters.size());
+    for (size_t i = 0; i < counters.size(); i++) {
+        status = counterArgs[i].Set(AJPARAM_STATS_COUNTER.c_str(), counters[i].m_Name.c_str(), counters[i].m_Value);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Can't marshal the counters - responding with error"));
+            MethodReply(msg, status);
+            return;
+        }
+    }
+
+    std::vector<MsgArg> histogramArgs(histograms.size());
+    for (size_t i = 0; i < histograms.size(); i++) {
+        status = histogramArgs[i].Set(AJPARAM_STATS_HISTOGRAM.c_str(), histograms[i].m_Name.c_str(), histograms[i].m_Count,
+                                      histograms[i].m_SumUs, histograms[i].m_MaxUs, GW_STATS_NUM_BUCKETS, histograms[i].m_Buckets);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Can't marshal the histograms - responding with error"));
+            MethodReply(msg, status);
+            return;
+        }
+    }
+
+    ajn::MsgArg replyArg[3];
+    replyArg[0].Set(AJPARAM_ARRAY_UINT64.c_str(), GW_STATS_NUM_BUCKETS - 1, GatewayStats::getBucketBoundsUs());
+    replyArg[1].Set(AJPARAM_STATS_COUNTER_ARRAY.c_str(), counterArgs.size(), counterArgs.data());
+    replyArg[2].Set(AJPARAM_STATS_HISTOGRAM_ARRAY.c_str(), histogramArgs.size(), histogramArgs.data());
+
+    status = MethodReply(msg, replyArg, 3);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("GetStats reply call failed"));
+    }
+}
+
+void AppMgmtBusObject::ResetStats(const InterfaceDescription::Member* member, Message& msg)
+{
+    QCC_DbgTrace(("Received ResetStats method call"));
+
+    GatewayStats::reset();
+
+    QStatus status = MethodReply(msg);
+    if (status != ER_OK) {
+        QCC_LogError(status, ("ResetStats reply call failed"));
+    }
+}
+
 } /* namespace gw */
 } /* namespace ajn */
 
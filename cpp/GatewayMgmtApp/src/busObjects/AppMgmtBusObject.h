@@ -51,6 +51,46 @@ class AppMgmtBusObject : public BusObject  {
      */
     void GetInstalledApps(const InterfaceDescription::Member* member, Message& msg);
 
+    /**
+     * Function callback for getInstalledAppsPaged. Returns one page of the
+     * installed Apps, starting after the given cursor
+     * @param member - the member called
+     * @param msg - the message of the method
+     */
+    void GetInstalledAppsPaged(const InterfaceDescription::Member* member, Message& msg);
+
+    /**
+     * Function callback for setAppStatusSubscriptions. Limits the AppStatusChanged
+     * signals sent to the calling session to the given Apps
+     * @param member - the member called
+     * @param msg - the message of the method
+     */
+    void SetAppStatusSubscriptions(const InterfaceDescription::Member* member, Message& msg);
+
+    /**
+     * Function callback for batchUpdate. Applies create, update, activate,
+     * deactivate and delete operations on Acls of several Apps with a single
+     * policy commit
+     * @param member - the member called
+     * @param msg - the message of the method
+     */
+    void BatchUpdate(const InterfaceDescription::Member* member, Message& msg);
+
+    /**
+     * Function callback for getStats. Returns all counters and the latency
+     * histograms that have samples in a single reply
+     * @param member - the member called
+     * @param msg - the message of the method
+     */
+    void GetStats(const InterfaceDescription::Member* member, Message& msg);
+
+    /**
+     * Function callback for resetStats. Resets all counters and latency histograms
+     * @param member - the member called
+     * @param msg - the message of the method
+     */
+    void ResetStats(const InterfaceDescription::Member* member, Message& msg);
+
     /**
      * Get Property
      * @param interfaceName - name of the interface
@@ -69,8 +109,26 @@ class AppMgmtBusObject : public BusObject  {
      */
     QStatus Set(const char* interfaceName, const char* propName, MsgArg& val);
 
+  protected:
+
+    /**
+     * Call a method handler and record its latency
+     * @param handler - the handler
+     * @param member - the member called
+     * @param message - the message of the method
+     * @param context - the context the handler was registered with
+     */
+    virtual void CallMethodHandler(MessageReceiver::MethodHandler handler, const InterfaceDescription::Member* member, Message& message, void* context);
+
   private:
 
+    /**
+     * Add the Stats interface and its method handlers
+     * @param bus - the bus to create the interface
+     * @return status - success/failure
+     */
+    QStatus AddStatsInterface(BusAttachment* bus);
+
     /**
      * The ConnectorAppManager that contains this BusObject
      */
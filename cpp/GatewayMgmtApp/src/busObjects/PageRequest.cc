@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include "PageRequest.h"
+#include "ShardedBusObject.h"
+#include "../GatewayConstants.h"
+
+namespace ajn {
+namespace gw {
+using namespace gwConsts;
+
+PageRequest::PageRequest() : m_Cursor(""), m_PageSize(GATEWAY_LIST_PAGE_SIZE_DEFAULT), m_Projection(GW_LP_FULL)
+{
+}
+
+PageRequest::~PageRequest()
+{
+}
+
+QStatus PageRequest::unmarshal(Message& msg)
+{
+    const ajn::MsgArg* args = 0;
+    size_t numArgs = 0;
+    ShardedBusObject::GetMethodArgs(msg, numArgs, args);
+    if (numArgs != 3) {
+        return ER_INVALID_DATA;
+    }
+
+    char* cursor;
+    QStatus status = args[0].Get(AJPARAM_STR.c_str(), &cursor);
+    if (status != ER_OK) {
+        return status;
+    }
+
+    uint32_t pageSize;
+    status = args[1].Get(AJPARAM_UINT32.c_str(), &pageSize);
+    if (status != ER_OK) {
+        return status;
+    }
+
+    uint16_t projection;
+    status = args[2].Get(AJPARAM_UINT16.c_str(), &projection);
+    if (status != ER_OK) {
+        return status;
+    }
+
+    if (projection > GW_LP_MAX_LIST_PROJECTION) {
+        return ER_INVALID_DATA;
+    }
+
+    m_Cursor.assign(cursor);
+    if (pageSize == 0) {
+        m_PageSize = GATEWAY_LIST_PAGE_SIZE_DEFAULT;
+    } else if (pageSize > GATEWAY_LIST_PAGE_SIZE_MAX) {
+        m_PageSize = GATEWAY_LIST_PAGE_SIZE_MAX;
+    } else {
+        m_PageSize = pageSize;
+    }
+    m_Projection = (ListProjection) projection;
+
+    return status;
+}
+
+const qcc::String& PageRequest::getCursor() const
+{
+    return m_Cursor;
+}
+
+uint32_t PageRequest::getPageSize() const
+{
+    return m_PageSize;
+}
+
+ListProjection PageRequest::getProjection() const
+{
+    return m_Projection;
+}
+
+} /* namespace gw */
+} /* namespace ajn */
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef PAGEREQUEST_H_
+#define PAGEREQUEST_H_
+
+#include <qcc/String.h>
+#include <alljoyn/Message.h>
+#include <alljoyn/gateway/GatewayEnums.h>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * PageRequest class. Used to unmarshal the arguments of the paged list methods.
+ * The cursor is opaque to the caller: it is the id of the last entry of the
+ * previous page, so a page starts after it even if entries were added or
+ * removed in between. An empty cursor starts at the first entry
+ */
+class PageRequest {
+
+  public:
+
+    /**
+     * Constructor for PageRequest
+     */
+    PageRequest();
+
+    /**
+     * Destructor for PageRequest
+     */
+    virtual ~PageRequest();
+
+    /**
+     * Unmarshal the cursor, pageSize and projection of a paged list method
+     * @param msg - message to unmarshal
+     * @return status - success/failure
+     */
+    QStatus unmarshal(Message& msg);
+
+    /**
+     * Get the cursor the page starts after
+     * @return cursor - empty to start at the first entry
+     */
+    const qcc::String& getCursor() const;
+
+    /**
+     * Get the maximum number of entries in the page
+     * @return pageSize
+     */
+    uint32_t getPageSize() const;
+
+    /**
+     * Get the fields to return for every entry
+     * @return projection
+     */
+    ListProjection getProjection() const;
+
+  private:
+
+    /**
+     * The cursor the page starts after
+     */
+    qcc::String m_Cursor;
+
+    /**
+     * The maximum number of entries in the page
+     */
+    uint32_t m_PageSize;
+
+    /**
+     * The fields to return for every entry
+     */
+    ListProjection m_Projection;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+#endif /* PAGEREQUEST_H_ */
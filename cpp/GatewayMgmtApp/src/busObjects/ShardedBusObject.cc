@@ -0,0 +1,202 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include "ShardedBusObject.h"
+#include "../GatewayConstants.h"
+#include <alljoyn/gateway/GatewayConnectorApp.h>
+#include <alljoyn/gateway/GatewayMgmt.h>
+#include <alljoyn/gateway/GatewayRecorder.h>
+#include <alljoyn/gateway/GatewayTaskQueue.h>
+#include <alljoyn/gateway/GatewayStats.h>
+#include <alljoyn/gateway/GatewayTrace.h>
+
+namespace ajn {
+namespace gw {
+
+/**
+ * Method call posted to the task queue of a Connector App. The target is
+ * resolved by object path when the task runs, so calls to an Acl that was
+ * deleted in the meantime are answered with an error
+ */
+class ShardedMethodTask : public GatewayTask {
+  public:
+
+    ShardedMethodTask(ShardedBusObject* busObject, GatewayConnectorApp* connectorApp, qcc::String const& objectPath,
+                      const InterfaceDescription::Member* member, Message& msg) :
+        m_BusObject(busObject), m_ConnectorApp(connectorApp), m_ObjectPath(objectPath), m_Member(member), m_Msg(msg) { }
+
+    void run()
+    {
+        QStatus status = ER_BUS_NO_SUCH_OBJECT;
+        ShardedBusObject* busObject = m_ConnectorApp->getShardedBusObject(m_ObjectPath);
+        if (busObject) {
+            busObject->HandleShardedCall(m_Member, m_Msg);
+            // members annotated NO_REPLY never reply, a caller through the router times out on a handler that sent no reply
+            status = (m_Member->annotation & MEMBER_ANNOTATE_NO_REPLY) ? ER_OK : ER_TIMEOUT;
+        } else {
+            busObject = m_ConnectorApp->getShardedBusObject(m_ConnectorApp->getObjectPath());
+            if (busObject) {
+                busObject->ReplyError(m_Msg, ER_BUS_NO_SUCH_OBJECT);
+            }
+        }
+
+        // a GatewayLoopbackBus waits for the reply of its calls, release it if the call got none
+        GatewayBus* bus = GatewayMgmt::getInstance()->getBus();
+        if (bus) {
+            bus->deliverMethodReply(m_Msg, status, NULL, 0);
+        }
+    }
+
+    void cancel()
+    {
+        m_BusObject->ReplyError(m_Msg, ER_BUS_OBJECT_NOT_REGISTERED);
+    }
+
+  private:
+
+    ShardedBusObject* m_BusObject;
+
+    GatewayConnectorApp* m_ConnectorApp;
+
+    qcc::String m_ObjectPath;
+
+    const InterfaceDescription::Member* m_Member;
+
+    Message m_Msg;
+};
+
+ShardedBusObject::ShardedBusObject(qcc::String const& objectPath) : BusObject(objectPath.c_str()), m_ShardObjectPath(objectPath)
+{
+}
+
+ShardedBusObject::~ShardedBusObject()
+{
+}
+
+QStatus ShardedBusObject::AddShardedMethodHandler(const InterfaceDescription::Member* member, MessageReceiver::MethodHandler handler)
+{
+    if (!member) {
+        return ER_BUS_INTERFACE_NO_SUCH_MEMBER;
+    }
+
+    m_ShardedHandlers[member] = handler;
+    return BusObject::AddMethodHandler(member, static_cast<MessageReceiver::MethodHandler>(&ShardedBusObject::DispatchToShard));
+}
+
+QStatus ShardedBusObject::AddMethodHandler(const InterfaceDescription::Member* member, MessageReceiver::MethodHandler handler, void* context)
+{
+    if (member) {
+        m_DirectHandlers[member] = handler;
+    }
+    return BusObject::AddMethodHandler(member, handler, context);
+}
+
+void ShardedBusObject::CallMethodHandler(MessageReceiver::MethodHandler handler, const InterfaceDescription::Member* member, Message& message, void* context)
+{
+    if (GatewayRecorder::isRecording()) {
+        GatewayRecorder::recordMethodCall(member, message);
+    }
+
+    if (m_ShardedHandlers.find(member) != m_ShardedHandlers.end()) {
+        BusObject::CallMethodHandler(handler, member, message, context);
+        return;
+    }
+
+    GatewayTraceScope trace(member->name);
+    GatewayStatsTimer timer(member);
+    BusObject::CallMethodHandler(handler, member, message, context);
+}
+
+QStatus ShardedBusObject::SendSignal(const char* destination, SessionId sessionId, const InterfaceDescription::Member& signal,
+                                     const MsgArg* args, size_t numArgs)
+{
+    GatewayBus* bus = GatewayMgmt::getInstance()->getBus();
+    if (bus && bus->deliverSignal(GetPath(), destination, sessionId, signal, args, numArgs)) {
+        return ER_OK;
+    }
+    return Signal(destination, sessionId, signal, args, numArgs);
+}
+
+void ShardedBusObject::DispatchToShard(const InterfaceDescription::Member* member, Message& msg)
+{
+    DispatchToShard(m_ShardObjectPath, member, msg);
+}
+
+void ShardedBusObject::DispatchToShard(qcc::String const& objectPath, const InterfaceDescription::Member* member, Message& msg)
+{
+    GatewayConnectorApp* connectorApp = getShardOwner();
+    connectorApp->getTaskQueue()->post(new ShardedMethodTask(this, connectorApp, objectPath, member, msg));
+}
+
+void ShardedBusObject::GetMethodArgs(Message& msg, size_t& numArgs, const MsgArg*& args)
+{
+    GatewayBus* bus = GatewayMgmt::getInstance()->getBus();
+    if (!bus || !bus->getMethodArgs(msg, &numArgs, &args)) {
+        msg->GetArgs(numArgs, args);
+    }
+}
+
+QStatus ShardedBusObject::MethodReply(const Message& msg, const MsgArg* args, size_t numArgs)
+{
+    GatewayBus* bus = GatewayMgmt::getInstance()->getBus();
+    if (bus && bus->deliverMethodReply(msg, ER_OK, args, numArgs)) {
+        return ER_OK;
+    }
+    return BusObject::MethodReply(msg, args, numArgs);
+}
+
+QStatus ShardedBusObject::MethodReply(const Message& msg, const char* error, const char* errorMessage)
+{
+    GatewayBus* bus = GatewayMgmt::getInstance()->getBus();
+    if (bus && bus->deliverMethodReply(msg, ER_BUS_REPLY_IS_ERROR_MESSAGE, NULL, 0)) {
+        return ER_OK;
+    }
+    return BusObject::MethodReply(msg, error, errorMessage);
+}
+
+QStatus ShardedBusObject::MethodReply(const Message& msg, QStatus status)
+{
+    GatewayBus* bus = GatewayMgmt::getInstance()->getBus();
+    if (bus && bus->deliverMethodReply(msg, status, NULL, 0)) {
+        return ER_OK;
+    }
+    return BusObject::MethodReply(msg, status);
+}
+
+void ShardedBusObject::HandleShardedCall(const InterfaceDescription::Member* member, Message& msg)
+{
+    std::map<const InterfaceDescription::Member*, MessageReceiver::MethodHandler>::iterator it = m_ShardedHandlers.find(member);
+    if (it == m_ShardedHandlers.end()) {
+        it = m_DirectHandlers.find(member);
+        if (it == m_DirectHandlers.end()) {
+            QCC_DbgHLPrintf(("No handler registered for member %s", member->name.c_str()));
+            MethodReply(msg, ER_BUS_INTERFACE_NO_SUCH_MEMBER);
+            return;
+        }
+    }
+
+    GatewayTraceScope trace(member->name);
+    GatewayStatsTimer timer(member);
+    (this->*(it->second))(member, msg);
+}
+
+void ShardedBusObject::ReplyError(Message& msg, QStatus status)
+{
+    MethodReply(msg, status);
+}
+
+} /* namespace gw */
+} /* namespace ajn */
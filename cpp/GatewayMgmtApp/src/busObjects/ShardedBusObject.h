@@ -0,0 +1,185 @@
+/******************************************************************************
+ * Copyright (c) 2014, AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef SHARDEDBUSOBJECT_H_
+#define SHARDEDBUSOBJECT_H_
+
+#include <map>
+#include <alljoyn/BusObject.h>
+#include <alljoyn/InterfaceDescription.h>
+
+namespace ajn {
+namespace gw {
+
+class GatewayConnectorApp;
+
+/**
+ * ShardedBusObject - BusObject whose method calls are executed on the
+ * task queue of the Connector App that owns it instead of the AllJoyn
+ * dispatcher thread
+ */
+class ShardedBusObject : public BusObject {
+  public:
+
+    /**
+     * Constructor for ShardedBusObject class
+     * @param objectPath - objectPath of BusObject
+     */
+    ShardedBusObject(qcc::String const& objectPath);
+
+    /**
+     * Destructor for the BusObject
+     */
+    virtual ~ShardedBusObject();
+
+    /**
+     * Get the Connector App whose task queue executes the method calls
+     * @return connectorApp
+     */
+    virtual GatewayConnectorApp* getShardOwner() const = 0;
+
+    /**
+     * Execute a method call on the current thread. Called on the task queue.
+     * Methods that are not sharded only get here when a GatewayLoopbackBus
+     * dispatches them
+     * @param member - the member called
+     * @param msg - the message of the method
+     */
+    void HandleShardedCall(const InterfaceDescription::Member* member, Message& msg);
+
+    /**
+     * Reply to a method call with an error
+     * @param msg - the message of the method
+     * @param status - the error to reply with
+     */
+    void ReplyError(Message& msg, QStatus status);
+
+    /**
+     * Post a method call to the task queue of the Connector App that owns this
+     * object. A GatewayLoopbackBus dispatches its calls through here
+     * @param objectPath - object path of the called object, this object or an Acl of the same Connector App
+     * @param member - the member called
+     * @param msg - the message of the method
+     */
+    void DispatchToShard(qcc::String const& objectPath, const InterfaceDescription::Member* member, Message& msg);
+
+    /**
+     * Get the args of a method call, from the bus if it dispatched the call
+     * itself or else from the message
+     * @param msg - the message of the method
+     * @param numArgs - set to the number of args
+     * @param args - set to the args
+     */
+    static void GetMethodArgs(Message& msg, size_t& numArgs, const MsgArg*& args);
+
+  protected:
+
+    /**
+     * Reply to a method call. The bus of the GatewayMgmt is offered the reply
+     * first, a GatewayLoopbackBus hands it to the caller in-process
+     * @param msg - the message of the method
+     * @param args - args of the reply
+     * @param numArgs - number of args
+     * @return status - success/failure
+     */
+    QStatus MethodReply(const Message& msg, const MsgArg* args = NULL, size_t numArgs = 0);
+
+    /**
+     * Reply to a method call with an error name, see MethodReply
+     * @param msg - the message of the method
+     * @param error - name of the error
+     * @param errorMessage - message of the error
+     * @return status - success/failure
+     */
+    QStatus MethodReply(const Message& msg, const char* error, const char* errorMessage = NULL);
+
+    /**
+     * Reply to a method call with an error status, see MethodReply
+     * @param msg - the message of the method
+     * @param status - the error to reply with
+     * @return status - success/failure
+     */
+    QStatus MethodReply(const Message& msg, QStatus status);
+
+    /**
+     * Register a method handler that is executed on the task queue
+     * @param member - the member to handle
+     * @param handler - the handler
+     * @return status - success/failure
+     */
+    QStatus AddShardedMethodHandler(const InterfaceDescription::Member* member, MessageReceiver::MethodHandler handler);
+
+    /**
+     * Register a method handler that is executed on the AllJoyn dispatcher thread
+     * @param member - the member to handle
+     * @param handler - the handler
+     * @param context - passed on to the handler
+     * @return status - success/failure
+     */
+    QStatus AddMethodHandler(const InterfaceDescription::Member* member, MessageReceiver::MethodHandler handler, void* context = NULL);
+
+    /**
+     * Call a method handler on the AllJoyn dispatcher thread. Records the latency
+     * of the handler, sharded methods are recorded when they run on the task queue
+     * @param handler - the handler
+     * @param member - the member called
+     * @param message - the message of the method
+     * @param context - the context the handler was registered with
+     */
+    virtual void CallMethodHandler(MessageReceiver::MethodHandler handler, const InterfaceDescription::Member* member, Message& message, void* context);
+
+    /**
+     * Send a signal. The bus of the GatewayMgmt is offered the signal first,
+     * a GatewayLoopbackBus delivers it in-process
+     * @param destination - destination of the signal, NULL for a session
+     * @param sessionId - the session of the signal
+     * @param signal - the signal
+     * @param args - args of the signal
+     * @param numArgs - number of args
+     * @return status - success/failure
+     */
+    QStatus SendSignal(const char* destination, SessionId sessionId, const InterfaceDescription::Member& signal,
+                       const MsgArg* args = NULL, size_t numArgs = 0);
+
+  private:
+
+    /**
+     * Callback for all sharded methods. Posts the call to the task queue
+     * @param member - the member called
+     * @param msg - the message of the method
+     */
+    void DispatchToShard(const InterfaceDescription::Member* member, Message& msg);
+
+    /**
+     * The ObjectPath of this busObject
+     */
+    qcc::String m_ShardObjectPath;
+
+    /**
+     * The handlers of the sharded methods
+     */
+    std::map<const InterfaceDescription::Member*, MessageReceiver::MethodHandler> m_ShardedHandlers;
+
+    /**
+     * The handlers of the methods that are not sharded
+     */
+    std::map<const InterfaceDescription::Member*, MessageReceiver::MethodHandler> m_DirectHandlers;
+};
+
+} /* namespace gw */
+} /* namespace ajn */
+
+#endif /* SHARDEDBUSOBJECT_H_ */